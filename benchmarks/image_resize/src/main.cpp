@@ -0,0 +1,183 @@
+// MIT License
+//
+// Copyright (c) 2019 Filip Björklund
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <cstdlib>
+
+#include <olivine/core/console.hpp>
+#include <olivine/core/image.hpp>
+#include <olivine/core/memory.hpp>
+#include <olivine/core/thread_pool.hpp>
+#include <olivine/core/time.hpp>
+#include <thirdparty/stb/stb_image_resize.h>
+
+// ========================================================================== //
+// Benchmark
+// ========================================================================== //
+
+using namespace olivine;
+
+/** Width and height of the source image **/
+static constexpr u32 kSourceSize = 4096;
+
+/** Number of times each routine is run **/
+static constexpr u32 kIterations = 5;
+
+/** Fill an image with a smooth gradient and some noise **/
+static void
+FillSource(Image& image)
+{
+  u8* data = image.GetData();
+  for (u32 y = 0; y < image.GetHeight(); y++) {
+    for (u32 x = 0; x < image.GetWidth(); x++) {
+      u8* pixel = data + (u64(y) * image.GetWidth() + x) * 4;
+      pixel[0] = u8(x >> 4);
+      pixel[1] = u8(y >> 4);
+      pixel[2] = u8((x ^ y) + (std::rand() & 15));
+      pixel[3] = u8(255 - ((x + y) >> 5));
+    }
+  }
+}
+
+/** Run a routine and print the average time and throughput, in megapixels of
+ * destination per second **/
+template<typename F>
+static void
+Measure(const char8* name, u64 pixelCount, F&& routine)
+{
+  routine();
+  const Time start = Time::Now();
+  for (u32 i = 0; i < kIterations; i++) {
+    routine();
+  }
+  const f64 seconds = (Time::Now() - start).GetSeconds() / kIterations;
+  Console::WriteLine("  {:<32} {:>8.2f} ms {:>8.1f} MP/s",
+                     name,
+                     seconds * 1000.0,
+                     f64(pixelCount) / seconds / 1e6);
+}
+
+/** Resize with a single call to the resampler on the calling thread, which is
+ * how 'Image::Resize' used to work **/
+static void
+ResizeReference(const Image& source,
+                u8* destination,
+                u32 width,
+                u32 height,
+                stbir_filter filter,
+                stbir_colorspace space)
+{
+  stbir_resize_uint8_generic(source.GetData(),
+                             source.GetWidth(),
+                             source.GetHeight(),
+                             0,
+                             destination,
+                             width,
+                             height,
+                             0,
+                             4,
+                             3,
+                             0,
+                             STBIR_EDGE_CLAMP,
+                             filter,
+                             space,
+                             nullptr);
+}
+
+/** Compare the reference and 'Image::Resize' for one destination size **/
+static void
+Run(const Image& source,
+    u32 width,
+    u32 height,
+    Image::Filter filter,
+    stbir_filter referenceFilter,
+    Image::ColorSpace colorSpace)
+{
+  const bool srgb = colorSpace == Image::ColorSpace::kSRGB;
+  const stbir_colorspace space =
+    srgb ? STBIR_COLORSPACE_SRGB : STBIR_COLORSPACE_LINEAR;
+  Console::WriteLine("{}x{} -> {}x{}, filter {}, {}",
+                     source.GetWidth(),
+                     source.GetHeight(),
+                     width,
+                     height,
+                     u32(filter),
+                     srgb ? "sRGB" : "linear");
+
+  const u64 pixelCount = u64(width) * height;
+  u8* destination = static_cast<u8*>(Memory::Allocate(pixelCount * 4));
+  Measure("reference (single call)", pixelCount, [&] {
+    ResizeReference(
+      source, destination, width, height, referenceFilter, space);
+  });
+  Measure("Image::Resize", pixelCount, [&] {
+    Image image = source.Copy();
+    image.Resize(width, height, filter, colorSpace);
+  });
+  Memory::Free(destination);
+  Console::WriteLine("");
+}
+
+// ========================================================================== //
+// Main Function
+// ========================================================================== //
+
+int
+main()
+{
+  Image source;
+  source.Create({ kSourceSize, kSourceSize, Image::Format::kRGBA });
+  FillSource(source);
+  Console::WriteLine("Threads: {}\n", ThreadPool::GetGlobal().GetThreadCount());
+
+  // The copies of the source share its data, so the 'Image::Resize' timings
+  // do not include copying the pixels
+  const u32 half = kSourceSize / 2;
+  for (Image::ColorSpace colorSpace :
+       { Image::ColorSpace::kLinear, Image::ColorSpace::kSRGB }) {
+    Run(source,
+        half,
+        half,
+        Image::Filter::kBox,
+        STBIR_FILTER_BOX,
+        colorSpace);
+    Run(source,
+        half,
+        half,
+        Image::Filter::kTriangle,
+        STBIR_FILTER_TRIANGLE,
+        colorSpace);
+    Run(source,
+        1000,
+        700,
+        Image::Filter::kMitchell,
+        STBIR_FILTER_MITCHELL,
+        colorSpace);
+    Run(source,
+        5000,
+        5000,
+        Image::Filter::kCatmullRom,
+        STBIR_FILTER_CATMULLROM,
+        colorSpace);
+  }
+
+  return 0;
+}
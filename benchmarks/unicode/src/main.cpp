@@ -0,0 +1,160 @@
+// MIT License
+//
+// Copyright (c) 2019 Filip Björklund
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <vector>
+
+#include <olivine/core/console.hpp>
+#include <olivine/core/time.hpp>
+#include <olivine/core/unicode.hpp>
+#include <thirdparty/alflib/alf_unicode.h>
+
+// ========================================================================== //
+// Benchmark
+// ========================================================================== //
+
+using namespace olivine;
+
+/** Size of each generated input in bytes **/
+static constexpr u64 kInputSize = 4 * 1024 * 1024;
+
+/** Number of times each routine is run **/
+static constexpr u32 kIterations = 20;
+
+/** Prevents the results from being optimized away **/
+static volatile u64 sSink = 0;
+
+/** Build a null-terminated input by repeating the pieces **/
+static std::vector<char8>
+BuildInput(const char8* const* pieces, u32 count)
+{
+  std::vector<char8> input;
+  input.reserve(kInputSize + 64);
+  for (u32 i = 0; input.size() < kInputSize; i++) {
+    for (const char8* c = pieces[i % count]; *c; c++) {
+      input.push_back(*c);
+    }
+  }
+  input.push_back(0);
+  return input;
+}
+
+/** Run a routine and print the throughput, in MB/s of UTF-8 input **/
+template<typename F>
+static void
+Measure(const char8* name, u64 size, F&& routine)
+{
+  routine();
+  const Time start = Time::Now();
+  for (u32 i = 0; i < kIterations; i++) {
+    sSink = sSink + routine();
+  }
+  const f64 seconds = (Time::Now() - start).GetSeconds();
+  const f64 throughput = f64(size) * kIterations / seconds / (1024 * 1024);
+  Console::WriteLine("  {:<24} {:>10.1f} MB/s", name, throughput);
+}
+
+/** Run all benchmarks on an input **/
+static void
+Run(const char8* title, const std::vector<char8>& input)
+{
+  const char8* data = input.data();
+  const u64 size = input.size() - 1;
+  Console::WriteLine("{} ({} bytes)", title, size);
+
+  // UTF-16 version of the input for the reverse direction
+  const u64 size16 = Unicode::UTF16SizeOfUTF8(data, size);
+  std::vector<char16> utf16(size16 + 1);
+  std::vector<char8> utf8(size + 1);
+  u64 written;
+  Unicode::UTF8ToUTF16(data, size, utf16.data(), size16, written);
+  utf16[written] = 0;
+
+  Measure("alf validate", size, [&] { return u64(alfUTF8Valid(data)); });
+  Measure("olivine validate", size, [&] {
+    return u64(Unicode::ValidateUTF8(data, size));
+  });
+  Measure("alf length", size, [&] { return alfUTF8StringLength(data); });
+  Measure("olivine length", size, [&] {
+    return Unicode::CountUTF8(data, size);
+  });
+  Measure("alf utf8->utf16", size, [&] {
+    u32 count;
+    alfUTF8ToUTF16(data, &count, nullptr);
+    alfUTF8ToUTF16(data, &count, reinterpret_cast<AlfChar16*>(utf16.data()));
+    return u64(count);
+  });
+  Measure("olivine utf8->utf16", size, [&] {
+    u64 count;
+    Unicode::UTF8ToUTF16(data,
+                         size,
+                         utf16.data(),
+                         Unicode::UTF16SizeOfUTF8(data, size),
+                         count);
+    return count;
+  });
+  Measure("alf utf16->utf8", size, [&] {
+    const AlfChar16* source =
+      reinterpret_cast<const AlfChar16*>(utf16.data());
+    u32 count;
+    alfUTF16ToUTF8(source, &count, nullptr);
+    alfUTF16ToUTF8(source, &count, utf8.data());
+    return u64(count);
+  });
+  Measure("olivine utf16->utf8", size, [&] {
+    u64 count;
+    Unicode::UTF16ToUTF8(utf16.data(),
+                         size16,
+                         utf8.data(),
+                         Unicode::UTF8SizeOfUTF16(utf16.data(), size16),
+                         count);
+    return count;
+  });
+  Console::WriteLine("");
+}
+
+// ========================================================================== //
+// Main Function
+// ========================================================================== //
+
+int
+main()
+{
+  // Mostly ASCII with the occasional accented character
+  const char8* ascii[] = { "The quick brown fox jumps over the lazy dog. ",
+                           "Sphinx of black quartz, judge my vow. ",
+                           "Caf\xC3\xA9 au lait, na\xC3\xAFve r\xC3\xA9sum\xC3\xA9. ",
+                           "Pack my box with five dozen liquor jugs.\n" };
+  Run("ASCII-heavy", BuildInput(ascii, 4));
+
+  // Mostly 3-byte CJK sequences with some ASCII punctuation
+  const char8* cjk[] = {
+    "\xE6\x97\xA5\xE6\x9C\xAC\xE8\xAA\x9E\xE3\x81\xAE\xE6\x96\x87\xE7\xAB"
+    "\xA0\xE3\x81\xA7\xE3\x81\x99\xE3\x80\x82",
+    "\xE4\xB8\xAD\xE6\x96\x87\xE6\xB5\x8B\xE8\xAF\x95\xE6\x96\x87\xE6\x9C"
+    "\xAC, ",
+    "\xED\x95\x9C\xEA\xB5\xAD\xEC\x96\xB4 \xED\x85\x8D\xEC\x8A\xA4\xED\x8A"
+    "\xB8\n"
+  };
+  Run("CJK-heavy", BuildInput(cjk, 3));
+
+  return 0;
+}
@@ -52,53 +52,23 @@ Console::Flush()
 // -------------------------------------------------------------------------- //
 
 void
-Console::Write_(const String& message)
+Console::Write_(StringView message)
 {
-  char16* _message = message.GetUTF16();
-  OutputDebugStringW(_message);
-  delete[] _message;
+  const UTF16Buffer _message(message.GetData(), message.GetSize());
+  OutputDebugStringW(_message.GetData());
 
-  fputs(message.GetUTF8(), stdout);
+  fwrite(message.GetData(), 1, message.GetSize(), stdout);
 }
 
 // -------------------------------------------------------------------------- //
 
 void
-Console::WriteErr_(const String& message)
+Console::WriteErr_(StringView message)
 {
-  char16* _message = message.GetUTF16();
-  OutputDebugStringW(_message);
-  delete[] _message;
+  const UTF16Buffer _message(message.GetData(), message.GetSize());
+  OutputDebugStringW(_message.GetData());
 
-  fputs(message.GetUTF8(), stderr);
+  fwrite(message.GetData(), 1, message.GetSize(), stderr);
 }
 
-// -------------------------------------------------------------------------- //
-
-void
-Console::WriteLine_(const String& message)
-{
-  const String withNewline = message + "\n";
-
-  char16* _message = withNewline.GetUTF16();
-  OutputDebugStringW(_message);
-  delete[] _message;
-
-  fputs(withNewline.GetUTF8(), stdout);
 }
-
-// -------------------------------------------------------------------------- //
-
-void
-Console::WriteErrLine_(const String& message)
-{
-  const String withNewline = message + "\n";
-
-  char16* _message = withNewline.GetUTF16();
-  OutputDebugStringW(_message);
-  delete[] _message;
-
-  fputs(withNewline.GetUTF8(), stderr);
-}
-
-}
\ No newline at end of file
@@ -44,6 +44,10 @@ public:
   /** Type for a 8-bit ANSI color **/
   using Color = u8;
 
+  /** Size of the stack buffer that messages are formatted into. Longer
+   * messages are formatted into a heap buffer **/
+  static constexpr u32 kBufferSize = 512;
+
   /** Black **/
   static constexpr Color BLACK = 0;
   /** Black **/
@@ -81,42 +85,46 @@ public:
   /** Write a formatted message to the standard output.
    * \note Message is formatted according to the rules of the 'fmt' library.
    * \brief Write to stdout.
+   * \tparam S Format string type.
    * \tparam ARGS Argument types.
    * \param format Message format string.
    * \param arguments Arguments to format string with.
    */
-  template<typename... ARGS>
-  static void Write(const String& format, ARGS&&... arguments);
+  template<typename S, typename... ARGS>
+  static void Write(const S& format, ARGS&&... arguments);
 
   /** Write a formatted error message to the error output.
    * \note Message is formatted according to the rules of the 'fmt' library.
    * \brief Write to stderr.
+   * \tparam S Format string type.
    * \tparam ARGS Argument types.
    * \param format Message format string.
    * \param arguments Arguments to format string with.
    */
-  template<typename... ARGS>
-  static void WriteErr(const String& format, ARGS&&... arguments);
+  template<typename S, typename... ARGS>
+  static void WriteErr(const S& format, ARGS&&... arguments);
 
   /** Write a formatted message to the standard output followed by a newline.
    * \note Message is formatted according to the rules of the 'fmt' library.
    * \brief Write to stdout.
+   * \tparam S Format string type.
    * \tparam ARGS Argument types.
    * \param format Message format string.
    * \param arguments Arguments to format string with.
    */
-  template<typename... ARGS>
-  static void WriteLine(const String& format, ARGS&&... arguments);
+  template<typename S, typename... ARGS>
+  static void WriteLine(const S& format, ARGS&&... arguments);
 
   /** Write a formatted error message to the error output followed by a newline.
    * \note Message is formatted according to the rules of the 'fmt' library.
    * \brief Write to stderr.
+   * \tparam S Format string type.
    * \tparam ARGS Argument types.
    * \param format Message format string.
    * \param arguments Arguments to format string with.
    */
-  template<typename... ARGS>
-  static void WriteErrLine(const String& format, ARGS&&... arguments);
+  template<typename S, typename... ARGS>
+  static void WriteErrLine(const S& format, ARGS&&... arguments);
 
   /** Construct a colored string from the input string and an 8-bit ANSI color
    * value. Values from 0 to 255 are supported.
@@ -134,52 +142,54 @@ public:
 
 private:
   /** Write to standard output **/
-  static void Write_(const String& message);
+  static void Write_(StringView message);
 
   /** Write to error output **/
-  static void WriteErr_(const String& message);
-
-  /** Write a line to standard output (newline is appended) **/
-  static void WriteLine_(const String& message);
-
-  /** Write a line to error output **/
-  static void WriteErrLine_(const String& message);
+  static void WriteErr_(StringView message);
 };
 
 // -------------------------------------------------------------------------- //
 
-template<typename... ARGS>
+template<typename S, typename... ARGS>
 void
-Console::Write(const String& format, ARGS&&... arguments)
+Console::Write(const S& format, ARGS&&... arguments)
 {
-  Write_(String::Format(format, std::forward<ARGS>(arguments)...));
+  FormatBuffer<kBufferSize> buffer;
+  Write_(String::FormatTo(buffer, format, std::forward<ARGS>(arguments)...));
 }
 
 // -------------------------------------------------------------------------- //
 
-template<typename... ARGS>
+template<typename S, typename... ARGS>
 void
-Console::WriteErr(const String& format, ARGS&&... arguments)
+Console::WriteErr(const S& format, ARGS&&... arguments)
 {
-  WriteErr_(String::Format(format, std::forward<ARGS>(arguments)...));
+  FormatBuffer<kBufferSize> buffer;
+  WriteErr_(String::FormatTo(buffer, format, std::forward<ARGS>(arguments)...));
 }
 
 // -------------------------------------------------------------------------- //
 
-template<typename... ARGS>
+template<typename S, typename... ARGS>
 void
-Console::WriteLine(const String& format, ARGS&&... arguments)
+Console::WriteLine(const S& format, ARGS&&... arguments)
 {
-  WriteLine_(String::Format(format, std::forward<ARGS>(arguments)...));
+  FormatBuffer<kBufferSize> buffer;
+  String::FormatTo(buffer, format, std::forward<ARGS>(arguments)...);
+  buffer.Append("\n");
+  Write_(buffer.GetView());
 }
 
 // -------------------------------------------------------------------------- //
 
-template<typename... ARGS>
+template<typename S, typename... ARGS>
 void
-Console::WriteErrLine(const String& format, ARGS&&... arguments)
+Console::WriteErrLine(const S& format, ARGS&&... arguments)
 {
-  WriteErrLine_(String::Format(format, std::forward<ARGS>(arguments)...));
+  FormatBuffer<kBufferSize> buffer;
+  String::FormatTo(buffer, format, std::forward<ARGS>(arguments)...);
+  buffer.Append("\n");
+  WriteErr_(buffer.GetView());
 }
 
-}
\ No newline at end of file
+}
@@ -0,0 +1,151 @@
+// MIT License
+//
+// Copyright (c) 2019 Filip Björklund
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "olivine/core/cpu.hpp"
+
+// ========================================================================== //
+// Headers
+// ========================================================================== //
+
+// Platform headers
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+
+// ========================================================================== //
+// Functions
+// ========================================================================== //
+
+namespace olivine {
+
+/** Detected CPU features **/
+struct CpuFeatures
+{
+  bool ssse3 = false;
+  bool sse41 = false;
+  bool avx2 = false;
+};
+
+// -------------------------------------------------------------------------- //
+
+/** Execute cpuid for the specified leaf and sub-leaf **/
+static void
+CpuId(u32 leaf, u32 subLeaf, u32 (&regs)[4])
+{
+#if defined(_MSC_VER)
+  int _regs[4];
+  __cpuidex(_regs, s32(leaf), s32(subLeaf));
+  for (u32 i = 0; i < 4; i++) {
+    regs[i] = u32(_regs[i]);
+  }
+#else
+  __cpuid_count(leaf, subLeaf, regs[0], regs[1], regs[2], regs[3]);
+#endif
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Returns the value of the extended control register 0 **/
+static u64
+ReadXCR0()
+{
+#if defined(_MSC_VER)
+  return _xgetbv(0);
+#else
+  u32 eax, edx;
+  __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+  return (u64(edx) << 32) | eax;
+#endif
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Detect features of the CPU **/
+static CpuFeatures
+DetectCpuFeatures()
+{
+  CpuFeatures features;
+  u32 regs[4];
+  CpuId(0, 0, regs);
+  const u32 maxLeaf = regs[0];
+  if (maxLeaf < 1) {
+    return features;
+  }
+
+  // Leaf 1: SSSE3 (ECX:9), SSE4.1 (ECX:19), OSXSAVE (ECX:27), AVX (ECX:28)
+  CpuId(1, 0, regs);
+  features.ssse3 = (regs[2] & (1u << 9)) != 0;
+  features.sse41 = (regs[2] & (1u << 19)) != 0;
+  const bool osxsave = (regs[2] & (1u << 27)) != 0;
+  const bool avx = (regs[2] & (1u << 28)) != 0;
+
+  // Leaf 7: AVX2 (EBX:5). The OS must also save the YMM registers
+  if (maxLeaf >= 7 && osxsave && avx && (ReadXCR0() & 0x6) == 0x6) {
+    CpuId(7, 0, regs);
+    features.avx2 = (regs[1] & (1u << 5)) != 0;
+  }
+  return features;
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Returns the detected CPU features **/
+static const CpuFeatures&
+GetCpuFeatures()
+{
+  static const CpuFeatures features = DetectCpuFeatures();
+  return features;
+}
+
+}
+
+// ========================================================================== //
+// Cpu Implementation
+// ========================================================================== //
+
+namespace olivine {
+
+bool
+Cpu::HasSSSE3()
+{
+  return GetCpuFeatures().ssse3;
+}
+
+// -------------------------------------------------------------------------- //
+
+bool
+Cpu::HasSSE41()
+{
+  return GetCpuFeatures().sse41;
+}
+
+// -------------------------------------------------------------------------- //
+
+bool
+Cpu::HasAVX2()
+{
+  return GetCpuFeatures().avx2;
+}
+
+}
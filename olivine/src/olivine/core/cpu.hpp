@@ -0,0 +1,91 @@
+// MIT License
+//
+// Copyright (c) 2019 Filip Björklund
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+// ========================================================================== //
+// Headers
+// ========================================================================== //
+
+// Project headers
+#include "olivine/core/types.hpp"
+#include "olivine/core/macros.hpp"
+
+// ========================================================================== //
+// Macros
+// ========================================================================== //
+
+/** Macros for marking a function as being compiled for a specific instruction
+ * set. MSVC allows intrinsics from any instruction set to be used without
+ * this, while GCC and Clang requires the target to be specified. Functions
+ * marked with these must only be called after checking the corresponding
+ * 'Cpu::Has*' function **/
+#if defined(_MSC_VER)
+#define OL_TARGET_SSSE3
+#define OL_TARGET_SSE41
+#define OL_TARGET_AVX2
+#else
+#define OL_TARGET_SSSE3 __attribute__((target("ssse3")))
+#define OL_TARGET_SSE41 __attribute__((target("sse4.1")))
+#define OL_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+// ========================================================================== //
+// Cpu Declaration
+// ========================================================================== //
+
+namespace olivine {
+
+/** \class Cpu
+ * \author Filip Björklund
+ * \date 18 october 2026 - 13:40
+ * \brief CPU information.
+ * \details
+ * Namespace class with functions for querying the features of the CPU that the
+ * process is running on. Features are detected once, on the first query.
+ */
+class Cpu
+{
+  OL_NAMESPACE_CLASS(Cpu);
+
+public:
+  /** Returns whether or not the CPU supports the SSSE3 instruction set.
+   * \brief Returns whether SSSE3 is supported.
+   * \return True if SSSE3 is supported otherwise false.
+   */
+  static bool HasSSSE3();
+
+  /** Returns whether or not the CPU supports the SSE4.1 instruction set.
+   * \brief Returns whether SSE4.1 is supported.
+   * \return True if SSE4.1 is supported otherwise false.
+   */
+  static bool HasSSE41();
+
+  /** Returns whether or not the CPU, and the operating system, supports the
+   * AVX2 instruction set.
+   * \brief Returns whether AVX2 is supported.
+   * \return True if AVX2 is supported otherwise false.
+   */
+  static bool HasAVX2();
+};
+
+}
@@ -0,0 +1,350 @@
+// MIT License
+//
+// Copyright (c) 2019 Filip Björklund
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "olivine/core/file/access_trace.hpp"
+
+// ========================================================================== //
+// Headers
+// ========================================================================== //
+
+// Standard headers
+#include <algorithm>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+
+// Project headers
+#include "olivine/core/memory.hpp"
+#include "olivine/core/file/buffered_io.hpp"
+#include "olivine/core/file/file_io.hpp"
+#include "olivine/core/file/vfs.hpp"
+#include "olivine/core/platform/headers.hpp"
+
+// ========================================================================== //
+// Variables
+// ========================================================================== //
+
+namespace olivine {
+
+/** Recorded range **/
+struct RecordedRange
+{
+  /** Path of the file **/
+  String path;
+  /** Offset of the start of the range **/
+  u64 begin;
+  /** Offset of the end of the range **/
+  u64 end;
+};
+
+// -------------------------------------------------------------------------- //
+
+/** Mutex for the recorded ranges **/
+static std::mutex sRecordMutex;
+/** Recorded ranges in the order they were first read. A deque is used so that
+ * the paths don't move when ranges are added **/
+static std::deque<RecordedRange> sRanges;
+/** Index of the last range of each file, keyed by a view of the path of the
+ * first range of the file **/
+static std::unordered_map<StringView, u64> sLastRanges;
+/** Whether the thread is prefetching, in which case reads are not recorded **/
+static thread_local bool sIsPrefetching = false;
+
+// -------------------------------------------------------------------------- //
+
+std::atomic<bool> AccessTrace::sRecording{ false };
+
+}
+
+// ========================================================================== //
+// AccessTrace Implementation
+// ========================================================================== //
+
+namespace olivine {
+
+void
+AccessTrace::StartRecording()
+{
+  std::lock_guard<std::mutex> lock(sRecordMutex);
+  sLastRanges.clear();
+  sRanges.clear();
+  sRecording.store(true, std::memory_order_relaxed);
+}
+
+// -------------------------------------------------------------------------- //
+
+FileResult
+AccessTrace::StopRecording(const Path& path)
+{
+  std::lock_guard<std::mutex> lock(sRecordMutex);
+  sRecording.store(false, std::memory_order_relaxed);
+
+  // Open trace file
+  FileIO io(path);
+  FileResult result = io.Open(FileIO::Flag::kWrite | FileIO::Flag::kCreate |
+                              FileIO::Flag::kOverwrite);
+  if (result != FileResult::kSuccess) {
+    return result;
+  }
+
+  // Write header followed by the ranges
+  BufferedWriter writer(io);
+  const u32 header[3] = { kMagic, kVersion, u32(sRanges.size()) };
+  writer.Write(reinterpret_cast<const u8*>(header), sizeof(header));
+  for (const RecordedRange& range : sRanges) {
+    const u64 values[2] = { range.begin, range.end - range.begin };
+    const u32 pathSize = range.path.GetSize();
+    writer.Write(reinterpret_cast<const u8*>(values), sizeof(values));
+    writer.Write(reinterpret_cast<const u8*>(&pathSize), sizeof(pathSize));
+    writer.Write(range.path.GetView());
+  }
+  result = writer.Close();
+
+  sLastRanges.clear();
+  sRanges.clear();
+  return result;
+}
+
+// -------------------------------------------------------------------------- //
+
+void
+AccessTrace::Record(PathView path, u64 offset, u64 size)
+{
+  if (!IsRecording() || sIsPrefetching || size == 0) {
+    return;
+  }
+  const StringView key = path.GetPathString();
+  const u64 end = offset + size;
+
+  std::lock_guard<std::mutex> lock(sRecordMutex);
+  if (!sRecording.load(std::memory_order_relaxed)) {
+    return;
+  }
+
+  // Merge with the last range of the file if they overlap or are adjacent
+  const auto last = sLastRanges.find(key);
+  if (last != sLastRanges.end()) {
+    RecordedRange& range = sRanges[last->second];
+    if (offset <= range.end && end >= range.begin) {
+      range.begin = std::min(range.begin, offset);
+      range.end = std::max(range.end, end);
+      return;
+    }
+    sRanges.push_back(RecordedRange{ String(key), offset, end });
+    last->second = sRanges.size() - 1;
+    return;
+  }
+
+  // First read of the file
+  sRanges.push_back(RecordedRange{ String(key), offset, end });
+  sLastRanges.emplace(sRanges.back().path.GetView(), sRanges.size() - 1);
+}
+
+// -------------------------------------------------------------------------- //
+
+FileResult
+AccessTrace::Load(const Path& path, std::vector<Range>& ranges)
+{
+  FileIO io(path);
+  FileResult result = io.Open(FileIO::Flag::kRead);
+  if (result != FileResult::kSuccess) {
+    return result;
+  }
+
+  // The trace is read front to back once, so it's streamed through a buffer
+  // and each range is parsed in place
+  BufferedReader reader(io);
+  const u8* data;
+  u64 available;
+
+  // Check header
+  u32 header[3];
+  result = reader.Peek(sizeof(header), data, available);
+  if (result != FileResult::kSuccess) {
+    return result;
+  }
+  if (available < sizeof(header)) {
+    return FileResult::kInvalidArgument;
+  }
+  memcpy(header, data, sizeof(header));
+  reader.Consume(sizeof(header));
+  if (header[0] != kMagic || header[1] != kVersion) {
+    return FileResult::kInvalidArgument;
+  }
+
+  // Read ranges
+  ranges.reserve(ranges.size() + header[2]);
+  for (u32 i = 0; i < header[2]; i++) {
+    u64 values[2];
+    u32 pathSize;
+    result = reader.Peek(sizeof(values) + sizeof(pathSize), data, available);
+    if (result != FileResult::kSuccess) {
+      return result;
+    }
+    if (available < sizeof(values) + sizeof(pathSize)) {
+      return FileResult::kInvalidArgument;
+    }
+    memcpy(values, data, sizeof(values));
+    memcpy(&pathSize, data + sizeof(values), sizeof(pathSize));
+    reader.Consume(sizeof(values) + sizeof(pathSize));
+
+    result = reader.Peek(pathSize, data, available);
+    if (result != FileResult::kSuccess) {
+      return result;
+    }
+    if (available < pathSize) {
+      return FileResult::kInvalidArgument;
+    }
+    const StringView rangePath(reinterpret_cast<const char8*>(data), pathSize);
+    ranges.push_back(Range{ Path{ String(rangePath) }, values[0], values[1] });
+    reader.Consume(pathSize);
+  }
+  return FileResult::kSuccess;
+}
+
+}
+
+// ========================================================================== //
+// Prefetcher Implementation
+// ========================================================================== //
+
+namespace olivine {
+
+Prefetcher::Prefetcher()
+  : Prefetcher(CreateInfo{})
+{}
+
+// -------------------------------------------------------------------------- //
+
+Prefetcher::Prefetcher(const CreateInfo& createInfo)
+  : mInfo(createInfo)
+{}
+
+// -------------------------------------------------------------------------- //
+
+Prefetcher::~Prefetcher()
+{
+  Stop();
+}
+
+// -------------------------------------------------------------------------- //
+
+FileResult
+Prefetcher::Start(const Path& trace)
+{
+  if (mThread.joinable()) {
+    return FileResult::kAlreadyOpen;
+  }
+
+  // Load the trace before starting, so that a missing trace is reported
+  std::vector<AccessTrace::Range> ranges;
+  const FileResult result = AccessTrace::Load(trace, ranges);
+  if (result != FileResult::kSuccess) {
+    return result;
+  }
+
+  mStop = false;
+  mPrefetchedBytes = 0;
+  mThread = std::thread([this, ranges = std::move(ranges)] {
+    sIsPrefetching = true;
+    u64 total = 0;
+    for (const AccessTrace::Range& range : ranges) {
+      if (mStop.load(std::memory_order_relaxed) ||
+          total + range.size > mInfo.maxBytes) {
+        break;
+      }
+      total += Prefetch(range);
+      mPrefetchedBytes.store(total, std::memory_order_relaxed);
+    }
+  });
+  return FileResult::kSuccess;
+}
+
+// -------------------------------------------------------------------------- //
+
+void
+Prefetcher::Stop()
+{
+  mStop = true;
+  Wait();
+}
+
+// -------------------------------------------------------------------------- //
+
+void
+Prefetcher::Wait()
+{
+  if (mThread.joinable()) {
+    mThread.join();
+  }
+}
+
+// -------------------------------------------------------------------------- //
+
+u64
+Prefetcher::Prefetch(const AccessTrace::Range& range)
+{
+  // Files in packs are prefetched from the mapped pack
+  VFS::File packed;
+  if (VFS::Find(range.path.GetView(), packed)) {
+    packed.pack->Prefetch(*packed.entry);
+    return packed.entry->storedSize;
+  }
+
+#if defined(OL_PLATFORM_LINUX)
+  // Ask the kernel to read the range ahead, without waiting for it
+  const int file =
+    open(range.path.GetPathString().GetUTF8(), O_RDONLY | O_CLOEXEC);
+  if (file == -1) {
+    return 0;
+  }
+  posix_fadvise(
+    file, off_t(range.offset), off_t(range.size), POSIX_FADV_WILLNEED);
+  close(file);
+  return range.size;
+#else
+  // Read the range into a scratch buffer, which leaves it in the file cache
+  static constexpr u64 kScratchSize = 1024 * 1024;
+  FileIO io(range.path);
+  if (io.Open(FileIO::Flag::kRead | FileIO::Flag::kShareRead) !=
+      FileResult::kSuccess) {
+    return 0;
+  }
+  u8* scratch = static_cast<u8*>(Memory::Allocate(kScratchSize));
+  u64 offset = range.offset;
+  const u64 end = range.offset + range.size;
+  while (offset < end) {
+    u64 read;
+    const u64 toRead = std::min(kScratchSize, end - offset);
+    if (io.ReadAt(offset, scratch, toRead, read) != FileResult::kSuccess ||
+        read == 0) {
+      break;
+    }
+    offset += read;
+  }
+  Memory::Free(scratch);
+  return offset - range.offset;
+#endif
+}
+
+}
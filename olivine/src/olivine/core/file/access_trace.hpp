@@ -0,0 +1,232 @@
+// MIT License
+//
+// Copyright (c) 2019 Filip Björklund
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+// ========================================================================== //
+// Headers
+// ========================================================================== //
+
+// Standard headers
+#include <atomic>
+#include <thread>
+#include <vector>
+
+// Project headers
+#include "olivine/core/common.hpp"
+#include "olivine/core/macros.hpp"
+#include "olivine/core/file/path.hpp"
+#include "olivine/core/file/result.hpp"
+
+// ========================================================================== //
+// AccessTrace Declaration
+// ========================================================================== //
+
+namespace olivine {
+
+/** \class AccessTrace
+ * \author Filip Björklund
+ * \date 18 october 2026 - 23:10
+ * \brief Recorder of the file reads of a run.
+ * \details
+ * Records the order and byte ranges of the files that are read while recording
+ * is active, and saves them to a trace file. A 'Prefetcher' can then replay the
+ * trace on the next run, so that the files are in the page cache by the time
+ * they are read.
+ *
+ * Reads through 'FileIO', 'AsyncIO' and 'VFS' are recorded, as are the ranges
+ * of a 'MappedFile' that are advised with 'MappedFile::Hint::kWillNeed'.
+ * Consecutive reads of adjacent or overlapping ranges of the same file are
+ * merged into a single range. Paths are recorded as they were passed to the
+ * reading function.
+ *
+ * Recording is disabled by default, and the cost of the hooks when it's
+ * disabled is a single atomic load.
+ *
+ * \code
+ * AccessTrace::StartRecording();
+ * LoadScene();
+ * AccessTrace::StopRecording("res/startup.trace");
+ * \endcode
+ */
+class AccessTrace
+{
+  OL_NAMESPACE_CLASS(AccessTrace);
+
+public:
+  /** Magic number at the start of every trace file ("OLAT") **/
+  static constexpr u32 kMagic = 0x54414C4Fu;
+  /** Version of the format **/
+  static constexpr u32 kVersion = 1;
+
+  /** Range of a file that was read **/
+  struct Range
+  {
+    /** Path of the file **/
+    Path path;
+    /** Offset of the range in bytes **/
+    u64 offset;
+    /** Size of the range in bytes **/
+    u64 size;
+  };
+
+private:
+  /** Whether recording is active **/
+  static std::atomic<bool> sRecording;
+
+public:
+  /** Start recording reads. Any ranges that was recorded before are discarded.
+   * \brief Start recording.
+   */
+  static void StartRecording();
+
+  /** Stop recording reads and save the recorded ranges to a trace file.
+   * \brief Stop recording.
+   * \param path Path of the trace file to write.
+   * \return Result.
+   */
+  static FileResult StopRecording(const Path& path);
+
+  /** Returns whether reads are being recorded.
+   * \brief Returns whether recording.
+   * \return True if recording otherwise false.
+   */
+  OL_NODISCARD static bool IsRecording()
+  {
+    return sRecording.load(std::memory_order_relaxed);
+  }
+
+  /** Record a read of a range of a file. This does nothing if recording is not
+   * active, or if called from a thread that is prefetching.
+   * \brief Record read.
+   * \param path Path of the file.
+   * \param offset Offset of the range in bytes.
+   * \param size Size of the range in bytes.
+   */
+  static void Record(PathView path, u64 offset, u64 size);
+
+  /** Load the ranges of a trace file.
+   * \brief Load trace.
+   * \param path Path of the trace file.
+   * \param[out] ranges Ranges in the order they were first read.
+   * \return Result.
+   * - FileResult::kInvalidArgument: The file is not a valid trace.
+   */
+  static FileResult Load(const Path& path, std::vector<Range>& ranges);
+};
+
+// ========================================================================== //
+// Prefetcher Declaration
+// ========================================================================== //
+
+/** \class Prefetcher
+ * \author Filip Björklund
+ * \date 18 october 2026 - 23:10
+ * \brief Prefetcher that replays an access trace.
+ * \details
+ * Replays a trace that was recorded by 'AccessTrace' on a background thread, by
+ * asking the operating system to read the ranges into the page cache in the
+ * order that they were read during the recorded run. When started before the
+ * assets are loaded, the IO overlaps with decoding instead of each file being
+ * read on demand.
+ *
+ * On Linux the ranges are read ahead with 'posix_fadvise', which does not copy
+ * any data. On other platforms the ranges are read into a scratch buffer. Files
+ * in packs that are mounted in the 'VFS' are prefetched from the mapped pack.
+ * The prefetching is only a hint, a trace that is missing or out of date does
+ * not affect the correctness of the reads.
+ */
+class Prefetcher
+{
+  OL_NO_COPY(Prefetcher);
+
+public:
+  /** Creation information **/
+  struct CreateInfo
+  {
+    /** Maximum number of bytes to prefetch. Ranges after the limit is reached
+     * are skipped, so that a large trace does not evict the data that was
+     * prefetched first **/
+    u64 maxBytes = 1024ull * 1024ull * 1024ull;
+  };
+
+private:
+  /** Creation information **/
+  CreateInfo mInfo;
+  /** Prefetching thread **/
+  std::thread mThread;
+  /** Whether the thread should stop **/
+  std::atomic<bool> mStop{ false };
+  /** Number of bytes that has been prefetched **/
+  std::atomic<u64> mPrefetchedBytes{ 0 };
+
+public:
+  /** Create a prefetcher with the default creation information.
+   * \brief Create prefetcher.
+   */
+  Prefetcher();
+
+  /** Create a prefetcher.
+   * \brief Create prefetcher.
+   * \param createInfo Creation information.
+   */
+  explicit Prefetcher(const CreateInfo& createInfo);
+
+  /** Destruct the prefetcher. This stops it if it's still running.
+   * \brief Destruct prefetcher.
+   */
+  ~Prefetcher();
+
+  /** Load a trace and start prefetching its ranges on a background thread.
+   * \brief Start prefetching.
+   * \param trace Path of the trace file.
+   * \return Result.
+   * - FileResult::kAlreadyOpen: The prefetcher has already been started.
+   */
+  FileResult Start(const Path& trace);
+
+  /** Stop prefetching and wait for the thread to exit. Ranges that has not been
+   * prefetched yet are skipped.
+   * \brief Stop prefetching.
+   */
+  void Stop();
+
+  /** Wait for all ranges to be prefetched.
+   * \brief Wait for prefetching.
+   */
+  void Wait();
+
+  /** Returns the number of bytes that has been prefetched so far.
+   * \brief Returns prefetched bytes.
+   * \return Number of bytes.
+   */
+  OL_NODISCARD u64 GetPrefetchedBytes() const
+  {
+    return mPrefetchedBytes.load(std::memory_order_relaxed);
+  }
+
+private:
+  /** Prefetch a single range **/
+  static u64 Prefetch(const AccessTrace::Range& range);
+};
+
+}
@@ -0,0 +1,779 @@
+// MIT License
+//
+// Copyright (c) 2019 Filip Björklund
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "olivine/core/file/async_io.hpp"
+
+// ========================================================================== //
+// Headers
+// ========================================================================== //
+
+// Standard headers
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <thread>
+
+// Project headers
+#include "olivine/core/assert.hpp"
+#include "olivine/core/file/access_trace.hpp"
+#include "olivine/core/file/file_io.hpp"
+#include "olivine/core/file/vfs.hpp"
+#include "olivine/core/memory.hpp"
+
+// Platform headers
+#if defined(OL_PLATFORM_LINUX)
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#endif
+
+// ========================================================================== //
+// AsyncIO Types
+// ========================================================================== //
+
+namespace olivine {
+
+/** Maximum number of bytes that are read by a single read operation **/
+static constexpr u64 kMaxChunkSize = 1ull << 30u;
+
+// -------------------------------------------------------------------------- //
+
+struct AsyncIO::Operation
+{
+  /** Request **/
+  Request request;
+  /** File **/
+  FileIO io;
+  /** Buffer that is read into **/
+  u8* data = nullptr;
+  /** Number of bytes to read **/
+  u64 size = 0;
+  /** Number of bytes that has been read **/
+  u64 done = 0;
+  /** Number of bytes that was acquired from the budget **/
+  u64 acquired = 0;
+  /** Whether the buffer was allocated by the engine **/
+  bool owned = false;
+  /** File in a mounted pack, if the file is in one **/
+  VFS::File packed;
+#if defined(OL_PLATFORM_LINUX)
+  /** Vector that describes the remaining part of the buffer **/
+  iovec vector{};
+#endif
+
+  explicit Operation(Request&& _request)
+    : request(std::move(_request))
+    , io(request.path)
+  {}
+};
+
+// -------------------------------------------------------------------------- //
+
+#if defined(OL_PLATFORM_LINUX)
+
+struct AsyncIO::Ring
+{
+  /** Ring file descriptor **/
+  int fd = -1;
+  /** Number of submission queue entries **/
+  u32 entries = 0;
+
+  /** Submission queue ring mapping **/
+  void* sqRing = nullptr;
+  /** Size of the submission queue ring mapping **/
+  size_t sqRingSize = 0;
+  /** Completion queue ring mapping. This may be the same as 'sqRing' **/
+  void* cqRing = nullptr;
+  /** Size of the completion queue ring mapping **/
+  size_t cqRingSize = 0;
+  /** Submission queue entries **/
+  io_uring_sqe* sqes = nullptr;
+  /** Size of the submission queue entries mapping **/
+  size_t sqesSize = 0;
+
+  /** Submission queue head **/
+  u32* sqHead = nullptr;
+  /** Submission queue tail **/
+  u32* sqTail = nullptr;
+  /** Submission queue index mask **/
+  u32 sqMask = 0;
+  /** Submission queue index array **/
+  u32* sqArray = nullptr;
+
+  /** Completion queue head **/
+  u32* cqHead = nullptr;
+  /** Completion queue tail **/
+  u32* cqTail = nullptr;
+  /** Completion queue index mask **/
+  u32 cqMask = 0;
+  /** Completion queue entries **/
+  io_uring_cqe* cqes = nullptr;
+
+  /** Queue a read of the remaining part of an operation in the submission
+   * queue. The caller must make sure that there is room in the queue **/
+  void PushRead(Operation& operation)
+  {
+    // Describe the remaining part of the buffer
+    const u64 remaining = operation.size - operation.done;
+    operation.vector.iov_base = operation.data + operation.done;
+    operation.vector.iov_len = size_t(std::min(remaining, kMaxChunkSize));
+
+    // Fill entry
+    const u32 tail = *sqTail;
+    const u32 index = tail & sqMask;
+    io_uring_sqe& sqe = sqes[index];
+    std::memset(&sqe, 0, sizeof(io_uring_sqe));
+    sqe.opcode = IORING_OP_READV;
+    sqe.fd = operation.io.GetHandle();
+    sqe.addr = reinterpret_cast<u64>(&operation.vector);
+    sqe.len = 1;
+    sqe.off = operation.request.offset + operation.done;
+    sqe.user_data = reinterpret_cast<u64>(&operation);
+
+    // Publish entry to the kernel
+    sqArray[index] = index;
+    __atomic_store_n(sqTail, tail + 1, __ATOMIC_RELEASE);
+  }
+
+  /** Take back the reads that are queued in the submission queue but has not
+   * been consumed by the kernel, and append their operations to a list **/
+  void Retract(std::vector<Operation*>& operations)
+  {
+    const u32 head = __atomic_load_n(sqHead, __ATOMIC_ACQUIRE);
+    const u32 tail = *sqTail;
+    for (u32 i = head; i != tail; i++) {
+      const io_uring_sqe& sqe = sqes[sqArray[i & sqMask]];
+      operations.push_back(reinterpret_cast<Operation*>(sqe.user_data));
+    }
+    __atomic_store_n(sqTail, head, __ATOMIC_RELEASE);
+  }
+};
+
+#else
+
+struct AsyncIO::Ring
+{};
+
+#endif
+
+}
+
+// ========================================================================== //
+// AsyncIO Implementation
+// ========================================================================== //
+
+namespace olivine {
+
+AsyncIO::AsyncIO()
+  : AsyncIO(CreateInfo{})
+{}
+
+// -------------------------------------------------------------------------- //
+
+AsyncIO::AsyncIO(const CreateInfo& createInfo)
+  : mInfo(createInfo)
+{
+  if (mInfo.allowIOUring && CreateRing()) {
+    mBackend = Backend::kIOUring;
+    mServiceThread = std::thread([this] { Service(); });
+  } else {
+    mBackend = Backend::kThreadPool;
+    mPool = new ThreadPool(mInfo.threadCount);
+  }
+}
+
+// -------------------------------------------------------------------------- //
+
+AsyncIO::~AsyncIO()
+{
+  Wait();
+
+  // Stop service thread
+  if (mRing) {
+    {
+      std::lock_guard<std::mutex> lock(mMutex);
+      mStop = true;
+    }
+    mQueueCondition.notify_all();
+    mServiceThread.join();
+    DestroyRing();
+  }
+
+  delete mPool;
+}
+
+// -------------------------------------------------------------------------- //
+
+void
+AsyncIO::Submit(Request request)
+{
+  std::vector<Request> requests;
+  requests.push_back(std::move(request));
+  Submit(std::move(requests));
+}
+
+// -------------------------------------------------------------------------- //
+
+void
+AsyncIO::Submit(std::vector<Request>&& requests)
+{
+  if (requests.empty()) {
+    return;
+  }
+
+  // Queue requests for the service thread
+  if (mBackend == Backend::kIOUring) {
+    {
+      std::lock_guard<std::mutex> lock(mMutex);
+      for (Request& request : requests) {
+        mQueues[u32(request.priority)].push_back(std::move(request));
+      }
+      mPendingCount += requests.size();
+    }
+    requests.clear();
+    mQueueCondition.notify_one();
+    return;
+  }
+
+  // Submit one task per request to the pool, batched by priority
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mPendingCount += requests.size();
+  }
+  std::vector<ThreadPool::Task> tasks[ThreadPool::kPriorityCount];
+  for (Request& request : requests) {
+    tasks[u32(request.priority)].push_back(
+      [this, request = std::move(request)]() mutable { Execute(request); });
+  }
+  requests.clear();
+  for (u32 i = ThreadPool::kPriorityCount; i-- > 0;) {
+    mPool->Submit(std::move(tasks[i]), Priority(i));
+  }
+}
+
+// -------------------------------------------------------------------------- //
+
+std::future<AsyncIO::Completion>
+AsyncIO::Read(Path path, Priority priority)
+{
+  auto promise = std::make_shared<std::promise<Completion>>();
+  std::future<Completion> future = promise->get_future();
+
+  Request request;
+  request.path = std::move(path);
+  request.priority = priority;
+  request.callback = [promise](Completion& completion) {
+    promise->set_value(std::move(completion));
+  };
+  Submit(std::move(request));
+  return future;
+}
+
+// -------------------------------------------------------------------------- //
+
+void
+AsyncIO::Wait()
+{
+  std::unique_lock<std::mutex> lock(mMutex);
+  mIdleCondition.wait(lock, [this] { return mPendingCount == 0; });
+}
+
+// -------------------------------------------------------------------------- //
+
+FileResult
+AsyncIO::Prepare(Operation& operation)
+{
+  // Files in mounted packs are copied instead of read
+  const Request& request = operation.request;
+  VFS::File& packed = operation.packed;
+  if (VFS::Find(request.path.GetView(), packed)) {
+    const u64 offset = std::min(request.offset, packed.size);
+    operation.size =
+      request.size == kWholeFile ? packed.size - offset : request.size;
+    return FileResult::kSuccess;
+  }
+
+  // Open file
+  FileResult result =
+    operation.io.Open(FileIO::Flag::kRead | FileIO::Flag::kShareRead);
+  if (result != FileResult::kSuccess) {
+    return result;
+  }
+
+  // Use requested size if one was specified, otherwise read the rest of the
+  // file. The read is recorded here as the io_uring backend bypasses 'FileIO'
+  if (request.size != kWholeFile) {
+    operation.size = request.size;
+  } else {
+    u64 fileSize;
+    result = operation.io.GetSize(fileSize);
+    if (result != FileResult::kSuccess) {
+      return result;
+    }
+    operation.size = fileSize > request.offset ? fileSize - request.offset : 0;
+  }
+  AccessTrace::Record(request.path, request.offset, operation.size);
+  return FileResult::kSuccess;
+}
+
+// -------------------------------------------------------------------------- //
+
+FileResult
+AsyncIO::Allocate(Operation& operation)
+{
+  if (operation.request.buffer) {
+    operation.data = operation.request.buffer;
+    operation.owned = false;
+    return FileResult::kSuccess;
+  }
+
+  operation.data = static_cast<u8*>(Memory::Allocate(operation.size));
+  if (!operation.data) {
+    return FileResult::kOutOfMemory;
+  }
+  operation.owned = true;
+  return FileResult::kSuccess;
+}
+
+// -------------------------------------------------------------------------- //
+
+FileResult
+AsyncIO::ReadFromPack(Operation& operation)
+{
+  FileResult result = Allocate(operation);
+  if (result != FileResult::kSuccess) {
+    return result;
+  }
+  const VFS::File& packed = operation.packed;
+  const u64 offset = std::min(operation.request.offset, packed.size);
+  const u64 size = std::min(operation.size, packed.size - offset);
+  result = VFS::Read(packed, offset, size, operation.data);
+  if (result != FileResult::kSuccess) {
+    return result;
+  }
+  operation.done = size;
+  return operation.done == operation.size ? FileResult::kSuccess
+                                          : FileResult::kEOF;
+}
+
+// -------------------------------------------------------------------------- //
+
+FileResult
+AsyncIO::ReadRemaining(Operation& operation)
+{
+  u64 read;
+  const FileResult result =
+    operation.io.ReadAt(operation.request.offset + operation.done,
+                        operation.data + operation.done,
+                        operation.size - operation.done,
+                        read);
+  operation.done += read;
+  if (result == FileResult::kSuccess && operation.done != operation.size) {
+    return FileResult::kEOF;
+  }
+  return result;
+}
+
+// -------------------------------------------------------------------------- //
+
+void
+AsyncIO::Complete(Operation& operation, FileResult result)
+{
+  operation.io.Close();
+
+  // Don't hand out allocated buffers without any data
+  const bool failed =
+    result != FileResult::kSuccess && result != FileResult::kEOF;
+  if (operation.owned && (failed || operation.done == 0)) {
+    Memory::Free(operation.data);
+    operation.data = nullptr;
+  }
+
+  // Call callback. Ownership of the data passes to the receiver
+  Completion completion;
+  completion.result = result;
+  completion.path = std::move(operation.request.path);
+  completion.data = operation.data;
+  completion.size = operation.done;
+  if (operation.request.callback) {
+    operation.request.callback(completion);
+  } else if (operation.owned) {
+    Memory::Free(operation.data);
+  }
+
+  // Release budget and signal waiters
+  bool idle;
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mInFlightBytes -= operation.acquired;
+    idle = --mPendingCount == 0;
+  }
+  if (operation.acquired > 0) {
+    mBudgetCondition.notify_all();
+  }
+  if (idle) {
+    mIdleCondition.notify_all();
+  }
+}
+
+// -------------------------------------------------------------------------- //
+
+void
+AsyncIO::Execute(Request& request)
+{
+  Operation operation(std::move(request));
+  FileResult result = Prepare(operation);
+  if (result == FileResult::kSuccess && operation.size > 0) {
+    AcquireBytes(operation);
+    if (operation.packed.pack) {
+      result = ReadFromPack(operation);
+    } else if ((result = Allocate(operation)) == FileResult::kSuccess) {
+      result = ReadRemaining(operation);
+    }
+  }
+  Complete(operation, result);
+}
+
+// -------------------------------------------------------------------------- //
+
+void
+AsyncIO::AcquireBytes(Operation& operation)
+{
+  std::unique_lock<std::mutex> lock(mMutex);
+  mBudgetCondition.wait(lock, [&] {
+    return mInFlightBytes == 0 ||
+           mInFlightBytes + operation.size <= mInfo.maxInFlightBytes;
+  });
+  mInFlightBytes += operation.size;
+  operation.acquired = operation.size;
+}
+
+// -------------------------------------------------------------------------- //
+
+bool
+AsyncIO::TryAcquireBytes(Operation& operation)
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  if (mInFlightBytes != 0 &&
+      mInFlightBytes + operation.size > mInfo.maxInFlightBytes) {
+    return false;
+  }
+  mInFlightBytes += operation.size;
+  operation.acquired = operation.size;
+  return true;
+}
+
+// -------------------------------------------------------------------------- //
+
+bool
+AsyncIO::PopRequest(Request& request, bool wait)
+{
+  std::unique_lock<std::mutex> lock(mMutex);
+  while (true) {
+    for (u32 i = ThreadPool::kPriorityCount; i-- > 0;) {
+      if (!mQueues[i].empty()) {
+        request = std::move(mQueues[i].front());
+        mQueues[i].pop_front();
+        return true;
+      }
+    }
+    if (!wait || mStop) {
+      return false;
+    }
+    mQueueCondition.wait(lock);
+  }
+}
+
+}
+
+// ========================================================================== //
+// AsyncIO Implementation (io_uring)
+// ========================================================================== //
+
+#if defined(OL_PLATFORM_LINUX)
+
+namespace olivine {
+
+bool
+AsyncIO::CreateRing()
+{
+  // Setup ring
+  io_uring_params params{};
+  const int fd =
+    int(syscall(__NR_io_uring_setup, std::max(mInfo.queueDepth, 1u), &params));
+  if (fd < 0) {
+    return false;
+  }
+  Ring* ring = new Ring;
+  ring->fd = fd;
+  ring->entries = params.sq_entries;
+
+  // Map rings. Newer kernels map both rings with a single mapping
+  ring->sqRingSize = params.sq_off.array + params.sq_entries * sizeof(u32);
+  ring->cqRingSize =
+    params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+  const bool singleMap = bool(params.features & IORING_FEAT_SINGLE_MMAP);
+  if (singleMap) {
+    ring->sqRingSize = ring->cqRingSize =
+      std::max(ring->sqRingSize, ring->cqRingSize);
+  }
+  ring->sqRing = mmap(nullptr,
+                      ring->sqRingSize,
+                      PROT_READ | PROT_WRITE,
+                      MAP_SHARED | MAP_POPULATE,
+                      fd,
+                      IORING_OFF_SQ_RING);
+  ring->cqRing = singleMap ? ring->sqRing
+                           : mmap(nullptr,
+                                  ring->cqRingSize,
+                                  PROT_READ | PROT_WRITE,
+                                  MAP_SHARED | MAP_POPULATE,
+                                  fd,
+                                  IORING_OFF_CQ_RING);
+  ring->sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+  void* sqes = mmap(nullptr,
+                    ring->sqesSize,
+                    PROT_READ | PROT_WRITE,
+                    MAP_SHARED | MAP_POPULATE,
+                    fd,
+                    IORING_OFF_SQES);
+  ring->sqes = sqes == MAP_FAILED ? nullptr : static_cast<io_uring_sqe*>(sqes);
+  mRing = ring;
+  if (ring->sqRing == MAP_FAILED || ring->cqRing == MAP_FAILED ||
+      !ring->sqes) {
+    DestroyRing();
+    return false;
+  }
+
+  // Locate queue fields
+  u8* sq = static_cast<u8*>(ring->sqRing);
+  ring->sqHead = reinterpret_cast<u32*>(sq + params.sq_off.head);
+  ring->sqTail = reinterpret_cast<u32*>(sq + params.sq_off.tail);
+  ring->sqMask = *reinterpret_cast<u32*>(sq + params.sq_off.ring_mask);
+  ring->sqArray = reinterpret_cast<u32*>(sq + params.sq_off.array);
+  u8* cq = static_cast<u8*>(ring->cqRing);
+  ring->cqHead = reinterpret_cast<u32*>(cq + params.cq_off.head);
+  ring->cqTail = reinterpret_cast<u32*>(cq + params.cq_off.tail);
+  ring->cqMask = *reinterpret_cast<u32*>(cq + params.cq_off.ring_mask);
+  ring->cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+  return true;
+}
+
+// -------------------------------------------------------------------------- //
+
+void
+AsyncIO::DestroyRing()
+{
+  if (!mRing) {
+    return;
+  }
+  if (mRing->sqes) {
+    munmap(mRing->sqes, mRing->sqesSize);
+  }
+  if (mRing->cqRing != MAP_FAILED && mRing->cqRing != mRing->sqRing) {
+    munmap(mRing->cqRing, mRing->cqRingSize);
+  }
+  if (mRing->sqRing != MAP_FAILED) {
+    munmap(mRing->sqRing, mRing->sqRingSize);
+  }
+  close(mRing->fd);
+  delete mRing;
+  mRing = nullptr;
+}
+
+// -------------------------------------------------------------------------- //
+
+void
+AsyncIO::Service()
+{
+  Ring& ring = *mRing;
+  u32 inFlight = 0;
+  u32 toSubmit = 0;
+  Operation* stalled = nullptr;
+  // Whether submitting to the ring has failed. Reads are then performed on
+  // this thread, while the reads that are in flight are still reaped
+  bool failed = false;
+
+  while (true) {
+    // Start requests while there is room in the ring and in the budget. When
+    // nothing is in flight this blocks until a request is queued
+    while (inFlight + toSubmit < ring.entries) {
+      const bool idle = inFlight + toSubmit == 0;
+      Operation* operation = stalled;
+      stalled = nullptr;
+      if (!operation) {
+        Request request;
+        if (!PopRequest(request, idle)) {
+          break;
+        }
+        operation = new Operation(std::move(request));
+        FileResult result = Prepare(*operation);
+        if (result == FileResult::kSuccess && operation->packed.pack &&
+            operation->size > 0) {
+          result = ReadFromPack(*operation);
+        }
+        if (result != FileResult::kSuccess || operation->size == 0 ||
+            operation->packed.pack) {
+          Complete(*operation, result);
+          delete operation;
+          continue;
+        }
+      }
+      if (!TryAcquireBytes(*operation)) {
+        stalled = operation;
+        break;
+      }
+      FileResult result = Allocate(*operation);
+      if (result == FileResult::kSuccess && failed) {
+        result = ReadRemaining(*operation);
+      }
+      if (result != FileResult::kSuccess || failed) {
+        Complete(*operation, result);
+        delete operation;
+        continue;
+      }
+      ring.PushRead(*operation);
+      toSubmit++;
+    }
+
+    // Nothing in flight after filling means that the engine is stopping
+    if (inFlight + toSubmit == 0) {
+      return;
+    }
+
+    // Submit new reads and wait for at least one completion
+    const int submitted = int(syscall(__NR_io_uring_enter,
+                                      ring.fd,
+                                      toSubmit,
+                                      1,
+                                      IORING_ENTER_GETEVENTS,
+                                      nullptr,
+                                      0));
+    if (submitted < 0 && errno == EINTR) {
+      continue;
+    }
+
+    // The kernel takes no new reads until completions have been reaped, or it
+    // is short on resources. Reap below, and back off if there was nothing to
+    // reap, instead of spinning on the same submission
+    const bool busy = submitted < 0 && (errno == EAGAIN || errno == EBUSY);
+    if (submitted < 0 && !busy) {
+      // Stop using the ring for new reads and perform the reads that the
+      // kernel has not consumed here instead. The reads that are in flight
+      // are still reaped below. If waiting for them fails as well, back off
+      // before polling the completion queue again
+      if (failed) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      } else {
+        failed = true;
+        std::vector<Operation*> retracted;
+        ring.Retract(retracted);
+        toSubmit = 0;
+        for (Operation* operation : retracted) {
+          Complete(*operation, ReadRemaining(*operation));
+          delete operation;
+        }
+      }
+    } else if (!busy) {
+      toSubmit -= u32(submitted);
+      inFlight += u32(submitted);
+    }
+
+    // Reap completions. Short reads are resubmitted for the remaining part, or
+    // read here if the ring has failed
+    const auto resubmit = [&](Operation* operation) {
+      if (failed) {
+        Complete(*operation, ReadRemaining(*operation));
+        delete operation;
+        return;
+      }
+      ring.PushRead(*operation);
+      toSubmit++;
+    };
+    u32 head = *ring.cqHead;
+    const u32 tail = __atomic_load_n(ring.cqTail, __ATOMIC_ACQUIRE);
+    if (busy && head == tail) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    while (head != tail) {
+      const io_uring_cqe& cqe = ring.cqes[head & ring.cqMask];
+      Operation* operation = reinterpret_cast<Operation*>(cqe.user_data);
+      const s32 res = cqe.res;
+      head++;
+      inFlight--;
+
+      if (res == -EINTR || res == -EAGAIN) {
+        resubmit(operation);
+        continue;
+      }
+      if (res < 0) {
+        errno = -res;
+        Complete(*operation, FileResultFromLastError());
+        delete operation;
+        continue;
+      }
+
+      operation->done += u64(res);
+      if (res > 0 && operation->done < operation->size) {
+        resubmit(operation);
+        continue;
+      }
+      Complete(*operation,
+               operation->done == operation->size ? FileResult::kSuccess
+                                                  : FileResult::kEOF);
+      delete operation;
+    }
+    __atomic_store_n(ring.cqHead, head, __ATOMIC_RELEASE);
+  }
+}
+
+}
+
+#else
+
+// ========================================================================== //
+// AsyncIO Implementation (No io_uring)
+// ========================================================================== //
+
+namespace olivine {
+
+bool
+AsyncIO::CreateRing()
+{
+  return false;
+}
+
+// -------------------------------------------------------------------------- //
+
+void
+AsyncIO::DestroyRing()
+{}
+
+// -------------------------------------------------------------------------- //
+
+void
+AsyncIO::Service()
+{}
+
+}
+
+#endif
@@ -0,0 +1,289 @@
+// MIT License
+//
+// Copyright (c) 2019 Filip Björklund
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+// ========================================================================== //
+// Headers
+// ========================================================================== //
+
+// Standard headers
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Project headers
+#include "olivine/core/common.hpp"
+#include "olivine/core/macros.hpp"
+#include "olivine/core/file/path.hpp"
+#include "olivine/core/file/result.hpp"
+#include "olivine/core/thread_pool.hpp"
+
+// ========================================================================== //
+// AsyncIO Declaration
+// ========================================================================== //
+
+namespace olivine {
+
+/** \class AsyncIO
+ * \author Filip Björklund
+ * \date 18 october 2026 - 17:05
+ * \brief Asynchronous file reads.
+ * \details
+ * Engine for reading files asynchronously. Requests are submitted, either one
+ * at a time or in batches, and are completed out of order by calling the
+ * callback of each request, or by fulfilling a future.
+ *
+ * Requests with a higher priority are started before requests with a lower
+ * priority. The total size of the reads that are in flight is bounded by
+ * 'CreateInfo::maxInFlightBytes', a request that does not fit waits until other
+ * requests have completed. A single request that is larger than the bound is
+ * still started once nothing else is in flight.
+ *
+ * On Linux the reads are performed with io_uring when the kernel supports it,
+ * which lets a single thread keep many reads in flight. If submitting to the
+ * ring fails with an unexpected error, the reads that were not submitted and
+ * all later requests are performed with blocking calls on the service thread.
+ * Otherwise the reads are performed with blocking calls on a dedicated thread
+ * pool. Files that are in a pack that is mounted in the 'VFS' are read from
+ * the pack instead, and compressed files are decompressed straight into the
+ * request buffer.
+ *
+ * Callbacks are called on an IO thread. They should be short, and heavy work
+ * like decoding should be passed on to another thread pool.
+ *
+ * \code
+ * AsyncIO io;
+ * AsyncIO::Request request;
+ * request.path = "res/textures/albedo.png";
+ * request.callback = [](AsyncIO::Completion& completion) {
+ *   Decode(completion.data, completion.size);
+ *   Memory::Free(completion.data);
+ * };
+ * io.Submit(std::move(request));
+ * io.Wait();
+ * \endcode
+ */
+class AsyncIO
+{
+  OL_NO_COPY(AsyncIO);
+
+public:
+  /** Request priority **/
+  using Priority = ThreadPool::Priority;
+
+  /** Size that requests the entire file, starting at the offset **/
+  static constexpr u64 kWholeFile = ~0ull;
+
+  /** Backends that perform the reads **/
+  enum class Backend : u8
+  {
+    /** Blocking reads on a thread pool **/
+    kThreadPool,
+    /** Linux io_uring **/
+    kIOUring
+  };
+
+  /** Completion of a request **/
+  struct Completion
+  {
+    /** Result of the read. This is 'FileResult::kEOF' if the end of the file
+     * was reached before the requested size was read **/
+    FileResult result = FileResult::kSuccess;
+    /** Path of the file that was read **/
+    Path path;
+    /** Data that was read. If the request did not specify a buffer then the
+     * data has been allocated with 'Memory::Allocate' and the receiver must
+     * free it with 'Memory::Free'. This is nullptr if the read failed or was
+     * empty **/
+    u8* data = nullptr;
+    /** Number of bytes that was read **/
+    u64 size = 0;
+  };
+
+  /** Completion callback **/
+  using Callback = std::function<void(Completion& completion)>;
+
+  /** Read request **/
+  struct Request
+  {
+    /** Path of the file to read **/
+    Path path;
+    /** Offset in the file to start reading at **/
+    u64 offset = 0;
+    /** Number of bytes to read, or 'kWholeFile' for the rest of the file **/
+    u64 size = kWholeFile;
+    /** Buffer to read into. If this is nullptr then a buffer is allocated **/
+    u8* buffer = nullptr;
+    /** Priority of the request **/
+    Priority priority = Priority::kNormal;
+    /** Callback to call on completion **/
+    Callback callback;
+  };
+
+  /** Creation information **/
+  struct CreateInfo
+  {
+    /** Number of threads of the thread pool backend **/
+    u32 threadCount = 4;
+    /** Maximum number of requests in flight for the io_uring backend **/
+    u32 queueDepth = 64;
+    /** Maximum number of bytes in flight **/
+    u64 maxInFlightBytes = 256ull * 1024ull * 1024ull;
+    /** Whether the io_uring backend may be used **/
+    bool allowIOUring = true;
+  };
+
+private:
+  /** Request that is in flight **/
+  struct Operation;
+  /** io_uring instance **/
+  struct Ring;
+
+  /** Creation information **/
+  CreateInfo mInfo;
+  /** Backend **/
+  Backend mBackend = Backend::kThreadPool;
+
+  /** Mutex for the queues and counters **/
+  std::mutex mMutex;
+  /** Condition that is signaled when requests are queued **/
+  std::condition_variable mQueueCondition;
+  /** Condition that is signaled when bytes in flight are released **/
+  std::condition_variable mBudgetCondition;
+  /** Condition that is signaled when all requests have completed **/
+  std::condition_variable mIdleCondition;
+  /** Number of requests that are submitted but not completed **/
+  u64 mPendingCount = 0;
+  /** Number of bytes in flight **/
+  u64 mInFlightBytes = 0;
+  /** Whether the service thread should stop **/
+  bool mStop = false;
+
+  /** Thread pool (thread pool backend) **/
+  ThreadPool* mPool = nullptr;
+  /** Ring (io_uring backend) **/
+  Ring* mRing = nullptr;
+  /** Queued requests, one queue per priority (io_uring backend) **/
+  std::deque<Request> mQueues[ThreadPool::kPriorityCount];
+  /** Thread that submits and completes requests (io_uring backend) **/
+  std::thread mServiceThread;
+
+public:
+  /** Create an asynchronous IO engine with the default creation information.
+   * \brief Create engine.
+   */
+  AsyncIO();
+
+  /** Create an asynchronous IO engine.
+   * \brief Create engine.
+   * \param createInfo Creation information.
+   */
+  explicit AsyncIO(const CreateInfo& createInfo);
+
+  /** Destruct the engine. This waits for all submitted requests to complete.
+   * \brief Destruct engine.
+   */
+  ~AsyncIO();
+
+  /** Submit a read request.
+   * \brief Submit request.
+   * \param request Request to submit.
+   */
+  void Submit(Request request);
+
+  /** Submit a batch of read requests. The batch is queued at once, which lets
+   * the backend start as many of the requests as possible together.
+   * \brief Submit batch of requests.
+   * \param requests Requests to submit.
+   */
+  void Submit(std::vector<Request>&& requests);
+
+  /** Submit a request to read an entire file and return a future for the
+   * completion.
+   * \brief Read file.
+   * \param path Path of the file to read.
+   * \param priority Priority of the request.
+   * \return Future for the completion. The data must be freed with
+   * 'Memory::Free'.
+   */
+  std::future<Completion> Read(Path path,
+                               Priority priority = Priority::kNormal);
+
+  /** Wait for all submitted requests to complete.
+   * \note This must not be called from a completion callback.
+   * \brief Wait for requests.
+   */
+  void Wait();
+
+  /** Returns the backend that is used by the engine.
+   * \brief Returns backend.
+   * \return Backend.
+   */
+  OL_NODISCARD Backend GetBackend() const { return mBackend; }
+
+private:
+  /** Open the file of an operation and determine the size to read **/
+  static FileResult Prepare(Operation& operation);
+
+  /** Set the buffer of an operation, allocating it if needed **/
+  static FileResult Allocate(Operation& operation);
+
+  /** Read the data of an operation from the mounted pack that it's in **/
+  static FileResult ReadFromPack(Operation& operation);
+
+  /** Read the part of an operation that has not been read yet, on the calling
+   * thread **/
+  static FileResult ReadRemaining(Operation& operation);
+
+  /** Complete an operation by calling its callback **/
+  void Complete(Operation& operation, FileResult result);
+
+  /** Read the request on the calling thread (thread pool backend) **/
+  void Execute(Request& request);
+
+  /** Wait until the size of an operation fits in the budget of bytes in
+   * flight and add it. The bytes are released when the operation completes **/
+  void AcquireBytes(Operation& operation);
+
+  /** Add the size of an operation to the budget if it fits **/
+  bool TryAcquireBytes(Operation& operation);
+
+  /** Take the queued request with the highest priority. If 'wait' is true
+   * then this waits until one is queued, or the engine stops **/
+  bool PopRequest(Request& request, bool wait);
+
+  /** Create the io_uring instance **/
+  bool CreateRing();
+
+  /** Destroy the io_uring instance **/
+  void DestroyRing();
+
+  /** Run loop of the service thread (io_uring backend) **/
+  void Service();
+};
+
+}
@@ -0,0 +1,262 @@
+// MIT License
+//
+// Copyright (c) 2019 Filip Björklund
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "olivine/core/file/buffered_io.hpp"
+
+// ========================================================================== //
+// Headers
+// ========================================================================== //
+
+// Standard headers
+#include <algorithm>
+#include <cstring>
+
+// Project headers
+#include "olivine/core/assert.hpp"
+#include "olivine/core/memory.hpp"
+
+// ========================================================================== //
+// BufferedReader Implementation
+// ========================================================================== //
+
+namespace olivine {
+
+BufferedReader::BufferedReader(FileIO& io, u64 bufferSize)
+  : mIO(io)
+  , mCapacity(std::max<u64>(bufferSize, 1))
+{
+  mBuffer = static_cast<u8*>(Memory::Allocate(mCapacity));
+}
+
+// -------------------------------------------------------------------------- //
+
+BufferedReader::~BufferedReader()
+{
+  Memory::Free(mBuffer);
+}
+
+// -------------------------------------------------------------------------- //
+
+FileResult
+BufferedReader::Peek(u64 size, const u8*& data, u64& available)
+{
+  const FileResult result = Fill(size);
+  data = mBuffer + mBegin;
+  available = mEnd - mBegin;
+  return result;
+}
+
+// -------------------------------------------------------------------------- //
+
+void
+BufferedReader::Consume(u64 size)
+{
+  Assert(size <= mEnd - mBegin, "Cannot consume more data than is buffered");
+  mBegin += size;
+}
+
+// -------------------------------------------------------------------------- //
+
+FileResult
+BufferedReader::Read(u8* buffer, u64 toRead, u64& read)
+{
+  // Take buffered data first
+  read = std::min(toRead, mEnd - mBegin);
+  Memory::Copy(buffer, mBuffer + mBegin, read);
+  mBegin += read;
+  if (read == toRead || mEOF) {
+    return FileResult::kSuccess;
+  }
+
+  // Read large amounts directly, and small amounts through the buffer
+  if (toRead - read >= mCapacity) {
+    u64 count;
+    const FileResult result = mIO.Read(buffer + read, toRead - read, count);
+    read += count;
+    mEOF = read < toRead;
+    return result;
+  }
+  const FileResult result = Fill(toRead - read);
+  const u64 count = std::min(toRead - read, mEnd - mBegin);
+  Memory::Copy(buffer + read, mBuffer + mBegin, count);
+  mBegin += count;
+  read += count;
+  return result;
+}
+
+// -------------------------------------------------------------------------- //
+
+FileResult
+BufferedReader::ReadLine(StringView& line)
+{
+  u64 scanned = 0;
+  while (true) {
+    // Buffer more data than has been searched
+    const u8* data;
+    u64 available;
+    const FileResult result = Peek(scanned + 1, data, available);
+    if (result != FileResult::kSuccess) {
+      return result;
+    }
+
+    // Find line ending in the new data. The last line might not have one
+    const void* newline =
+      memchr(data + scanned, '\n', std::size_t(available - scanned));
+    u64 size = available;
+    if (newline) {
+      size = u64(static_cast<const u8*>(newline) - data);
+    } else if (available > scanned) {
+      scanned = available;
+      continue;
+    } else if (available == 0) {
+      return FileResult::kEOF;
+    }
+    Consume(newline ? size + 1 : size);
+
+    // Strip carriage return
+    if (size > 0 && data[size - 1] == '\r') {
+      size--;
+    }
+    line = StringView(reinterpret_cast<const char8*>(data), size);
+    return FileResult::kSuccess;
+  }
+}
+
+// -------------------------------------------------------------------------- //
+
+FileResult
+BufferedReader::Fill(u64 size)
+{
+  const u64 buffered = mEnd - mBegin;
+  if (buffered >= size || mEOF) {
+    return FileResult::kSuccess;
+  }
+
+  // Move the data that has not been consumed to the start of the buffer, and
+  // grow the buffer if it's too small
+  if (size > mCapacity) {
+    const u64 capacity = std::max(size, mCapacity * 2);
+    u8* buffer = static_cast<u8*>(Memory::Allocate(capacity));
+    Memory::Copy(buffer, mBuffer + mBegin, buffered);
+    Memory::Free(mBuffer);
+    mBuffer = buffer;
+    mCapacity = capacity;
+  } else if (mBegin > 0) {
+    memmove(mBuffer, mBuffer + mBegin, std::size_t(buffered));
+  }
+  mBegin = 0;
+  mEnd = buffered;
+
+  // Fill the rest of the buffer. A short read means that the end of the file
+  // was reached
+  u64 read;
+  const FileResult result = mIO.Read(mBuffer + mEnd, mCapacity - mEnd, read);
+  if (result != FileResult::kSuccess) {
+    return result;
+  }
+  mEnd += read;
+  mEOF = mEnd < mCapacity;
+  return FileResult::kSuccess;
+}
+
+}
+
+// ========================================================================== //
+// BufferedWriter Implementation
+// ========================================================================== //
+
+namespace olivine {
+
+BufferedWriter::BufferedWriter(FileIO& io, u64 bufferSize)
+  : mIO(io)
+  , mCapacity(std::max<u64>(bufferSize, 1))
+{
+  mBuffer = static_cast<u8*>(Memory::Allocate(mCapacity));
+}
+
+// -------------------------------------------------------------------------- //
+
+BufferedWriter::~BufferedWriter()
+{
+  Flush();
+  Memory::Free(mBuffer);
+}
+
+// -------------------------------------------------------------------------- //
+
+FileResult
+BufferedWriter::Write(const u8* data, u64 size)
+{
+  if (mResult != FileResult::kSuccess) {
+    return mResult;
+  }
+
+  // Flush buffer if the data does not fit
+  if (size > mCapacity - mSize && Flush() != FileResult::kSuccess) {
+    return mResult;
+  }
+
+  // Write large amounts directly
+  if (size >= mCapacity) {
+    mResult = mIO.Write(data, size);
+    return mResult;
+  }
+  Memory::Copy(mBuffer + mSize, data, size);
+  mSize += size;
+  return FileResult::kSuccess;
+}
+
+// -------------------------------------------------------------------------- //
+
+FileResult
+BufferedWriter::Write(StringView string)
+{
+  return Write(reinterpret_cast<const u8*>(string.GetData()),
+               string.GetSize());
+}
+
+// -------------------------------------------------------------------------- //
+
+FileResult
+BufferedWriter::Flush()
+{
+  if (mResult == FileResult::kSuccess && mSize > 0) {
+    mResult = mIO.Write(mBuffer, mSize);
+  }
+  mSize = 0;
+  return mResult;
+}
+
+// -------------------------------------------------------------------------- //
+
+FileResult
+BufferedWriter::Close()
+{
+  Flush();
+  const FileResult result = mIO.Close();
+  if (mResult == FileResult::kSuccess) {
+    mResult = result;
+  }
+  return mResult;
+}
+
+}
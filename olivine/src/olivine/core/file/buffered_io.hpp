@@ -0,0 +1,233 @@
+// MIT License
+//
+// Copyright (c) 2019 Filip Björklund
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+// ========================================================================== //
+// Headers
+// ========================================================================== //
+
+// Project headers
+#include "olivine/core/common.hpp"
+#include "olivine/core/macros.hpp"
+#include "olivine/core/string_view.hpp"
+#include "olivine/core/file/file_io.hpp"
+#include "olivine/core/file/result.hpp"
+
+// ========================================================================== //
+// BufferedReader Declaration
+// ========================================================================== //
+
+namespace olivine {
+
+/** \class BufferedReader
+ * \author Filip Björklund
+ * \date 18 october 2026 - 19:40
+ * \brief Buffered reader on top of a file.
+ * \details
+ * Reads a file in large chunks through a buffer, so that parsers that consume
+ * the file a few bytes at a time don't make a system call for each read.
+ *
+ * Parsers can access the buffer directly with 'BufferedReader::Peek' and then
+ * advance past the data that they used with 'BufferedReader::Consume'. The
+ * reader does not own the file, which must stay open while it's used.
+ */
+class BufferedReader
+{
+  OL_NO_COPY(BufferedReader);
+
+public:
+  /** Default size of the buffer **/
+  static constexpr u64 kDefaultBufferSize = 64 * 1024;
+
+private:
+  /** File to read from **/
+  FileIO& mIO;
+  /** Buffer **/
+  u8* mBuffer = nullptr;
+  /** Size of the buffer **/
+  u64 mCapacity;
+  /** Offset of the first byte that has not been consumed **/
+  u64 mBegin = 0;
+  /** Offset of the end of the data that has been read into the buffer **/
+  u64 mEnd = 0;
+  /** Whether the end of the file has been reached **/
+  bool mEOF = false;
+
+public:
+  /** Create a reader for a file that is open for reading. Reading starts at
+   * the current cursor position of the file.
+   * \brief Create reader.
+   * \param io File to read from.
+   * \param bufferSize Size of the buffer.
+   */
+  explicit BufferedReader(FileIO& io, u64 bufferSize = kDefaultBufferSize);
+
+  /** Destruct reader.
+   * \brief Destruct reader.
+   */
+  ~BufferedReader();
+
+  /** Returns a view of the buffered data, after making sure that it's at least
+   * 'size' bytes unless the end of the file is reached first. The buffer grows
+   * if it's smaller than 'size'. The data stays valid until the next call to
+   * a function of the reader other than 'BufferedReader::Consume'.
+   * \brief Peek at data.
+   * \param size Number of bytes that is wanted.
+   * \param data Buffered data.
+   * \param available Number of bytes of buffered data. This is less than
+   * 'size' only if the end of the file has been reached.
+   * \return Result.
+   */
+  FileResult Peek(u64 size, const u8*& data, u64& available);
+
+  /** Advance past data that was returned from 'BufferedReader::Peek'.
+   * \pre The size must not be larger than the data that is buffered.
+   * \brief Consume data.
+   * \param size Number of bytes to consume.
+   */
+  void Consume(u64 size);
+
+  /** Read data into a buffer. Large reads bypass the buffer of the reader.
+   * \brief Read data.
+   * \param buffer Buffer to read into.
+   * \param toRead Number of bytes to read.
+   * \param read Number of bytes that was read. This is less than 'toRead' only
+   * if the end of the file was reached.
+   * \return Result.
+   */
+  FileResult Read(u8* buffer, u64 toRead, u64& read);
+
+  /** Read the next line. The line does not include the line ending, which can
+   * be either "\n" or "\r\n". The line stays valid until the next call to a
+   * function of the reader other than 'BufferedReader::Consume'.
+   * \brief Read line.
+   * \param line Line that was read.
+   * \return Result.
+   * - FileResult::kEOF: There are no more lines.
+   */
+  FileResult ReadLine(StringView& line);
+
+  /** Returns whether all data of the file has been consumed.
+   * \brief Returns whether at end of file.
+   * \return True if at the end of the file otherwise false.
+   */
+  OL_NODISCARD bool IsEOF() const { return mEOF && mBegin == mEnd; }
+
+private:
+  /** Read more data into the buffer, until there are at least 'size' bytes
+   * buffered or the end of the file is reached **/
+  FileResult Fill(u64 size);
+};
+
+}
+
+// ========================================================================== //
+// BufferedWriter Declaration
+// ========================================================================== //
+
+namespace olivine {
+
+/** \class BufferedWriter
+ * \author Filip Björklund
+ * \date 18 october 2026 - 19:40
+ * \brief Buffered writer on top of a file.
+ * \details
+ * Collects small writes in a buffer and writes them to the file in large
+ * chunks. Writes that are larger than the buffer are written directly.
+ *
+ * The first error that occurs is kept and returned by all later calls, so
+ * that callers that write many small pieces can check the result once at the
+ * end. Buffered data is written when the writer is flushed, closed or
+ * destructed. The writer does not own the file, which must stay open while
+ * it's used.
+ */
+class BufferedWriter
+{
+  OL_NO_COPY(BufferedWriter);
+
+public:
+  /** Default size of the buffer **/
+  static constexpr u64 kDefaultBufferSize = 64 * 1024;
+
+private:
+  /** File to write to **/
+  FileIO& mIO;
+  /** Buffer **/
+  u8* mBuffer = nullptr;
+  /** Size of the buffer **/
+  u64 mCapacity;
+  /** Number of bytes in the buffer **/
+  u64 mSize = 0;
+  /** First error that occurred **/
+  FileResult mResult = FileResult::kSuccess;
+
+public:
+  /** Create a writer for a file that is open for writing. Writing starts at
+   * the current cursor position of the file.
+   * \brief Create writer.
+   * \param io File to write to.
+   * \param bufferSize Size of the buffer.
+   */
+  explicit BufferedWriter(FileIO& io, u64 bufferSize = kDefaultBufferSize);
+
+  /** Destruct writer. Buffered data is written to the file, call
+   * 'BufferedWriter::Flush' first to be able to check the result.
+   * \brief Destruct writer.
+   */
+  ~BufferedWriter();
+
+  /** Write data.
+   * \brief Write data.
+   * \param data Data to write.
+   * \param size Size of the data in bytes.
+   * \return Result.
+   */
+  FileResult Write(const u8* data, u64 size);
+
+  /** Write a string.
+   * \brief Write string.
+   * \param string String to write.
+   * \return Result.
+   */
+  FileResult Write(StringView string);
+
+  /** Write the buffered data to the file.
+   * \brief Flush writer.
+   * \return Result.
+   */
+  FileResult Flush();
+
+  /** Write the buffered data to the file and then close the file.
+   * \brief Close writer and file.
+   * \return Result, which is the first error that occurred if any.
+   */
+  FileResult Close();
+
+  /** Returns the first error that occurred, or FileResult::kSuccess.
+   * \brief Returns result.
+   * \return Result.
+   */
+  OL_NODISCARD FileResult GetResult() const { return mResult; }
+};
+
+}
@@ -26,8 +26,12 @@
 // Headers
 // ========================================================================== //
 
+// Standard headers
+#include <algorithm>
+
 // Project headers
-#include "olivine/core/file/file_system.hpp"
+#include "olivine/core/file/access_trace.hpp"
+#include "olivine/core/file/metadata_cache.hpp"
 
 // ========================================================================== //
 // Functions
@@ -35,23 +39,9 @@
 
 namespace olivine {
 
-FileResult
-FileIOErrorFromErrorWin32(DWORD error)
-{
-  switch (error) {
-    case ERROR_SUCCESS:
-      return FileResult::kSuccess;
-    case ERROR_FILE_EXISTS:
-      return FileResult::kAlreadyExists;
-    case ERROR_NOT_FOUND:
-    case ERROR_PATH_NOT_FOUND:
-      return FileResult::kNotFound;
-    case ERROR_ACCESS_DENIED:
-      return FileResult::kAccessDenied;
-    default:
-      return FileResult::kUnknownError;
-  }
-}
+/** Maximum number of bytes that are read or written by a single call to the
+ * platform. Larger requests are split into multiple calls **/
+static constexpr u64 kMaxChunkSize = 1ull << 30u;
 
 }
 
@@ -76,6 +66,107 @@ FileIO::~FileIO()
 
 // -------------------------------------------------------------------------- //
 
+FileResult
+FileIO::Read(u8* buffer, u64 toRead)
+{
+  u64 read;
+  return Read(buffer, toRead, read);
+}
+
+// -------------------------------------------------------------------------- //
+
+FileResult
+FileIO::Read(String& string)
+{
+  // Determine size from the open handle
+  u64 size;
+  FileResult result = GetSize(size);
+  if (result != FileResult::kSuccess) {
+    return result;
+  }
+
+  // Allocate buffer
+  char8* buffer = static_cast<char8*>(
+    Memory::Allocate(sizeof(char8) * (size + 1), Memory::MIN_ALIGN));
+  if (!buffer) {
+    return FileResult::kOutOfMemory;
+  }
+
+  // Read file
+  u64 read;
+  result = Read(reinterpret_cast<u8*>(buffer), size, read);
+  if (result != FileResult::kSuccess) {
+    Memory::Free(buffer);
+    return result;
+  }
+  buffer[read] = 0;
+
+  // Create string and return
+  string = String(buffer);
+  Memory::Free(buffer);
+  return FileResult::kSuccess;
+}
+
+// -------------------------------------------------------------------------- //
+
+FileResult
+FileIO::ReadAt(u64 offset, u8* buffer, u64 toRead) const
+{
+  u64 read;
+  const FileResult result = ReadAt(offset, buffer, toRead, read);
+  if (result == FileResult::kSuccess && read != toRead) {
+    return FileResult::kEOF;
+  }
+  return result;
+}
+
+// -------------------------------------------------------------------------- //
+
+FileResult
+FileIO::Write(const u8* buffer, u64 toWrite) const
+{
+  u64 written;
+  return Write(buffer, toWrite, written);
+}
+
+// -------------------------------------------------------------------------- //
+
+FileResult
+FileIO::Write(const String& string, u64& written) const
+{
+  return Write(
+    reinterpret_cast<const u8*>(string.GetUTF8()), string.GetSize(), written);
+}
+
+// -------------------------------------------------------------------------- //
+
+FileResult
+FileIO::Write(const String& string) const
+{
+  u64 written;
+  return Write(
+    reinterpret_cast<const u8*>(string.GetUTF8()), string.GetSize(), written);
+}
+
+// -------------------------------------------------------------------------- //
+
+FileResult
+FileIO::WriteAt(u64 offset, const u8* buffer, u64 toWrite) const
+{
+  u64 written;
+  return WriteAt(offset, buffer, toWrite, written);
+}
+
+}
+
+// ========================================================================== //
+// FileIO Implementation (Windows)
+// ========================================================================== //
+
+#if defined(OL_PLATFORM_WINDOWS)
+
+namespace olivine {
+
 FileResult
 FileIO::Open(FileIO::Flag flags)
 {
@@ -118,12 +209,21 @@ FileIO::Open(FileIO::Flag flags)
     wpath, access, sharing, nullptr, disposition, attributes, nullptr);
   delete[] wpath;
   if (mHandle == INVALID_HANDLE_VALUE) {
-    const DWORD error = GetLastError();
-    return FileIOErrorFromErrorWin32(error);
+    mHandle = INVALID_HANDLE;
+    return FileResultFromLastError();
+  }
+
+  // Creating or truncating the file changes its metadata
+  if (bool(flags & (Flag::kCreate | Flag::kOverwrite))) {
+    MetadataCache::Invalidate(mPath);
   }
 
   // Finalize
+  mFlags = flags;
   mIsOpen = true;
+  if (bool(flags & Flag::kAppend)) {
+    SeekEnd();
+  }
   return FileResult::kSuccess;
 }
 
@@ -138,15 +238,18 @@ FileIO::Close()
   }
 
   // Flush any content
-  const FileResult result = Flush();
-  if (result != FileResult::kSuccess) {
-    return result;
+  if (bool(mFlags & Flag::kWrite)) {
+    const FileResult result = Flush();
+    if (result != FileResult::kSuccess) {
+      return result;
+    }
   }
 
   // Close file
   CloseHandle(mHandle);
 
   // Finalize
+  mHandle = INVALID_HANDLE;
   mIsOpen = false;
   return FileResult::kSuccess;
 }
@@ -156,95 +259,404 @@ FileIO::Close()
 FileResult
 FileIO::Read(u8* buffer, u64 toRead, u64& read)
 {
-  DWORD _read;
-  const BOOL result =
-    ReadFile(mHandle, buffer, static_cast<DWORD>(toRead), &_read, nullptr);
-  if (result != TRUE) {
-    const DWORD error = GetLastError();
-    return FileIOErrorFromErrorWin32(error);
+  // The cursor is only queried when recording
+  const u64 offset = AccessTrace::IsRecording() ? GetCursorPosition() : 0;
+  read = 0;
+  while (read < toRead) {
+    const DWORD chunk =
+      static_cast<DWORD>(std::min(toRead - read, kMaxChunkSize));
+    DWORD chunkRead;
+    if (ReadFile(mHandle, buffer + read, chunk, &chunkRead, nullptr) != TRUE) {
+      return FileResultFromLastError();
+    }
+    if (chunkRead == 0) {
+      break;
+    }
+    read += chunkRead;
   }
-  read = static_cast<u64>(_read);
+  AccessTrace::Record(mPath, offset, read);
   return FileResult::kSuccess;
 }
 
 // -------------------------------------------------------------------------- //
 
 FileResult
-FileIO::Read(u8* buffer, u64 toRead)
+FileIO::ReadAt(u64 offset, u8* buffer, u64 toRead, u64& read) const
 {
-  u64 read;
-  return Read(buffer, toRead, read);
+  read = 0;
+  while (read < toRead) {
+    const u64 position = offset + read;
+    OVERLAPPED overlapped{};
+    overlapped.Offset = static_cast<DWORD>(position);
+    overlapped.OffsetHigh = static_cast<DWORD>(position >> 32u);
+
+    const DWORD chunk =
+      static_cast<DWORD>(std::min(toRead - read, kMaxChunkSize));
+    DWORD chunkRead;
+    if (ReadFile(mHandle, buffer + read, chunk, &chunkRead, &overlapped) !=
+        TRUE) {
+      if (GetLastError() == ERROR_HANDLE_EOF) {
+        break;
+      }
+      return FileResultFromLastError();
+    }
+    if (chunkRead == 0) {
+      break;
+    }
+    read += chunkRead;
+  }
+  AccessTrace::Record(mPath, offset, read);
+  return FileResult::kSuccess;
 }
 
 // -------------------------------------------------------------------------- //
 
 FileResult
-FileIO::Read(String& string)
+FileIO::Write(const u8* buffer, u64 toWrite, u64& written) const
 {
-  // Allocate buffer
-  const u64 size = FileSystem::GetSize(mPath);
-  char8* buffer = static_cast<char8*>(
-    Memory::Allocate(sizeof(char8) * (size + 1), Memory::MIN_ALIGN));
-  if (!buffer) {
-    return FileResult::kOutOfMemory;
+  // Writes change the metadata of the file, so the cached metadata is
+  // invalidated after anything has been written
+  FileResult result = FileResult::kSuccess;
+  written = 0;
+  while (written < toWrite) {
+    const DWORD chunk =
+      static_cast<DWORD>(std::min(toWrite - written, kMaxChunkSize));
+    DWORD chunkWritten;
+    if (WriteFile(mHandle, buffer + written, chunk, &chunkWritten, nullptr) !=
+        TRUE) {
+      result = FileResultFromLastError();
+      break;
+    }
+    if (chunkWritten == 0) {
+      result = FileResult::kUnknownError;
+      break;
+    }
+    written += chunkWritten;
+  }
+  if (written > 0) {
+    MetadataCache::Invalidate(mPath);
   }
-  buffer[size] = 0;
+  return result;
+}
 
-  // Read file
-  u64 read;
-  const FileResult result = Read(reinterpret_cast<u8*>(buffer), size, read);
-  if (result != FileResult::kSuccess) {
-    Memory::Free(buffer);
-    return result;
+// -------------------------------------------------------------------------- //
+
+FileResult
+FileIO::WriteAt(u64 offset,
+                const u8* buffer,
+                u64 toWrite,
+                u64& written) const
+{
+  FileResult result = FileResult::kSuccess;
+  written = 0;
+  while (written < toWrite) {
+    const u64 position = offset + written;
+    OVERLAPPED overlapped{};
+    overlapped.Offset = static_cast<DWORD>(position);
+    overlapped.OffsetHigh = static_cast<DWORD>(position >> 32u);
+
+    const DWORD chunk =
+      static_cast<DWORD>(std::min(toWrite - written, kMaxChunkSize));
+    DWORD chunkWritten;
+    if (WriteFile(
+          mHandle, buffer + written, chunk, &chunkWritten, &overlapped) !=
+        TRUE) {
+      result = FileResultFromLastError();
+      break;
+    }
+    if (chunkWritten == 0) {
+      result = FileResult::kUnknownError;
+      break;
+    }
+    written += chunkWritten;
+  }
+  if (written > 0) {
+    MetadataCache::Invalidate(mPath);
+  }
+  return result;
+}
+
+// -------------------------------------------------------------------------- //
+
+FileResult
+FileIO::Flush() const
+{
+  const BOOL success = FlushFileBuffers(mHandle);
+  if (!success) {
+    return FileResultFromLastError();
   }
+  return FileResult::kSuccess;
+}
 
-  // Create string and return
-  string = String(buffer);
-  Memory::Free(buffer);
+// -------------------------------------------------------------------------- //
+
+void
+FileIO::Seek(u64 position) const
+{
+  LARGE_INTEGER seekOffset;
+  seekOffset.QuadPart = static_cast<LONGLONG>(position);
+  SetFilePointerEx(mHandle, seekOffset, nullptr, FILE_BEGIN);
+}
+
+// -------------------------------------------------------------------------- //
+
+void
+FileIO::SeekEnd() const
+{
+  LARGE_INTEGER seekOffset;
+  seekOffset.QuadPart = 0ull;
+  SetFilePointerEx(mHandle, seekOffset, nullptr, FILE_END);
+}
+
+// -------------------------------------------------------------------------- //
+
+u64
+FileIO::GetCursorPosition() const
+{
+  LARGE_INTEGER seekOffset;
+  seekOffset.QuadPart = 0ull;
+  LARGE_INTEGER position;
+  position.QuadPart = 0ull;
+  SetFilePointerEx(mHandle, seekOffset, &position, FILE_CURRENT);
+  return static_cast<u64>(position.QuadPart);
+}
+
+// -------------------------------------------------------------------------- //
+
+FileResult
+FileIO::GetMetadata(FileSystem::Metadata& metadata) const
+{
+  BY_HANDLE_FILE_INFORMATION info;
+  if (!GetFileInformationByHandle(mHandle, &info)) {
+    return FileResultFromLastError();
+  }
+
+  // File times are in 100 nanosecond intervals
+  const FILETIME& time = info.ftLastWriteTime;
+  const u64 modified = (u64(time.dwHighDateTime) << 32u) | time.dwLowDateTime;
+  metadata.type = info.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY
+                    ? FileSystem::ObjectType::kDirectory
+                    : FileSystem::ObjectType::kFile;
+  metadata.size = (u64(info.nFileSizeHigh) << 32u) | info.nFileSizeLow;
+  metadata.modified = Time{ modified / 10 };
+  MetadataCache::Update(mPath, metadata);
   return FileResult::kSuccess;
 }
 
 // -------------------------------------------------------------------------- //
 
 FileResult
-FileIO::Write(const u8* buffer, u64 toWrite, u64& written) const
+FileIO::GetSize(u64& size) const
+{
+  LARGE_INTEGER fileSize;
+  if (!GetFileSizeEx(mHandle, &fileSize)) {
+    return FileResultFromLastError();
+  }
+  size = static_cast<u64>(fileSize.QuadPart);
+  return FileResult::kSuccess;
+}
+
+}
+
+#else
+
+// ========================================================================== //
+// FileIO Implementation (POSIX)
+// ========================================================================== //
+
+namespace olivine {
+
+FileResult
+FileIO::Open(FileIO::Flag flags)
 {
-  DWORD _written;
-  const BOOL success =
-    WriteFile(mHandle, buffer, static_cast<DWORD>(toWrite), &_written, nullptr);
-  if (success != TRUE) {
-    return FileIOErrorFromErrorWin32(GetLastError());
+  // Check that file is not already open
+  if (mIsOpen) {
+    return FileResult::kAlreadyOpen;
+  }
+
+  // Access flags. Descriptors are never inherited by child processes
+  const bool read = bool(flags & Flag::kRead);
+  const bool write = bool(flags & Flag::kWrite);
+  int openFlags = O_CLOEXEC;
+  if (read && write) {
+    openFlags |= O_RDWR;
+  } else if (write) {
+    openFlags |= O_WRONLY;
+  } else {
+    openFlags |= O_RDONLY;
+  }
+
+  // Disposition. Sharing flags have no equivalent as POSIX locks are advisory
+  if (bool(flags & Flag::kCreate)) {
+    openFlags |= O_CREAT;
+  }
+  if (bool(flags & Flag::kOverwrite)) {
+    openFlags |= O_TRUNC;
+  }
+
+  // Open handle
+  const char8* path = mPath.GetPathString().GetUTF8();
+  do {
+    mHandle = open(path, openFlags, 0644);
+  } while (mHandle == INVALID_HANDLE && errno == EINTR);
+  if (mHandle == INVALID_HANDLE) {
+    return FileResultFromLastError();
+  }
+
+  // Creating or truncating the file changes its metadata
+  if (bool(flags & (Flag::kCreate | Flag::kOverwrite))) {
+    MetadataCache::Invalidate(mPath);
+  }
+
+  // Finalize
+  mFlags = flags;
+  mIsOpen = true;
+  if (bool(flags & Flag::kAppend)) {
+    SeekEnd();
   }
-  written = _written;
   return FileResult::kSuccess;
 }
 
 // -------------------------------------------------------------------------- //
 
 FileResult
-FileIO::Write(const u8* buffer, u64 toWrite) const
+FileIO::Close()
 {
-  u64 written;
-  return Write(buffer, toWrite, written);
+  // Check that file is open
+  if (!mIsOpen) {
+    return FileResult::kNotOpen;
+  }
+
+  // Flush any content
+  if (bool(mFlags & Flag::kWrite)) {
+    const FileResult result = Flush();
+    if (result != FileResult::kSuccess) {
+      return result;
+    }
+  }
+
+  // Close file. The descriptor is released even if 'close' is interrupted
+  close(mHandle);
+
+  // Finalize
+  mHandle = INVALID_HANDLE;
+  mIsOpen = false;
+  return FileResult::kSuccess;
 }
 
 // -------------------------------------------------------------------------- //
 
 FileResult
-FileIO::Write(const String& string, u64& written) const
+FileIO::Read(u8* buffer, u64 toRead, u64& read)
 {
-  return Write(
-    reinterpret_cast<const u8*>(string.GetUTF8()), string.GetSize(), written);
+  // The cursor is only queried when recording
+  const u64 offset = AccessTrace::IsRecording() ? GetCursorPosition() : 0;
+  read = 0;
+  while (read < toRead) {
+    const u64 chunk = std::min(toRead - read, kMaxChunkSize);
+    const ssize_t chunkRead = ::read(mHandle, buffer + read, chunk);
+    if (chunkRead < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return FileResultFromLastError();
+    }
+    if (chunkRead == 0) {
+      break;
+    }
+    read += static_cast<u64>(chunkRead);
+  }
+  AccessTrace::Record(mPath, offset, read);
+  return FileResult::kSuccess;
 }
 
 // -------------------------------------------------------------------------- //
 
 FileResult
-FileIO::Write(const String& string) const
+FileIO::ReadAt(u64 offset, u8* buffer, u64 toRead, u64& read) const
 {
-  u64 written;
-  return Write(
-    reinterpret_cast<const u8*>(string.GetUTF8()), string.GetSize(), written);
+  read = 0;
+  while (read < toRead) {
+    const u64 chunk = std::min(toRead - read, kMaxChunkSize);
+    const ssize_t chunkRead =
+      pread(mHandle, buffer + read, chunk, static_cast<off_t>(offset + read));
+    if (chunkRead < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return FileResultFromLastError();
+    }
+    if (chunkRead == 0) {
+      break;
+    }
+    read += static_cast<u64>(chunkRead);
+  }
+  AccessTrace::Record(mPath, offset, read);
+  return FileResult::kSuccess;
+}
+
+// -------------------------------------------------------------------------- //
+
+FileResult
+FileIO::Write(const u8* buffer, u64 toWrite, u64& written) const
+{
+  // Writes change the metadata of the file, so the cached metadata is
+  // invalidated after anything has been written
+  FileResult result = FileResult::kSuccess;
+  written = 0;
+  while (written < toWrite) {
+    const u64 chunk = std::min(toWrite - written, kMaxChunkSize);
+    const ssize_t chunkWritten = ::write(mHandle, buffer + written, chunk);
+    if (chunkWritten < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      result = FileResultFromLastError();
+      break;
+    }
+    if (chunkWritten == 0) {
+      result = FileResult::kUnknownError;
+      break;
+    }
+    written += static_cast<u64>(chunkWritten);
+  }
+  if (written > 0) {
+    MetadataCache::Invalidate(mPath);
+  }
+  return result;
+}
+
+// -------------------------------------------------------------------------- //
+
+FileResult
+FileIO::WriteAt(u64 offset,
+                const u8* buffer,
+                u64 toWrite,
+                u64& written) const
+{
+  FileResult result = FileResult::kSuccess;
+  written = 0;
+  while (written < toWrite) {
+    const u64 chunk = std::min(toWrite - written, kMaxChunkSize);
+    const ssize_t chunkWritten = pwrite(
+      mHandle, buffer + written, chunk, static_cast<off_t>(offset + written));
+    if (chunkWritten < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      result = FileResultFromLastError();
+      break;
+    }
+    if (chunkWritten == 0) {
+      result = FileResult::kUnknownError;
+      break;
+    }
+    written += static_cast<u64>(chunkWritten);
+  }
+  if (written > 0) {
+    MetadataCache::Invalidate(mPath);
+  }
+  return result;
 }
 
 // -------------------------------------------------------------------------- //
@@ -252,9 +664,8 @@ FileIO::Write(const String& string) const
 FileResult
 FileIO::Flush() const
 {
-  const BOOL success = FlushFileBuffers(mHandle);
-  if (!success) {
-    return FileIOErrorFromErrorWin32(GetLastError());
+  if (fsync(mHandle) != 0) {
+    return FileResultFromLastError();
   }
   return FileResult::kSuccess;
 }
@@ -264,9 +675,7 @@ FileIO::Flush() const
 void
 FileIO::Seek(u64 position) const
 {
-  LARGE_INTEGER seekOffset;
-  seekOffset.QuadPart = static_cast<LONGLONG>(position);
-  SetFilePointerEx(mHandle, seekOffset, nullptr, FILE_BEGIN);
+  lseek(mHandle, static_cast<off_t>(position), SEEK_SET);
 }
 
 // -------------------------------------------------------------------------- //
@@ -274,9 +683,7 @@ FileIO::Seek(u64 position) const
 void
 FileIO::SeekEnd() const
 {
-  LARGE_INTEGER seekOffset;
-  seekOffset.QuadPart = 0ull;
-  SetFilePointerEx(mHandle, seekOffset, nullptr, FILE_END);
+  lseek(mHandle, 0, SEEK_END);
 }
 
 // -------------------------------------------------------------------------- //
@@ -284,9 +691,45 @@ FileIO::SeekEnd() const
 u64
 FileIO::GetCursorPosition() const
 {
-  LARGE_INTEGER seekOffset;
-  seekOffset.QuadPart = 0ull;
-  return SetFilePointerEx(mHandle, seekOffset, nullptr, FILE_CURRENT);
+  const off_t position = lseek(mHandle, 0, SEEK_CUR);
+  return position < 0 ? 0 : static_cast<u64>(position);
+}
+
+// -------------------------------------------------------------------------- //
+
+FileResult
+FileIO::GetMetadata(FileSystem::Metadata& metadata) const
+{
+  struct stat info;
+  if (fstat(mHandle, &info) != 0) {
+    return FileResultFromLastError();
+  }
+  metadata.type = S_ISDIR(info.st_mode) ? FileSystem::ObjectType::kDirectory
+                                        : FileSystem::ObjectType::kFile;
+  metadata.size = u64(info.st_size);
+#if defined(OL_PLATFORM_LINUX)
+  metadata.modified = Time{ u64(info.st_mtim.tv_sec) * 1000000u +
+                            u64(info.st_mtim.tv_nsec) / 1000u };
+#else
+  metadata.modified = Time{ u64(info.st_mtime) * 1000000u };
+#endif
+  MetadataCache::Update(mPath, metadata);
+  return FileResult::kSuccess;
+}
+
+// -------------------------------------------------------------------------- //
+
+FileResult
+FileIO::GetSize(u64& size) const
+{
+  struct stat info;
+  if (fstat(mHandle, &info) != 0) {
+    return FileResultFromLastError();
+  }
+  size = static_cast<u64>(info.st_size);
+  return FileResult::kSuccess;
+}
+
 }
 
-}
\ No newline at end of file
+#endif
@@ -28,6 +28,7 @@
 
 // Project headers
 #include "olivine/core/common.hpp"
+#include "olivine/core/file/file_system.hpp"
 #include "olivine/core/file/path.hpp"
 #include "olivine/core/file/result.hpp"
 
@@ -44,14 +45,26 @@ namespace olivine {
  * \details
  *  Class that represents an interface to perform operations on a file in the
  * filesystem.
+ *
+ *  All sizes are 64-bit, reads and writes larger than what the underlying
+ * platform call supports are split into multiple calls. The positioned
+ * 'FileIO::ReadAt' and 'FileIO::WriteAt' functions do not depend on the cursor
+ * and can be called from multiple threads on the same handle.
  */
 class FileIO
 {
 public:
-  /** Opaque file handle **/
+#if defined(OL_PLATFORM_WINDOWS)
+  /** Opaque file handle (Windows) **/
   using OpaqueHandle = void*;
-  /** Invalid handle value **/
+  /** Invalid handle value (Windows) **/
   static constexpr OpaqueHandle INVALID_HANDLE = nullptr;
+#else
+  /** Opaque file handle (POSIX file descriptor) **/
+  using OpaqueHandle = s32;
+  /** Invalid handle value (POSIX) **/
+  static constexpr OpaqueHandle INVALID_HANDLE = -1;
+#endif
 
   /** File IO opening flags **/
   enum class Flag : u8
@@ -82,6 +95,8 @@ private:
   Path mPath;
   /** File handle **/
   OpaqueHandle mHandle = INVALID_HANDLE;
+  /** Flags that the file was opened with **/
+  Flag mFlags = Flag(0);
   /** Whether file is open **/
   bool mIsOpen = false;
 
@@ -143,6 +158,34 @@ public:
    */
   FileResult Read(String& string);
 
+  /** Read data from the file, starting at the specified offset, into a buffer.
+   * The read continues until 'toRead' bytes has been read or the end of the
+   * file is reached. The number of read bytes is returned as an output
+   * parameter.
+   *
+   * The cursor is not used, which means that multiple threads can read from
+   * the same handle at the same time. On Windows the cursor position is however
+   * changed as a side-effect of the read.
+   * \brief Read from file at offset.
+   * \param[in] offset Offset in file to read from.
+   * \param[in] buffer Buffer to read into.
+   * \param[in] toRead Number of bytes to read.
+   * \param[out] read Number of bytes read.
+   * \return Result.
+   */
+  FileResult ReadAt(u64 offset, u8* buffer, u64 toRead, u64& read) const;
+
+  /** Read data from the file, starting at the specified offset, into a buffer.
+   * \brief Read from file at offset.
+   * \param[in] offset Offset in file to read from.
+   * \param[in] buffer Buffer to read into.
+   * \param[in] toRead Number of bytes to read.
+   * \return Result.
+   * - FileResult::kEOF: The end of the file was reached before 'toRead' bytes
+   * could be read.
+   */
+  FileResult ReadAt(u64 offset, u8* buffer, u64 toRead) const;
+
   /** Write data from a buffer into the file. The buffer and number of bytes to
    * write must be specified by the user. The number of bytes that was
    * successfully written is returned to the user in an output parameter.
@@ -178,6 +221,34 @@ public:
    */
   FileResult Write(const String& string) const;
 
+  /** Write data from a buffer into the file, starting at the specified offset.
+   * The number of bytes that was successfully written is returned to the user
+   * in an output parameter.
+   *
+   * The cursor is not used, which means that multiple threads can write to
+   * different parts of the same handle at the same time. On Windows the cursor
+   * position is however changed as a side-effect of the write.
+   * \brief Write to file at offset.
+   * \param[in] offset Offset in file to write to.
+   * \param[in] buffer Buffer to write data from.
+   * \param[in] toWrite Number of bytes to write.
+   * \param[out] written Number of bytes written.
+   * \return Result.
+   */
+  FileResult WriteAt(u64 offset,
+                     const u8* buffer,
+                     u64 toWrite,
+                     u64& written) const;
+
+  /** Write data from a buffer into the file, starting at the specified offset.
+   * \brief Write to file at offset.
+   * \param[in] offset Offset in file to write to.
+   * \param[in] buffer Buffer to write data from.
+   * \param[in] toWrite Number of bytes to write.
+   * \return Result.
+   */
+  FileResult WriteAt(u64 offset, const u8* buffer, u64 toWrite) const;
+
   /** Flush and buffered writes that has not yet been written to file.
    * \brief Flush file.
    * \return Result.
@@ -212,6 +283,30 @@ public:
    * \return Cursor position.
    */
   OL_NODISCARD u64 GetCursorPosition() const;
+
+  /** Query the size of the open file from the handle. Unlike
+   * 'FileSystem::GetSize' this does not look up the path again.
+   * \brief Query size.
+   * \param[out] size Size of the file in bytes.
+   * \return Result.
+   */
+  FileResult GetSize(u64& size) const;
+
+  /** Query the metadata of the open file from the handle. If the metadata cache
+   * is enabled then the cached entry for the path of the file is updated when
+   * the modification time or size has changed.
+   * \brief Query metadata.
+   * \param[out] metadata Metadata of the file.
+   * \return Result.
+   */
+  FileResult GetMetadata(FileSystem::Metadata& metadata) const;
+
+  /** Returns the platform handle of the file. This is only valid while the
+   * file is open.
+   * \brief Returns platform handle.
+   * \return Handle.
+   */
+  OL_NODISCARD OpaqueHandle GetHandle() const { return mHandle; }
 };
 
 }
\ No newline at end of file
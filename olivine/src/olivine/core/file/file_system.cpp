@@ -22,54 +22,140 @@
 
 #include "olivine/core/file/file_system.hpp"
 
+// ========================================================================== //
+// Headers
+// ========================================================================== //
+
+// Standard headers
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Project headers
+#include "olivine/core/thread_pool.hpp"
+#include "olivine/core/file/metadata_cache.hpp"
+#include "olivine/core/platform/headers.hpp"
+
+#if defined(OL_PLATFORM_POSIX)
+#include <dirent.h>
+#endif
+#if defined(OL_PLATFORM_LINUX)
+#include <sys/syscall.h>
+#endif
+
 // ========================================================================== //
 // Functions
 // ========================================================================== //
 
 namespace olivine {
 
-/** Retrieve win32 file attributes **/
+/** State that is shared by all directories of an enumeration **/
+struct EnumerateContext
+{
+  /** Function to call for each entry **/
+  const FileSystem::EnumerateCallback* callback;
+  /** Extension of the files to report, or empty for all entries **/
+  StringView extension;
+  /** Whether subdirectories are enumerated **/
+  bool recursive;
+  /** Whether subdirectories are enumerated in parallel **/
+  bool parallel;
+};
+
+// -------------------------------------------------------------------------- //
+
+/** Invalidate the cached metadata of an object and of the directories that
+ * contain it, which may have been created together with the object **/
 static void
-RetrieveFileAttributeData(const Path& path,
-                          WIN32_FILE_ATTRIBUTE_DATA& attributes)
+InvalidateWithParents(const Path& path)
 {
-  char16* wpath = path.GetPathString().GetUTF16();
-  GetFileAttributesExW(wpath, GetFileExInfoStandard, &attributes);
-  delete[] wpath;
+  if (!MetadataCache::IsEnabled()) {
+    return;
+  }
+  Path current = path;
+  while (!current.GetPathString().IsEmpty()) {
+    MetadataCache::Invalidate(current);
+    current = current.GetDirectory();
+  }
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Returns whether a name is one of the special entries '.' and '..' **/
+static bool
+IsSpecialName(const char8* name)
+{
+  return name[0] == '.' &&
+         (name[1] == 0 || (name[1] == '.' && name[2] == 0));
 }
 
 // -------------------------------------------------------------------------- //
 
+/** Report an entry to the callback of an enumeration. The path of the entry is
+ * built by temporarily appending the name to the path of its directory **/
 static void
-EnumerateHelper(const Path& path,
-                const Path& basePath,
-                ArrayList<Path>& paths,
-                FileSystem::EnumerateFlag flags)
+ReportEntry(const EnumerateContext& context,
+            std::string& path,
+            StringView name,
+            FileSystem::ObjectType type)
 {
-  // TODO(Filip Björklund): Support recursive
-
-  // Enumerate and add files to list from directory
-  if (FileSystem::GetType(path) == FileSystem::ObjectType::kDirectory) {
-    String wildcardPath = path.GetPathString() + "/*";
-    WIN32_FIND_DATAW findData;
-    char16* wpath = wildcardPath.GetUTF16();
-    const HANDLE findHandle = FindFirstFileExW(
-      wpath, FindExInfoBasic, &findData, FindExSearchNameMatch, nullptr, 0);
-    delete[] wpath;
-    if (findHandle != INVALID_HANDLE_VALUE) {
-      do {
-        String filePath(findData.cFileName);
-        if (filePath != "." && filePath != "..") {
-          paths.AppendEmplace(filePath);
-        }
-      } while (FindNextFileW(findHandle, &findData));
-    }
-    FindClose(findHandle);
+  if (!context.extension.IsEmpty() &&
+      (type != FileSystem::ObjectType::kFile ||
+       !name.EndsWith(context.extension))) {
+    return;
   }
+  const size_t directorySize = path.size();
+  path.append(name.GetData(), name.GetSize());
+  const StringView view{ path.data(), StringView::SizeType(path.size()) };
+  (*context.callback)(FileSystem::Entry{ PathView{ view }, type });
+  path.resize(directorySize);
 }
 
 // -------------------------------------------------------------------------- //
 
+/** Run a function for each subdirectory in a list of names that are separated
+ * by null-terminators. The relative path of each subdirectory is appended to
+ * 'path' while the function runs. When parallel enumeration is enabled the
+ * subdirectories are distributed over the global thread pool, and each task
+ * gets a copy of the path **/
+template<typename F>
+static void
+ForEachSubdirectory(const EnumerateContext& context,
+                    std::string& path,
+                    const std::string& names,
+                    const std::vector<u32>& offsets,
+                    F&& function)
+{
+  if (context.parallel && offsets.size() > 1) {
+    ThreadPool::GetGlobal().ParallelFor(offsets.size(), [&](u64 index) {
+      const char8* name = names.data() + offsets[index];
+      std::string subPath = path;
+      subPath.append(name).push_back('/');
+      function(name, subPath);
+    });
+    return;
+  }
+
+  const size_t directorySize = path.size();
+  for (const u32 offset : offsets) {
+    const char8* name = names.data() + offset;
+    path.append(name).push_back('/');
+    function(name, path);
+    path.resize(directorySize);
+  }
+}
+
+}
+
+// ========================================================================== //
+// Functions (Windows)
+// ========================================================================== //
+
+#if defined(OL_PLATFORM_WINDOWS)
+
+namespace olivine {
+
+/** Convert a win32 error code to a file result **/
 FileResult
 FileErrorFromErrorWin32(DWORD error)
 {
@@ -90,6 +176,103 @@ FileErrorFromErrorWin32(DWORD error)
 
 // -------------------------------------------------------------------------- //
 
+/** Retrieve win32 file attributes. Only a missing object is reported as
+ * 'FileResult::kNotFound', other failures like sharing violations are reported
+ * as the error that they are **/
+static FileResult
+RetrieveFileAttributeData(const Path& path,
+                          WIN32_FILE_ATTRIBUTE_DATA& attributes)
+{
+  char16* wpath = path.GetPathString().GetUTF16();
+  const BOOL success =
+    GetFileAttributesExW(wpath, GetFileExInfoStandard, &attributes);
+  const DWORD error = success ? ERROR_SUCCESS : GetLastError();
+  delete[] wpath;
+  if (error == ERROR_FILE_NOT_FOUND || error == ERROR_PATH_NOT_FOUND) {
+    return FileResult::kNotFound;
+  }
+  return FileErrorFromErrorWin32(error);
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Enumerate the directory at 'directory', which is the absolute wide path of
+ * the directory with a trailing separator. 'path' is the relative UTF-8 path of
+ * the directory that entries are reported with **/
+static void
+EnumerateDirectoryWin32(const EnumerateContext& context,
+                        std::wstring& directory,
+                        std::string& path)
+{
+  // Large fetches and skipping the short names makes each call return more
+  // entries
+  const size_t directorySize = directory.size();
+  directory.push_back('*');
+  WIN32_FIND_DATAW findData;
+  const HANDLE findHandle = FindFirstFileExW(directory.c_str(),
+                                             FindExInfoBasic,
+                                             &findData,
+                                             FindExSearchNameMatch,
+                                             nullptr,
+                                             FIND_FIRST_EX_LARGE_FETCH);
+  directory.resize(directorySize);
+  if (findHandle == INVALID_HANDLE_VALUE) {
+    return;
+  }
+
+  // Report entries and remember the subdirectories
+  std::string names;
+  std::vector<u32> offsets;
+  char8 name[MAX_PATH * 4];
+  do {
+    const s32 nameSize = WideCharToMultiByte(CP_UTF8,
+                                             0,
+                                             findData.cFileName,
+                                             -1,
+                                             name,
+                                             sizeof(name),
+                                             nullptr,
+                                             nullptr);
+    if (nameSize <= 0 || IsSpecialName(name)) {
+      continue;
+    }
+    const bool isDirectory =
+      findData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY;
+    ReportEntry(context,
+                path,
+                StringView{ name, StringView::SizeType(nameSize - 1) },
+                isDirectory ? FileSystem::ObjectType::kDirectory
+                            : FileSystem::ObjectType::kFile);
+
+    // Links are not followed, to not enumerate directories more than once
+    if (context.recursive && isDirectory &&
+        !(findData.dwFileAttributes & FILE_ATTRIBUTE_REPARSE_POINT)) {
+      offsets.push_back(u32(names.size()));
+      names.append(name, nameSize);
+    }
+  } while (FindNextFileW(findHandle, &findData));
+  FindClose(findHandle);
+
+  // Enumerate subdirectories
+  ForEachSubdirectory(
+    context,
+    path,
+    names,
+    offsets,
+    [&](const char8* subName, std::string& subPath) {
+      char16 wideName[MAX_PATH];
+      if (MultiByteToWideChar(CP_UTF8, 0, subName, -1, wideName, MAX_PATH) ==
+          0) {
+        return;
+      }
+      std::wstring subDirectory = directory;
+      subDirectory.append(wideName).push_back('\\');
+      EnumerateDirectoryWin32(context, subDirectory, subPath);
+    });
+}
+
+// -------------------------------------------------------------------------- //
+
 static s64
 LastOffsetOfWStringWin32(const wchar_t* str, wchar_t chr)
 {
@@ -149,12 +332,264 @@ CreateDirectoryRecursivelyWin32(char16* path)
 
 }
 
+}
+
+#else
+
+// ========================================================================== //
+// Functions (POSIX)
+// ========================================================================== //
+
+namespace olivine {
+
+#if defined(OL_PLATFORM_LINUX)
+
+/** Directory entry that is returned by the 'getdents64' system call **/
+struct LinuxDirent64
+{
+  u64 d_ino;
+  s64 d_off;
+  u16 d_reclen;
+  u8 d_type;
+  char8 d_name[1];
+};
+
+/** Size of the buffer that directory entries are read into **/
+static constexpr u64 kDirentBufferSize = 32 * 1024;
+
+#endif
+
+// -------------------------------------------------------------------------- //
+
+/** Enumerate the open directory 'directory'. 'path' is the relative path of the
+ * directory that entries are reported with. The directory is closed before
+ * returning **/
+static void
+EnumerateDirectoryPOSIX(const EnumerateContext& context,
+                        s32 directory,
+                        std::string& path)
+{
+  std::string names;
+  std::vector<u32> offsets;
+
+  // Report an entry and remember it if it's a subdirectory to enumerate. The
+  // type is looked up if the file system does not return it. Links are not
+  // followed into, to not enumerate directories more than once
+  const auto visit = [&](const char8* name, u8 type) {
+    if (IsSpecialName(name)) {
+      return;
+    }
+    bool isLink = type == DT_LNK;
+    if (type == DT_UNKNOWN || isLink) {
+      struct stat info;
+      if (fstatat(directory, name, &info, isLink ? 0 : AT_SYMLINK_NOFOLLOW) !=
+          0) {
+        return;
+      }
+      isLink = isLink || S_ISLNK(info.st_mode);
+      type = S_ISDIR(info.st_mode) ? DT_DIR : DT_REG;
+    }
+    ReportEntry(context,
+                path,
+                StringView{ name },
+                type == DT_DIR ? FileSystem::ObjectType::kDirectory
+                               : FileSystem::ObjectType::kFile);
+    if (context.recursive && type == DT_DIR && !isLink) {
+      offsets.push_back(u32(names.size()));
+      names.append(name).push_back(0);
+    }
+  };
+
+#if defined(OL_PLATFORM_LINUX)
+  // Read entries in batches directly with 'getdents64', which avoids the
+  // per-entry overhead of 'readdir'. The buffer is only used before recursing
+  // into the subdirectories, so one buffer per thread is enough
+  alignas(8) static thread_local u8 buffer[kDirentBufferSize];
+  while (true) {
+    const long size = syscall(SYS_getdents64, directory, buffer, sizeof buffer);
+    if (size <= 0) {
+      break;
+    }
+    for (long offset = 0; offset < size;) {
+      const LinuxDirent64* entry =
+        reinterpret_cast<const LinuxDirent64*>(buffer + offset);
+      visit(entry->d_name, entry->d_type);
+      offset += entry->d_reclen;
+    }
+  }
+#else
+  DIR* stream = fdopendir(dup(directory));
+  if (stream) {
+    while (const dirent* entry = readdir(stream)) {
+      visit(entry->d_name, entry->d_type);
+    }
+    closedir(stream);
+  }
+#endif
+
+  // Enumerate subdirectories. They are opened relative to the directory, which
+  // avoids resolving the full path for each of them
+  ForEachSubdirectory(
+    context,
+    path,
+    names,
+    offsets,
+    [&](const char8* name, std::string& subPath) {
+      const s32 subDirectory =
+        openat(directory, name, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+      if (subDirectory != -1) {
+        EnumerateDirectoryPOSIX(context, subDirectory, subPath);
+      }
+    });
+  close(directory);
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Create a directory and any missing parent directories **/
+static FileResult
+CreateDirectoryRecursivelyPOSIX(const std::string& path)
+{
+  if (mkdir(path.c_str(), 0755) == 0) {
+    return FileResult::kSuccess;
+  }
+  if (errno != ENOENT) {
+    return FileResultFromLastError();
+  }
+
+  // Create parent directory, then this directory
+  const size_t separator = path.find_last_of('/');
+  if (separator == std::string::npos || separator == 0) {
+    return FileResult::kNotFound;
+  }
+  const FileResult result =
+    CreateDirectoryRecursivelyPOSIX(path.substr(0, separator));
+  if (result != FileResult::kSuccess && result != FileResult::kAlreadyExists) {
+    return result;
+  }
+  if (mkdir(path.c_str(), 0755) != 0) {
+    return FileResultFromLastError();
+  }
+  return FileResult::kSuccess;
+}
+
+}
+
+#endif
+
 // ========================================================================== //
 // FileSystem Implementation
 // ========================================================================== //
 
 namespace olivine {
 
+FileResult
+FileSystem::Rename(const Path& path, const String& name)
+{
+  // TODO(Filip Björklund): Implement
+  (void)name;
+  return FileResult::kUnknownError;
+}
+
+// -------------------------------------------------------------------------- //
+
+FileResult
+FileSystem::Copy(const Path& from, const Path& to)
+{
+  // TODO(Filip Björklund): Implement
+  (void)to;
+  return FileResult::kUnknownError;
+}
+
+// -------------------------------------------------------------------------- //
+
+FileResult
+FileSystem::Move(const Path& from, const Path& to)
+{
+  // TODO(Filip Björklund): Implement
+  (void)to;
+  return FileResult::kUnknownError;
+}
+
+// -------------------------------------------------------------------------- //
+
+FileResult
+FileSystem::GetMetadata(const Path& path, Metadata& metadata)
+{
+  if (MetadataCache::IsEnabled()) {
+    return MetadataCache::Get(path, metadata);
+  }
+  return QueryMetadata(path, metadata);
+}
+
+// -------------------------------------------------------------------------- //
+
+bool
+FileSystem::Exists(const Path& path)
+{
+  Metadata metadata;
+  return GetMetadata(path, metadata) == FileResult::kSuccess;
+}
+
+// -------------------------------------------------------------------------- //
+
+ArrayList<Path>
+FileSystem::Enumerate(const Path& path, EnumerateFlag flags)
+{
+  // Assert preconditions
+  Assert(GetType(path) == ObjectType::kDirectory,
+         "Only directories can be enumerated");
+
+  // Collect the entries. The list is locked if the callback can be called from
+  // multiple threads
+  ArrayList<Path> paths;
+  std::mutex mutex;
+  const bool parallel = bool(flags & EnumerateFlag::kParallel);
+  Enumerate(
+    path,
+    [&](const Entry& entry) {
+      std::unique_lock<std::mutex> lock(mutex, std::defer_lock);
+      if (parallel) {
+        lock.lock();
+      }
+      paths.AppendEmplace(String{ entry.path.GetPathString() });
+    },
+    flags);
+
+  // Return list of paths
+  return paths;
+}
+
+// -------------------------------------------------------------------------- //
+
+FileSystem::ObjectType
+FileSystem::GetType(const Path& path)
+{
+  Metadata metadata;
+  GetMetadata(path, metadata);
+  return metadata.type;
+}
+
+// -------------------------------------------------------------------------- //
+
+u64
+FileSystem::GetSize(const Path& path)
+{
+  Metadata metadata;
+  GetMetadata(path, metadata);
+  return metadata.size;
+}
+
+}
+
+// ========================================================================== //
+// FileSystem Implementation (Windows)
+// ========================================================================== //
+
+#if defined(OL_PLATFORM_WINDOWS)
+
+namespace olivine {
+
 FileResult
 FileSystem::Create(const Path& path, ObjectType type, CreateFlag flags)
 {
@@ -172,17 +607,21 @@ FileSystem::Create(const Path& path, ObjectType type, CreateFlag flags)
                               overwrite ? OPEN_ALWAYS : CREATE_NEW,
                               FILE_ATTRIBUTE_NORMAL,
                               nullptr);
+    const FileResult result = file == INVALID_HANDLE_VALUE
+                                ? FileErrorFromErrorWin32(GetLastError())
+                                : FileResult::kSuccess;
     delete[] wpath;
-    if (file == INVALID_HANDLE_VALUE) {
-      return FileErrorFromErrorWin32(GetLastError());
+    if (file != INVALID_HANDLE_VALUE) {
+      CloseHandle(file);
     }
-    CloseHandle(file);
-    return FileResult::kSuccess;
+    MetadataCache::Invalidate(path);
+    return result;
   }
   if (type == ObjectType::kDirectory) {
     char16* wpath = path.GetPathString().GetUTF16();
     const DWORD result = CreateDirectoryRecursivelyWin32(wpath);
     delete[] wpath;
+    InvalidateWithParents(path);
     return FileErrorFromErrorWin32(result);
   }
 
@@ -195,26 +634,29 @@ FileSystem::Create(const Path& path, ObjectType type, CreateFlag flags)
 FileResult
 FileSystem::Delete(const Path& path, DeleteFlag flags)
 {
-  // File does not exist
-  if (!Exists(path)) {
-    return FileResult::kNotFound;
+  // Query the object itself, as the cached metadata might be out of date
+  Metadata metadata;
+  const FileResult result = QueryMetadata(path, metadata);
+  if (result != FileResult::kSuccess) {
+    MetadataCache::Invalidate(path);
+    return result;
   }
 
   // Currently directories can't be removed
-  if (GetType(path) == ObjectType::kDirectory) {
+  if (metadata.type == ObjectType::kDirectory) {
     Assert(false, "Directories does not support being deleted yet");
     return FileResult::kInvalidArgument;
   }
 
   // Delete file
-  if (GetType(path) == ObjectType::kFile) {
+  if (metadata.type == ObjectType::kFile) {
     char16* wpath = path.GetPathString().GetUTF16();
-    const BOOL success = DeleteFileW(wpath);
+    const FileResult deleted = DeleteFileW(wpath)
+                                 ? FileResult::kSuccess
+                                 : FileErrorFromErrorWin32(GetLastError());
     delete[] wpath;
-    if (!success) {
-      return FileErrorFromErrorWin32(GetLastError());
-    }
-    return FileResult::kSuccess;
+    MetadataCache::Invalidate(path);
+    return deleted;
   }
 
   // Unknown error
@@ -224,99 +666,182 @@ FileSystem::Delete(const Path& path, DeleteFlag flags)
 // -------------------------------------------------------------------------- //
 
 FileResult
-FileSystem::Rename(const Path& path, const String& name)
+FileSystem::QueryMetadata(const Path& path, Metadata& metadata)
 {
-  // TODO(Filip Björklund): Implement
-  (void)name;
-  return FileResult::kUnknownError;
+  WIN32_FILE_ATTRIBUTE_DATA attributes;
+  const FileResult result = RetrieveFileAttributeData(path, attributes);
+  if (result != FileResult::kSuccess) {
+    metadata = Metadata{};
+    return result;
+  }
+
+  // File times are in 100 nanosecond intervals
+  const FILETIME& time = attributes.ftLastWriteTime;
+  const u64 modified = (u64(time.dwHighDateTime) << 32u) | time.dwLowDateTime;
+  metadata.type = attributes.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY
+                    ? ObjectType::kDirectory
+                    : ObjectType::kFile;
+  metadata.size =
+    (u64(attributes.nFileSizeHigh) << 32u) | attributes.nFileSizeLow;
+  metadata.modified = Time{ modified / 10 };
+  return FileResult::kSuccess;
 }
 
 // -------------------------------------------------------------------------- //
 
 FileResult
-FileSystem::Copy(const Path& from, const Path& to)
+FileSystem::Enumerate(const Path& path,
+                      const EnumerateCallback& callback,
+                      EnumerateFlag flags,
+                      StringView extension)
 {
-  // TODO(Filip Björklund): Implement
-  (void)to;
-  return FileResult::kUnknownError;
+  if (GetType(path) != ObjectType::kDirectory) {
+    return FileResult::kNotFound;
+  }
+
+  // Report special entries of the directory itself
+  const EnumerateContext context{ &callback,
+                                  extension,
+                                  bool(flags & EnumerateFlag::kRecursive),
+                                  bool(flags & EnumerateFlag::kParallel) };
+  std::string relativePath;
+  if (bool(flags & EnumerateFlag::kIncludeSpecial)) {
+    ReportEntry(context, relativePath, ".", ObjectType::kDirectory);
+    ReportEntry(context, relativePath, "..", ObjectType::kDirectory);
+  }
+
+  // Enumerate entries
+  char16* wpath = path.GetPathString().GetUTF16();
+  std::wstring directory = wpath;
+  delete[] wpath;
+  if (!directory.empty() && directory.back() != '/' &&
+      directory.back() != '\\') {
+    directory.push_back('\\');
+  }
+  EnumerateDirectoryWin32(context, directory, relativePath);
+  return FileResult::kSuccess;
 }
 
-// -------------------------------------------------------------------------- //
+}
+
+#else
+
+// ========================================================================== //
+// FileSystem Implementation (POSIX)
+// ========================================================================== //
+
+namespace olivine {
 
 FileResult
-FileSystem::Move(const Path& from, const Path& to)
+FileSystem::Create(const Path& path, ObjectType type, CreateFlag flags)
 {
-  // TODO(Filip Björklund): Implement
-  (void)to;
-  return FileResult::kUnknownError;
-}
+  Assert(type != ObjectType::kInvalid,
+         "Cannot create file system object of type 'kInvalid'");
 
-// -------------------------------------------------------------------------- //
+  bool overwrite = bool(flags & CreateFlag::kOverwrite);
 
-bool
-FileSystem::Exists(const Path& path)
-{
-  WIN32_FILE_ATTRIBUTE_DATA attributes;
-  RetrieveFileAttributeData(path, attributes);
-  return attributes.dwFileAttributes != INVALID_FILE_ATTRIBUTES;
+  if (type == ObjectType::kFile) {
+    const s32 openFlags =
+      O_WRONLY | O_CREAT | O_CLOEXEC | (overwrite ? 0 : O_EXCL);
+    const s32 file = open(path.GetPathString().GetUTF8(), openFlags, 0644);
+    const FileResult result =
+      file == -1 ? FileResultFromLastError() : FileResult::kSuccess;
+    if (file != -1) {
+      close(file);
+    }
+    MetadataCache::Invalidate(path);
+    return result;
+  }
+  if (type == ObjectType::kDirectory) {
+    const FileResult result =
+      CreateDirectoryRecursivelyPOSIX(path.GetPathString().GetUTF8());
+    InvalidateWithParents(path);
+    return result;
+  }
+
+  // Unknown error
+  return FileResult::kUnknownError;
 }
 
 // -------------------------------------------------------------------------- //
 
-ArrayList<Path>
-FileSystem::Enumerate(const Path& path, EnumerateFlag flags)
+FileResult
+FileSystem::Delete(const Path& path, DeleteFlag flags)
 {
-  // Assert preconditions
-  Assert(GetType(path) == ObjectType::kDirectory,
-         "Only directories can be enumerated");
-
-  // List of paths
-  ArrayList<Path> paths;
-
-  // Add special directories if they should be included
-  bool includeSpecial = bool(flags & EnumerateFlag::kIncludeSpecial);
-  if (includeSpecial && GetType(path) == ObjectType::kDirectory) {
-    paths.AppendEmplace(".");
-    paths.AppendEmplace("..");
+  // Query the object itself, as the cached metadata might be out of date
+  Metadata metadata;
+  const FileResult result = QueryMetadata(path, metadata);
+  if (result != FileResult::kSuccess) {
+    MetadataCache::Invalidate(path);
+    return result;
   }
 
-  // Enumerate directory entries
-  EnumerateHelper(path, Path{ "" }, paths, flags);
+  // Currently directories can't be removed
+  if (metadata.type == ObjectType::kDirectory) {
+    Assert(false, "Directories does not support being deleted yet");
+    return FileResult::kInvalidArgument;
+  }
 
-  // Return list of paths
-  return paths;
+  // Delete file
+  const FileResult deleted = unlink(path.GetPathString().GetUTF8()) == 0
+                               ? FileResult::kSuccess
+                               : FileResultFromLastError();
+  MetadataCache::Invalidate(path);
+  return deleted;
 }
 
 // -------------------------------------------------------------------------- //
 
-FileSystem::ObjectType
-FileSystem::GetType(const Path& path)
+FileResult
+FileSystem::QueryMetadata(const Path& path, Metadata& metadata)
 {
-  // Only existing files has a type
-  if (!Exists(path)) {
-    return ObjectType::kInvalid;
-  }
-
-  WIN32_FILE_ATTRIBUTE_DATA attributes;
-  RetrieveFileAttributeData(path, attributes);
-  if (attributes.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) {
-    return ObjectType::kDirectory;
+  struct stat info;
+  if (stat(path.GetPathString().GetUTF8(), &info) != 0) {
+    metadata = Metadata{};
+    return FileResultFromLastError();
   }
-  return ObjectType::kFile;
+  metadata.type =
+    S_ISDIR(info.st_mode) ? ObjectType::kDirectory : ObjectType::kFile;
+  metadata.size = u64(info.st_size);
+#if defined(OL_PLATFORM_LINUX)
+  metadata.modified = Time{ u64(info.st_mtim.tv_sec) * 1000000u +
+                            u64(info.st_mtim.tv_nsec) / 1000u };
+#else
+  metadata.modified = Time{ u64(info.st_mtime) * 1000000u };
+#endif
+  return FileResult::kSuccess;
 }
 
 // -------------------------------------------------------------------------- //
 
-u64
-FileSystem::GetSize(const Path& path)
+FileResult
+FileSystem::Enumerate(const Path& path,
+                      const EnumerateCallback& callback,
+                      EnumerateFlag flags,
+                      StringView extension)
 {
-  WIN32_FILE_ATTRIBUTE_DATA attributes;
-  RetrieveFileAttributeData(path, attributes);
-  if (attributes.dwFileAttributes != INVALID_FILE_ATTRIBUTES) {
-    const u64 sizeHigh = (uint64_t)attributes.nFileSizeHigh << sizeof(DWORD);
-    const u64 sizeLow = attributes.nFileSizeLow;
-    return sizeLow | sizeHigh;
+  const s32 directory =
+    open(path.GetPathString().GetUTF8(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+  if (directory == -1) {
+    return FileResultFromLastError();
+  }
+
+  // Report special entries of the directory itself
+  const EnumerateContext context{ &callback,
+                                  extension,
+                                  bool(flags & EnumerateFlag::kRecursive),
+                                  bool(flags & EnumerateFlag::kParallel) };
+  std::string relativePath;
+  if (bool(flags & EnumerateFlag::kIncludeSpecial)) {
+    ReportEntry(context, relativePath, ".", ObjectType::kDirectory);
+    ReportEntry(context, relativePath, "..", ObjectType::kDirectory);
   }
-  return 0;
+
+  // Enumerate entries
+  EnumerateDirectoryPOSIX(context, directory, relativePath);
+  return FileResult::kSuccess;
+}
+
 }
-}
\ No newline at end of file
+
+#endif
@@ -26,8 +26,12 @@
 // Headers
 // ========================================================================== //
 
+// Standard headers
+#include <functional>
+
 // Project headers
 #include "olivine/core/common.hpp"
+#include "olivine/core/time.hpp"
 #include "olivine/core/file/path.hpp"
 #include "olivine/core/file/result.hpp"
 
@@ -94,9 +98,40 @@ public:
     /** Flag that specifies that special paths, such as '.' and '..', should be
      * included in the enumerated files list **/
     kIncludeSpecial = Bit(1),
+    /** Flag that specifies that subdirectories should be enumerated in
+     * parallel on the global thread pool. The callback is then called from
+     * multiple threads at the same time **/
+    kParallel = Bit(2)
   };
   OL_ENUM_CLASS_OPERATORS(friend, EnumerateFlag, u8);
 
+  /** Entry that is reported when enumerating a directory **/
+  struct Entry
+  {
+    /** Path of the entry relative to the enumerated directory, with '/' as
+     * separator. This is a view into a buffer that is reused for the following
+     * entries, so it's only valid during the callback **/
+    PathView path;
+    /** Type of the entry **/
+    ObjectType type;
+  };
+
+  /** Function that is called for each enumerated entry **/
+  using EnumerateCallback = std::function<void(const Entry& entry)>;
+
+  /** Metadata of a file system object **/
+  struct Metadata
+  {
+    /** Type of the object. This is 'ObjectType::kInvalid' if the object does
+     * not exist **/
+    ObjectType type = ObjectType::kInvalid;
+    /** Size of the object in bytes **/
+    u64 size = 0;
+    /** Time of the last modification. The epoch depends on the platform, so
+     * this should only be compared to other modification times **/
+    Time modified;
+  };
+
 public:
   /** Create an object in the file system. The path to the object and the type
    * is specified. A flag can be passed to determine how the object will be
@@ -145,6 +180,27 @@ public:
    */
   static FileResult Move(const Path& from, const Path& to);
 
+  /** Retrieve the metadata of an object in the file system. If the metadata
+   * cache is enabled then the metadata is taken from the cache when possible,
+   * see 'MetadataCache'.
+   * \brief Retrieve metadata.
+   * \param path Path to object.
+   * \param[out] metadata Metadata of the object.
+   * \return Result.
+   * - FileResult::kNotFound: The object does not exist. The type in the
+   * metadata is then set to 'ObjectType::kInvalid'.
+   */
+  static FileResult GetMetadata(const Path& path, Metadata& metadata);
+
+  /** Query the metadata of an object from the file system. Unlike
+   * 'FileSystem::GetMetadata' this never uses the metadata cache.
+   * \brief Query metadata.
+   * \param path Path to object.
+   * \param[out] metadata Metadata of the object.
+   * \return Result.
+   */
+  static FileResult QueryMetadata(const Path& path, Metadata& metadata);
+
   /** Returns whether or not an object exists in the file system at the
    * specified path.
    * \brief Returns whether object exists.
@@ -163,6 +219,28 @@ public:
     const Path& path,
     EnumerateFlag flags = EnumerateFlag::kNone);
 
+  /** Enumerate the entries of the directory pointed to by the specified path,
+   * calling a function for each entry. No list of the entries is built and no
+   * allocations are made per entry, which makes this suitable for large
+   * directory trees.
+   *
+   * If an extension is specified then only files with that extension are
+   * reported. The check is done on the raw entry name before anything else.
+   * Subdirectories are still enumerated when recursive.
+   * \brief Enumerate directory with callback.
+   * \param path Path to the directory to enumerate.
+   * \param callback Function to call for each entry.
+   * \param flags Flags for enumerating.
+   * \param extension Extension of the files to report, including the dot, or
+   * empty to report all entries.
+   * \return Result.
+   * - FileResult::kNotFound: The directory does not exist.
+   */
+  static FileResult Enumerate(const Path& path,
+                              const EnumerateCallback& callback,
+                              EnumerateFlag flags = EnumerateFlag::kNone,
+                              StringView extension = StringView{});
+
   /** Returns the type of an object in the file system pointed to by the
    * specified path.
    * \brief Returns object type.
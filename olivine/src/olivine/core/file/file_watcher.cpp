@@ -0,0 +1,513 @@
+// MIT License
+//
+// Copyright (c) 2019 Filip Björklund
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "olivine/core/file/file_watcher.hpp"
+
+// ========================================================================== //
+// Headers
+// ========================================================================== //
+
+// Project headers
+#include "olivine/core/unicode.hpp"
+#include "olivine/core/file/metadata_cache.hpp"
+#include "olivine/core/platform/headers.hpp"
+
+#if defined(OL_PLATFORM_LINUX)
+#include <sys/inotify.h>
+#endif
+
+// ========================================================================== //
+// FileWatcher Implementation (Windows)
+// ========================================================================== //
+
+#if defined(OL_PLATFORM_WINDOWS)
+
+namespace olivine {
+
+/** Size of the notification buffer of each directory **/
+static constexpr u32 kNotifyBufferSize = 16 * 1024;
+
+/** Changes that are watched for **/
+static constexpr DWORD kNotifyFilter = FILE_NOTIFY_CHANGE_FILE_NAME |
+                                       FILE_NOTIFY_CHANGE_LAST_WRITE |
+                                       FILE_NOTIFY_CHANGE_SIZE;
+
+// -------------------------------------------------------------------------- //
+
+struct FileWatcher::Directory
+{
+  /** Path of the directory **/
+  Path path;
+  /** Directory handle **/
+  HANDLE handle = INVALID_HANDLE_VALUE;
+  /** Overlapped structure of the pending read **/
+  OVERLAPPED overlapped{};
+  /** Whether a read is pending **/
+  bool reading = false;
+  /** Buffer that the notifications are written to **/
+  alignas(DWORD) u8 buffer[kNotifyBufferSize];
+
+  /** Start reading notifications **/
+  bool BeginRead()
+  {
+    overlapped = OVERLAPPED{};
+    reading = ReadDirectoryChangesW(handle,
+                                    buffer,
+                                    kNotifyBufferSize,
+                                    FALSE,
+                                    kNotifyFilter,
+                                    nullptr,
+                                    &overlapped,
+                                    nullptr) == TRUE;
+    return reading;
+  }
+
+  /** Cancel the pending read and close the handle **/
+  ~Directory()
+  {
+    if (handle != INVALID_HANDLE_VALUE) {
+      if (reading) {
+        CancelIoEx(handle, &overlapped);
+        DWORD transferred;
+        GetOverlappedResult(handle, &overlapped, &transferred, TRUE);
+      }
+      CloseHandle(handle);
+    }
+  }
+};
+
+// -------------------------------------------------------------------------- //
+
+FileWatcher::FileWatcher(Time debounce)
+  : mDebounce(debounce)
+{}
+
+// -------------------------------------------------------------------------- //
+
+FileWatcher::~FileWatcher() = default;
+
+// -------------------------------------------------------------------------- //
+
+FileResult
+FileWatcher::Watch(const Path& directory)
+{
+  if (IsWatching(directory)) {
+    return FileResult::kSuccess;
+  }
+
+  // Open directory for overlapped reads of the notifications
+  std::unique_ptr<Directory> watched = std::make_unique<Directory>();
+  watched->path = directory;
+  char16* path = directory.GetPathString().GetUTF16();
+  watched->handle =
+    CreateFileW(path,
+                FILE_LIST_DIRECTORY,
+                FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                nullptr,
+                OPEN_EXISTING,
+                FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED,
+                nullptr);
+  delete[] path;
+  if (watched->handle == INVALID_HANDLE_VALUE) {
+    return FileResultFromLastError();
+  }
+  if (!watched->BeginRead()) {
+    const FileResult result = FileResultFromLastError();
+    CloseHandle(watched->handle);
+    watched->handle = INVALID_HANDLE_VALUE;
+    return result;
+  }
+
+  mDirectories.push_back(std::move(watched));
+  return FileResult::kSuccess;
+}
+
+// -------------------------------------------------------------------------- //
+
+FileResult
+FileWatcher::Collect()
+{
+  FileResult result = FileResult::kSuccess;
+  for (auto it = mDirectories.begin(); it != mDirectories.end();) {
+    // Skip directories that has no notifications yet. Other errors, like
+    // 'ERROR_NOTIFY_ENUM_DIR', mean that the notifications were lost
+    Directory* directory = it->get();
+    DWORD transferred;
+    if (GetOverlappedResult(directory->handle,
+                            &directory->overlapped,
+                            &transferred,
+                            FALSE) != TRUE) {
+      if (GetLastError() == ERROR_IO_INCOMPLETE) {
+        ++it;
+        continue;
+      }
+      transferred = 0;
+    }
+    directory->reading = false;
+
+    // Zero bytes means that the buffer overflowed and notifications were lost
+    if (transferred == 0) {
+      RecordRescan(directory->path);
+    }
+    const u8* data = directory->buffer;
+    while (transferred > 0) {
+      const FILE_NOTIFY_INFORMATION* info =
+        reinterpret_cast<const FILE_NOTIFY_INFORMATION*>(data);
+      char8 name[MAX_PATH * 3];
+      u64 written;
+      if (Unicode::UTF16ToUTF8(info->FileName,
+                               info->FileNameLength / sizeof(char16),
+                               name,
+                               sizeof(name),
+                               written)) {
+        Action action = Action::kModified;
+        if (info->Action == FILE_ACTION_ADDED ||
+            info->Action == FILE_ACTION_RENAMED_NEW_NAME) {
+          action = Action::kCreated;
+        } else if (info->Action == FILE_ACTION_REMOVED ||
+                   info->Action == FILE_ACTION_RENAMED_OLD_NAME) {
+          action = Action::kDeleted;
+        }
+        Record(directory->path, String(StringView(name, written)), action);
+      }
+      if (info->NextEntryOffset == 0) {
+        break;
+      }
+      data += info->NextEntryOffset;
+    }
+
+    // Read next notifications. A directory that cannot be read anymore, for
+    // example because it was deleted, is no longer watched
+    if (!directory->BeginRead()) {
+      if (result == FileResult::kSuccess) {
+        result = FileResultFromLastError();
+      }
+      RecordRescan(directory->path);
+      it = mDirectories.erase(it);
+      continue;
+    }
+    ++it;
+  }
+  return result;
+}
+
+}
+
+// ========================================================================== //
+// FileWatcher Implementation (Linux)
+// ========================================================================== //
+
+#elif defined(OL_PLATFORM_LINUX)
+
+namespace olivine {
+
+/** Changes that are watched for **/
+static constexpr u32 kNotifyMask = IN_CREATE | IN_DELETE | IN_MODIFY |
+                                   IN_CLOSE_WRITE | IN_MOVED_FROM |
+                                   IN_MOVED_TO | IN_DELETE_SELF | IN_MOVE_SELF;
+
+/** Notifications that the watch of a directory has ended **/
+static constexpr u32 kWatchEndMask = IN_IGNORED | IN_DELETE_SELF | IN_MOVE_SELF;
+
+// -------------------------------------------------------------------------- //
+
+struct FileWatcher::Directory
+{
+  /** Path of the directory **/
+  Path path;
+  /** Watch descriptor **/
+  s32 handle;
+};
+
+// -------------------------------------------------------------------------- //
+
+FileWatcher::FileWatcher(Time debounce)
+  : mDebounce(debounce)
+{
+  mHandle = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+}
+
+// -------------------------------------------------------------------------- //
+
+FileWatcher::~FileWatcher()
+{
+  // Closing the instance removes all watches
+  if (mHandle != -1) {
+    close(mHandle);
+  }
+}
+
+// -------------------------------------------------------------------------- //
+
+FileResult
+FileWatcher::Watch(const Path& directory)
+{
+  if (IsWatching(directory)) {
+    return FileResult::kSuccess;
+  }
+  if (mHandle == -1) {
+    return FileResult::kUnknownError;
+  }
+
+  const s32 handle = inotify_add_watch(
+    mHandle, directory.GetPathStringUTF8(), kNotifyMask | IN_ONLYDIR);
+  if (handle == -1) {
+    return FileResultFromLastError();
+  }
+  mDirectories.push_back(
+    std::unique_ptr<Directory>(new Directory{ directory, handle }));
+  return FileResult::kSuccess;
+}
+
+// -------------------------------------------------------------------------- //
+
+FileResult
+FileWatcher::Collect()
+{
+  if (mHandle == -1) {
+    return FileResult::kUnknownError;
+  }
+
+  FileResult result = FileResult::kSuccess;
+  alignas(inotify_event) char8 buffer[16 * 1024];
+  while (true) {
+    const ssize_t size = read(mHandle, buffer, sizeof(buffer));
+    if (size < 0 && errno == EINTR) {
+      continue;
+    }
+    if (size < 0 && errno != EAGAIN) {
+      return FileResultFromLastError();
+    }
+    if (size <= 0) {
+      break;
+    }
+
+    // Record the notifications of files in the watched directories
+    for (ssize_t offset = 0; offset < size;) {
+      const inotify_event* event =
+        reinterpret_cast<const inotify_event*>(buffer + offset);
+      offset += sizeof(inotify_event) + event->len;
+
+      // The queue overflowed and notifications of any directory were lost
+      if (event->mask & IN_Q_OVERFLOW) {
+        for (std::unique_ptr<Directory>& directory : mDirectories) {
+          RecordRescan(directory->path);
+        }
+        continue;
+      }
+
+      // A watched directory that was deleted or moved away is no longer
+      // watched, so that watching it again adds a new watch
+      if (event->mask & kWatchEndMask) {
+        for (auto it = mDirectories.begin(); it != mDirectories.end(); ++it) {
+          if ((*it)->handle != event->wd) {
+            continue;
+          }
+          inotify_rm_watch(mHandle, event->wd);
+          RecordRescan((*it)->path);
+          mDirectories.erase(it);
+          result = FileResult::kNotFound;
+          break;
+        }
+        continue;
+      }
+      if (event->len == 0 || (event->mask & IN_ISDIR)) {
+        continue;
+      }
+      for (std::unique_ptr<Directory>& directory : mDirectories) {
+        if (directory->handle != event->wd) {
+          continue;
+        }
+        Action action = Action::kModified;
+        if (event->mask & (IN_CREATE | IN_MOVED_TO)) {
+          action = Action::kCreated;
+        } else if (event->mask & (IN_DELETE | IN_MOVED_FROM)) {
+          action = Action::kDeleted;
+        }
+        Record(directory->path, String(event->name), action);
+        break;
+      }
+    }
+  }
+  return result;
+}
+
+}
+
+// ========================================================================== //
+// FileWatcher Implementation (Unsupported)
+// ========================================================================== //
+
+#else
+
+namespace olivine {
+
+struct FileWatcher::Directory
+{
+  /** Path of the directory **/
+  Path path;
+};
+
+// -------------------------------------------------------------------------- //
+
+FileWatcher::FileWatcher(Time debounce)
+  : mDebounce(debounce)
+{}
+
+// -------------------------------------------------------------------------- //
+
+FileWatcher::~FileWatcher() = default;
+
+// -------------------------------------------------------------------------- //
+
+FileResult
+FileWatcher::Watch(const Path& directory)
+{
+  return FileResult::kUnknownError;
+}
+
+// -------------------------------------------------------------------------- //
+
+FileResult
+FileWatcher::Collect()
+{
+  return FileResult::kSuccess;
+}
+
+}
+
+#endif
+
+// ========================================================================== //
+// FileWatcher Implementation
+// ========================================================================== //
+
+namespace olivine {
+
+FileResult
+FileWatcher::Unwatch(const Path& directory)
+{
+  for (auto it = mDirectories.begin(); it != mDirectories.end(); ++it) {
+    if ((*it)->path != directory) {
+      continue;
+    }
+#if defined(OL_PLATFORM_LINUX)
+    inotify_rm_watch(mHandle, (*it)->handle);
+#endif
+    mDirectories.erase(it);
+
+    // Drop changes in the directory
+    for (auto pending = mPending.begin(); pending != mPending.end();) {
+      const Path path(pending->first);
+      if (path.GetDirectory() == directory ||
+          (pending->second.action == Action::kRescan && path == directory)) {
+        pending = mPending.erase(pending);
+      } else {
+        ++pending;
+      }
+    }
+    return FileResult::kSuccess;
+  }
+  return FileResult::kNotFound;
+}
+
+// -------------------------------------------------------------------------- //
+
+FileResult
+FileWatcher::Poll(std::vector<Event>& events)
+{
+  const FileResult result = Collect();
+
+  // Deliver changes of files that has settled
+  const Time now = Time::Now();
+  for (auto it = mPending.begin(); it != mPending.end();) {
+    if (now - it->second.time < mDebounce) {
+      ++it;
+      continue;
+    }
+    events.push_back(Event{ Path(it->first), it->second.action });
+    it = mPending.erase(it);
+  }
+  return result;
+}
+
+// -------------------------------------------------------------------------- //
+
+bool
+FileWatcher::IsWatching(const Path& directory) const
+{
+  for (const std::unique_ptr<Directory>& watched : mDirectories) {
+    if (watched->path == directory) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// -------------------------------------------------------------------------- //
+
+void
+FileWatcher::Record(const Path& directory, const String& name, Action action)
+{
+  // Cached metadata is stale as soon as the change is observed, even though the
+  // event is not delivered until it has settled
+  const Path joined = directory.Joined(Path(name));
+  MetadataCache::Invalidate(joined);
+
+  const String& path = joined.GetPathString();
+  const Time now = Time::Now();
+  const auto it = mPending.find(path);
+  if (it == mPending.end()) {
+    mPending.emplace(path, Pending{ action, now });
+    return;
+  }
+
+  // Coalesce with the change that is pending. A file that is deleted and then
+  // created again, like when saving through a rename, has been modified
+  Pending& pending = it->second;
+  if (pending.action == Action::kRescan) {
+    pending.time = now;
+    return;
+  }
+  if (action == Action::kDeleted && pending.action == Action::kCreated) {
+    mPending.erase(it);
+    return;
+  }
+  if (action == Action::kDeleted) {
+    pending.action = Action::kDeleted;
+  } else if (pending.action == Action::kDeleted) {
+    pending.action = Action::kModified;
+  }
+  pending.time = now;
+}
+
+// -------------------------------------------------------------------------- //
+
+void
+FileWatcher::RecordRescan(const Path& directory)
+{
+  // The files that changed are not known, so all cached metadata is dropped
+  MetadataCache::InvalidateAll();
+  mPending[directory.GetPathString()] = Pending{ Action::kRescan, Time::Now() };
+}
+
+}
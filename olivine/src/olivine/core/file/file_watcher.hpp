@@ -0,0 +1,187 @@
+// MIT License
+//
+// Copyright (c) 2019 Filip Björklund
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+// ========================================================================== //
+// Headers
+// ========================================================================== //
+
+// Standard headers
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+// Project headers
+#include "olivine/core/common.hpp"
+#include "olivine/core/macros.hpp"
+#include "olivine/core/string.hpp"
+#include "olivine/core/time.hpp"
+#include "olivine/core/file/path.hpp"
+#include "olivine/core/file/result.hpp"
+
+// ========================================================================== //
+// FileWatcher Declaration
+// ========================================================================== //
+
+namespace olivine {
+
+/** \class FileWatcher
+ * \author Filip Björklund
+ * \date 18 october 2026 - 20:05
+ * \brief Watches directories for changes to files.
+ * \details
+ * Uses inotify on Linux and ReadDirectoryChangesW on Windows to be notified
+ * when files in the watched directories are created, modified or deleted.
+ * Directories are watched non-recursively.
+ *
+ * Saving a file usually produces several notifications, for example a
+ * truncate followed by a number of writes, or a write to a temporary file
+ * followed by a rename. The notifications for each file are therefore
+ * coalesced into a single event, which is only delivered once the file has
+ * not changed for the debounce time.
+ *
+ * If notifications are lost, because the platform ran out of room for them,
+ * a 'FileWatcher::Action::kRescan' event is delivered for the watched
+ * directory instead, and any file in it must be assumed to have changed.
+ *
+ * The watcher does not use any threads. Notifications are collected when
+ * 'FileWatcher::Poll' is called, which is meant to be done once per frame.
+ */
+class FileWatcher
+{
+  OL_NO_COPY(FileWatcher);
+
+public:
+  /** Default time that a file must be unchanged before an event is delivered
+   * for it, in microseconds **/
+  static constexpr u64 kDefaultDebounce = 100000;
+
+  /** Kinds of changes **/
+  enum class Action : u8
+  {
+    /** The file was created **/
+    kCreated,
+    /** The file was modified **/
+    kModified,
+    /** The file was deleted **/
+    kDeleted,
+    /** Notifications for the directory was lost and any file in it may have
+     * changed **/
+    kRescan
+  };
+
+  /** Change to a file **/
+  struct Event
+  {
+    /** Path of the file, the watched directory joined with the file name. For
+     * 'Action::kRescan' this is the watched directory **/
+    Path path;
+    /** What happened to the file **/
+    Action action;
+  };
+
+private:
+  /** Watched directory, defined per platform **/
+  struct Directory;
+
+  /** Change that has not been delivered yet **/
+  struct Pending
+  {
+    /** Coalesced action **/
+    Action action;
+    /** Time of the latest notification **/
+    Time time;
+  };
+
+  /** Debounce time **/
+  Time mDebounce;
+#if defined(OL_PLATFORM_LINUX)
+  /** Inotify instance **/
+  s32 mHandle = -1;
+#endif
+  /** Watched directories **/
+  std::vector<std::unique_ptr<Directory>> mDirectories;
+  /** Changes that have not been delivered, by path **/
+  std::unordered_map<String, Pending> mPending;
+
+public:
+  /** Create a file watcher.
+   * \brief Create watcher.
+   * \param debounce Time that a file must be unchanged before an event is
+   * delivered for it.
+   */
+  explicit FileWatcher(Time debounce = Time{ kDefaultDebounce });
+
+  /** Destruct watcher, which stops watching all directories.
+   * \brief Destruct watcher.
+   */
+  ~FileWatcher();
+
+  /** Start watching a directory. Watching a directory that is already watched
+   * does nothing.
+   * \brief Watch directory.
+   * \param directory Path to the directory.
+   * \return Result.
+   */
+  FileResult Watch(const Path& directory);
+
+  /** Stop watching a directory. Changes in it that has not been delivered are
+   * dropped.
+   * \brief Stop watching directory.
+   * \param directory Path to the directory, as it was passed when watching.
+   * \return Result.
+   * - FileResult::kNotFound: The directory is not watched.
+   */
+  FileResult Unwatch(const Path& directory);
+
+  /** Collect notifications and append the events of files that has not
+   * changed for the debounce time. Events are appended even if an error is
+   * returned.
+   * \brief Poll for events.
+   * \param events List to append the events to.
+   * \return Result. If a directory could not be read anymore, for example
+   * because it was deleted or moved, then it is no longer watched and the error
+   * of the first such directory is returned. A 'FileWatcher::Action::kRescan'
+   * event is delivered for it.
+   */
+  FileResult Poll(std::vector<Event>& events);
+
+  /** Returns whether a directory is watched.
+   * \brief Returns whether directory is watched.
+   * \param directory Path to the directory.
+   * \return True if the directory is watched otherwise false.
+   */
+  OL_NODISCARD bool IsWatching(const Path& directory) const;
+
+private:
+  /** Read the notifications of the platform and record them as pending **/
+  FileResult Collect();
+
+  /** Record a notification for a file **/
+  void Record(const Path& directory, const String& name, Action action);
+
+  /** Record that the notifications for a directory was lost **/
+  void RecordRescan(const Path& directory);
+};
+
+}
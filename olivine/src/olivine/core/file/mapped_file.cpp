@@ -0,0 +1,325 @@
+// MIT License
+//
+// Copyright (c) 2019 Filip Björklund
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "olivine/core/file/mapped_file.hpp"
+
+// ========================================================================== //
+// Headers
+// ========================================================================== //
+
+// Standard headers
+#include <algorithm>
+
+// Project headers
+#include "olivine/core/file/access_trace.hpp"
+
+// ========================================================================== //
+// MappedFile Implementation
+// ========================================================================== //
+
+namespace olivine {
+
+MappedFile::MappedFile(Path path)
+  : mPath(std::move(path))
+{}
+
+// -------------------------------------------------------------------------- //
+
+MappedFile::~MappedFile()
+{
+  if (mIsOpen) {
+    Close();
+  }
+}
+
+// -------------------------------------------------------------------------- //
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+  : mPath(std::move(other.mPath))
+  , mData(other.mData)
+  , mSize(other.mSize)
+  , mIsOpen(other.mIsOpen)
+{
+  other.mData = nullptr;
+  other.mSize = 0;
+  other.mIsOpen = false;
+}
+
+// -------------------------------------------------------------------------- //
+
+MappedFile&
+MappedFile::operator=(MappedFile&& other) noexcept
+{
+  if (this != &other) {
+    if (mIsOpen) {
+      Close();
+    }
+    mPath = std::move(other.mPath);
+    mData = other.mData;
+    mSize = other.mSize;
+    mIsOpen = other.mIsOpen;
+    other.mData = nullptr;
+    other.mSize = 0;
+    other.mIsOpen = false;
+  }
+  return *this;
+}
+
+}
+
+// ========================================================================== //
+// MappedFile Implementation (Windows)
+// ========================================================================== //
+
+#if defined(OL_PLATFORM_WINDOWS)
+
+namespace olivine {
+
+FileResult
+MappedFile::Open()
+{
+  // Check that file is not already open
+  if (mIsOpen) {
+    return FileResult::kAlreadyOpen;
+  }
+
+  // Open file
+  char16* wpath = mPath.GetPathString().GetUTF16();
+  HANDLE file = CreateFileW(wpath,
+                            GENERIC_READ,
+                            FILE_SHARE_READ,
+                            nullptr,
+                            OPEN_EXISTING,
+                            FILE_ATTRIBUTE_NORMAL,
+                            nullptr);
+  delete[] wpath;
+  if (file == INVALID_HANDLE_VALUE) {
+    return FileResultFromLastError();
+  }
+
+  // Query size
+  LARGE_INTEGER fileSize;
+  if (!GetFileSizeEx(file, &fileSize)) {
+    const FileResult result = FileResultFromLastError();
+    CloseHandle(file);
+    return result;
+  }
+  mSize = static_cast<u64>(fileSize.QuadPart);
+
+  // Empty files can't be mapped
+  if (mSize == 0) {
+    CloseHandle(file);
+    mData = nullptr;
+    mIsOpen = true;
+    return FileResult::kSuccess;
+  }
+
+  // Map file. The view keeps the file alive, so the handles can be closed
+  HANDLE mapping =
+    CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  if (!mapping) {
+    const FileResult result = FileResultFromLastError();
+    CloseHandle(file);
+    return result;
+  }
+  void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+  const FileResult result =
+    view ? FileResult::kSuccess : FileResultFromLastError();
+  CloseHandle(mapping);
+  CloseHandle(file);
+  if (result != FileResult::kSuccess) {
+    mSize = 0;
+    return result;
+  }
+
+  // Finalize
+  mData = static_cast<const u8*>(view);
+  mIsOpen = true;
+  return FileResult::kSuccess;
+}
+
+// -------------------------------------------------------------------------- //
+
+FileResult
+MappedFile::Close()
+{
+  // Check that file is open
+  if (!mIsOpen) {
+    return FileResult::kNotOpen;
+  }
+
+  // Unmap view
+  if (mData) {
+    UnmapViewOfFile(mData);
+  }
+
+  // Finalize
+  mData = nullptr;
+  mSize = 0;
+  mIsOpen = false;
+  return FileResult::kSuccess;
+}
+
+// -------------------------------------------------------------------------- //
+
+void
+MappedFile::Advise(Hint hints, u64 offset, u64 size) const
+{
+  if (!mData || offset >= mSize) {
+    return;
+  }
+  size = std::min(size, mSize - offset);
+
+  // Ranges that will be needed soon are the ones that will be read
+  if (bool(hints & Hint::kWillNeed)) {
+    AccessTrace::Record(mPath, offset, size);
+  }
+
+  // Only prefetching is supported on Windows, the access pattern of a view
+  // can't be changed after it has been mapped
+  if (bool(hints & Hint::kWillNeed)) {
+    WIN32_MEMORY_RANGE_ENTRY range;
+    range.VirtualAddress = const_cast<u8*>(mData + offset);
+    range.NumberOfBytes = static_cast<SIZE_T>(size);
+    PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+  }
+}
+
+}
+
+#else
+
+// ========================================================================== //
+// MappedFile Implementation (POSIX)
+// ========================================================================== //
+
+namespace olivine {
+
+FileResult
+MappedFile::Open()
+{
+  // Check that file is not already open
+  if (mIsOpen) {
+    return FileResult::kAlreadyOpen;
+  }
+
+  // Open file
+  const char8* path = mPath.GetPathString().GetUTF8();
+  int file;
+  do {
+    file = open(path, O_RDONLY | O_CLOEXEC);
+  } while (file == -1 && errno == EINTR);
+  if (file == -1) {
+    return FileResultFromLastError();
+  }
+
+  // Query size
+  struct stat info;
+  if (fstat(file, &info) != 0) {
+    const FileResult result = FileResultFromLastError();
+    close(file);
+    return result;
+  }
+  mSize = static_cast<u64>(info.st_size);
+
+  // Empty files can't be mapped
+  if (mSize == 0) {
+    close(file);
+    mData = nullptr;
+    mIsOpen = true;
+    return FileResult::kSuccess;
+  }
+
+  // Map file. The mapping keeps the file alive, so the descriptor can be closed
+  void* view = mmap(nullptr, mSize, PROT_READ, MAP_PRIVATE, file, 0);
+  const FileResult result =
+    view != MAP_FAILED ? FileResult::kSuccess : FileResultFromLastError();
+  close(file);
+  if (result != FileResult::kSuccess) {
+    mSize = 0;
+    return result;
+  }
+
+  // Finalize
+  mData = static_cast<const u8*>(view);
+  mIsOpen = true;
+  return FileResult::kSuccess;
+}
+
+// -------------------------------------------------------------------------- //
+
+FileResult
+MappedFile::Close()
+{
+  // Check that file is open
+  if (!mIsOpen) {
+    return FileResult::kNotOpen;
+  }
+
+  // Unmap data
+  if (mData) {
+    munmap(const_cast<u8*>(mData), mSize);
+  }
+
+  // Finalize
+  mData = nullptr;
+  mSize = 0;
+  mIsOpen = false;
+  return FileResult::kSuccess;
+}
+
+// -------------------------------------------------------------------------- //
+
+void
+MappedFile::Advise(Hint hints, u64 offset, u64 size) const
+{
+  if (!mData || offset >= mSize) {
+    return;
+  }
+  size = std::min(size, mSize - offset);
+
+  // Ranges that will be needed soon are the ones that will be read
+  if (bool(hints & Hint::kWillNeed)) {
+    AccessTrace::Record(mPath, offset, size);
+  }
+
+  // The start of the range must be aligned to a page boundary
+  static const u64 kPageSize = static_cast<u64>(sysconf(_SC_PAGESIZE));
+  const u64 alignedOffset = offset - (offset % kPageSize);
+  size += offset - alignedOffset;
+  u8* address = const_cast<u8*>(mData + alignedOffset);
+
+  // Apply hints
+  if (bool(hints & Hint::kSequential)) {
+    madvise(address, size, MADV_SEQUENTIAL);
+  }
+  if (bool(hints & Hint::kRandom)) {
+    madvise(address, size, MADV_RANDOM);
+  }
+  if (bool(hints & Hint::kWillNeed)) {
+    madvise(address, size, MADV_WILLNEED);
+  }
+}
+
+}
+
+#endif
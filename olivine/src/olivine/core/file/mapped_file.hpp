@@ -0,0 +1,160 @@
+// MIT License
+//
+// Copyright (c) 2019 Filip Björklund
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+// ========================================================================== //
+// Headers
+// ========================================================================== //
+
+// Project headers
+#include "olivine/core/common.hpp"
+#include "olivine/core/file/path.hpp"
+#include "olivine/core/file/result.hpp"
+
+// ========================================================================== //
+// MappedFile Declaration
+// ========================================================================== //
+
+namespace olivine {
+
+/** \class MappedFile
+ * \author Filip Björklund
+ * \date 18 october 2026 - 16:10
+ * \brief Read-only memory-mapped file.
+ * \details
+ * Maps the entire contents of a file read-only into the address space of the
+ * process. The pages are loaded on demand by the operating system when they are
+ * first accessed, which means that the data is never copied into an
+ * intermediate buffer. 'MappedFile::Advise' can be used to tell the operating
+ * system how the data will be accessed so that it can read ahead.
+ *
+ * The data stays valid until the file is closed or the object is destroyed.
+ *
+ * \code
+ * MappedFile file(path);
+ * if (file.Open() == FileResult::kSuccess) {
+ *   file.Advise(MappedFile::Hint::kSequential | MappedFile::Hint::kWillNeed);
+ *   Parse(file.GetData(), file.GetSize());
+ * }
+ * \endcode
+ */
+class MappedFile
+{
+  OL_NO_COPY(MappedFile);
+
+public:
+  /** Hints about how the mapped data will be accessed **/
+  enum class Hint : u8
+  {
+    /** No particular access pattern **/
+    kNormal = 0,
+    /** Data will be accessed sequentially from lower to higher addresses **/
+    kSequential = Bit(0),
+    /** Data will be accessed in random order **/
+    kRandom = Bit(1),
+    /** Data will be accessed soon and should be read ahead **/
+    kWillNeed = Bit(2)
+  };
+  OL_ENUM_CLASS_OPERATORS(friend, Hint, u8);
+
+private:
+  /** Path to file **/
+  Path mPath;
+  /** Mapped data **/
+  const u8* mData = nullptr;
+  /** Size of the mapped data in bytes **/
+  u64 mSize = 0;
+  /** Whether file is open **/
+  bool mIsOpen = false;
+
+public:
+  /** Create a mapped file for the file at the specified path. This does not map
+   * the file, call 'MappedFile::Open' to map it.
+   * \brief Create mapped file.
+   * \param path Path to file.
+   */
+  explicit MappedFile(Path path);
+
+  /** Destruct the mapped file. The file is unmapped if it's still open.
+   * \brief Destruct mapped file.
+   */
+  ~MappedFile();
+
+  /** Move-construct a mapped file **/
+  MappedFile(MappedFile&& other) noexcept;
+
+  /** Move-assign a mapped file **/
+  MappedFile& operator=(MappedFile&& other) noexcept;
+
+  /** Map the entire file read-only into memory. An empty file is opened
+   * successfully but has no data.
+   * \brief Open and map file.
+   * \return Result.
+   * - FileResult::kSuccess: Successfully mapped file.
+   */
+  FileResult Open();
+
+  /** Unmap the file. The data that was returned from 'MappedFile::GetData' may
+   * not be accessed after this call.
+   * \brief Close file.
+   * \return Result.
+   */
+  FileResult Close();
+
+  /** Give the operating system a hint about how a range of the mapped data
+   * will be accessed. This does not affect the correctness of any accesses and
+   * the hints that are not supported on a platform are ignored.
+   * \brief Advise about access pattern.
+   * \param hints Access hints.
+   * \param offset Offset of the range in bytes.
+   * \param size Size of the range in bytes. The range is clamped to the size of
+   * the file.
+   */
+  void Advise(Hint hints, u64 offset = 0, u64 size = ~0ull) const;
+
+  /** Returns whether or not the file is currently mapped.
+   * \brief Returns whether file is open.
+   * \return True if the file is open otherwise false.
+   */
+  OL_NODISCARD bool IsOpen() const { return mIsOpen; }
+
+  /** Returns the mapped data of the file.
+   * \brief Returns data.
+   * \return Data, or nullptr if the file is not open or is empty.
+   */
+  OL_NODISCARD const u8* GetData() const { return mData; }
+
+  /** Returns the size of the mapped data.
+   * \brief Returns size.
+   * \return Size in bytes.
+   */
+  OL_NODISCARD u64 GetSize() const { return mSize; }
+
+  /** Returns the path to the file.
+   * \brief Returns path.
+   * \return Path.
+   */
+  OL_NODISCARD const Path& GetPath() const { return mPath; }
+};
+
+}
@@ -0,0 +1,203 @@
+// MIT License
+//
+// Copyright (c) 2019 Filip Björklund
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "olivine/core/file/metadata_cache.hpp"
+
+// ========================================================================== //
+// Headers
+// ========================================================================== //
+
+// Standard headers
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
+// ========================================================================== //
+// Variables
+// ========================================================================== //
+
+namespace olivine {
+
+/** Cache entry **/
+struct MetadataEntry
+{
+  /** Path of the entry. The key of the entry map is a view of this **/
+  std::unique_ptr<String> path;
+  /** Metadata **/
+  FileSystem::Metadata metadata;
+  /** Result of querying the metadata **/
+  FileResult result;
+  /** Whether the metadata is valid. Invalidated entries are kept so that the
+   * path does not have to be interned again **/
+  bool valid;
+};
+
+// -------------------------------------------------------------------------- //
+
+/** Whether the cache is enabled **/
+static std::atomic<bool> sEnabled{ false };
+/** Mutex for the entries **/
+static std::shared_mutex sMutex;
+/** Cache entries, keyed by views of the interned paths **/
+static std::unordered_map<StringView, MetadataEntry> sEntries;
+/** Number of invalidations. This lets a query that was made without holding
+ * the mutex detect that it raced with an invalidation **/
+static u64 sGeneration = 0;
+
+// -------------------------------------------------------------------------- //
+
+/** Store metadata for a path, interning the path if it's not in the cache.
+ * The mutex must be held exclusively **/
+static void
+Store(const Path& path,
+      const FileSystem::Metadata& metadata,
+      FileResult result)
+{
+  const StringView key = path.GetPathString().GetView();
+  const auto entry = sEntries.find(key);
+  if (entry != sEntries.end()) {
+    entry->second.metadata = metadata;
+    entry->second.result = result;
+    entry->second.valid = true;
+    return;
+  }
+  std::unique_ptr<String> interned = std::make_unique<String>(key);
+  const StringView view = interned->GetView();
+  sEntries.emplace(
+    view, MetadataEntry{ std::move(interned), metadata, result, true });
+}
+
+}
+
+// ========================================================================== //
+// MetadataCache Implementation
+// ========================================================================== //
+
+namespace olivine {
+
+void
+MetadataCache::SetEnabled(bool enabled)
+{
+  std::unique_lock<std::shared_mutex> lock(sMutex);
+  sEnabled.store(enabled, std::memory_order_relaxed);
+  sGeneration++;
+  if (!enabled) {
+    sEntries.clear();
+  }
+}
+
+// -------------------------------------------------------------------------- //
+
+bool
+MetadataCache::IsEnabled()
+{
+  return sEnabled.load(std::memory_order_relaxed);
+}
+
+// -------------------------------------------------------------------------- //
+
+FileResult
+MetadataCache::Get(const Path& path, FileSystem::Metadata& metadata)
+{
+  // Look up a valid entry
+  u64 generation;
+  {
+    std::shared_lock<std::shared_mutex> lock(sMutex);
+    const auto entry = sEntries.find(path.GetPathString().GetView());
+    if (entry != sEntries.end() && entry->second.valid) {
+      metadata = entry->second.metadata;
+      return entry->second.result;
+    }
+    generation = sGeneration;
+  }
+
+  // Query without holding the lock, then store the result. If anything was
+  // invalidated in the meantime then the result might already be stale, and
+  // is not stored
+  const FileResult result = FileSystem::QueryMetadata(path, metadata);
+  if (result == FileResult::kSuccess || result == FileResult::kNotFound) {
+    std::unique_lock<std::shared_mutex> lock(sMutex);
+    if (sEnabled.load(std::memory_order_relaxed) &&
+        sGeneration == generation) {
+      Store(path, metadata, result);
+    }
+  }
+  return result;
+}
+
+// -------------------------------------------------------------------------- //
+
+void
+MetadataCache::Update(const Path& path, const FileSystem::Metadata& metadata)
+{
+  if (!IsEnabled()) {
+    return;
+  }
+
+  // Only take the exclusive lock if the metadata has changed
+  {
+    std::shared_lock<std::shared_mutex> lock(sMutex);
+    const auto entry = sEntries.find(path.GetPathString().GetView());
+    if (entry != sEntries.end() && entry->second.valid &&
+        entry->second.result == FileResult::kSuccess &&
+        entry->second.metadata.modified == metadata.modified &&
+        entry->second.metadata.size == metadata.size) {
+      return;
+    }
+  }
+  std::unique_lock<std::shared_mutex> lock(sMutex);
+  if (sEnabled.load(std::memory_order_relaxed)) {
+    Store(path, metadata, FileResult::kSuccess);
+  }
+}
+
+// -------------------------------------------------------------------------- //
+
+void
+MetadataCache::Invalidate(const Path& path)
+{
+  if (!IsEnabled()) {
+    return;
+  }
+  std::unique_lock<std::shared_mutex> lock(sMutex);
+  sGeneration++;
+  const auto entry = sEntries.find(path.GetPathString().GetView());
+  if (entry != sEntries.end()) {
+    entry->second.valid = false;
+  }
+}
+
+// -------------------------------------------------------------------------- //
+
+void
+MetadataCache::InvalidateAll()
+{
+  std::unique_lock<std::shared_mutex> lock(sMutex);
+  sGeneration++;
+  for (auto& entry : sEntries) {
+    entry.second.valid = false;
+  }
+}
+
+}
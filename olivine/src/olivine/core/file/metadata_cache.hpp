@@ -0,0 +1,116 @@
+// MIT License
+//
+// Copyright (c) 2019 Filip Björklund
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+// ========================================================================== //
+// Headers
+// ========================================================================== //
+
+// Project headers
+#include "olivine/core/common.hpp"
+#include "olivine/core/macros.hpp"
+#include "olivine/core/file/file_system.hpp"
+#include "olivine/core/file/path.hpp"
+#include "olivine/core/file/result.hpp"
+
+// ========================================================================== //
+// MetadataCache Declaration
+// ========================================================================== //
+
+namespace olivine {
+
+/** \class MetadataCache
+ * \author Filip Björklund
+ * \date 18 october 2026 - 22:45
+ * \brief Process-wide cache of file metadata.
+ * \details
+ * Caches the metadata of file system objects, keyed by path, so that repeated
+ * queries like 'FileSystem::Exists', 'FileSystem::GetType' and
+ * 'FileSystem::GetSize' for the same path does not each go to the file system.
+ * Objects that does not exist are cached as well. The paths are interned in
+ * the cache, which means that a lookup of a path that has been seen before
+ * does not allocate.
+ *
+ * The cache is disabled by default, and is enabled by the 'Loader' while it
+ * watches the resource files. When enabled, 'FileSystem::GetMetadata' and
+ * the functions that are built on it use the cache. Entries are invalidated
+ * when 'FileSystem::Create' or 'FileSystem::Delete' changes their paths, when a
+ * 'FileIO' creates, truncates or writes to their files and when a 'FileWatcher'
+ * reports changes to their paths. They are updated when the metadata of an open
+ * 'FileIO' is queried and the modification time or size differs. Only
+ * successful queries and objects that does not exist are cached, other errors
+ * are queried again. Paths are not canonicalized, different spellings of the
+ * same path are cached separately.
+ *
+ * The cache is thread-safe.
+ */
+class MetadataCache
+{
+  OL_NAMESPACE_CLASS(MetadataCache);
+
+public:
+  /** Enable or disable the cache. The cache is cleared when it's disabled.
+   * \brief Set whether enabled.
+   * \param enabled True to enable the cache.
+   */
+  static void SetEnabled(bool enabled);
+
+  /** Returns whether the cache is enabled.
+   * \brief Returns whether enabled.
+   * \return True if the cache is enabled otherwise false.
+   */
+  OL_NODISCARD static bool IsEnabled();
+
+  /** Retrieve the metadata of an object. The metadata is queried from the
+   * file system, and added to the cache, if the path has no valid entry.
+   * \brief Retrieve metadata.
+   * \param path Path to object.
+   * \param[out] metadata Metadata of the object.
+   * \return Result.
+   * - FileResult::kNotFound: The object does not exist.
+   */
+  static FileResult Get(const Path& path, FileSystem::Metadata& metadata);
+
+  /** Update the metadata of an object that has been retrieved elsewhere, for
+   * example from an open file handle. This does nothing if the cache is
+   * disabled.
+   * \brief Update metadata.
+   * \param path Path to object.
+   * \param metadata Metadata of the object.
+   */
+  static void Update(const Path& path, const FileSystem::Metadata& metadata);
+
+  /** Invalidate the cached metadata of an object, so that it's queried again
+   * on the next retrieval.
+   * \brief Invalidate entry.
+   * \param path Path to object.
+   */
+  static void Invalidate(const Path& path);
+
+  /** Invalidate the cached metadata of all objects.
+   * \brief Invalidate all entries.
+   */
+  static void InvalidateAll();
+};
+
+}
@@ -0,0 +1,454 @@
+// MIT License
+//
+// Copyright (c) 2019 Filip Björklund
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "olivine/core/file/pack.hpp"
+
+// ========================================================================== //
+// Headers
+// ========================================================================== //
+
+// Standard headers
+#include <algorithm>
+#include <atomic>
+
+// Project headers
+#include "olivine/core/lz.hpp"
+#include "olivine/core/memory.hpp"
+#include "olivine/core/thread_pool.hpp"
+#include "olivine/core/file/file_io.hpp"
+#include "olivine/math/math.hpp"
+
+// ========================================================================== //
+// Block Functions
+// ========================================================================== //
+
+namespace olivine {
+
+/** Returns the number of blocks of a compressed file **/
+static u64
+GetBlockCount(u64 size, u64 blockSize)
+{
+  return (size + blockSize - 1) / blockSize;
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Returns the offset of a block from the block table of a compressed file **/
+static u64
+GetBlockOffset(const u8* data, u64 block)
+{
+  u64 offset;
+  Memory::Copy(&offset, data + block * sizeof(u64), sizeof(u64));
+  return offset;
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Read the part of a block of a compressed file that is inside of the range
+ * [offset, offset + size) of the file. Returns false if the block is corrupt.
+ * The destination is the start of the range **/
+static bool
+ReadBlock(const u8* data,
+          const Pack::Entry& entry,
+          u64 block,
+          u64 offset,
+          u64 size,
+          u8* destination)
+{
+  // Locate the stored block
+  const u64 tableSize =
+    (GetBlockCount(entry.size, entry.blockSize) + 1) * sizeof(u64);
+  const u64 begin = GetBlockOffset(data, block);
+  const u64 end = GetBlockOffset(data, block + 1);
+  if (begin < tableSize || begin > end || end > entry.storedSize) {
+    return false;
+  }
+  const u8* stored = data + begin;
+  const u64 storedSize = end - begin;
+
+  // Part of the block to read
+  const u64 blockStart = block * entry.blockSize;
+  const u64 blockSize = Min<u64>(entry.blockSize, entry.size - blockStart);
+  const u64 from = Max(offset, blockStart);
+  const u64 to = Min(offset + size, blockStart + blockSize);
+  u8* target = destination + (from - offset);
+
+  // Blocks that did not compress are stored as is
+  if (storedSize == blockSize) {
+    Memory::Copy(target, stored + (from - blockStart), to - from);
+    return true;
+  }
+
+  // Decompress whole blocks straight into the destination, and partial blocks
+  // through a temporary buffer
+  if (from == blockStart && to == blockStart + blockSize) {
+    return LZ::Decompress(stored, storedSize, target, blockSize);
+  }
+  u8* buffer = static_cast<u8*>(Memory::Allocate(blockSize));
+  const bool decompressed =
+    LZ::Decompress(stored, storedSize, buffer, blockSize);
+  if (decompressed) {
+    Memory::Copy(target, buffer + (from - blockStart), to - from);
+  }
+  Memory::Free(buffer);
+  return decompressed;
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Compress data into blocks that are compressed in parallel. Returns the
+ * block table followed by the blocks **/
+static std::vector<u8>
+CompressBlocks(const u8* data, u64 size, u32 blockSize)
+{
+  // Compress each block into a buffer of its own. Blocks that don't get
+  // smaller are stored as is
+  const u64 blockCount = GetBlockCount(size, blockSize);
+  std::vector<std::vector<u8>> blocks(blockCount);
+  ThreadPool::GetGlobal().ParallelFor(blockCount, [&](u64 index) {
+    const u64 start = index * blockSize;
+    const u64 count = Min<u64>(blockSize, size - start);
+    std::vector<u8>& block = blocks[index];
+    block.resize(count);
+    const u64 compressed =
+      LZ::Compress(data + start, count, block.data(), count - 1);
+    if (compressed > 0) {
+      block.resize(compressed);
+    } else {
+      Memory::Copy(block.data(), data + start, count);
+    }
+  });
+
+  // Write block table and blocks
+  std::vector<u8> stored((blockCount + 1) * sizeof(u64));
+  for (u64 i = 0; i <= blockCount; i++) {
+    const u64 offset = stored.size();
+    Memory::Copy(stored.data() + i * sizeof(u64), &offset, sizeof(u64));
+    if (i < blockCount) {
+      stored.insert(stored.end(), blocks[i].begin(), blocks[i].end());
+    }
+  }
+  return stored;
+}
+
+}
+
+// ========================================================================== //
+// Pack Implementation
+// ========================================================================== //
+
+namespace olivine {
+
+Pack::Pack(Path path)
+  : mFile(std::move(path))
+{}
+
+// -------------------------------------------------------------------------- //
+
+FileResult
+Pack::Open()
+{
+  // Map file
+  const FileResult result = mFile.Open();
+  if (result != FileResult::kSuccess) {
+    return result;
+  }
+  const u8* data = mFile.GetData();
+  const u64 size = mFile.GetSize();
+
+  // Validate header
+  if (size < sizeof(Header)) {
+    mFile.Close();
+    return FileResult::kInvalidArgument;
+  }
+  const Header* header = reinterpret_cast<const Header*>(data);
+  const u64 tableSize = u64(header->entryCount) * sizeof(Entry);
+  if (header->magic != kMagic || header->version != kVersion ||
+      header->tableOffset % alignof(Entry) != 0 ||
+      header->tableOffset > size || tableSize > size - header->tableOffset ||
+      header->namesOffset > size ||
+      header->namesSize > size - header->namesOffset) {
+    mFile.Close();
+    return FileResult::kInvalidArgument;
+  }
+  mEntries = reinterpret_cast<const Entry*>(data + header->tableOffset);
+  mEntryCount = header->entryCount;
+  mNames = reinterpret_cast<const char8*>(data + header->namesOffset);
+
+  // Validate entries, so that lookups don't have to
+  for (u32 i = 0; i < mEntryCount; i++) {
+    const Entry& entry = mEntries[i];
+    if (entry.offset > size || entry.storedSize > size - entry.offset ||
+        u64(entry.nameOffset) + entry.nameSize > header->namesSize ||
+        (i > 0 && mEntries[i - 1].hash > entry.hash)) {
+      Close();
+      return FileResult::kInvalidArgument;
+    }
+    if (!IsCompressed(entry) && entry.size != entry.storedSize) {
+      Close();
+      return FileResult::kInvalidArgument;
+    }
+    if (IsCompressed(entry) &&
+        (entry.blockSize < kMinBlockSize || entry.blockSize > kMaxBlockSize ||
+         (GetBlockCount(entry.size, entry.blockSize) + 1) * sizeof(u64) >
+           entry.storedSize)) {
+      Close();
+      return FileResult::kInvalidArgument;
+    }
+  }
+
+  return FileResult::kSuccess;
+}
+
+// -------------------------------------------------------------------------- //
+
+FileResult
+Pack::Close()
+{
+  mEntries = nullptr;
+  mEntryCount = 0;
+  mNames = nullptr;
+  return mFile.Close();
+}
+
+// -------------------------------------------------------------------------- //
+
+const Pack::Entry*
+Pack::Find(StringView name) const
+{
+  // Find first entry with the hash. Entries with colliding hashes are next to
+  // each other and are told apart by name
+  const u64 hash = Hash(name);
+  const Entry* end = mEntries + mEntryCount;
+  const Entry* entry = std::lower_bound(
+    mEntries, end, hash, [](const Entry& e, u64 h) { return e.hash < h; });
+  for (; entry != end && entry->hash == hash; entry++) {
+    if (GetName(*entry) == name) {
+      return entry;
+    }
+  }
+  return nullptr;
+}
+
+// -------------------------------------------------------------------------- //
+
+StringView
+Pack::GetName(const Entry& entry) const
+{
+  return StringView(mNames + entry.nameOffset, entry.nameSize);
+}
+
+// -------------------------------------------------------------------------- //
+
+const u8*
+Pack::GetData(const Entry& entry) const
+{
+  return mFile.GetData() + entry.offset;
+}
+
+// -------------------------------------------------------------------------- //
+
+void
+Pack::Prefetch(const Entry& entry) const
+{
+  mFile.Advise(MappedFile::Hint::kWillNeed, entry.offset, entry.storedSize);
+}
+
+// -------------------------------------------------------------------------- //
+
+FileResult
+Pack::Read(const Entry& entry, u64 offset, u64 size, u8* destination) const
+{
+  if (offset > entry.size || size > entry.size - offset) {
+    return FileResult::kEOF;
+  }
+  if (size == 0) {
+    return FileResult::kSuccess;
+  }
+  const u8* data = GetData(entry);
+  if (!IsCompressed(entry)) {
+    Memory::Copy(destination, data + offset, size);
+    return FileResult::kSuccess;
+  }
+
+  // Decompress the blocks that overlap the range in parallel
+  const u64 first = offset / entry.blockSize;
+  const u64 last = (offset + size - 1) / entry.blockSize;
+  std::atomic<bool> corrupt{ false };
+  ThreadPool::GetGlobal().ParallelFor(last - first + 1, [&](u64 index) {
+    if (!ReadBlock(data, entry, first + index, offset, size, destination)) {
+      corrupt.store(true, std::memory_order_relaxed);
+    }
+  });
+  return corrupt ? FileResult::kInvalidArgument : FileResult::kSuccess;
+}
+
+// -------------------------------------------------------------------------- //
+
+u64
+Pack::Hash(StringView name)
+{
+  u64 hash = 14695981039346656037ull;
+  for (StringView::SizeType i = 0; i < name.GetSize(); i++) {
+    hash ^= u8(name.GetData()[i]);
+    hash *= 1099511628211ull;
+  }
+  return hash;
+}
+
+}
+
+// ========================================================================== //
+// PackBuilder Implementation
+// ========================================================================== //
+
+namespace olivine {
+
+PackBuilder::PackBuilder(u32 alignment, u32 blockSize)
+  : mAlignment(std::max(alignment, 1u))
+  , mBlockSize(Clamp(blockSize, Pack::kMinBlockSize, Pack::kMaxBlockSize))
+{}
+
+// -------------------------------------------------------------------------- //
+
+void
+PackBuilder::Add(String name, Path source, Pack::Flag flags)
+{
+  mItems.push_back(Item{ std::move(name), std::move(source), flags });
+}
+
+// -------------------------------------------------------------------------- //
+
+FileResult
+PackBuilder::Write(const Path& path) const
+{
+  // Build entries without data, and reject duplicate names
+  std::vector<Pack::Entry> entries(mItems.size());
+  std::vector<char8> names;
+  for (u64 i = 0; i < mItems.size(); i++) {
+    const StringView name = mItems[i].name.GetView();
+    Pack::Entry& entry = entries[i];
+    entry = Pack::Entry{};
+    entry.hash = Pack::Hash(name);
+    entry.nameOffset = u32(names.size());
+    entry.nameSize = name.GetSize();
+    names.insert(names.end(), name.GetData(), name.GetData() + name.GetSize());
+  }
+  std::vector<u32> order(entries.size());
+  for (u32 i = 0; i < order.size(); i++) {
+    order[i] = i;
+  }
+  std::sort(order.begin(), order.end(), [&](u32 a, u32 b) {
+    return entries[a].hash != entries[b].hash
+             ? entries[a].hash < entries[b].hash
+             : mItems[a].name.GetView().GetStd() <
+                 mItems[b].name.GetView().GetStd();
+  });
+  for (u64 i = 1; i < order.size(); i++) {
+    if (mItems[order[i - 1]].name == mItems[order[i]].name) {
+      return FileResult::kAlreadyExists;
+    }
+  }
+
+  // Open pack file
+  FileIO io(path);
+  FileResult result = io.Open(FileIO::Flag::kWrite | FileIO::Flag::kCreate |
+                              FileIO::Flag::kOverwrite);
+  if (result != FileResult::kSuccess) {
+    return result;
+  }
+
+  // Write data in the order that the files were added
+  u64 offset = AlignUp(sizeof(Pack::Header), mAlignment);
+  for (u64 i = 0; i < mItems.size(); i++) {
+    MappedFile source(mItems[i].source);
+    result = source.Open();
+    if (result != FileResult::kSuccess) {
+      return result;
+    }
+    source.Advise(MappedFile::Hint::kSequential);
+
+    Pack::Entry& entry = entries[i];
+    entry.offset = offset;
+    entry.size = source.GetSize();
+    entry.storedSize = source.GetSize();
+    const u8* data = source.GetData();
+
+    // Compress file if requested and if it gets smaller
+    std::vector<u8> compressed;
+    if (bool(mItems[i].flags & Pack::Flag::kCompressed) && entry.size > 0) {
+      compressed = CompressBlocks(data, entry.size, mBlockSize);
+      if (compressed.size() < entry.size) {
+        entry.flags = Pack::Flag::kCompressed;
+        entry.blockSize = mBlockSize;
+        entry.storedSize = compressed.size();
+        data = compressed.data();
+      }
+    }
+
+    if (entry.storedSize > 0) {
+      result = io.WriteAt(offset, data, entry.storedSize);
+      if (result != FileResult::kSuccess) {
+        return result;
+      }
+    }
+    offset = AlignUp(offset + entry.storedSize, mAlignment);
+  }
+
+  // Write table of contents, sorted by hash
+  std::vector<Pack::Entry> table(entries.size());
+  for (u64 i = 0; i < order.size(); i++) {
+    table[i] = entries[order[i]];
+  }
+  Pack::Header header{};
+  header.magic = Pack::kMagic;
+  header.version = Pack::kVersion;
+  header.entryCount = u32(table.size());
+  header.alignment = mAlignment;
+  header.tableOffset = AlignUp(offset, Pack::kTableAlignment);
+  header.namesOffset = header.tableOffset + table.size() * sizeof(Pack::Entry);
+  header.namesSize = names.size();
+  result = io.WriteAt(header.tableOffset,
+                      reinterpret_cast<const u8*>(table.data()),
+                      table.size() * sizeof(Pack::Entry));
+  if (result != FileResult::kSuccess) {
+    return result;
+  }
+
+  // Write names
+  result = io.WriteAt(header.namesOffset,
+                      reinterpret_cast<const u8*>(names.data()),
+                      names.size());
+  if (result != FileResult::kSuccess) {
+    return result;
+  }
+
+  // Write header last, so that a pack that failed to be written is invalid
+  result = io.WriteAt(
+    0, reinterpret_cast<const u8*>(&header), sizeof(Pack::Header));
+  if (result != FileResult::kSuccess) {
+    return result;
+  }
+  return io.Close();
+}
+
+}
@@ -0,0 +1,342 @@
+// MIT License
+//
+// Copyright (c) 2019 Filip Björklund
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+// ========================================================================== //
+// Headers
+// ========================================================================== //
+
+// Standard headers
+#include <vector>
+
+// Project headers
+#include "olivine/core/common.hpp"
+#include "olivine/core/macros.hpp"
+#include "olivine/core/string.hpp"
+#include "olivine/core/file/mapped_file.hpp"
+#include "olivine/core/file/path.hpp"
+#include "olivine/core/file/result.hpp"
+
+// ========================================================================== //
+// Pack Declaration
+// ========================================================================== //
+
+namespace olivine {
+
+/** \class Pack
+ * \author Filip Björklund
+ * \date 18 october 2026 - 18:20
+ * \brief Packed asset archive.
+ * \details
+ * A pack is a single file that holds the contents of many files. It is read by
+ * mapping it into memory, which means that looking up and reading a file in
+ * the pack does not require any system calls.
+ *
+ * The layout of a pack is:
+ * - 'Header', at offset 0.
+ * - The data of each file, aligned to 'Header::alignment', in the order the
+ *   files were added to the pack. Files that are loaded together should be
+ *   added together so that they are read sequentially.
+ * - The table of contents, an array of 'Entry' that is sorted by the hash of
+ *   the names. It's aligned to 'kTableAlignment'.
+ * - The names of the files, UTF-8 without null-terminators.
+ *
+ * The name of a file in the pack is its path relative to the root of the pack,
+ * with '/' as separator. All values are stored little-endian.
+ *
+ * Files can be stored compressed with 'LZ', in blocks of 'Entry::blockSize'
+ * bytes that are compressed separately. The data of a compressed file starts
+ * with a table of 'block count + 1' u64 offsets, relative to the start of the
+ * data, where block i is stored between offset i and i + 1. Blocks that did
+ * not compress are stored as is. The blocks are decompressed in parallel on
+ * the global thread pool by 'Pack::Read'. Loading is usually limited by the
+ * disk, so reading less data is faster even though it has to be decompressed.
+ *
+ * Packs are created with 'PackBuilder', or with the 'packer' tool.
+ */
+class Pack
+{
+  OL_NO_COPY(Pack);
+
+public:
+  /** Magic number at the start of every pack ("OLPK") **/
+  static constexpr u32 kMagic = 0x4B504C4Fu;
+  /** Version of the format **/
+  static constexpr u16 kVersion = 1;
+  /** Default alignment of the file data **/
+  static constexpr u32 kDefaultAlignment = 64;
+  /** Alignment of the table of contents **/
+  static constexpr u32 kTableAlignment = 64;
+  /** Minimum size of the blocks of compressed files **/
+  static constexpr u32 kMinBlockSize = 64 * 1024;
+  /** Maximum size of the blocks of compressed files **/
+  static constexpr u32 kMaxBlockSize = 256 * 1024;
+  /** Default size of the blocks of compressed files **/
+  static constexpr u32 kDefaultBlockSize = 128 * 1024;
+
+  /** Entry flags **/
+  enum class Flag : u32
+  {
+    /** No flags **/
+    kNone = 0,
+    /** The file is compressed **/
+    kCompressed = Bit(0)
+  };
+  OL_ENUM_CLASS_OPERATORS(friend, Flag, u32);
+
+  /** Pack header **/
+  struct Header
+  {
+    /** Magic number, 'kMagic' **/
+    u32 magic;
+    /** Format version, 'kVersion' **/
+    u16 version;
+    /** Reserved, must be 0 **/
+    u16 reserved0;
+    /** Number of entries in the table of contents **/
+    u32 entryCount;
+    /** Alignment of the file data **/
+    u32 alignment;
+    /** Offset of the table of contents **/
+    u64 tableOffset;
+    /** Offset of the names **/
+    u64 namesOffset;
+    /** Size of the names in bytes **/
+    u64 namesSize;
+    /** Reserved, must be 0 **/
+    u64 reserved1[3];
+  };
+
+  /** Entry in the table of contents **/
+  struct Entry
+  {
+    /** Hash of the name, see 'Pack::Hash' **/
+    u64 hash;
+    /** Offset of the data in the pack **/
+    u64 offset;
+    /** Size of the file **/
+    u64 size;
+    /** Size of the data as it's stored in the pack **/
+    u64 storedSize;
+    /** Offset of the name, relative to the start of the names **/
+    u32 nameOffset;
+    /** Size of the name in bytes **/
+    u32 nameSize;
+    /** Flags **/
+    Flag flags;
+    /** Size of the blocks if the file is compressed, otherwise 0 **/
+    u32 blockSize;
+  };
+
+  static_assert(sizeof(Header) == 64, "Pack header must be 64 bytes");
+  static_assert(sizeof(Entry) == 48, "Pack entry must be 48 bytes");
+
+private:
+  /** Mapped pack file **/
+  MappedFile mFile;
+  /** Table of contents **/
+  const Entry* mEntries = nullptr;
+  /** Number of entries **/
+  u32 mEntryCount = 0;
+  /** Names **/
+  const char8* mNames = nullptr;
+
+public:
+  /** Create a pack for the file at the specified path. Call 'Pack::Open' to
+   * open it.
+   * \brief Create pack.
+   * \param path Path to the pack file.
+   */
+  explicit Pack(Path path);
+
+  /** Map and validate the pack file.
+   * \brief Open pack.
+   * \return Result.
+   * - FileResult::kInvalidArgument: The file is not a valid pack.
+   */
+  FileResult Open();
+
+  /** Close the pack. Data that was returned from the pack may not be accessed
+   * after this call.
+   * \brief Close pack.
+   * \return Result.
+   */
+  FileResult Close();
+
+  /** Find the entry of a file in the pack.
+   * \brief Find entry.
+   * \param name Name of the file, with '/' as separator.
+   * \return Entry, or nullptr if the pack does not contain the file.
+   */
+  OL_NODISCARD const Entry* Find(StringView name) const;
+
+  /** Returns the name of an entry.
+   * \brief Returns name.
+   * \param entry Entry of the pack.
+   * \return Name.
+   */
+  OL_NODISCARD StringView GetName(const Entry& entry) const;
+
+  /** Returns the stored data of an entry. For compressed entries this is the
+   * compressed data, use 'Pack::Read' to read the file.
+   * \brief Returns data.
+   * \param entry Entry of the pack.
+   * \return Data, valid while the pack is open.
+   */
+  OL_NODISCARD const u8* GetData(const Entry& entry) const;
+
+  /** Ask the operating system to read the stored data of an entry ahead, so
+   * that it's in memory when it's accessed.
+   * \brief Prefetch entry.
+   * \param entry Entry of the pack.
+   */
+  void Prefetch(const Entry& entry) const;
+
+  /** Read a range of the file of an entry. Compressed files are decompressed
+   * straight into the destination, except for blocks that are only partially
+   * in the range.
+   * \brief Read file.
+   * \param entry Entry of the pack.
+   * \param offset Offset in the file to read from.
+   * \param size Number of bytes to read.
+   * \param destination Buffer to read into, of at least 'size' bytes.
+   * \return Result.
+   * - FileResult::kEOF: The range is not inside of the file.
+   * - FileResult::kInvalidArgument: The compressed data is corrupt.
+   */
+  FileResult Read(const Entry& entry,
+                  u64 offset,
+                  u64 size,
+                  u8* destination) const;
+
+  /** Returns whether or not an entry is compressed.
+   * \brief Returns whether entry is compressed.
+   * \param entry Entry of the pack.
+   * \return True if the entry is compressed otherwise false.
+   */
+  OL_NODISCARD static bool IsCompressed(const Entry& entry)
+  {
+    return bool(entry.flags & Flag::kCompressed);
+  }
+
+  /** Returns the number of entries in the pack.
+   * \brief Returns entry count.
+   * \return Entry count.
+   */
+  OL_NODISCARD u32 GetEntryCount() const { return mEntryCount; }
+
+  /** Returns the entries of the pack, sorted by hash.
+   * \brief Returns entries.
+   * \return Entries.
+   */
+  OL_NODISCARD const Entry* GetEntries() const { return mEntries; }
+
+  /** Returns the path to the pack file.
+   * \brief Returns path.
+   * \return Path.
+   */
+  OL_NODISCARD const Path& GetPath() const { return mFile.GetPath(); }
+
+  /** Returns the hash of a name in a pack. This is the 64-bit FNV-1a hash of
+   * the UTF-8 bytes of the name.
+   * \brief Hash name.
+   * \param name Name to hash.
+   * \return Hash.
+   */
+  OL_NODISCARD static u64 Hash(StringView name);
+};
+
+}
+
+// ========================================================================== //
+// PackBuilder Declaration
+// ========================================================================== //
+
+namespace olivine {
+
+/** \class PackBuilder
+ * \author Filip Björklund
+ * \date 18 october 2026 - 18:20
+ * \brief Builder for packs.
+ * \details
+ * Collects files and writes them into a pack. The data of the files is laid
+ * out in the order that the files are added.
+ */
+class PackBuilder
+{
+  OL_NO_COPY(PackBuilder);
+
+private:
+  /** File that is added to the pack **/
+  struct Item
+  {
+    /** Name in the pack **/
+    String name;
+    /** Path of the source file **/
+    Path source;
+    /** Flags of the entry **/
+    Pack::Flag flags;
+  };
+
+  /** Alignment of the file data **/
+  u32 mAlignment;
+  /** Size of the blocks of compressed files **/
+  u32 mBlockSize;
+  /** Files to pack **/
+  std::vector<Item> mItems;
+
+public:
+  /** Create a pack builder.
+   * \brief Create builder.
+   * \param alignment Alignment of the file data. Must be a power of two.
+   * \param blockSize Size of the blocks of compressed files. It's clamped to
+   * the range of 'Pack::kMinBlockSize' to 'Pack::kMaxBlockSize'.
+   */
+  explicit PackBuilder(u32 alignment = Pack::kDefaultAlignment,
+                       u32 blockSize = Pack::kDefaultBlockSize);
+
+  /** Add a file to the pack. Files that are added with the compressed flag are
+   * stored uncompressed if compressing them does not make them smaller.
+   * \brief Add file.
+   * \param name Name of the file in the pack, with '/' as separator.
+   * \param source Path of the file to read the data from.
+   * \param flags Flags of the entry.
+   */
+  void Add(String name, Path source, Pack::Flag flags = Pack::Flag::kNone);
+
+  /** Write the pack to a file.
+   * \brief Write pack.
+   * \param path Path of the pack file to write.
+   * \return Result.
+   * - FileResult::kAlreadyExists: Two files were added with the same name.
+   */
+  FileResult Write(const Path& path) const;
+
+  /** Returns the number of files that has been added.
+   * \brief Returns file count.
+   * \return File count.
+   */
+  OL_NODISCARD u32 GetFileCount() const { return u32(mItems.size()); }
+};
+
+}
@@ -31,6 +31,301 @@
 
 // Project headers
 #include "olivine/core/platform/headers.hpp"
+#include "olivine/core/string_builder.hpp"
+#include "olivine/math/limits.hpp"
+
+// ========================================================================== //
+// Functions
+// ========================================================================== //
+
+namespace olivine {
+
+/** Extension string and the extension that it is classified as **/
+struct ExtensionEntry
+{
+  /** Extension string, including the dot **/
+  const char8* string;
+  /** Extension **/
+  Path::Extension extension;
+};
+
+/** Extensions that are recognized **/
+using Extension = Path::Extension;
+static constexpr ExtensionEntry kExtensions[] = {
+  // Data (text, binary, config, ...)
+  { ".tmp", Extension::kTmp },
+  { ".txt", Extension::kTxt },
+  { ".csv", Extension::kCsv },
+  { ".dat", Extension::kDat },
+  { ".json", Extension::kJson },
+  { ".xml", Extension::kXml },
+  { ".yaml", Extension::kYaml },
+  { ".toml", Extension::kToml },
+  { ".md", Extension::kMd },
+  { ".cfg", Extension::kCfg },
+  { ".ini", Extension::kIni },
+  { ".log", Extension::kLog },
+  // Images
+  { ".png", Extension::kPng },
+  { ".tga", Extension::kTga },
+  { ".jpeg", Extension::kJpeg },
+  { ".jpg", Extension::kJpeg },
+  { ".psd", Extension::kPsd },
+  { ".bmp", Extension::kBmp },
+  { ".gif", Extension::kGif },
+  { ".ico", Extension::kIco },
+  { ".svg", Extension::kSvg },
+  { ".tiff", Extension::kTiff },
+  { ".tif", Extension::kTiff },
+  // Audio
+  { ".ogg", Extension::kOgg },
+  { ".wav", Extension::kWav },
+  { ".mp3", Extension::kMp3 },
+  // Models
+  { ".obj", Extension::kObj },
+  { ".gltf", Extension::kGltf },
+  // Video
+  { ".avi", Extension::kAvi },
+  { ".mp4", Extension::kMp4 },
+  // Archives
+  { ".tar", Extension::kTar },
+  { ".zip", Extension::kZip },
+  { ".gz", Extension::kGz },
+  { ".7z", Extension::k7z },
+  // Fonts
+  { ".ttf", Extension::kTtf },
+  { ".otf", Extension::kOtf },
+  // Code
+  { ".c", Extension::kC },
+  { ".h", Extension::kH },
+  { ".cpp", Extension::kCpp },
+  { ".hpp", Extension::kHpp },
+  { ".py", Extension::kPy },
+  { ".js", Extension::kJs },
+  { ".java", Extension::kJava },
+  { ".rs", Extension::kRs },
+  // Shader
+  { ".hlsl", Extension::kHLSL },
+  { ".glsl", Extension::kGLSL },
+  { ".metal", Extension::kMetal },
+  // Executables, libraries, ...
+  { ".exe", Extension::kExe },
+  { ".app", Extension::kApp },
+  { ".apk", Extension::kApk },
+  { ".dll", Extension::kDll },
+  { ".so", Extension::kSo },
+  { ".dynlib", Extension::kDynlib },
+  { ".lib", Extension::kLib },
+  { ".a", Extension::kA },
+};
+
+/** Number of recognized extensions **/
+static constexpr u32 kExtensionCount =
+  u32(sizeof kExtensions / sizeof *kExtensions);
+
+/** Number of slots in the extension hash table. This must be a power of two **/
+static constexpr u32 kExtensionSlotCount = 256;
+
+/** Value of slots that are not used **/
+static constexpr u8 kExtensionSlotEmpty = 0xFF;
+
+/** Maximum size of a recognized extension string in bytes **/
+static constexpr u32 kMaxExtensionSize = 8;
+
+// -------------------------------------------------------------------------- //
+
+/** Returns the size of a null-terminated string at compile time **/
+static constexpr u32
+ConstexprStringSize(const char8* string)
+{
+  u32 size = 0;
+  while (string[size] != 0) {
+    size++;
+  }
+  return size;
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Hash of an extension string. This is FNV-1a that starts from a seed, with a
+ * final mix so that the low bits, which are used as slot index, depend on all
+ * the bytes **/
+static constexpr u32
+HashExtension(const char8* string, u32 size, u32 seed)
+{
+  u32 hash = 2166136261u ^ seed;
+  for (u32 i = 0; i < size; i++) {
+    hash ^= u8(string[i]);
+    hash *= 16777619u;
+  }
+  hash ^= hash >> 15u;
+  hash *= 0x2C1B3C6Du;
+  hash ^= hash >> 12u;
+  return hash;
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Perfect hash table of the recognized extensions. Each slot holds the index
+ * of an entry in 'kExtensions', or 'kExtensionSlotEmpty' **/
+struct ExtensionTable
+{
+  /** Seed of the hash **/
+  u32 seed = 0;
+  /** Slots **/
+  u8 slots[kExtensionSlotCount] = {};
+};
+
+/** Build the extension table by searching for a seed where none of the
+ * extensions hash to the same slot. A seed of 'Limits::kU32Max' is returned if
+ * none is found **/
+static constexpr ExtensionTable
+BuildExtensionTable()
+{
+  ExtensionTable table;
+  for (u32 seed = 0; seed < 4096; seed++) {
+    for (u8& slot : table.slots) {
+      slot = kExtensionSlotEmpty;
+    }
+    bool perfect = true;
+    for (u32 i = 0; i < kExtensionCount && perfect; i++) {
+      const char8* string = kExtensions[i].string;
+      const u32 hash = HashExtension(string, ConstexprStringSize(string), seed);
+      const u32 index = hash & (kExtensionSlotCount - 1);
+      perfect = table.slots[index] == kExtensionSlotEmpty;
+      table.slots[index] = u8(i);
+    }
+    if (perfect) {
+      table.seed = seed;
+      return table;
+    }
+  }
+  table.seed = Limits::kU32Max;
+  return table;
+}
+
+/** Extension table, which is built at compile time **/
+static constexpr ExtensionTable kExtensionTable = BuildExtensionTable();
+static_assert(kExtensionTable.seed != Limits::kU32Max,
+              "No perfect hash found for the extensions, increase the number "
+              "of slots in the table");
+static_assert(kExtensionCount < kExtensionSlotEmpty,
+              "Extension indices must fit in the slots");
+
+// -------------------------------------------------------------------------- //
+
+/** Returns the extension enumeration value from an extension string. This is
+ * a single lookup in the perfect hash table followed by one comparison **/
+static Path::Extension
+ExtensionFromString(StringView extensionString)
+{
+  if (extensionString.IsEmpty()) {
+    return Extension::kNone;
+  }
+  const u32 size = extensionString.GetSize();
+  if (size > kMaxExtensionSize) {
+    return Extension::kUnknown;
+  }
+
+  const u32 index =
+    HashExtension(extensionString.GetData(), size, kExtensionTable.seed) &
+    (kExtensionSlotCount - 1);
+  const u8 slot = kExtensionTable.slots[index];
+  if (slot == kExtensionSlotEmpty ||
+      extensionString != StringView{ kExtensions[slot].string }) {
+    return Extension::kUnknown;
+  }
+  return kExtensions[slot].extension;
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Returns whether a byte is a path separator **/
+static bool
+IsSeparator(char8 byte)
+{
+  return byte == '/' || byte == '\\';
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Join a path string to the end of a path. The result is built in a single
+ * allocation, and the separators of the joined string are made native when the
+ * result is constructed **/
+static Path
+JoinPaths(const Path& path, StringView other)
+{
+  // Remove trailing separator, like the path constructor does
+  const StringView::SizeType otherSize = other.GetSize();
+  if (otherSize > 1 && IsSeparator(other.GetData()[otherSize - 1])) {
+    other = other.Subview(0, otherSize - 1);
+  }
+
+  // Check if a separator should be added. The root directory already ends
+  // with one, in which case a leading separator of the other path is dropped
+  const StringView pathString = path.GetPathString().GetView();
+  const bool otherSeparator =
+    !other.IsEmpty() && IsSeparator(other.GetData()[0]);
+  bool separator = !pathString.IsEmpty() && !otherSeparator;
+  if (!pathString.IsEmpty() &&
+      IsSeparator(pathString.GetData()[pathString.GetSize() - 1])) {
+    separator = false;
+    if (otherSeparator) {
+      other = other.Subview(1);
+    }
+  }
+
+  StringBuilder builder(pathString.GetSize() + u32(separator) +
+                        other.GetSize());
+  builder.Append(pathString);
+  if (separator) {
+    builder.Append(StringView{ Path::SEPARATOR });
+  }
+  builder.Append(other);
+  return Path{ builder.Build() };
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Iterates the components of a path in canonical form. A component that is
+ * followed by '..' is skipped together with the '..', and '.' components are
+ * skipped. This is the form that 'Path::GetCanonical' returns, but without
+ * building the path **/
+class CanonicalComponents
+{
+private:
+  /** Next component **/
+  PathComponents::Iterator mCurrent;
+  /** End of components **/
+  PathComponents::Iterator mEnd;
+
+public:
+  explicit CanonicalComponents(const PathComponents& components)
+    : mCurrent(components.begin())
+    , mEnd(components.end())
+  {}
+
+  /** Retrieve the next canonical component. Returns false at the end **/
+  bool Next(StringView& component)
+  {
+    while (mCurrent != mEnd) {
+      const StringView current = *mCurrent;
+      ++mCurrent;
+      if (current != ".." && mCurrent != mEnd && *mCurrent == "..") {
+        ++mCurrent;
+        continue;
+      }
+      if (current == ".") {
+        continue;
+      }
+      component = current;
+      return true;
+    }
+    return false;
+  }
+};
+
+}
 
 // ========================================================================== //
 // Path Implementation
@@ -41,26 +336,40 @@ namespace olivine {
 Path::Path(String path)
   : mPath(std::move(path))
 {
-  // Replace separators with native ones
-  mPath.Replace("/", "\\");
+  // Replace separators with native ones. This is done in-place
+#if defined(OL_PLATFORM_WINDOWS)
+  mPath.Replace("/", SEPARATOR);
+#else
+  mPath.Replace("\\", SEPARATOR);
+#endif
 
-  // Remove trailing separator
-  if (mPath.EndsWith('\\') || mPath.EndsWith('/')) {
-    mPath = mPath.Substring(0, mPath.GetLength() - 1);
+  // Remove trailing separator, except for the root directory
+  const StringView view = mPath.GetView();
+  if (view.GetSize() > 1 && IsSeparator(view.GetData()[view.GetSize() - 1])) {
+    mPath = String{ view.Subview(0, view.GetSize() - 1) };
   }
+
+  Parse();
 }
 
 // -------------------------------------------------------------------------- //
 
+Path::Path(const char8* path)
+  : Path(String{ path })
+{}
+
+// -------------------------------------------------------------------------- //
+
+Path::Path(PathView path)
+  : Path(String{ path.GetPathString() })
+{}
+
+// -------------------------------------------------------------------------- //
+
 Path&
 Path::Join(const Path& other)
 {
-  // Check if a separator should be added
-  if (!other.mPath.StartsWith('\\') && !other.mPath.StartsWith('/') &&
-      mPath.GetLength() > 0) {
-    mPath += SEPARATOR_CHAR;
-  }
-  mPath += other.mPath;
+  *this = JoinPaths(*this, other.mPath.GetView());
   return *this;
 }
 
@@ -77,9 +386,7 @@ Path::operator+=(const Path& other)
 Path
 Path::Joined(const Path& other) const
 {
-  Path path = *this;
-  path.Join(other);
-  return path;
+  return JoinPaths(*this, other.mPath.GetView());
 }
 
 // -------------------------------------------------------------------------- //
@@ -112,35 +419,17 @@ Path::GetAbsolutePath() const
 Path
 Path::GetCanonical() const
 {
-  // Empty path or single '.' is empty
-  if (mPath.GetLength() == 0 || mPath == ".") {
-    return Path{ "" };
-  }
-
-  // Retrieve components
-  ArrayList<String> components = GetComponents();
-
-  // Build path
-  Path path;
-  const u32 componentCount = u32(components.GetSize());
-  for (u32 i = 0; i < componentCount; ++i) {
-    // Remove any (non '..') component before a '..'
-    if (components[i] != ".." && componentCount > i + 1 &&
-        components[i + 1] == "..") {
-      i++;
-      continue;
+  // Join the canonical components
+  CanonicalComponents components{ GetComponents() };
+  StringBuilder builder(mPath.GetSize());
+  StringView component;
+  while (components.Next(component)) {
+    if (!builder.IsEmpty()) {
+      builder.Append(StringView{ SEPARATOR });
     }
-
-    // 4. Ignore dots
-    if (components[i] == ".") {
-      continue;
-    }
-
-    // Concatenate
-    path.Join(components[i]);
+    builder.Append(component);
   }
-
-  return path;
+  return Path{ builder.Build() };
 }
 
 // -------------------------------------------------------------------------- //
@@ -148,62 +437,34 @@ Path::GetCanonical() const
 Path
 Path::GetDirectory() const
 {
-  const s64 sepIndex = Max(mPath.LastIndexOf('/'), mPath.LastIndexOf('\\'));
-  if (sepIndex < 0) {
+  if (mNameOffset == 0) {
     return Path{ "" };
   }
-  return Path{ mPath.Substring(0, sepIndex) };
+  return Path{ PathView{ mPath.GetView().Subview(0, mNameOffset - 1) } };
 }
 
 // -------------------------------------------------------------------------- //
 
-ArrayList<String>
+PathComponents
 Path::GetComponents() const
 {
-  ArrayList<String> components;
-
-  // Find components
-  u32 index = 0;
-  u32 prevIndex = 0;
-  for (u32 codepoint : mPath) {
-    if (codepoint == '/' || codepoint == '\\') {
-      String substring = mPath.Substring(prevIndex, index - prevIndex);
-      if (substring.GetSize() > 0) {
-        components.Append(substring);
-      }
-      prevIndex = index + 1;
-    }
-    index++;
-  }
-  components.Append(mPath.Substring(prevIndex));
-
-  return components;
+  return PathComponents{ mPath.GetView() };
 }
 
 // -------------------------------------------------------------------------- //
 
-String
+StringView
 Path::GetName() const
 {
-  // If index is not valid (-1), then it becomes 0 in the same way that the
-  // separator are skipped (+1).
-  const s64 sepIndex = Max(mPath.LastIndexOf('/'), mPath.LastIndexOf('\\'));
-  return mPath.Substring(sepIndex + 1);
+  return mPath.GetView().Subview(mNameOffset);
 }
 
 // -------------------------------------------------------------------------- //
 
-String
+StringView
 Path::GetBaseName() const
 {
-  // Retrieve indices of last separator and 'dot'
-  const s64 sepIndex = Max(mPath.LastIndexOf('/'), mPath.LastIndexOf('\\'));
-  const s64 dotIndex = mPath.LastIndexOf('.');
-
-  if (dotIndex <= sepIndex) {
-    return mPath.Substring(sepIndex + 1);
-  }
-  return mPath.Substring(sepIndex + 1, dotIndex - sepIndex - 1);
+  return mPath.GetView().Subview(mNameOffset, mExtensionOffset - mNameOffset);
 }
 
 // -------------------------------------------------------------------------- //
@@ -211,206 +472,34 @@ Path::GetBaseName() const
 Path::Extension
 Path::GetExtension() const
 {
-  const String extensionString = GetExtensionString();
-  if (extensionString.GetLength() == 0) {
-    return Extension::kNone;
-  }
-
-  // Data (text, binary, config, ...)
-  if (extensionString == ".tmp") {
-    return Extension::kTmp;
-  }
-  if (extensionString == ".txt") {
-    return Extension::kTxt;
-  }
-  if (extensionString == ".csv") {
-    return Extension::kCsv;
-  }
-  if (extensionString == ".dat") {
-    return Extension::kDat;
-  }
-  if (extensionString == ".json") {
-    return Extension::kJson;
-  }
-  if (extensionString == ".xml") {
-    return Extension::kXml;
-  }
-  if (extensionString == ".yaml") {
-    return Extension::kYaml;
-  }
-  if (extensionString == ".toml") {
-    return Extension::kToml;
-  }
-  if (extensionString == ".md") {
-    return Extension::kMd;
-  }
-  if (extensionString == ".cfg") {
-    return Extension::kCfg;
-  }
-  if (extensionString == ".ini") {
-    return Extension::kIni;
-  }
-  if (extensionString == ".log") {
-    return Extension::kLog;
-  }
-
-  // Image
-  if (extensionString == ".png") {
-    return Extension::kPng;
-  }
-  if (extensionString == ".tga") {
-    return Extension::kTga;
-  }
-  if (extensionString == ".jpeg" || extensionString == ".jpg") {
-    return Extension::kJpeg;
-  }
-  if (extensionString == ".psd") {
-    return Extension::kPsd;
-  }
-  if (extensionString == ".bmp") {
-    return Extension::kBmp;
-  }
-  if (extensionString == ".gif") {
-    return Extension::kGif;
-  }
-  if (extensionString == ".ico") {
-    return Extension::kIco;
-  }
-  if (extensionString == ".svg") {
-    return Extension::kSvg;
-  }
-  if (extensionString == ".tiff" || extensionString == ".tif") {
-    return Extension::kTiff;
-  }
-
-  // Audio
-  if (extensionString == ".ogg") {
-    return Extension::kOgg;
-  }
-  if (extensionString == ".wav") {
-    return Extension::kWav;
-  }
-  if (extensionString == ".mp3") {
-    return Extension::kMp3;
-  }
-
-  // Model/Scene
-  if (extensionString == ".obj") {
-    return Extension::kObj;
-  }
-  if (extensionString == ".gltf") {
-    return Extension::kGltf;
-  }
-
-  // Video
-  if (extensionString == ".avi") {
-    return Extension::kAvi;
-  }
-  if (extensionString == ".mp4") {
-    return Extension::kMp4;
-  }
-
-  // Archive
-  if (extensionString == ".tar") {
-    return Extension::kTar;
-  }
-  if (extensionString == ".zip") {
-    return Extension::kZip;
-  }
-  if (extensionString == ".gz") {
-    return Extension::kGz;
-  }
-  if (extensionString == ".7z") {
-    return Extension::k7z;
-  }
-
-  // Font
-  if (extensionString == ".ttf") {
-    return Extension::kTtf;
-  }
-  if (extensionString == ".otf") {
-    return Extension::kOtf;
-  }
+  return ExtensionFromString(GetExtensionString());
+}
 
-  // Code (source, headers)
-  if (extensionString == ".c") {
-    return Extension::kC;
-  }
-  if (extensionString == ".h") {
-    return Extension::kH;
-  }
-  if (extensionString == ".cpp") {
-    return Extension::kCpp;
-  }
-  if (extensionString == ".hpp") {
-    return Extension::kHpp;
-  }
-  if (extensionString == ".py") {
-    return Extension::kPy;
-  }
-  if (extensionString == ".js") {
-    return Extension::kJs;
-  }
-  if (extensionString == ".java") {
-    return Extension::kJava;
-  }
-  if (extensionString == ".rs") {
-    return Extension::kRs;
-  }
+// -------------------------------------------------------------------------- //
 
-  // Shader
-  if (extensionString == ".hlsl") {
-    return Extension::kHLSL;
-  }
-  if (extensionString == ".glsl") {
-    return Extension::kGLSL;
-  }
-  if (extensionString == ".metal") {
-    return Extension::kMetal;
+StringView
+Path::GetExtensionString() const
+{
+  // A single '.' at the end of the name is not an extension
+  if (mPath.GetSize() - mExtensionOffset <= 1) {
+    return StringView{};
   }
+  return mPath.GetView().Subview(mExtensionOffset);
+}
 
-  // Executables, libraries, ...
-  if (extensionString == ".exe") {
-    return Extension::kExe;
-  }
-  if (extensionString == ".app") {
-    return Extension::kApp;
-  }
-  if (extensionString == ".apk") {
-    return Extension::kApk;
-  }
-  if (extensionString == ".dll") {
-    return Extension::kDll;
-  }
-  if (extensionString == ".so") {
-    return Extension::kSo;
-  }
-  if (extensionString == ".dynlib") {
-    return Extension::kDynlib;
-  }
-  if (extensionString == ".lib") {
-    return Extension::kLib;
-  }
-  if (extensionString == ".a") {
-    return Extension::kA;
-  }
+// -------------------------------------------------------------------------- //
 
-  // Could not determine
-  return Extension::kUnknown;
+PathView
+Path::GetView() const
+{
+  return PathView{ mPath.GetView() };
 }
 
 // -------------------------------------------------------------------------- //
 
-String
-Path::GetExtensionString() const
+Path::operator PathView() const
 {
-  const s64 sepIndex = Max(mPath.LastIndexOf('/'), mPath.LastIndexOf('\\'));
-  const s64 dotIndex = mPath.LastIndexOf('.');
-  if (dotIndex <= sepIndex) {
-    return "";
-  }
-  const String extension = mPath.Substring(dotIndex);
-  return extension.GetLength() > 1 ? extension : "";
+  return GetView();
 }
 
 // -------------------------------------------------------------------------- //
@@ -426,8 +515,23 @@ operator<<(std::ostream& stream, const Path& path)
 bool
 operator==(const Path& path0, const Path& path1)
 {
-  return path0.GetCanonical().GetPathString() ==
-         path1.GetCanonical().GetPathString();
+  // Compare the canonical forms one component at a time, without building them
+  CanonicalComponents components0{ path0.GetComponents() };
+  CanonicalComponents components1{ path1.GetComponents() };
+  StringView component0, component1;
+  while (true) {
+    const bool valid0 = components0.Next(component0);
+    const bool valid1 = components1.Next(component1);
+    if (valid0 != valid1) {
+      return false;
+    }
+    if (!valid0) {
+      return true;
+    }
+    if (component0 != component1) {
+      return false;
+    }
+  }
 }
 
 // -------------------------------------------------------------------------- //
@@ -435,8 +539,7 @@ operator==(const Path& path0, const Path& path1)
 bool
 operator!=(const Path& path0, const Path& path1)
 {
-  return path0.GetCanonical().GetCanonical() ==
-         path1.GetCanonical().GetPathString();
+  return !(path0 == path1);
 }
 
 // -------------------------------------------------------------------------- //
@@ -452,7 +555,145 @@ operator+(const Path& path0, const Path& path1)
 Path
 operator+(const Path& path0, const String& path1)
 {
-  return path0.Joined(Path{ path1 });
+  return JoinPaths(path0, path1.GetView());
+}
+
+// -------------------------------------------------------------------------- //
+
+Path
+operator+(const Path& path0, const char8* path1)
+{
+  return JoinPaths(path0, StringView{ path1 });
+}
+
+// -------------------------------------------------------------------------- //
+
+void
+Path::Parse()
+{
+  // Scan backwards from the end for the last separator. Only the name is
+  // scanned, so this is cheap even for long paths
+  const char8* data = mPath.GetView().GetData();
+  const u32 size = mPath.GetSize();
+  mNameOffset = size;
+  mExtensionOffset = size;
+  while (mNameOffset > 0 && !IsSeparator(data[mNameOffset - 1])) {
+    mNameOffset--;
+    if (data[mNameOffset] == '.' && mExtensionOffset == size) {
+      mExtensionOffset = mNameOffset;
+    }
+  }
+}
+
+}
+
+// ========================================================================== //
+// PathComponents Implementation
+// ========================================================================== //
+
+namespace olivine {
+
+PathComponents::Iterator::Iterator(StringView path, StringView::SizeType offset)
+  : mPath(path)
+  , mOffset(offset)
+{
+  Find();
+}
+
+// -------------------------------------------------------------------------- //
+
+PathComponents::Iterator&
+PathComponents::Iterator::operator++()
+{
+  mOffset += mSize;
+  Find();
+  return *this;
+}
+
+// -------------------------------------------------------------------------- //
+
+void
+PathComponents::Iterator::Find()
+{
+  const char8* data = mPath.GetData();
+  const StringView::SizeType size = mPath.GetSize();
+  while (mOffset < size && IsSeparator(data[mOffset])) {
+    mOffset++;
+  }
+  mSize = 0;
+  while (mOffset + mSize < size && !IsSeparator(data[mOffset + mSize])) {
+    mSize++;
+  }
+}
+
+}
+
+// ========================================================================== //
+// PathView Implementation
+// ========================================================================== //
+
+namespace olivine {
+
+PathView
+PathView::GetDirectory() const
+{
+  const s64 sepOffset = GetSeparatorOffset();
+  if (sepOffset < 0) {
+    return PathView{ "" };
+  }
+  return PathView{ mPath.Subview(0, StringView::SizeType(sepOffset)) };
+}
+
+// -------------------------------------------------------------------------- //
+
+StringView
+PathView::GetName() const
+{
+  // If offset is not valid (-1), then it becomes 0 in the same way that the
+  // separator are skipped (+1).
+  return mPath.Subview(StringView::SizeType(GetSeparatorOffset() + 1));
+}
+
+// -------------------------------------------------------------------------- //
+
+StringView
+PathView::GetBaseName() const
+{
+  const StringView name = GetName();
+  const s64 dotOffset = name.FindLast('.');
+  if (dotOffset < 0) {
+    return name;
+  }
+  return name.Subview(0, StringView::SizeType(dotOffset));
+}
+
+// -------------------------------------------------------------------------- //
+
+Path::Extension
+PathView::GetExtension() const
+{
+  return ExtensionFromString(GetExtensionString());
+}
+
+// -------------------------------------------------------------------------- //
+
+StringView
+PathView::GetExtensionString() const
+{
+  const StringView name = GetName();
+  const s64 dotOffset = name.FindLast('.');
+  if (dotOffset < 0 || name.GetSize() - dotOffset <= 1) {
+    return StringView{};
+  }
+  return name.Subview(StringView::SizeType(dotOffset));
+}
+
+// -------------------------------------------------------------------------- //
+
+s64
+PathView::GetSeparatorOffset() const
+{
+  return Max(mPath.FindLast('/'), mPath.FindLast('\\'));
 }
 
 }
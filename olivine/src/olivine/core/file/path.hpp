@@ -38,6 +38,9 @@
 
 namespace olivine {
 
+OL_FORWARD_DECLARE(PathView);
+OL_FORWARD_DECLARE(PathComponents);
+
 /** \class Path
  * \author Filip Björklund
  * \date 19 july 2019 - 19:29
@@ -188,14 +191,26 @@ public:
   /** Path (relative) to parent directory **/
   static constexpr char8 PARENT[] = "..";
 
+#if defined(OL_PLATFORM_WINDOWS)
   /** Path separator (Windows) **/
   static constexpr char8 SEPARATOR[] = "\\";
   /** Path separator character (Windows) **/
   static constexpr u32 SEPARATOR_CHAR = '\\';
+#else
+  /** Path separator (POSIX) **/
+  static constexpr char8 SEPARATOR[] = "/";
+  /** Path separator character (POSIX) **/
+  static constexpr u32 SEPARATOR_CHAR = '/';
+#endif
 
 private:
   /** Path string **/
   String mPath;
+  /** Byte offset of the name, which is the part after the last separator **/
+  u32 mNameOffset = 0;
+  /** Byte offset of the last '.' in the name, or the size of the path if the
+   * name has none **/
+  u32 mExtensionOffset = 0;
 
 public:
   /** Construct a path from a string.
@@ -204,6 +219,18 @@ public:
    */
   Path(String path = "");
 
+  /** Construct a path from a UTF-8 string.
+   * \brief Construct path.
+   * \param path
+   */
+  Path(const char8* path);
+
+  /** Construct a path from a path view. This copies the viewed path.
+   * \brief Construct path.
+   * \param path
+   */
+  explicit Path(PathView path);
+
   /** Join another path at the end of this path. This correctly insert a
    * separator between the path components.
    * \brief Join with another path.
@@ -243,6 +270,16 @@ public:
     return mPath.GetUTF8();
   }
 
+  /** Returns a view of the path. The view is only valid as long as the path is
+   * not modified or destroyed.
+   * \brief Returns view.
+   * \return Path view.
+   */
+  OL_NODISCARD PathView GetView() const;
+
+  /** Implicit conversion to a view of the path **/
+  operator PathView() const;
+
   /** Returns the path as an absolute path. This function also resolves any '.'
    * (current directory) and '..' (parent directory) components that may be part
    * of the path. For this reason this function may be costly and should not be
@@ -268,15 +305,23 @@ public:
    */
   OL_NODISCARD Path GetDirectory() const;
 
-  /** Returns each of the path components that make up the path.
+  /** Returns each of the path components that make up the path. The
+   * components are views into the path, which means that they are only valid
+   * as long as the path is not modified or destroyed. Empty components are
+   * skipped.
    * \brief Returns path components.
    * \return Path components.
+   *
+   * \example
+   * for (StringView component : Path{ "path/to/file.txt" }.GetComponents()) {
+   *   // 'path', 'to', 'file.txt'
+   * }
    */
-  OL_NODISCARD ArrayList<String> GetComponents() const;
+  OL_NODISCARD PathComponents GetComponents() const;
 
   /** Returns the name of the object at the path. This includes the base name
    * and the extension. This works similar to Path::GetBaseName(), however it
-   * does include the extension.
+   * does include the extension. The name is a view into the path.
    * \brief Returns name.
    * \return Name.
    *
@@ -284,10 +329,11 @@ public:
    * auto name = Path{ "path/to/file.txt" }.GetName(); // 'file.txt'
    * auto name = Path{ "path/to/file" }.GetName(); // 'file'
    */
-  OL_NODISCARD String GetName() const;
+  OL_NODISCARD StringView GetName() const;
 
   /** Returns the base name of the object at the path. This works similar to
-   * Path::GetName(), however without including the extension.
+   * Path::GetName(), however without including the extension. The base name is
+   * a view into the path.
    * \brief Returns base name.
    * \return Base name.
    *
@@ -295,7 +341,7 @@ public:
    * auto name = Path{ "path/to/file.txt" }.GetName(); // 'file'
    * auto name = Path{ "path/to/file" }.GetName(); // 'file'
    */
-  OL_NODISCARD String GetBaseName() const;
+  OL_NODISCARD StringView GetBaseName() const;
 
   /** Returns the extension of the path.
    * \brief Returns extension.
@@ -309,11 +355,12 @@ public:
    */
   OL_NODISCARD Extension GetExtension() const;
 
-  /** Returns the extension of the path as a string.
+  /** Returns the extension of the path as a string, including the dot. The
+   * extension is a view into the path.
    * \brief Returns extension string.
    * \return Extension string.
    */
-  OL_NODISCARD String GetExtensionString() const;
+  OL_NODISCARD StringView GetExtensionString() const;
 
   /** Output stream function **/
   friend std::ostream& operator<<(std::ostream& stream, const Path& path);
@@ -349,6 +396,175 @@ public:
    * \return Joined paths.
    */
   friend Path operator+(const Path& path0, const String& path1);
+
+  /** Returns two paths joined together, the second created from a string.
+   * \brief Returns joined paths.
+   * \param path0 First path.
+   * \param path1 Second path.
+   * \return Joined paths.
+   */
+  friend Path operator+(const Path& path0, const char8* path1);
+
+private:
+  /** Find the offsets of the name and extension in the path string **/
+  void Parse();
+};
+
+}
+
+// ========================================================================== //
+// PathComponents Declaration
+// ========================================================================== //
+
+namespace olivine {
+
+/** \class PathComponents
+ * \author Filip Björklund
+ * \date 18 october 2026 - 22:10
+ * \brief Range of path components.
+ * \details
+ * Range over the components of a path, that is the parts between the
+ * separators. The components are found while iterating and are returned as
+ * views into the path string, so iterating never allocates. Empty components,
+ * like the one before a leading separator, are skipped.
+ */
+class PathComponents
+{
+public:
+  /** Iterator over the components **/
+  class Iterator
+  {
+  private:
+    /** Path string **/
+    StringView mPath;
+    /** Byte offset of the current component **/
+    StringView::SizeType mOffset;
+    /** Size of the current component in bytes **/
+    StringView::SizeType mSize = 0;
+
+  public:
+    /** Construct an iterator at the first component at or after 'offset' **/
+    Iterator(StringView path, StringView::SizeType offset);
+
+    /** Proceed to the next component **/
+    Iterator& operator++();
+
+    /** Returns the current component **/
+    StringView operator*() const { return mPath.Subview(mOffset, mSize); }
+
+    /** Check equality **/
+    bool operator==(const Iterator& other) const
+    {
+      return mOffset == other.mOffset;
+    }
+
+    /** Check inequality **/
+    bool operator!=(const Iterator& other) const { return !(*this == other); }
+
+  private:
+    /** Skip separators and find the end of the component at 'mOffset' **/
+    void Find();
+  };
+
+private:
+  /** Path string **/
+  StringView mPath;
+
+public:
+  /** Construct a range over the components of a path string.
+   * \brief Construct range.
+   * \param path Path string.
+   */
+  explicit PathComponents(StringView path)
+    : mPath(path)
+  {}
+
+  /** Returns an iterator to the first component **/
+  OL_NODISCARD Iterator begin() const { return Iterator{ mPath, 0 }; }
+
+  /** Returns an iterator past the last component **/
+  OL_NODISCARD Iterator end() const
+  {
+    return Iterator{ mPath, mPath.GetSize() };
+  }
+};
+
+}
+
+// ========================================================================== //
+// PathView Declaration
+// ========================================================================== //
+
+namespace olivine {
+
+/** \class PathView
+ * \author Filip Björklund
+ * \date 18 october 2026 - 11:02
+ * \brief Non-owning path view.
+ * \details
+ * Represents a view of a path string that is owned by someone else, for example
+ * a 'Path' or a string literal. All queries on a path view returns views into
+ * the same data and therefore never allocates.
+ */
+class PathView
+{
+private:
+  /** View of path string **/
+  StringView mPath;
+
+public:
+  /** Construct an empty path view **/
+  constexpr PathView() = default;
+
+  /** Construct a path view from a null-terminated UTF-8 string.
+   * \brief Construct path view.
+   * \param path Path string to view.
+   */
+  constexpr PathView(const char8* path)
+    : mPath(path)
+  {}
+
+  /** Construct a path view from a string view.
+   * \brief Construct path view.
+   * \param path Path string to view.
+   */
+  constexpr PathView(StringView path)
+    : mPath(path)
+  {}
+
+  /** \copydoc Path::GetPathString **/
+  OL_NODISCARD StringView GetPathString() const { return mPath; }
+
+  /** \copydoc Path::GetDirectory **/
+  OL_NODISCARD PathView GetDirectory() const;
+
+  /** \copydoc Path::GetName **/
+  OL_NODISCARD StringView GetName() const;
+
+  /** \copydoc Path::GetBaseName **/
+  OL_NODISCARD StringView GetBaseName() const;
+
+  /** \copydoc Path::GetExtension **/
+  OL_NODISCARD Path::Extension GetExtension() const;
+
+  /** \copydoc Path::GetExtensionString **/
+  OL_NODISCARD StringView GetExtensionString() const;
+
+  /** \copydoc Path::GetComponents **/
+  OL_NODISCARD PathComponents GetComponents() const
+  {
+    return PathComponents{ mPath };
+  }
+
+  /** Output stream function **/
+  friend std::ostream& operator<<(std::ostream& stream, PathView path)
+  {
+    return stream << path.mPath;
+  }
+
+private:
+  /** Returns the byte offset of the last separator or -1 if there is none **/
+  OL_NODISCARD s64 GetSeparatorOffset() const;
 };
 
 }
\ No newline at end of file
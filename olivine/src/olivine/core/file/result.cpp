@@ -22,6 +22,13 @@
 
 #include "olivine/core/file/result.hpp"
 
+// ========================================================================== //
+// Headers
+// ========================================================================== //
+
+// Project headers
+#include "olivine/core/platform/headers.hpp"
+
 // ========================================================================== //
 // Functions
 // ========================================================================== //
@@ -76,4 +83,72 @@ operator<<(std::ostream& os, const FileResult& result)
   return os;
 }
 
+// -------------------------------------------------------------------------- //
+
+#if defined(OL_PLATFORM_WINDOWS)
+
+static FileResult
+FileResultFromErrorWin32(DWORD error)
+{
+  switch (error) {
+    case ERROR_SUCCESS:
+      return FileResult::kSuccess;
+    case ERROR_FILE_EXISTS:
+      return FileResult::kAlreadyExists;
+    case ERROR_FILE_NOT_FOUND:
+    case ERROR_NOT_FOUND:
+    case ERROR_PATH_NOT_FOUND:
+      return FileResult::kNotFound;
+    case ERROR_ACCESS_DENIED:
+      return FileResult::kAccessDenied;
+    default:
+      return FileResult::kUnknownError;
+  }
+}
+
+// -------------------------------------------------------------------------- //
+
+FileResult
+FileResultFromLastError()
+{
+  return FileResultFromErrorWin32(GetLastError());
+}
+
+#else
+
+static FileResult
+FileResultFromErrno(int error)
+{
+  switch (error) {
+    case 0:
+      return FileResult::kSuccess;
+    case EEXIST:
+      return FileResult::kAlreadyExists;
+    case ENOENT:
+    case ENOTDIR:
+      return FileResult::kNotFound;
+    case EACCES:
+    case EPERM:
+    case EROFS:
+      return FileResult::kAccessDenied;
+    case ENOMEM:
+      return FileResult::kOutOfMemory;
+    case EINVAL:
+    case EBADF:
+      return FileResult::kInvalidArgument;
+    default:
+      return FileResult::kUnknownError;
+  }
+}
+
+// -------------------------------------------------------------------------- //
+
+FileResult
+FileResultFromLastError()
+{
+  return FileResultFromErrno(errno);
+}
+
+#endif
+
 }
\ No newline at end of file
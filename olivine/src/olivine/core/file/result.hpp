@@ -85,4 +85,13 @@ namespace olivine {
 std::ostream&
 operator<<(std::ostream& os, const FileResult& result);
 
+/** Returns the file result that corresponds to the last error that was set by
+ * a platform call on the calling thread. This is 'GetLastError' on Windows and
+ * 'errno' on POSIX platforms.
+ * \brief Returns file result from last platform error.
+ * \return File result.
+ */
+FileResult
+FileResultFromLastError();
+
 }
\ No newline at end of file
@@ -0,0 +1,218 @@
+// MIT License
+//
+// Copyright (c) 2019 Filip Björklund
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "olivine/core/file/vfs.hpp"
+
+// ========================================================================== //
+// Headers
+// ========================================================================== //
+
+// Standard headers
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <vector>
+
+// Project headers
+#include "olivine/core/file/access_trace.hpp"
+#include "olivine/core/file/file_system.hpp"
+#include "olivine/core/file/pack.hpp"
+
+// ========================================================================== //
+// Functions
+// ========================================================================== //
+
+namespace olivine {
+
+/** Maximum size of a path that can be looked up in the packs **/
+static constexpr u32 kMaxPathSize = 1024;
+
+// -------------------------------------------------------------------------- //
+
+/** Mounted pack **/
+struct MountedPack
+{
+  /** Path of the pack file **/
+  Path path;
+  /** Mount point with '/' as separator and a trailing '/', or empty **/
+  String mountPoint;
+  /** Pack **/
+  std::unique_ptr<Pack> pack;
+};
+
+// -------------------------------------------------------------------------- //
+
+/** Mutex for the mounts **/
+static std::shared_mutex sMountMutex;
+/** Mounted packs, in mount order **/
+static std::vector<MountedPack> sMounts;
+
+// -------------------------------------------------------------------------- //
+
+/** Write a path with '/' as separator into a buffer, skipping a leading './'.
+ * Returns the size of the normalized path, or 'kMaxPathSize' if the path does
+ * not fit in the buffer **/
+static u32
+NormalizePath(StringView path, char8 (&buffer)[kMaxPathSize])
+{
+  if (path.StartsWith("./") || path.StartsWith(".\\")) {
+    path = path.Subview(2);
+  }
+  if (path.GetSize() >= kMaxPathSize) {
+    return kMaxPathSize;
+  }
+  for (u32 i = 0; i < path.GetSize(); i++) {
+    const char8 c = path.GetData()[i];
+    buffer[i] = c == '\\' ? '/' : c;
+  }
+  return path.GetSize();
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Find a file in the mounted packs without recording it as read **/
+static bool
+Lookup(PathView path, VFS::File& file)
+{
+  std::shared_lock<std::shared_mutex> lock(sMountMutex);
+  if (sMounts.empty()) {
+    return false;
+  }
+
+  // Normalize path
+  char8 buffer[kMaxPathSize];
+  const u32 size = NormalizePath(path.GetPathString(), buffer);
+  if (size == kMaxPathSize) {
+    return false;
+  }
+  const StringView normalized(buffer, size);
+
+  // Search packs, latest mounted first
+  for (auto it = sMounts.rbegin(); it != sMounts.rend(); ++it) {
+    const StringView mountPoint = it->mountPoint.GetView();
+    if (!normalized.StartsWith(mountPoint)) {
+      continue;
+    }
+    const Pack::Entry* entry =
+      it->pack->Find(normalized.Subview(mountPoint.GetSize()));
+    if (entry) {
+      const bool compressed = Pack::IsCompressed(*entry);
+      file.data = compressed ? nullptr : it->pack->GetData(*entry);
+      file.size = entry->size;
+      file.pack = it->pack.get();
+      file.entry = entry;
+      return true;
+    }
+  }
+  return false;
+}
+
+}
+
+// ========================================================================== //
+// VFS Implementation
+// ========================================================================== //
+
+namespace olivine {
+
+FileResult
+VFS::Mount(const Path& pack, const Path& mountPoint)
+{
+  // Open pack
+  std::unique_ptr<Pack> opened = std::make_unique<Pack>(pack);
+  const FileResult result = opened->Open();
+  if (result != FileResult::kSuccess) {
+    return result;
+  }
+
+  // Normalize mount point
+  char8 buffer[kMaxPathSize];
+  const u32 size = NormalizePath(mountPoint.GetPathString(), buffer);
+  if (size == kMaxPathSize) {
+    return FileResult::kInvalidArgument;
+  }
+  String normalized(StringView(buffer, size));
+  if (!normalized.IsEmpty() && !normalized.EndsWith('/')) {
+    normalized += "/";
+  }
+
+  // Add mount
+  std::unique_lock<std::shared_mutex> lock(sMountMutex);
+  sMounts.push_back(
+    MountedPack{ pack, std::move(normalized), std::move(opened) });
+  return FileResult::kSuccess;
+}
+
+// -------------------------------------------------------------------------- //
+
+FileResult
+VFS::Unmount(const Path& pack)
+{
+  std::unique_lock<std::shared_mutex> lock(sMountMutex);
+  for (auto it = sMounts.rbegin(); it != sMounts.rend(); ++it) {
+    if (it->path == pack) {
+      sMounts.erase(std::next(it).base());
+      return FileResult::kSuccess;
+    }
+  }
+  return FileResult::kNotFound;
+}
+
+// -------------------------------------------------------------------------- //
+
+void
+VFS::UnmountAll()
+{
+  std::unique_lock<std::shared_mutex> lock(sMountMutex);
+  sMounts.clear();
+}
+
+// -------------------------------------------------------------------------- //
+
+bool
+VFS::Find(PathView path, File& file)
+{
+  if (!Lookup(path, file)) {
+    return false;
+  }
+  AccessTrace::Record(path, 0, file.size);
+  return true;
+}
+
+// -------------------------------------------------------------------------- //
+
+FileResult
+VFS::Read(const File& file, u64 offset, u64 size, u8* destination)
+{
+  return file.pack->Read(*file.entry, offset, size, destination);
+}
+
+// -------------------------------------------------------------------------- //
+
+bool
+VFS::Exists(const Path& path)
+{
+  File file;
+  return Lookup(path.GetView(), file) || FileSystem::Exists(path);
+}
+
+}
@@ -0,0 +1,133 @@
+// MIT License
+//
+// Copyright (c) 2019 Filip Björklund
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+// ========================================================================== //
+// Headers
+// ========================================================================== //
+
+// Project headers
+#include "olivine/core/common.hpp"
+#include "olivine/core/macros.hpp"
+#include "olivine/core/file/pack.hpp"
+#include "olivine/core/file/path.hpp"
+#include "olivine/core/file/result.hpp"
+
+// ========================================================================== //
+// VFS Declaration
+// ========================================================================== //
+
+namespace olivine {
+
+/** \class VFS
+ * \author Filip Björklund
+ * \date 18 october 2026 - 18:55
+ * \brief Virtual file system.
+ * \details
+ * Resolves paths against packs that have been mounted, before the file system
+ * on disk is used. A pack is mounted at a mount point, a directory path, and
+ * the files in the pack then appear as if they were in that directory. For
+ * example a pack that contains 'material/brass/albedo.png' and is mounted at
+ * 'res' serves the path 'res/material/brass/albedo.png'.
+ *
+ * Packs that are mounted later take precedence over earlier ones. Lookups are
+ * thread-safe, and the data that is returned stays valid until the pack is
+ * unmounted. Files that are compressed in the pack has no data that can be
+ * accessed directly, they are read with 'VFS::Read' instead.
+ */
+class VFS
+{
+  OL_NAMESPACE_CLASS(VFS);
+
+public:
+  /** File that was found in a pack **/
+  struct File
+  {
+    /** Data of the file, or nullptr if the file is compressed **/
+    const u8* data = nullptr;
+    /** Size of the file in bytes **/
+    u64 size = 0;
+    /** Pack that contains the file **/
+    const Pack* pack = nullptr;
+    /** Entry of the file in the pack **/
+    const Pack::Entry* entry = nullptr;
+  };
+
+public:
+  /** Mount a pack at a mount point.
+   * \brief Mount pack.
+   * \param pack Path to the pack file.
+   * \param mountPoint Directory that the pack is mounted at. An empty path
+   * mounts the pack at the working directory.
+   * \return Result.
+   */
+  static FileResult Mount(const Path& pack, const Path& mountPoint);
+
+  /** Unmount a pack that was mounted with 'VFS::Mount'.
+   * \brief Unmount pack.
+   * \param pack Path to the pack file, as it was passed when mounting.
+   * \return Result.
+   * - FileResult::kNotFound: The pack is not mounted.
+   */
+  static FileResult Unmount(const Path& pack);
+
+  /** Unmount all packs.
+   * \brief Unmount all packs.
+   */
+  static void UnmountAll();
+
+  /** Find a file in the mounted packs. The file is expected to be read, and is
+   * recorded as such if an 'AccessTrace' is being recorded.
+   * \brief Find file.
+   * \param path Path of the file.
+   * \param file File that was found.
+   * \return True if the file was found otherwise false.
+   */
+  static bool Find(PathView path, File& file);
+
+  /** Read a range of a file that was found in a pack. Compressed files are
+   * decompressed in parallel.
+   * \brief Read file.
+   * \param file File to read.
+   * \param offset Offset in the file to read from.
+   * \param size Number of bytes to read.
+   * \param destination Buffer to read into, of at least 'size' bytes.
+   * \return Result.
+   * - FileResult::kEOF: The range is not inside of the file.
+   * - FileResult::kInvalidArgument: The compressed data is corrupt.
+   */
+  static FileResult Read(const File& file,
+                         u64 offset,
+                         u64 size,
+                         u8* destination);
+
+  /** Returns whether a file exists, either in one of the mounted packs or in
+   * the file system on disk.
+   * \brief Returns whether file exists.
+   * \param path Path of the file.
+   * \return True if the file exists otherwise false.
+   */
+  OL_NODISCARD static bool Exists(const Path& path);
+};
+
+}
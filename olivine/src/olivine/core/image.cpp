@@ -26,14 +26,33 @@
 // Headers
 // ========================================================================== //
 
+// Standard headers
+#include <atomic>
+#include <climits>
+#include <cstring>
+#include <immintrin.h>
+
 // Project headers
 #include "olivine/core/assert.hpp"
+#include "olivine/core/cpu.hpp"
+#include "olivine/core/image_view.hpp"
+#include "olivine/core/memory.hpp"
+#include "olivine/core/mip_generator.hpp"
+#include "olivine/core/pixel_converter.hpp"
+#include "olivine/core/thread_pool.hpp"
+#include "olivine/core/file/buffered_io.hpp"
 #include "olivine/core/file/file_io.hpp"
-#include "olivine/core/file/file_system.hpp"
+#include "olivine/core/file/mapped_file.hpp"
+#include "olivine/core/file/vfs.hpp"
 #include "olivine/render/color.hpp"
 
-// stb_image header
+// stb_image header. Allocations are made through 'Memory', so that images can
+// adopt the decoded pixels as their data
 #define STBI_ASSERT(x) OL_ASSERT(!!(x), "Assertion failed in library stb_image")
+#define STBI_MALLOC(size) olivine::Memory::Allocate(size)
+#define STBI_REALLOC(pointer, size)                                            \
+  olivine::Memory::Rellocate(pointer, size, olivine::Memory::MIN_ALIGN)
+#define STBI_FREE(pointer) olivine::Memory::Free(pointer)
 #define STBI_NO_STDIO
 #define STB_IMAGE_IMPLEMENTATION
 #include <thirdparty/stb/stb_image.h>
@@ -53,17 +72,327 @@
   OL_ASSERT(!!(x), "Assertion failed in library stb_image_resize")
 #include <thirdparty/stb/stb_image_resize.h>
 
+// ========================================================================== //
+// Functions
+// ========================================================================== //
+
+namespace olivine {
+
+/** Returns the image format of pixels decoded with the specified number of
+ * channels **/
+static Image::Format
+GetDecodedFormat(s32 channelCount)
+{
+  switch (channelCount) {
+    case 1: {
+      return Image::Format::kRed;
+    }
+    case 3: {
+      return Image::Format::kRGB;
+    }
+    case 4: {
+      return Image::Format::kRGBA;
+    }
+    default: {
+      return Image::Format::kUnknown;
+    }
+  }
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Size in bytes of fills above which the stores bypass the cache. Data that
+ * is larger than this would evict most of the cache anyway **/
+static constexpr u64 kStreamThreshold = 8ull * 1024ull * 1024ull;
+
+/** Size of the repeating pattern of a fill. This is a multiple of both the
+ * vector sizes and the pixel sizes of all formats **/
+static constexpr u32 kPatternSize = 96;
+
+/** Number of destination pixels of a resize above which it's split into bands
+ * that are run on the global thread pool **/
+static constexpr u64 kResizeParallelThreshold = 64 * 1024;
+
+// -------------------------------------------------------------------------- //
+
+/** Write a color to a pixel of a format **/
+static void
+WritePixel(Image::Format format, u8* address, Color color)
+{
+  switch (format) {
+    case Image::Format::kRGBA: {
+      MutableImageView<Image::Format::kRGBA>::Store(address, color);
+      break;
+    }
+    case Image::Format::kBGRA: {
+      MutableImageView<Image::Format::kBGRA>::Store(address, color);
+      break;
+    }
+    case Image::Format::kRGB: {
+      MutableImageView<Image::Format::kRGB>::Store(address, color);
+      break;
+    }
+    case Image::Format::kBGR: {
+      MutableImageView<Image::Format::kBGR>::Store(address, color);
+      break;
+    }
+    case Image::Format::kRed: {
+      MutableImageView<Image::Format::kRed>::Store(address, color);
+      break;
+    }
+    case Image::Format::kAlpha: {
+      MutableImageView<Image::Format::kAlpha>::Store(address, color);
+      break;
+    }
+    case Image::Format::kUnknown: {
+      break;
+    }
+    default: {
+      Panic("Invalid image format");
+    }
+  }
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Fill bytes with a repeated pixel, one byte at a time. The first byte is at
+ * byte 'phase' of the pixel **/
+static void
+FillScalar(u8* destination, u64 size, const u8* pixel, u32 pixelSize, u32 phase)
+{
+  for (u64 i = 0; i < size; i++) {
+    destination[i] = pixel[phase];
+    phase = phase + 1 == pixelSize ? 0 : phase + 1;
+  }
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Swap the bytes of two non-overlapping ranges **/
+static void
+SwapBytes(u8* a, u8* b, u64 size)
+{
+  u64 i = 0;
+  for (; i + 16 <= size; i += 16) {
+    const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+    const __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(a + i), y);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(b + i), x);
+  }
+  for (; i < size; i++) {
+    const u8 x = a[i];
+    a[i] = b[i];
+    b[i] = x;
+  }
+}
+
+}
+
+// ========================================================================== //
+// SSE2 Functions
+// ========================================================================== //
+
+namespace olivine {
+
+/** Fill 16-byte aligned bytes with a pattern, in chunks of the pattern size.
+ * Returns the number of bytes that was filled **/
+static u64
+FillPatternSSE2(u8* destination, u64 size, const u8* pattern, bool stream)
+{
+  __m128i vectors[kPatternSize / 16];
+  for (u32 k = 0; k < kPatternSize / 16; k++) {
+    vectors[k] = _mm_load_si128(reinterpret_cast<const __m128i*>(pattern) + k);
+  }
+
+  u64 i = 0;
+  if (stream) {
+    for (; i + kPatternSize <= size; i += kPatternSize) {
+      __m128i* out = reinterpret_cast<__m128i*>(destination + i);
+      for (u32 k = 0; k < kPatternSize / 16; k++) {
+        _mm_stream_si128(out + k, vectors[k]);
+      }
+    }
+    _mm_sfence();
+  } else {
+    for (; i + kPatternSize <= size; i += kPatternSize) {
+      __m128i* out = reinterpret_cast<__m128i*>(destination + i);
+      for (u32 k = 0; k < kPatternSize / 16; k++) {
+        _mm_store_si128(out + k, vectors[k]);
+      }
+    }
+  }
+  return i;
+}
+
+}
+
+// ========================================================================== //
+// AVX2 Functions
+// ========================================================================== //
+
+namespace olivine {
+
+/** Fill 32-byte aligned bytes with a pattern, in chunks of the pattern size.
+ * Returns the number of bytes that was filled **/
+OL_TARGET_AVX2 static u64
+FillPatternAVX2(u8* destination, u64 size, const u8* pattern, bool stream)
+{
+  __m256i vectors[kPatternSize / 32];
+  for (u32 k = 0; k < kPatternSize / 32; k++) {
+    vectors[k] =
+      _mm256_load_si256(reinterpret_cast<const __m256i*>(pattern) + k);
+  }
+
+  u64 i = 0;
+  if (stream) {
+    for (; i + kPatternSize <= size; i += kPatternSize) {
+      __m256i* out = reinterpret_cast<__m256i*>(destination + i);
+      for (u32 k = 0; k < kPatternSize / 32; k++) {
+        _mm256_stream_si256(out + k, vectors[k]);
+      }
+    }
+    _mm_sfence();
+  } else {
+    for (; i + kPatternSize <= size; i += kPatternSize) {
+      __m256i* out = reinterpret_cast<__m256i*>(destination + i);
+      for (u32 k = 0; k < kPatternSize / 32; k++) {
+        _mm256_store_si256(out + k, vectors[k]);
+      }
+    }
+  }
+  return i;
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Fill bytes with a repeated pixel. The bytes must start at the first byte of
+ * a pixel **/
+static void
+FillPixels(u8* destination,
+           u64 size,
+           const u8* pixel,
+           u32 pixelSize,
+           bool stream)
+{
+  if (size < 2 * kPatternSize) {
+    FillScalar(destination, size, pixel, pixelSize, 0);
+    return;
+  }
+
+  // Fill up to the alignment of the vectors one byte at a time
+  const bool avx2 = Cpu::HasAVX2();
+  const u64 alignment = avx2 ? 32 : 16;
+  const u64 head = (alignment - (u64(destination) & (alignment - 1))) &
+                   (alignment - 1);
+  FillScalar(destination, head, pixel, pixelSize, 0);
+
+  // Build the pattern, starting at the byte of the pixel that follows the head
+  alignas(32) u8 pattern[kPatternSize];
+  const u32 phase = u32(head % pixelSize);
+  FillScalar(pattern, kPatternSize, pixel, pixelSize, phase);
+
+  // Fill the aligned bytes with the pattern, and the rest one byte at a time
+  u8* body = destination + head;
+  const u64 filled = avx2 ? FillPatternAVX2(body, size - head, pattern, stream)
+                          : FillPatternSSE2(body, size - head, pattern, stream);
+  FillScalar(body + filled, size - head - filled, pixel, pixelSize, phase);
+}
+
+}
+
 // ========================================================================== //
 // Image Implementation
 // ========================================================================== //
 
 namespace olivine {
 
+struct Image::Storage
+{
+  /** Number of images that share the storage **/
+  std::atomic<u32> refCount;
+  /** Data **/
+  u8* data;
+};
+
+// -------------------------------------------------------------------------- //
+
+Image::Image(const Image& other)
+  : mWidth(other.mWidth)
+  , mHeight(other.mHeight)
+  , mFormat(other.mFormat)
+  , mStorage(other.mStorage)
+  , mData(other.mData)
+  , mDataSize(other.mDataSize)
+  , mMipLevels(other.mMipLevels)
+{
+  if (mStorage) {
+    mStorage->refCount.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+// -------------------------------------------------------------------------- //
+
+Image::Image(Image&& other) noexcept
+  : mWidth(other.mWidth)
+  , mHeight(other.mHeight)
+  , mFormat(other.mFormat)
+  , mStorage(other.mStorage)
+  , mData(other.mData)
+  , mDataSize(other.mDataSize)
+  , mMipLevels(other.mMipLevels)
+{
+  other.mStorage = nullptr;
+  other.mData = nullptr;
+  other.mDataSize = 0;
+}
+
+// -------------------------------------------------------------------------- //
+
 Image::~Image()
 {
-  // Free image data
-  Memory::Free(mData);
-  mData = nullptr;
+  Release();
+}
+
+// -------------------------------------------------------------------------- //
+
+Image&
+Image::operator=(const Image& other)
+{
+  if (mStorage != other.mStorage) {
+    if (other.mStorage) {
+      other.mStorage->refCount.fetch_add(1, std::memory_order_relaxed);
+    }
+    Release();
+    mStorage = other.mStorage;
+    mData = other.mData;
+    mDataSize = other.mDataSize;
+  }
+  mWidth = other.mWidth;
+  mHeight = other.mHeight;
+  mFormat = other.mFormat;
+  mMipLevels = other.mMipLevels;
+  return *this;
+}
+
+// -------------------------------------------------------------------------- //
+
+Image&
+Image::operator=(Image&& other) noexcept
+{
+  if (this != &other) {
+    Release();
+    mWidth = other.mWidth;
+    mHeight = other.mHeight;
+    mFormat = other.mFormat;
+    mStorage = other.mStorage;
+    mData = other.mData;
+    mDataSize = other.mDataSize;
+    mMipLevels = other.mMipLevels;
+    other.mStorage = nullptr;
+    other.mData = nullptr;
+    other.mDataSize = 0;
+  }
+  return *this;
 }
 
 // -------------------------------------------------------------------------- //
@@ -74,8 +403,9 @@ Image::Create(const CreateInfo& createInfo)
   mWidth = createInfo.width;
   mHeight = createInfo.height;
   mFormat = createInfo.format;
-  mDataSize = u64(GetFormatRowStride(mFormat, mWidth)) * u64(mHeight);
-  mData = static_cast<u8*>(Memory::Allocate(mDataSize));
+  mMipLevels = 1;
+  const u64 dataSize = u64(GetFormatRowStride(mFormat, mWidth)) * u64(mHeight);
+  SetData(static_cast<u8*>(Memory::Allocate(dataSize)), dataSize);
 
   return Result::kSuccess;
 }
@@ -85,55 +415,125 @@ Image::Create(const CreateInfo& createInfo)
 Image::Result
 Image::Load(const Path& path)
 {
-  // Read file into buffer
-  u64 size = FileSystem::GetSize(path);
-  FileIO io(path);
-  FileResult result = io.Open(FileIO::Flag::kRead);
-  if (result != FileResult::kSuccess) {
-    return Result::kFailedToReadFile;
-  }
-  u8* buffer = static_cast<u8*>(Memory::Allocate(size));
-  if (!buffer) {
-    return Result::kFailedToReadFile;
+  // Use file from a mounted pack if there is one
+  VFS::File packed;
+  if (VFS::Find(path.GetView(), packed)) {
+    if (packed.data) {
+      return Load(packed.data, packed.size);
+    }
+
+    // Decompress file before decoding it
+    u8* data = static_cast<u8*>(Memory::Allocate(packed.size));
+    Result result = Result::kFailedToReadFile;
+    if (VFS::Read(packed, 0, packed.size, data) == FileResult::kSuccess) {
+      result = Load(data, packed.size);
+    }
+    Memory::Free(data);
+    return result;
   }
-  result = io.Read(buffer, size);
+
+  // Map file. The decoder reads it front to back, so it can be read ahead
+  MappedFile file(path);
+  const FileResult result = file.Open();
   if (result != FileResult::kSuccess) {
-    Memory::Free(buffer);
     return Result::kFailedToReadFile;
   }
+  file.Advise(MappedFile::Hint::kSequential | MappedFile::Hint::kWillNeed);
+  return Load(file.GetData(), file.GetSize());
+}
+
+// -------------------------------------------------------------------------- //
+
+Image::Result
+Image::Load(const u8* data, u64 size)
+{
+  if (size == 0 || size > u64(INT_MAX)) {
+    return Result::kFailedToLoadData;
+  }
 
-  // Load image data
+  // Load image data. The decoder allocates the pixels through 'Memory', which
+  // means that they can be adopted as the data of the image without a copy
   s32 x, y, c;
-  stbi_uc* data =
-    stbi_load_from_memory(buffer, (int)size, &x, &y, &c, STBI_default);
-  Memory::Free(buffer);
-  if (!data) {
+  stbi_uc* pixels =
+    stbi_load_from_memory(data, int(size), &x, &y, &c, STBI_default);
+  if (!pixels) {
     return Result::kFailedToLoadData;
   }
 
-  // Determine format
+  // Adopt data
+  SetData(pixels, u64(x) * u64(y) * u64(c));
   mWidth = u32(x);
   mHeight = u32(y);
-  mFormat = Format::kUnknown;
-  if (c == 1) {
-    mFormat = Format::kRed;
-  } else if (c == 3) {
-    mFormat = Format::kRGB;
-  } else if (c == 4) {
-    mFormat = Format::kRGBA;
-  }
-
-  // Copy data
-  mDataSize = u64(GetFormatRowStride(mFormat, mWidth)) * u64(mHeight);
-  mData = static_cast<u8*>(Memory::Allocate(mDataSize));
-  if (!mData) {
-    stbi_image_free(data);
+  mFormat = GetDecodedFormat(c);
+  mMipLevels = 1;
+
+  // Success
+  return Result::kSuccess;
+}
+
+// -------------------------------------------------------------------------- //
+
+Image::Result
+Image::GetInfo(const u8* data, u64 size, Info& info)
+{
+  if (size == 0 || size > u64(INT_MAX)) {
     return Result::kFailedToLoadData;
   }
-  Memory::Copy(mData, data, mDataSize);
-  stbi_image_free(data);
 
-  // Success
+  // Only the header is parsed
+  s32 x, y, c;
+  if (!stbi_info_from_memory(data, int(size), &x, &y, &c)) {
+    return Result::kFailedToLoadData;
+  }
+  info.width = u32(x);
+  info.height = u32(y);
+  info.format = GetDecodedFormat(c);
+  return Result::kSuccess;
+}
+
+// -------------------------------------------------------------------------- //
+
+Image::Result
+Image::Decode(const u8* data,
+              u64 size,
+              const Info& expected,
+              u8* destination,
+              u64 rowStride)
+{
+  if (size == 0 || size > u64(INT_MAX)) {
+    return Result::kFailedToLoadData;
+  }
+
+  // Decode image
+  s32 x, y, c;
+  stbi_uc* pixels =
+    stbi_load_from_memory(data, int(size), &x, &y, &c, STBI_default);
+  if (!pixels) {
+    return Result::kFailedToLoadData;
+  }
+  // The destination is sized for the expected image, so anything else is
+  // rejected before it's written
+  const u32 width = u32(x);
+  const u32 height = u32(y);
+  const Format decoded = GetDecodedFormat(c);
+  const Format format =
+    expected.format == Format::kUnknown ? decoded : expected.format;
+  if (decoded == Format::kUnknown || width != expected.width ||
+      height != expected.height ||
+      rowStride < GetFormatRowStride(format, width)) {
+    stbi_image_free(pixels);
+    return Result::kFailedToLoadData;
+  }
+
+  // Write the rows to the destination, converting them if the formats differ
+  const PixelConverter converter(decoded, format);
+  converter.Convert(pixels,
+                    GetFormatRowStride(decoded, width),
+                    destination,
+                    rowStride,
+                    width,
+                    height);
+  stbi_image_free(pixels);
   return Result::kSuccess;
 }
 
@@ -142,15 +542,13 @@ Image::Load(const Path& path)
 Image
 Image::Copy() const
 {
-  u8* data = static_cast<u8*>(Memory::Allocate(mDataSize));
-  Memory::Copy(data, mData, mDataSize);
-  return Image{ mWidth, mHeight, mFormat, data, mDataSize };
+  return Image{ *this };
 }
 
 // -------------------------------------------------------------------------- //
 
 Image::Result
-Image::Resize(u32 width, u32 height, Filter filter)
+Image::Resize(u32 width, u32 height, Filter filter, ColorSpace colorSpace)
 {
   // Function to convert filter type
   auto ConvFilter = [](Filter _filter) -> stbir_filter {
@@ -182,33 +580,80 @@ Image::Resize(u32 width, u32 height, Filter filter)
   // Create resized data
   const u64 dataSize = u64(GetFormatRowStride(mFormat, width)) * u64(height);
   u8* data = static_cast<u8*>(Memory::Allocate(dataSize));
-  const int success =
-    stbir_resize_uint8_generic(mData,
-                               mWidth,
-                               mHeight,
-                               0,
-                               data,
-                               width,
-                               height,
-                               0,
-                               GetFormatChannelCount(mFormat),
-                               GetFormatChannelCount(mFormat) == 4,
-                               0,
-                               STBIR_EDGE_CLAMP,
-                               ConvFilter(filter),
-                               STBIR_COLORSPACE_LINEAR,
-                               NULL);
-  if (!success) {
-    Memory::Free(data);
-    return Result::kUnknownError;
+
+  // Halving an image with a box or triangle filter is done by the vectorized
+  // mipmap generator, which matches the general resampler up to rounding
+  const bool isHalf = mWidth % 2 == 0 && mHeight % 2 == 0 &&
+                      width == mWidth / 2 && height == mHeight / 2;
+  if (isHalf && mFormat != Format::kUnknown &&
+      (filter == Filter::kBox || filter == Filter::kTriangle)) {
+    const MipGenerator generator(
+      mFormat,
+      filter == Filter::kBox ? MipFilter::kBox : MipFilter::kTriangle,
+      colorSpace);
+    generator.Downsample(mData, mWidth, mHeight, data);
+  } else {
+    // Resize bands of destination rows in parallel. Each band samples the
+    // whole source image, offset to the first row of the band
+    const u32 channelCount = GetFormatChannelCount(mFormat);
+    s32 alphaChannel = STBIR_ALPHA_CHANNEL_NONE;
+    if (mFormat == Format::kRGBA || mFormat == Format::kBGRA) {
+      alphaChannel = 3;
+    } else if (mFormat == Format::kAlpha) {
+      alphaChannel = 0;
+    }
+    const stbir_colorspace space = colorSpace == ColorSpace::kSRGB
+                                     ? STBIR_COLORSPACE_SRGB
+                                     : STBIR_COLORSPACE_LINEAR;
+    const u64 rowStride = GetFormatRowStride(mFormat, width);
+    const auto ResizeRows = [&](u32 begin, u32 end) {
+      return stbir_resize_subpixel(mData,
+                                   mWidth,
+                                   mHeight,
+                                   0,
+                                   data + rowStride * begin,
+                                   width,
+                                   end - begin,
+                                   0,
+                                   STBIR_TYPE_UINT8,
+                                   channelCount,
+                                   alphaChannel,
+                                   0,
+                                   STBIR_EDGE_CLAMP,
+                                   STBIR_EDGE_CLAMP,
+                                   ConvFilter(filter),
+                                   ConvFilter(filter),
+                                   space,
+                                   nullptr,
+                                   f32(width) / f32(mWidth),
+                                   f32(height) / f32(mHeight),
+                                   0.0f,
+                                   f32(begin));
+    };
+    std::atomic<bool> success{ true };
+    if (u64(width) * height < kResizeParallelThreshold) {
+      success = ResizeRows(0, height) != 0;
+    } else {
+      ThreadPool& pool = ThreadPool::GetGlobal();
+      const u64 bandCount = Min(u64(height), u64(pool.GetThreadCount()) * 4);
+      pool.ParallelFor(bandCount, [&](u64 band) {
+        if (!ResizeRows(u32(height * band / bandCount),
+                        u32(height * (band + 1) / bandCount))) {
+          success.store(false, std::memory_order_relaxed);
+        }
+      });
+    }
+    if (!success) {
+      Memory::Free(data);
+      return Result::kUnknownError;
+    }
   }
 
   // Update data
   mWidth = width;
   mHeight = height;
-  Memory::Free(mData);
-  mData = data;
-  mDataSize = dataSize;
+  mMipLevels = 1;
+  SetData(data, dataSize);
 
   // Success
   return Result::kSuccess;
@@ -248,27 +693,21 @@ Image::Blit(const Image& src,
          "Destination image Y offset plus height must not be greater than "
          "the height of the destination image");
 
-  // Fast-path?
-  if (mFormat == src.mFormat) {
-    // Copy rows
-    for (u32 row = 0; row < height; row++) {
-      const u32 bytesPerPixel = GetFormatChannelCount(mFormat);
-      u8* dstPointer =
-        mData + bytesPerPixel * (mWidth * (row + dstOffsetY) + dstOffsetX);
-      u8* srcPointer =
-        src.mData +
-        bytesPerPixel * (src.mWidth * (row + srcOffsetY) + srcOffsetX);
-      memcpy(dstPointer, srcPointer, bytesPerPixel * width);
-    }
-  } else { // Otherwise slow path (pixel-by-pixel)
-    for (u32 y = 0; y < height; y++) {
-      for (u32 x = 0; x < width; x++) {
-        SetPixel(x + dstOffsetX,
-                 y + dstOffsetY,
-                 src.GetPixel(x + srcOffsetX, y + srcOffsetY));
-      }
-    }
-  }
+  // Copy rows, converting the pixels if the formats differ
+  PrepareWrite();
+  const u32 srcBytesPerPixel = GetFormatChannelCount(src.mFormat);
+  const u32 dstBytesPerPixel = GetFormatChannelCount(mFormat);
+  const u64 srcStride = GetFormatRowStride(src.mFormat, src.mWidth);
+  const u64 dstStride = GetFormatRowStride(mFormat, mWidth);
+  const PixelConverter converter(src.mFormat, mFormat);
+  converter.Convert(src.mData + srcStride * srcOffsetY +
+                      u64(srcBytesPerPixel) * srcOffsetX,
+                    srcStride,
+                    mData + dstStride * dstOffsetY +
+                      u64(dstBytesPerPixel) * dstOffsetX,
+                    dstStride,
+                    width,
+                    height);
 
   // Success
   return Result::kSuccess;
@@ -276,13 +715,166 @@ Image::Blit(const Image& src,
 
 // -------------------------------------------------------------------------- //
 
+Image::Result
+Image::ConvertTo(Format format)
+{
+  if (mFormat == Format::kUnknown || format == Format::kUnknown) {
+    return Result::kUnknownError;
+  }
+  if (format == mFormat) {
+    return Result::kSuccess;
+  }
+
+  // Convert into new data. The mip levels are converted together with the
+  // first level, as all levels are tightly packed
+  const u64 pixelCount = mDataSize / GetFormatChannelCount(mFormat);
+  const u64 dataSize = pixelCount * GetFormatChannelCount(format);
+  u8* data = static_cast<u8*>(Memory::Allocate(dataSize));
+  if (!data) {
+    return Result::kUnknownError;
+  }
+  const PixelConverter converter(mFormat, format);
+  converter.Convert(mData, data, pixelCount);
+
+  // Update data
+  SetData(data, dataSize);
+  mFormat = format;
+  return Result::kSuccess;
+}
+
+// -------------------------------------------------------------------------- //
+
+Image::Result
+Image::GenerateMips(MipFilter filter, ColorSpace colorSpace)
+{
+  if (mFormat == Format::kUnknown || !mData) {
+    return Result::kUnknownError;
+  }
+
+  // Allocate data for the full chain and copy the first level into it
+  const u32 levelCount = GetMipLevelCount(mWidth, mHeight);
+  u64 dataSize = 0;
+  for (u32 level = 0; level < levelCount; level++) {
+    dataSize += u64(GetFormatRowStride(mFormat, GetMipWidth(level))) *
+                u64(GetMipHeight(level));
+  }
+  u8* data = static_cast<u8*>(Memory::Allocate(dataSize));
+  if (!data) {
+    return Result::kUnknownError;
+  }
+  Memory::Copy(data, mData, u64(GetStride()) * u64(mHeight));
+
+  // Generate the levels
+  const MipGenerator generator(mFormat, filter, colorSpace);
+  generator.Generate(data, mWidth, mHeight, levelCount);
+
+  // Update data
+  SetData(data, dataSize);
+  mMipLevels = levelCount;
+  return Result::kSuccess;
+}
+
+// -------------------------------------------------------------------------- //
+
 void
 Image::Fill(Color color)
 {
-  for (u32 y = 0; y < mHeight; y++) {
-    for (u32 x = 0; x < mWidth; x++) {
-      SetPixel(x, y, color);
+  // The rows are tightly packed, so the image is filled as a single span
+  PrepareWrite();
+  u8 pixel[4];
+  WritePixel(mFormat, pixel, color);
+  const u64 size = u64(GetFormatRowStride(mFormat, mWidth)) * mHeight;
+  FillPixels(mData,
+             size,
+             pixel,
+             GetFormatChannelCount(mFormat),
+             size >= kStreamThreshold);
+}
+
+// -------------------------------------------------------------------------- //
+
+void
+Image::FillRect(u32 x, u32 y, u32 width, u32 height, Color color)
+{
+  // Assert preconditions
+  Assert(x + width <= mWidth,
+         "X offset plus width must not be greater than the width of the image");
+  Assert(y + height <= mHeight,
+         "Y offset plus height must not be greater than the height of the "
+         "image");
+
+  // Fill each row of the rectangle
+  PrepareWrite();
+  u8 pixel[4];
+  WritePixel(mFormat, pixel, color);
+  const u32 bytesPerPixel = GetFormatChannelCount(mFormat);
+  const u64 stride = GetFormatRowStride(mFormat, mWidth);
+  const u64 rowSize = u64(bytesPerPixel) * width;
+  const bool stream = rowSize * height >= kStreamThreshold;
+  u8* row = mData + stride * y + u64(bytesPerPixel) * x;
+  for (u32 i = 0; i < height; i++, row += stride) {
+    FillPixels(row, rowSize, pixel, bytesPerPixel, stream);
+  }
+}
+
+// -------------------------------------------------------------------------- //
+
+void
+Image::Clear()
+{
+  PrepareWrite();
+  const u8 zero[4] = { 0, 0, 0, 0 };
+  const u64 size = u64(GetFormatRowStride(mFormat, mWidth)) * mHeight;
+  FillPixels(mData, size, zero, 1, size >= kStreamThreshold);
+}
+
+// -------------------------------------------------------------------------- //
+
+void
+Image::CopyRect(u32 srcX,
+                u32 srcY,
+                u32 width,
+                u32 height,
+                u32 dstX,
+                u32 dstY)
+{
+  // Assert preconditions
+  Assert(srcX + width <= mWidth && dstX + width <= mWidth,
+         "X offsets plus width must not be greater than the width of the "
+         "image");
+  Assert(srcY + height <= mHeight && dstY + height <= mHeight,
+         "Y offsets plus height must not be greater than the height of the "
+         "image");
+
+  // Copy rows. When the destination is below the source the rows are copied
+  // from the bottom up, so that source rows are not overwritten before they
+  // are copied. Overlap within a row is handled by the move
+  PrepareWrite();
+  const u32 bytesPerPixel = GetFormatChannelCount(mFormat);
+  const u64 stride = GetFormatRowStride(mFormat, mWidth);
+  const u64 rowSize = u64(bytesPerPixel) * width;
+  const u8* src = mData + stride * srcY + u64(bytesPerPixel) * srcX;
+  u8* dst = mData + stride * dstY + u64(bytesPerPixel) * dstX;
+  if (dstY > srcY) {
+    for (u32 i = height; i-- > 0;) {
+      std::memmove(dst + stride * i, src + stride * i, rowSize);
     }
+  } else {
+    for (u32 i = 0; i < height; i++) {
+      std::memmove(dst + stride * i, src + stride * i, rowSize);
+    }
+  }
+}
+
+// -------------------------------------------------------------------------- //
+
+void
+Image::FlipVertical()
+{
+  PrepareWrite();
+  const u64 stride = GetFormatRowStride(mFormat, mWidth);
+  for (u32 y = 0; y < mHeight / 2; y++) {
+    SwapBytes(mData + stride * y, mData + stride * (mHeight - 1 - y), stride);
   }
 }
 
@@ -291,22 +883,15 @@ Image::Fill(Color color)
 Image::Result
 Image::Save(const Path& path, bool overwrite, FileKind kind)
 {
-  // Context structure
-  struct Context
-  {
-    FileIO& io;
-    FileResult result;
+  // Write callback. The encoders write many small pieces, which are collected
+  // by the buffered writer. Errors are kept by the writer until it's closed
+  static auto WriteCallback = [](void* context, void* data, int size) {
+    static_cast<BufferedWriter*>(context)->Write(static_cast<u8*>(data),
+                                                 u64(size));
   };
 
-  // Write callback
-  static auto WriteCallback = [](void* _context, void* data, int size) {
-    auto context = static_cast<Context*>(_context);
-    context->result = context->io.Write(static_cast<u8*>(data), u64(size));
-  };
-
-  // Setup context
+  // Open file
   FileIO io(path);
-  Context context{ io, FileResult::kSuccess };
   FileIO::Flag ioFlags = FileIO::Flag::kWrite | FileIO::Flag::kCreate;
   if (overwrite) {
     ioFlags |= FileIO::Flag::kOverwrite;
@@ -317,10 +902,11 @@ Image::Save(const Path& path, bool overwrite, FileKind kind)
   }
 
   // Write file
+  BufferedWriter writer(io);
   int writeSuccess = false;
   if (kind == FileKind::kPng) {
     writeSuccess = stbi_write_png_to_func(WriteCallback,
-                                          &context,
+                                          &writer,
                                           mWidth,
                                           mHeight,
                                           GetFormatChannelCount(mFormat),
@@ -328,7 +914,7 @@ Image::Save(const Path& path, bool overwrite, FileKind kind)
                                           GetStride());
   } else if (kind == FileKind::kTga) {
     writeSuccess = stbi_write_tga_to_func(WriteCallback,
-                                          &context,
+                                          &writer,
                                           mWidth,
                                           mHeight,
                                           GetFormatChannelCount(mFormat),
@@ -338,8 +924,8 @@ Image::Save(const Path& path, bool overwrite, FileKind kind)
     return Result::kUnknownError;
   }
 
-  // Check result
-  if (context.result != FileResult::kSuccess) {
+  // Flush and close file
+  if (writer.Close() != FileResult::kSuccess) {
     return Result::kUnknownError;
   }
   return Result::kSuccess;
@@ -350,47 +936,13 @@ Image::Save(const Path& path, bool overwrite, FileKind kind)
 Color
 Image::GetPixel(u32 x, u32 y) const
 {
-  // Retrieve data
-  const u64 _x = (u64)x;
-  const u64 _y = (u64)y;
-  const u32 bytesPerPixel = GetFormatChannelCount(mFormat);
-  const u8* address =
-    mData + (_y * mWidth * bytesPerPixel) + (_x * bytesPerPixel);
-
-  // Set pixel
-  switch (mFormat) {
-    // Format:: RGBA
-    case Format::kRGBA: {
-      return Color(u32(address[0]), address[1], address[2], address[3]);
-    }
-    // Format:: RGBA
-    case Format::kBGRA: {
-      return Color(u32(address[2]), address[1], address[0], address[3]);
-    }
-    // Format:: RGBA
-    case Format::kRGB: {
-      return Color(u32(address[0]), address[1], address[2]);
-    }
-    // Format:: RGBA
-    case Format::kBGR: {
-      return Color(u32(address[2]), address[1], address[0]);
-    }
-    // Format: Red
-    case Format::kRed: {
-      return Color(address[0], 0u, 0u, 0u);
-    }
-    // Format: Alpha
-    case Format::kAlpha: {
-      return Color(0u, 0u, 0u, address[0]);
-    }
-    // Default
-    case Format::kUnknown: {
-      return Color(0u, 0u, 0u, 0u);
-    }
-    default: {
-      Panic("Invalid image format");
-    }
+  // Images of unknown format has no pixels to read
+  if (mFormat == Format::kUnknown) {
+    return Color(0u, 0u, 0u, 0u);
   }
+  Color color;
+  VisitImageView(*this, 0, [&](auto view) { color = view.GetPixel(x, y); });
+  return color;
 }
 
 // -------------------------------------------------------------------------- //
@@ -398,81 +950,116 @@ Image::GetPixel(u32 x, u32 y) const
 void
 Image::SetPixel(u32 x, u32 y, Color color)
 {
-  // Retrieve data
-  const u64 _x = (u64)x;
-  const u64 _y = (u64)y;
-  const u32 bytesPerPixel = GetFormatChannelCount(mFormat);
-  u8* address = mData + (_y * mWidth * bytesPerPixel) + (_x * bytesPerPixel);
-
-  // Set pixel
-  switch (mFormat) {
-    // Format:: RGBA
-    case Format::kRGBA: {
-      address[0] = color.Red();
-      address[1] = color.Green();
-      address[2] = color.Blue();
-      address[3] = color.Alpha();
-      break;
-    }
-    // Format:: RGBA
-    case Format::kBGRA: {
-      address[0] = color.Blue();
-      address[1] = color.Green();
-      address[2] = color.Red();
-      address[3] = color.Alpha();
-      break;
-    }
-    // Format:: RGBA
-    case Format::kRGB: {
-      address[0] = color.Red();
-      address[1] = color.Green();
-      address[2] = color.Blue();
-      break;
-    }
-    // Format:: RGBA
-    case Format::kBGR: {
-      address[0] = color.Blue();
-      address[1] = color.Green();
-      address[2] = color.Red();
-      break;
-    }
-    // Format: Red
-    case Format::kRed: {
-      address[0] = color.Red();
-      break;
-    }
-    // Format: Alpha
-    case Format::kAlpha: {
-      address[0] = color.Alpha();
-      break;
-    }
-    // Default
-    case Format::kUnknown: {
-      break;
-    }
-    default: {
-      Panic("Invalid image format");
-    }
+  PrepareWrite();
+  if (mFormat == Format::kUnknown) {
+    return;
   }
+  VisitImageView(*this, 0, [&](auto view) { view.SetPixel(x, y, color); });
 }
 
 // -------------------------------------------------------------------------- //
 
 u32
-Image::GetStride()
+Image::GetStride() const
 {
   return GetFormatRowStride(mFormat, mWidth);
 }
 
 // -------------------------------------------------------------------------- //
 
-Image::Image(u32 width, u32 height, Format format, u8* data, u64 dataSize)
-  : mWidth(width)
-  , mHeight(height)
-  , mFormat(format)
-  , mData(data)
-  , mDataSize(dataSize)
-{}
+u8*
+Image::GetMipData(u32 level)
+{
+  Detach();
+  return mData + GetMipOffset(level);
+}
+
+// -------------------------------------------------------------------------- //
+
+u8*
+Image::GetData()
+{
+  Detach();
+  return mData;
+}
+
+// -------------------------------------------------------------------------- //
+
+bool
+Image::IsShared() const
+{
+  return mStorage && mStorage->refCount.load(std::memory_order_acquire) > 1;
+}
+
+// -------------------------------------------------------------------------- //
+
+void
+Image::SetData(u8* data, u64 dataSize)
+{
+  Release();
+  if (data) {
+    mStorage = new Storage{ { 1 }, data };
+    mData = data;
+    mDataSize = dataSize;
+  }
+}
+
+// -------------------------------------------------------------------------- //
+
+void
+Image::Release()
+{
+  // The acquire-release decrement makes the writes of the other images that
+  // shared the storage visible before it is freed
+  if (mStorage &&
+      mStorage->refCount.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    Memory::Free(mStorage->data);
+    delete mStorage;
+  }
+  mStorage = nullptr;
+  mData = nullptr;
+  mDataSize = 0;
+}
+
+// -------------------------------------------------------------------------- //
+
+void
+Image::Detach()
+{
+  if (!IsShared()) {
+    return;
+  }
+  u8* data = static_cast<u8*>(Memory::Allocate(mDataSize));
+  Memory::Copy(data, mData, mDataSize);
+  SetData(data, mDataSize);
+}
+
+// -------------------------------------------------------------------------- //
+
+void
+Image::PrepareWrite()
+{
+  // The levels after the first are stored after it, so dropping them only
+  // shrinks the size of the data
+  if (mMipLevels > 1) {
+    mMipLevels = 1;
+    mDataSize = u64(GetStride()) * u64(mHeight);
+  }
+  Detach();
+}
+
+// -------------------------------------------------------------------------- //
+
+u64
+Image::GetMipOffset(u32 level) const
+{
+  u64 offset = 0;
+  for (u32 i = 0; i < level; i++) {
+    offset += u64(GetFormatRowStride(mFormat, GetMipWidth(i))) *
+              u64(GetMipHeight(i));
+  }
+  return offset;
+}
 
 // -------------------------------------------------------------------------- //
 
@@ -529,4 +1116,16 @@ Image::GetFormatRowStride(Format format, u32 width)
   }
 }
 
+// -------------------------------------------------------------------------- //
+
+u32
+Image::GetMipLevelCount(u32 width, u32 height)
+{
+  u32 count = 1;
+  for (u32 size = Max(width, height); size > 1; size >>= 1) {
+    count++;
+  }
+  return count;
+}
+
 }
@@ -30,6 +30,7 @@
 #include "olivine/core/types.hpp"
 #include "olivine/core/macros.hpp"
 #include "olivine/math/limits.hpp"
+#include "olivine/math/math.hpp"
 
 // ========================================================================== //
 // Image Declaration
@@ -47,11 +48,24 @@ OL_FORWARD_DECLARE(Color);
  * \details
  * Represents a CPU-side image that can be loaded from file or created from
  * scratch.
+ *
+ * An image can hold a mipmap chain, which is generated from the first level by
+ * 'Image::GenerateMips'. The levels are stored after each other in the data.
+ * Functions that work on pixels only use the first level. Functions that
+ * modify the pixels, like 'Image::Fill', 'Image::Blit' and 'Image::SetPixel',
+ * and functions that change the size of the image discard the other levels, so
+ * that a stale chain is never uploaded. 'Image::ConvertTo' converts all levels.
+ * Writes through 'Image::GetData' and 'Image::GetMipData' keep the chain.
+ *
+ * Copies of an image share the same data, which is reference-counted with an
+ * atomic count. The data is copied the first time that an image that shares it
+ * is modified, which includes calling the non-const 'Image::GetData' and
+ * 'Image::GetMipData'. Images that share data can be used from different
+ * threads, but a single image must not be modified by multiple threads at the
+ * same time.
  */
 class Image
 {
-  OL_NO_COPY(Image);
-
 public:
   /* Results */
   enum class Result
@@ -102,6 +116,26 @@ public:
     kMitchell
   };
 
+  /* Color spaces of image data */
+  enum class ColorSpace
+  {
+    /* Linear data, like normals or roughness */
+    kLinear,
+    /* sRGB encoded colors. Alpha is always linear */
+    kSRGB
+  };
+
+  /* Mipmap generation filters */
+  enum class MipFilter
+  {
+    /* 2x2 box filter, or 3 pixels wide along axes of odd size */
+    kBox,
+    /* 4x4 triangle filter */
+    kTriangle,
+    /* Kaiser-windowed sinc filter. This is sharper than the box filter */
+    kKaiser
+  };
+
   /* Image file kinds */
   enum class FileKind
   {
@@ -122,6 +156,18 @@ public:
     Format format;
   };
 
+  /* Information about an image file */
+  struct Info
+  {
+    /* Width of the image in pixels */
+    u32 width;
+    /* Height of the image in pixels */
+    u32 height;
+    /* Format that the image is decoded to. This is 'Format::kUnknown' if the
+     * image has a channel count that no format represents */
+    Format format;
+  };
+
 private:
   /** Width **/
   u32 mWidth = 0;
@@ -130,10 +176,17 @@ private:
   /** Format **/
   Format mFormat = Format::kUnknown;
 
-  /** Data **/
+  /** Shared storage of the data **/
+  struct Storage;
+
+  /** Storage of the data, shared with copies of the image **/
+  Storage* mStorage = nullptr;
+  /** Data, owned by the storage **/
   u8* mData = nullptr;
   /** Size of data **/
   u64 mDataSize = 0;
+  /** Number of mip levels in the data **/
+  u32 mMipLevels = 1;
 
 public:
   /** Construct an empty image with no data. This image cannot be used before
@@ -142,11 +195,38 @@ public:
    */
   Image() = default;
 
+  /** Construct an image that shares the data of another image.
+   * \brief Copy-construct image.
+   * \param other Image to share data with.
+   */
+  Image(const Image& other);
+
+  /** Construct an image by taking the data of another image, which is left
+   * empty.
+   * \brief Move-construct image.
+   * \param other Image to move.
+   */
+  Image(Image&& other) noexcept;
+
   /** Destruct the image.
    * \brief Destruct image.
    */
   ~Image();
 
+  /** Make the image share the data of another image.
+   * \brief Copy-assign image.
+   * \param other Image to share data with.
+   * \return Reference to this image.
+   */
+  Image& operator=(const Image& other);
+
+  /** Take the data of another image, which is left empty.
+   * \brief Move-assign image.
+   * \param other Image to move.
+   * \return Reference to this image.
+   */
+  Image& operator=(Image&& other) noexcept;
+
   /** Create an image from the specified creation information. The image will be
    * initialized with an empty data buffer. The entire data can be cleared to a
    * specific color by calling 'Fill' or by setting each pixel individually
@@ -164,24 +244,44 @@ public:
    */
   Result Load(const Path& path);
 
-  /** Create and return a copy of the image.
+  /** Load data for the image from the contents of an image file that is
+   * already in memory. The decoded pixels are adopted as the data of the
+   * image, without being copied.
+   * \brief Load image from memory.
+   * \param data Contents of the image file.
+   * \param size Size of the contents in bytes.
+   * \return Result.
+   */
+  Result Load(const u8* data, u64 size);
+
+  /** Create and return a copy of the image. The copy shares the data with the
+   * image until one of them is modified.
    * \brief Copy image.
    * \return Copy of the image.
    */
   Image Copy() const;
 
   /** Resize the image to the specified width and height using the specified
-   * filter for performing the sampling.
+   * filter for performing the sampling. Large images are resized in bands of
+   * rows on the global thread pool. Halving an image with even dimensions with
+   * the box or triangle filter takes a vectorized path. Any mipmap chain is
+   * discarded.
    * \brief Resize image.
    * \param width Width to resize to.
    * \param height Height to resize to.
    * \param filter Filter to use for sampling the image.
+   * \param colorSpace Color space of the color channels. sRGB encoded colors
+   * are linearized before they are filtered. Alpha is always linear.
    */
-  Result Resize(u32 width, u32 height, Filter filter = Filter::kDefault);
+  Result Resize(u32 width,
+                u32 height,
+                Filter filter = Filter::kDefault,
+                ColorSpace colorSpace = ColorSpace::kLinear);
 
   /** Blit the a sub-part of the 'src' texture onto the image. The part is
    * specified by the offsets on each respective image and the width and height
-   * of the sub-image to blit.
+   * of the sub-image to blit. The pixels are converted if the images have
+   * different formats, see 'Image::ConvertTo'.
    * \brief Blit image.
    * \param src Source image.
    * \param dstOffsetX X offset on the destination image to blit at.
@@ -204,12 +304,74 @@ public:
               u32 width = Limits::kU32Max,
               u32 height = Limits::kU32Max);
 
-  /** Fill the entire image with a solid color.
+  /** Convert the pixels of the image to another format. Channels that the
+   * current format does not have are set to 0, except for alpha which is set to
+   * 255 when converting from a 3-channel format.
+   * \brief Convert image format.
+   * \param format Format to convert to.
+   * \return Result.
+   * - Result::kUnknownError: The image or the format is unknown.
+   */
+  Result ConvertTo(Format format);
+
+  /** Generate a full mipmap chain for the image, down to a single pixel. All
+   * levels are stored in one allocation, after the first level. Any previous
+   * chain is replaced. Large levels are generated on the global thread pool.
+   * \brief Generate mipmaps.
+   * \param filter Filter to downsample with.
+   * \param colorSpace Color space of the color channels. sRGB colors are
+   * filtered in linear space.
+   * \return Result.
+   * - Result::kUnknownError: The image format is unknown or memory could not
+   * be allocated.
+   */
+  Result GenerateMips(MipFilter filter = MipFilter::kBox,
+                      ColorSpace colorSpace = ColorSpace::kSRGB);
+
+  /** Fill the entire image with a solid color. Large images are filled with
+   * non-temporal stores, that bypass the cache.
    * \brief Fill image.
    * \param color Color to fill image with.
    */
   void Fill(Color color);
 
+  /** Fill a rectangle of the image with a solid color.
+   * \brief Fill rectangle.
+   * \param x X offset of the rectangle.
+   * \param y Y offset of the rectangle.
+   * \param width Width of the rectangle.
+   * \param height Height of the rectangle.
+   * \param color Color to fill rectangle with.
+   */
+  void FillRect(u32 x, u32 y, u32 width, u32 height, Color color);
+
+  /** Clear all bytes of the image data to zero.
+   * \brief Clear image.
+   */
+  void Clear();
+
+  /** Copy a rectangle of the image to another position in the same image. The
+   * source and destination rectangles may overlap.
+   * \brief Copy rectangle.
+   * \param srcX X offset of the rectangle to copy.
+   * \param srcY Y offset of the rectangle to copy.
+   * \param width Width of the rectangle.
+   * \param height Height of the rectangle.
+   * \param dstX X offset to copy the rectangle to.
+   * \param dstY Y offset to copy the rectangle to.
+   */
+  void CopyRect(u32 srcX,
+                u32 srcY,
+                u32 width,
+                u32 height,
+                u32 dstX,
+                u32 dstY);
+
+  /** Flip the image vertically, so that the top row becomes the bottom row.
+   * \brief Flip image vertically.
+   */
+  void FlipVertical();
+
   /** Save the image to a file in the file system at the specified path.
    * \brief Save image.
    * \param path Path to save image at.
@@ -257,11 +419,51 @@ public:
    */
   Format GetFormat() const { return mFormat; }
 
-  /** Returns the underlying image data.
+  /** Returns the number of mip levels of the image. This is 1 unless mipmaps
+   * has been generated.
+   * \brief Returns mip level count.
+   * \return Number of mip levels.
+   */
+  u32 GetMipLevels() const { return mMipLevels; }
+
+  /** Returns the width of a mip level.
+   * \brief Returns mip width.
+   * \param level Mip level.
+   * \return Width.
+   */
+  u32 GetMipWidth(u32 level) const { return Max(1u, mWidth >> level); }
+
+  /** Returns the height of a mip level.
+   * \brief Returns mip height.
+   * \param level Mip level.
+   * \return Height.
+   */
+  u32 GetMipHeight(u32 level) const { return Max(1u, mHeight >> level); }
+
+  /** Returns the data of a mip level for writing. This copies the data first
+   * if it is shared with another image.
+   * \brief Returns mip data.
+   * \param level Mip level.
+   * \return Data of the level.
+   */
+  u8* GetMipData(u32 level);
+
+  /** Returns the data of a mip level.
+   * \brief Returns mip data.
+   * \param level Mip level.
+   * \return Data of the level.
+   */
+  const u8* GetMipData(u32 level) const
+  {
+    return level == 0 ? mData : mData + GetMipOffset(level);
+  }
+
+  /** Returns the underlying image data for writing. This copies the data first
+   * if it is shared with another image.
    * \brief Returns data.
    * \return Image data.
    */
-  u8* GetData() { return mData; }
+  u8* GetData();
 
   /** Returns the underlying image data.
    * \brief Returns data.
@@ -273,11 +475,31 @@ public:
    * \brief Returns stride.
    * \return Data stride.
    */
-  u32 GetStride();
+  u32 GetStride() const;
+
+  /** Returns whether the data of the image is shared with another image.
+   * \brief Returns whether data is shared.
+   * \return True if the data is shared otherwise false.
+   */
+  bool IsShared() const;
 
 private:
-  /** Internal constructor to construct an image from existing data **/
-  Image(u32 width, u32 height, Format format, u8* data, u64 dataSize);
+  /** Replace the data of the image with data that the image takes ownership
+   * of, and release the previous data **/
+  void SetData(u8* data, u64 dataSize);
+
+  /** Release the reference to the data, freeing it if this was the last **/
+  void Release();
+
+  /** Copy the data if it is shared, before the image is modified **/
+  void Detach();
+
+  /** Discard the mipmap chain and copy the data if it is shared, before the
+   * pixels of the first level are modified **/
+  void PrepareWrite();
+
+  /** Returns the offset of a mip level in the data **/
+  u64 GetMipOffset(u32 level) const;
 
 public:
   /** Returns the number of channels that a specific image format has.
@@ -293,6 +515,50 @@ public:
    * \return Row stride.
    */
   static u32 GetFormatRowStride(Format format, u32 width);
+
+  /** Returns the number of levels of a full mipmap chain for an image of the
+   * specified size.
+   * \brief Returns mip level count.
+   * \param width Width of the image.
+   * \param height Height of the image.
+   * \return Number of mip levels.
+   */
+  static u32 GetMipLevelCount(u32 width, u32 height);
+
+  /** Read the size and format of an image from the contents of an image file
+   * without decoding the pixels. This can be used to allocate the destination
+   * of 'Image::Decode'.
+   * \brief Returns image file information.
+   * \param data Contents of the image file.
+   * \param size Size of the contents in bytes.
+   * \param[out] info Information about the image.
+   * \return Result.
+   */
+  static Result GetInfo(const u8* data, u64 size, Info& info);
+
+  /** Decode the contents of an image file into memory that is owned by the
+   * caller, such as a mapped upload buffer, instead of into an image. The rows
+   * are written with the specified stride and converted to the specified
+   * format if it differs from the decoded format. Nothing is written unless
+   * the decoded image has the expected size and the rows fit in the stride.
+   * \brief Decode image into memory.
+   * \param data Contents of the image file.
+   * \param size Size of the contents in bytes.
+   * \param expected Expected width and height of the image, usually from
+   * 'Image::GetInfo', and the format to write the pixels in. A format of
+   * 'Format::kUnknown' writes them in the decoded format.
+   * \param destination Destination of the first row. This must be large
+   * enough to hold 'expected.height' rows of 'rowStride' bytes.
+   * \param rowStride Distance between the rows in the destination in bytes.
+   * \return Result.
+   * - Result::kFailedToLoadData: The data could not be decoded, the image does
+   * not have the expected size or the stride is smaller than a row.
+   */
+  static Result Decode(const u8* data,
+                       u64 size,
+                       const Info& expected,
+                       u8* destination,
+                       u64 rowStride);
 };
 
 }
\ No newline at end of file
@@ -0,0 +1,668 @@
+// MIT License
+//
+// Copyright (c) 2019 Filip Björklund
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+// ========================================================================== //
+// Headers
+// ========================================================================== //
+
+// Standard headers
+#include <type_traits>
+
+// Project headers
+#include "olivine/core/assert.hpp"
+#include "olivine/core/image.hpp"
+#include "olivine/core/macros.hpp"
+#include "olivine/core/types.hpp"
+#include "olivine/render/color.hpp"
+
+// ========================================================================== //
+// PixelLayout Declaration
+// ========================================================================== //
+
+namespace olivine {
+
+/** \class PixelLayout
+ * \author Filip Björklund
+ * \date 19 october 2026 - 14:10
+ * \tparam F Image format.
+ * \brief Compile-time layout of the pixels of an image format.
+ * \details
+ * Holds the size of a pixel and the byte offset of each channel in it, or -1
+ * for channels that the format does not have. The offsets let pixel accessors
+ * be resolved at compile time instead of switching on the format per pixel.
+ *
+ * Missing channels read as 0, except alpha which reads as 255 for the 3-channel
+ * formats. This matches 'Image::GetPixel'.
+ */
+template<Image::Format F>
+struct PixelLayout;
+
+// -------------------------------------------------------------------------- //
+
+/** \copydoc olivine::PixelLayout **/
+template<>
+struct PixelLayout<Image::Format::kRGBA>
+{
+  static constexpr u32 kSize = 4;
+  static constexpr s32 kRed = 0;
+  static constexpr s32 kGreen = 1;
+  static constexpr s32 kBlue = 2;
+  static constexpr s32 kAlpha = 3;
+};
+
+// -------------------------------------------------------------------------- //
+
+/** \copydoc olivine::PixelLayout **/
+template<>
+struct PixelLayout<Image::Format::kBGRA>
+{
+  static constexpr u32 kSize = 4;
+  static constexpr s32 kRed = 2;
+  static constexpr s32 kGreen = 1;
+  static constexpr s32 kBlue = 0;
+  static constexpr s32 kAlpha = 3;
+};
+
+// -------------------------------------------------------------------------- //
+
+/** \copydoc olivine::PixelLayout **/
+template<>
+struct PixelLayout<Image::Format::kRGB>
+{
+  static constexpr u32 kSize = 3;
+  static constexpr s32 kRed = 0;
+  static constexpr s32 kGreen = 1;
+  static constexpr s32 kBlue = 2;
+  static constexpr s32 kAlpha = -1;
+};
+
+// -------------------------------------------------------------------------- //
+
+/** \copydoc olivine::PixelLayout **/
+template<>
+struct PixelLayout<Image::Format::kBGR>
+{
+  static constexpr u32 kSize = 3;
+  static constexpr s32 kRed = 2;
+  static constexpr s32 kGreen = 1;
+  static constexpr s32 kBlue = 0;
+  static constexpr s32 kAlpha = -1;
+};
+
+// -------------------------------------------------------------------------- //
+
+/** \copydoc olivine::PixelLayout **/
+template<>
+struct PixelLayout<Image::Format::kRed>
+{
+  static constexpr u32 kSize = 1;
+  static constexpr s32 kRed = 0;
+  static constexpr s32 kGreen = -1;
+  static constexpr s32 kBlue = -1;
+  static constexpr s32 kAlpha = -1;
+};
+
+// -------------------------------------------------------------------------- //
+
+/** \copydoc olivine::PixelLayout **/
+template<>
+struct PixelLayout<Image::Format::kAlpha>
+{
+  static constexpr u32 kSize = 1;
+  static constexpr s32 kRed = -1;
+  static constexpr s32 kGreen = -1;
+  static constexpr s32 kBlue = -1;
+  static constexpr s32 kAlpha = 0;
+};
+
+}
+
+// ========================================================================== //
+// BasicImageView Declaration
+// ========================================================================== //
+
+namespace olivine {
+
+/** \class BasicImageView
+ * \author Filip Björklund
+ * \date 19 october 2026 - 14:10
+ * \tparam F Format of the pixels.
+ * \tparam T Type of the bytes, 'const u8' for read-only views and 'u8' for
+ * mutable views.
+ * \brief View of the pixels of an image with a format known at compile time.
+ * \details
+ * Views a rectangle of pixels that is laid out as rows with an explicit stride
+ * in bytes. The view does not own the pixels, which must outlive it. Views of
+ * sub-rectangles are created without copying by offsetting the data and
+ * keeping the stride.
+ *
+ * The pixel accessors use the 'PixelLayout' of the format, so loops over a view
+ * compile to plain loads and stores without branching on the format. Iterating
+ * a view yields its rows:
+ * \code
+ * for (auto row : view) {
+ *   for (u32 x = 0; x < row.GetWidth(); x++) {
+ *     row.SetPixel(x, Color::kRed);
+ *   }
+ * }
+ * \endcode
+ *
+ * Use the 'ImageView' and 'MutableImageView' aliases rather than this class.
+ * Code that handles any format can call 'VisitImageView', which calls a generic
+ * function with the view type that matches the format of an image.
+ */
+template<Image::Format F, typename T>
+class BasicImageView
+{
+  static_assert(std::is_same<std::remove_const_t<T>, u8>::value,
+                "Image views are views of bytes");
+
+public:
+  /** Layout of the pixels **/
+  using Layout = PixelLayout<F>;
+
+  /** Image type that the view can be created from **/
+  using ImageType =
+    std::conditional_t<std::is_const<T>::value, const Image, Image>;
+
+  /** Whether the pixels can be written through the view **/
+  static constexpr bool kIsMutable = !std::is_const<T>::value;
+
+  /** Format of the pixels **/
+  static constexpr Image::Format kFormat = F;
+
+  /** Row of pixels in a view **/
+  class Row
+  {
+  private:
+    /** Data of the first pixel **/
+    T* mData;
+    /** Width in pixels **/
+    u32 mWidth;
+
+  public:
+    /** Construct row **/
+    Row(T* data, u32 width);
+
+    /** Returns the data of a pixel **/
+    T* GetPixelData(u32 x) const;
+
+    /** Returns a pixel **/
+    Color GetPixel(u32 x) const;
+
+    /** Set a pixel. Only available for mutable views **/
+    void SetPixel(u32 x, Color color) const;
+
+    /** Returns the data of the first pixel **/
+    T* GetData() const { return mData; }
+
+    /** Returns the width in pixels **/
+    u32 GetWidth() const { return mWidth; }
+  };
+
+  /** Iterator over the rows of a view **/
+  class RowIterator
+  {
+  private:
+    /** Data of the first pixel of the current row **/
+    T* mData;
+    /** Stride between rows in bytes **/
+    u64 mStride;
+    /** Width of the rows in pixels **/
+    u32 mWidth;
+
+  public:
+    /** Construct iterator **/
+    RowIterator(T* data, u64 stride, u32 width);
+
+    /** Next row **/
+    RowIterator& operator++();
+
+    /** Check inequality **/
+    bool operator!=(const RowIterator& other) const;
+
+    /** Retrieve row **/
+    Row operator*() const;
+  };
+
+private:
+  /** Data of the top-left pixel **/
+  T* mData = nullptr;
+  /** Width in pixels **/
+  u32 mWidth = 0;
+  /** Height in pixels **/
+  u32 mHeight = 0;
+  /** Stride between rows in bytes **/
+  u64 mStride = 0;
+
+public:
+  /** Construct an empty view **/
+  BasicImageView() = default;
+
+  /** Construct a view of pixels in memory.
+   * \brief Construct view.
+   * \param data Data of the top-left pixel.
+   * \param width Width in pixels.
+   * \param height Height in pixels.
+   * \param stride Stride between rows in bytes. This must be at least the size
+   * of a row.
+   */
+  BasicImageView(T* data, u32 width, u32 height, u64 stride);
+
+  /** Construct a view of a mip level of an image. The image must have the
+   * format of the view.
+   * \brief Construct view of image.
+   * \param image Image to view.
+   * \param mipLevel Mip level to view.
+   */
+  explicit BasicImageView(ImageType& image, u32 mipLevel = 0);
+
+  /** Convert a mutable view to a read-only view **/
+  operator BasicImageView<F, const u8>() const;
+
+  /** Returns a view of a sub-rectangle of the view. No pixels are copied.
+   * \brief Returns sub-view.
+   * \param x X offset of the sub-rectangle.
+   * \param y Y offset of the sub-rectangle.
+   * \param width Width of the sub-rectangle.
+   * \param height Height of the sub-rectangle.
+   * \return Sub-view.
+   */
+  BasicImageView GetSubView(u32 x, u32 y, u32 width, u32 height) const;
+
+  /** Returns a row of the view.
+   * \brief Returns row.
+   * \param y Index of the row.
+   * \return Row.
+   */
+  Row GetRow(u32 y) const;
+
+  /** Returns the data of a pixel.
+   * \brief Returns pixel data.
+   * \param x X coordinate of the pixel.
+   * \param y Y coordinate of the pixel.
+   * \return Data of the pixel.
+   */
+  T* GetPixelData(u32 x, u32 y) const;
+
+  /** Returns a pixel.
+   * \brief Returns pixel.
+   * \param x X coordinate of the pixel.
+   * \param y Y coordinate of the pixel.
+   * \return Pixel.
+   */
+  Color GetPixel(u32 x, u32 y) const;
+
+  /** Set a pixel. Only available for mutable views.
+   * \brief Set pixel.
+   * \param x X coordinate of the pixel.
+   * \param y Y coordinate of the pixel.
+   * \param color Color to set.
+   */
+  void SetPixel(u32 x, u32 y, Color color) const;
+
+  /** Returns an iterator to the first row **/
+  RowIterator begin() const;
+
+  /** Returns an iterator past the last row **/
+  RowIterator end() const;
+
+  /** Returns the data of the top-left pixel **/
+  T* GetData() const { return mData; }
+
+  /** Returns the width in pixels **/
+  u32 GetWidth() const { return mWidth; }
+
+  /** Returns the height in pixels **/
+  u32 GetHeight() const { return mHeight; }
+
+  /** Returns the stride between rows in bytes **/
+  u64 GetStride() const { return mStride; }
+
+public:
+  /** Read a pixel from its data **/
+  static Color Load(const u8* pixel);
+
+  /** Read a pixel from its data as four RGBA bytes, with the same values as
+   * 'BasicImageView::Load' **/
+  static void LoadRGBA(const u8* pixel, u8* rgba);
+
+  /** Write a pixel to its data **/
+  static void Store(u8* pixel, Color color);
+};
+
+// -------------------------------------------------------------------------- //
+
+/** Read-only view of the pixels of an image **/
+template<Image::Format F>
+using ImageView = BasicImageView<F, const u8>;
+
+/** Mutable view of the pixels of an image **/
+template<Image::Format F>
+using MutableImageView = BasicImageView<F, u8>;
+
+// -------------------------------------------------------------------------- //
+
+/** Call a generic function with a view of a mip level of an image, of the type
+ * that matches the format of the image. The function is instantiated for each
+ * format, which lets generic pixel loops be specialized per format while the
+ * format is only checked once.
+ * \brief Visit image with view.
+ * \tparam I 'Image' or 'const Image', for mutable or read-only views.
+ * \tparam FN Type of the function.
+ * \param image Image to visit. The format must not be
+ * 'Image::Format::kUnknown'.
+ * \param mipLevel Mip level to view.
+ * \param function Function to call with the view.
+ */
+template<typename I, typename FN>
+void
+VisitImageView(I& image, u32 mipLevel, FN&& function);
+
+}
+
+// ========================================================================== //
+// BasicImageView Implementation
+// ========================================================================== //
+
+namespace olivine {
+
+template<Image::Format F, typename T>
+BasicImageView<F, T>::Row::Row(T* data, u32 width)
+  : mData(data)
+  , mWidth(width)
+{}
+
+// -------------------------------------------------------------------------- //
+
+template<Image::Format F, typename T>
+T*
+BasicImageView<F, T>::Row::GetPixelData(u32 x) const
+{
+  OL_ASSERT(x < mWidth, "Image view pixel out of bounds");
+  return mData + u64(x) * Layout::kSize;
+}
+
+// -------------------------------------------------------------------------- //
+
+template<Image::Format F, typename T>
+Color
+BasicImageView<F, T>::Row::GetPixel(u32 x) const
+{
+  return Load(GetPixelData(x));
+}
+
+// -------------------------------------------------------------------------- //
+
+template<Image::Format F, typename T>
+void
+BasicImageView<F, T>::Row::SetPixel(u32 x, Color color) const
+{
+  static_assert(kIsMutable, "Cannot set pixels through a read-only view");
+  Store(GetPixelData(x), color);
+}
+
+// -------------------------------------------------------------------------- //
+
+template<Image::Format F, typename T>
+BasicImageView<F, T>::RowIterator::RowIterator(T* data, u64 stride, u32 width)
+  : mData(data)
+  , mStride(stride)
+  , mWidth(width)
+{}
+
+// -------------------------------------------------------------------------- //
+
+template<Image::Format F, typename T>
+typename BasicImageView<F, T>::RowIterator&
+BasicImageView<F, T>::RowIterator::operator++()
+{
+  mData += mStride;
+  return *this;
+}
+
+// -------------------------------------------------------------------------- //
+
+template<Image::Format F, typename T>
+bool
+BasicImageView<F, T>::RowIterator::operator!=(const RowIterator& other) const
+{
+  return mData != other.mData;
+}
+
+// -------------------------------------------------------------------------- //
+
+template<Image::Format F, typename T>
+typename BasicImageView<F, T>::Row
+BasicImageView<F, T>::RowIterator::operator*() const
+{
+  return Row(mData, mWidth);
+}
+
+// -------------------------------------------------------------------------- //
+
+template<Image::Format F, typename T>
+BasicImageView<F, T>::BasicImageView(T* data, u32 width, u32 height, u64 stride)
+  : mData(data)
+  , mWidth(width)
+  , mHeight(height)
+  , mStride(stride)
+{
+  OL_ASSERT(stride >= u64(width) * Layout::kSize,
+            "Image view stride must be at least the size of a row");
+}
+
+// -------------------------------------------------------------------------- //
+
+template<Image::Format F, typename T>
+BasicImageView<F, T>::BasicImageView(ImageType& image, u32 mipLevel)
+{
+  // Views are created for single pixel accesses, so the messages are only
+  // created when a check fails
+  if (image.GetFormat() != F) {
+    Panic("Image view format does not match image");
+  }
+  if (mipLevel >= image.GetMipLevels()) {
+    Panic("Image view mip level out of bounds");
+  }
+  mData = image.GetMipData(mipLevel);
+  mWidth = image.GetMipWidth(mipLevel);
+  mHeight = image.GetMipHeight(mipLevel);
+  mStride = u64(mWidth) * Layout::kSize;
+}
+
+// -------------------------------------------------------------------------- //
+
+template<Image::Format F, typename T>
+BasicImageView<F, T>::operator BasicImageView<F, const u8>() const
+{
+  return BasicImageView<F, const u8>(mData, mWidth, mHeight, mStride);
+}
+
+// -------------------------------------------------------------------------- //
+
+template<Image::Format F, typename T>
+BasicImageView<F, T>
+BasicImageView<F, T>::GetSubView(u32 x, u32 y, u32 width, u32 height) const
+{
+  if (u64(x) + width > mWidth || u64(y) + height > mHeight) {
+    Panic("Image sub-view must be inside the view");
+  }
+  return BasicImageView(mData + mStride * y + u64(x) * Layout::kSize,
+                        width,
+                        height,
+                        mStride);
+}
+
+// -------------------------------------------------------------------------- //
+
+template<Image::Format F, typename T>
+typename BasicImageView<F, T>::Row
+BasicImageView<F, T>::GetRow(u32 y) const
+{
+  OL_ASSERT(y < mHeight, "Image view row out of bounds");
+  return Row(mData + mStride * y, mWidth);
+}
+
+// -------------------------------------------------------------------------- //
+
+template<Image::Format F, typename T>
+T*
+BasicImageView<F, T>::GetPixelData(u32 x, u32 y) const
+{
+  OL_ASSERT(x < mWidth && y < mHeight, "Image view pixel out of bounds");
+  return mData + mStride * y + u64(x) * Layout::kSize;
+}
+
+// -------------------------------------------------------------------------- //
+
+template<Image::Format F, typename T>
+Color
+BasicImageView<F, T>::GetPixel(u32 x, u32 y) const
+{
+  return Load(GetPixelData(x, y));
+}
+
+// -------------------------------------------------------------------------- //
+
+template<Image::Format F, typename T>
+void
+BasicImageView<F, T>::SetPixel(u32 x, u32 y, Color color) const
+{
+  static_assert(kIsMutable, "Cannot set pixels through a read-only view");
+  Store(GetPixelData(x, y), color);
+}
+
+// -------------------------------------------------------------------------- //
+
+template<Image::Format F, typename T>
+typename BasicImageView<F, T>::RowIterator
+BasicImageView<F, T>::begin() const
+{
+  return RowIterator(mData, mStride, mWidth);
+}
+
+// -------------------------------------------------------------------------- //
+
+template<Image::Format F, typename T>
+typename BasicImageView<F, T>::RowIterator
+BasicImageView<F, T>::end() const
+{
+  return RowIterator(mData + mStride * mHeight, mStride, mWidth);
+}
+
+// -------------------------------------------------------------------------- //
+
+template<Image::Format F, typename T>
+Color
+BasicImageView<F, T>::Load(const u8* pixel)
+{
+  u8 rgba[4];
+  LoadRGBA(pixel, rgba);
+  return Color(u32(rgba[0]), rgba[1], rgba[2], rgba[3]);
+}
+
+// -------------------------------------------------------------------------- //
+
+template<Image::Format F, typename T>
+void
+BasicImageView<F, T>::LoadRGBA(const u8* pixel, u8* rgba)
+{
+  // Missing channels are resolved at compile time
+  rgba[0] = rgba[1] = rgba[2] = 0;
+  rgba[3] = Layout::kSize == 3 ? 255 : 0;
+  if constexpr (Layout::kRed >= 0) {
+    rgba[0] = pixel[Layout::kRed];
+  }
+  if constexpr (Layout::kGreen >= 0) {
+    rgba[1] = pixel[Layout::kGreen];
+  }
+  if constexpr (Layout::kBlue >= 0) {
+    rgba[2] = pixel[Layout::kBlue];
+  }
+  if constexpr (Layout::kAlpha >= 0) {
+    rgba[3] = pixel[Layout::kAlpha];
+  }
+}
+
+// -------------------------------------------------------------------------- //
+
+template<Image::Format F, typename T>
+void
+BasicImageView<F, T>::Store(u8* pixel, Color color)
+{
+  if constexpr (Layout::kRed >= 0) {
+    pixel[Layout::kRed] = color.Red();
+  }
+  if constexpr (Layout::kGreen >= 0) {
+    pixel[Layout::kGreen] = color.Green();
+  }
+  if constexpr (Layout::kBlue >= 0) {
+    pixel[Layout::kBlue] = color.Blue();
+  }
+  if constexpr (Layout::kAlpha >= 0) {
+    pixel[Layout::kAlpha] = color.Alpha();
+  }
+}
+
+// -------------------------------------------------------------------------- //
+
+template<typename I, typename FN>
+void
+VisitImageView(I& image, u32 mipLevel, FN&& function)
+{
+  // Bytes are const for const images
+  using T = std::conditional_t<std::is_const<I>::value, const u8, u8>;
+  switch (image.GetFormat()) {
+    case Image::Format::kRGBA: {
+      function(BasicImageView<Image::Format::kRGBA, T>(image, mipLevel));
+      break;
+    }
+    case Image::Format::kBGRA: {
+      function(BasicImageView<Image::Format::kBGRA, T>(image, mipLevel));
+      break;
+    }
+    case Image::Format::kRGB: {
+      function(BasicImageView<Image::Format::kRGB, T>(image, mipLevel));
+      break;
+    }
+    case Image::Format::kBGR: {
+      function(BasicImageView<Image::Format::kBGR, T>(image, mipLevel));
+      break;
+    }
+    case Image::Format::kRed: {
+      function(BasicImageView<Image::Format::kRed, T>(image, mipLevel));
+      break;
+    }
+    case Image::Format::kAlpha: {
+      function(BasicImageView<Image::Format::kAlpha, T>(image, mipLevel));
+      break;
+    }
+    default: {
+      Panic("Cannot visit image of unknown format");
+    }
+  }
+}
+
+}
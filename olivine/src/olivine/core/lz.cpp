@@ -0,0 +1,263 @@
+// MIT License
+//
+// Copyright (c) 2019 Filip Björklund
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "olivine/core/lz.hpp"
+
+// ========================================================================== //
+// Headers
+// ========================================================================== //
+
+// Standard headers
+#include <algorithm>
+#include <cstring>
+
+// ========================================================================== //
+// LZ Implementation
+// ========================================================================== //
+
+namespace olivine {
+
+/** Number of bits in the hash of the match finder **/
+static constexpr u32 kHashBits = 14;
+
+// -------------------------------------------------------------------------- //
+
+/** Read 4 bytes from unaligned memory **/
+static u32
+Load32(const u8* data)
+{
+  u32 value;
+  memcpy(&value, data, sizeof(value));
+  return value;
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Hash 4 bytes for the match finder **/
+static u32
+Hash32(u32 value)
+{
+  return (value * 2654435761u) >> (32 - kHashBits);
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Write the extension bytes of a length that did not fit in a nibble.
+ * Returns the new output position or nullptr if it did not fit **/
+static u8*
+WriteLength(u8* out, const u8* end, u64 length)
+{
+  for (; length >= 255; length -= 255) {
+    if (out == end) {
+      return nullptr;
+    }
+    *out++ = 255;
+  }
+  if (out == end) {
+    return nullptr;
+  }
+  *out++ = u8(length);
+  return out;
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Read the extension bytes of a length that did not fit in a nibble.
+ * Returns false if the data ended **/
+static bool
+ReadLength(const u8*& in, const u8* end, u64& length)
+{
+  u8 byte;
+  do {
+    if (in == end) {
+      return false;
+    }
+    byte = *in++;
+    length += byte;
+  } while (byte == 255);
+  return true;
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Write a command. A match length of 0 means that there is no match **/
+static u8*
+WriteCommand(u8* out,
+             const u8* end,
+             const u8* literals,
+             u64 literalCount,
+             u32 offset,
+             u64 matchLength)
+{
+  if (out == end) {
+    return nullptr;
+  }
+  const u64 matchCode = matchLength > 0 ? matchLength - LZ::kMinMatch : 0;
+  u8* token = out++;
+  *token = u8((std::min<u64>(literalCount, 15) << 4) |
+              std::min<u64>(matchCode, 15));
+  if (literalCount >= 15 && !(out = WriteLength(out, end, literalCount - 15))) {
+    return nullptr;
+  }
+  if (u64(end - out) < literalCount) {
+    return nullptr;
+  }
+  memcpy(out, literals, literalCount);
+  out += literalCount;
+  if (matchLength == 0) {
+    return out;
+  }
+  if (end - out < 2) {
+    return nullptr;
+  }
+  *out++ = u8(offset);
+  *out++ = u8(offset >> 8);
+  if (matchCode >= 15 && !(out = WriteLength(out, end, matchCode - 15))) {
+    return nullptr;
+  }
+  return out;
+}
+
+// -------------------------------------------------------------------------- //
+
+u64
+LZ::Compress(const u8* source, u64 size, u8* destination, u64 capacity)
+{
+  // Positions of the last occurrence of each hash. Blocks are expected to be
+  // smaller than 4 GiB, positions in larger data wrap and are rejected by the
+  // offset check
+  u32 table[1u << kHashBits];
+  memset(table, 0, sizeof(table));
+
+  u8* out = destination;
+  const u8* end = destination + capacity;
+  u64 anchor = 0;
+  u64 position = 1;
+  while (size >= kMinMatch && position <= size - kMinMatch) {
+    // Look for a match at the position
+    const u32 sequence = Load32(source + position);
+    const u32 hash = Hash32(sequence);
+    const u64 candidate = table[hash];
+    table[hash] = u32(position);
+    const u64 offset = position - candidate;
+    if (candidate >= position || offset > kMaxOffset ||
+        Load32(source + candidate) != sequence) {
+      // Skip faster through data that does not compress
+      position += 1 + ((position - anchor) >> 6);
+      continue;
+    }
+
+    // Extend the match backwards over the literals, and then forwards
+    u64 start = position;
+    u64 match = candidate;
+    while (start > anchor && match > 0 &&
+           source[start - 1] == source[match - 1]) {
+      start--;
+      match--;
+    }
+    u64 length = position - start + kMinMatch;
+    while (start + length < size &&
+           source[start + length] == source[match + length]) {
+      length++;
+    }
+
+    out = WriteCommand(
+      out, end, source + anchor, start - anchor, u32(offset), length);
+    if (!out) {
+      return 0;
+    }
+    anchor = start + length;
+    position = anchor;
+
+    // Insert a position inside of the match to find repeats more often
+    if (position >= 2 && position - 2 <= size - kMinMatch) {
+      table[Hash32(Load32(source + position - 2))] = u32(position - 2);
+    }
+  }
+
+  // Write the remaining literals
+  out = WriteCommand(out, end, source + anchor, size - anchor, 0, 0);
+  return out ? u64(out - destination) : 0;
+}
+
+// -------------------------------------------------------------------------- //
+
+bool
+LZ::Decompress(const u8* source, u64 sourceSize, u8* destination, u64 size)
+{
+  const u8* in = source;
+  const u8* inEnd = source + sourceSize;
+  u8* out = destination;
+  u8* outEnd = destination + size;
+  while (in != inEnd) {
+    // Copy literals
+    const u8 token = *in++;
+    u64 literalCount = token >> 4;
+    if (literalCount == 15 && !ReadLength(in, inEnd, literalCount)) {
+      return false;
+    }
+    if (u64(inEnd - in) < literalCount || u64(outEnd - out) < literalCount) {
+      return false;
+    }
+    memcpy(out, in, literalCount);
+    in += literalCount;
+    out += literalCount;
+
+    // The last command only has literals
+    if (in == inEnd) {
+      break;
+    }
+
+    // Copy match
+    if (inEnd - in < 2) {
+      return false;
+    }
+    const u64 offset = u64(in[0]) | (u64(in[1]) << 8);
+    in += 2;
+    u64 length = token & 15;
+    if (length == 15 && !ReadLength(in, inEnd, length)) {
+      return false;
+    }
+    length += kMinMatch;
+    if (offset == 0 || offset > u64(out - destination) ||
+        u64(outEnd - out) < length) {
+      return false;
+    }
+    const u8* match = out - offset;
+    if (offset == 1) {
+      memset(out, *match, length);
+      out += length;
+    } else {
+      // Overlapping matches repeat the last 'offset' bytes, so copy at most
+      // 'offset' bytes at a time to never read bytes that are not written yet
+      for (u64 count; length > 0; length -= count) {
+        count = std::min(length, offset);
+        memcpy(out, match, count);
+        out += count;
+        match += count;
+      }
+    }
+  }
+  return out == outEnd;
+}
+
+}
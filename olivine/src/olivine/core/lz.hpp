@@ -0,0 +1,108 @@
+// MIT License
+//
+// Copyright (c) 2019 Filip Björklund
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+// ========================================================================== //
+// Headers
+// ========================================================================== //
+
+// Project headers
+#include "olivine/core/types.hpp"
+#include "olivine/core/macros.hpp"
+
+// ========================================================================== //
+// LZ Declaration
+// ========================================================================== //
+
+namespace olivine {
+
+/** \class LZ
+ * \author Filip Björklund
+ * \date 18 october 2026 - 19:10
+ * \brief Fast LZ77 compression.
+ * \details
+ * Namespace class with a byte-oriented LZ77 codec in the style of LZ4. It
+ * trades compression ratio for decompression speed, which is several GB/s per
+ * core, so that decompressing data is faster than reading it from disk.
+ *
+ * The compressed data is a sequence of commands. Each command starts with a
+ * token byte where the high nibble is the number of literals and the low nibble
+ * is the length of the match minus 'kMinMatch'. A nibble of 15 is followed by
+ * bytes that are added to it, until a byte that is not 255. Then follows the
+ * literals, and a 16-bit little-endian offset back to the match. The last
+ * command only has literals.
+ *
+ * Offsets are limited to 64 KiB, so the data is meant to be compressed in
+ * blocks of around that size or larger, that can be decompressed separately.
+ */
+class LZ
+{
+  OL_NAMESPACE_CLASS(LZ);
+
+public:
+  /** Minimum length of a match **/
+  static constexpr u32 kMinMatch = 4;
+  /** Maximum offset of a match **/
+  static constexpr u32 kMaxOffset = 65535;
+
+public:
+  /** Returns the maximum size of the compressed data for data of the specified
+   * size. Compressing into a buffer of this size never fails.
+   * \brief Returns maximum compressed size.
+   * \param size Size of the data to compress.
+   * \return Maximum compressed size.
+   */
+  static constexpr u64 GetMaxCompressedSize(u64 size)
+  {
+    return size + size / 255 + 16;
+  }
+
+  /** Compress data.
+   * \brief Compress data.
+   * \param source Data to compress.
+   * \param size Size of the data.
+   * \param destination Buffer to write the compressed data to.
+   * \param capacity Size of the buffer.
+   * \return Size of the compressed data, or 0 if it did not fit in the buffer.
+   */
+  static u64 Compress(const u8* source,
+                      u64 size,
+                      u8* destination,
+                      u64 capacity);
+
+  /** Decompress data. The compressed data is validated while decompressing,
+   * so corrupt data never causes reads or writes outside of the buffers.
+   * \brief Decompress data.
+   * \param source Compressed data.
+   * \param sourceSize Size of the compressed data.
+   * \param destination Buffer to write the data to.
+   * \param size Size of the decompressed data.
+   * \return True if exactly 'size' bytes were decompressed, otherwise false.
+   */
+  static bool Decompress(const u8* source,
+                         u64 sourceSize,
+                         u8* destination,
+                         u64 size);
+};
+
+}
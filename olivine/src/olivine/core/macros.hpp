@@ -22,6 +22,21 @@
 
 #pragma once
 
+// ========================================================================== //
+// Macros: Platform
+// ========================================================================== //
+
+/** Macros for the platform that is being compiled for. POSIX is defined for
+ * all UNIX-like platforms, including Linux **/
+#if defined(_WIN32)
+#define OL_PLATFORM_WINDOWS
+#elif defined(__linux__)
+#define OL_PLATFORM_LINUX
+#define OL_PLATFORM_POSIX
+#elif defined(__unix__) || defined(__APPLE__)
+#define OL_PLATFORM_POSIX
+#endif
+
 // ========================================================================== //
 // Macros: Functions
 // ========================================================================== //
@@ -0,0 +1,695 @@
+// MIT License
+//
+// Copyright (c) 2019 Filip Björklund
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "olivine/core/mip_generator.hpp"
+
+// ========================================================================== //
+// Headers
+// ========================================================================== //
+
+// Standard headers
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <immintrin.h>
+#include <vector>
+
+// Project headers
+#include "olivine/core/assert.hpp"
+#include "olivine/core/cpu.hpp"
+#include "olivine/core/thread_pool.hpp"
+#include "olivine/math/constants.hpp"
+#include "olivine/math/math.hpp"
+
+// ========================================================================== //
+// Scalar Functions
+// ========================================================================== //
+
+namespace olivine {
+
+/** Shape parameter of the Kaiser window **/
+static constexpr f64 kKaiserAlpha = 4.0;
+/** Half-width of the Kaiser filter, in destination pixels **/
+static constexpr f64 kKaiserWidth = 2.0;
+/** Number of entries in the table that encodes linear values as sRGB **/
+static constexpr u32 kEncodeTableSize = 4096;
+
+// -------------------------------------------------------------------------- //
+
+/** Returns the zeroth-order modified Bessel function of the first kind **/
+static f64
+BesselI0(f64 x)
+{
+  f64 sum = 1.0;
+  f64 term = 1.0;
+  for (u32 k = 1; k < 32; k++) {
+    const f64 factor = x / (2.0 * k);
+    term *= factor * factor;
+    sum += term;
+  }
+  return sum;
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Returns the table that maps bytes to linear values, either for sRGB
+ * encoded bytes or for linear bytes **/
+static const f32*
+GetDecodeTable(bool srgb)
+{
+  static const std::array<f32, 512> tables = [] {
+    std::array<f32, 512> values{};
+    for (u32 i = 0; i < 256; i++) {
+      const f64 c = i / 255.0;
+      values[i] = f32(c);
+      values[256 + i] = f32(
+        c <= 0.04045 ? c / 12.92 : std::pow((c + 0.055) / 1.055, 2.4));
+    }
+    return values;
+  }();
+  return tables.data() + (srgb ? 256 : 0);
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Returns the table that maps linear values, scaled to the size of the
+ * table, to sRGB encoded bytes **/
+static const u8*
+GetEncodeTable()
+{
+  static const std::array<u8, kEncodeTableSize> table = [] {
+    std::array<u8, kEncodeTableSize> values{};
+    for (u32 i = 0; i < kEncodeTableSize; i++) {
+      const f64 l = i / f64(kEncodeTableSize - 1);
+      const f64 c =
+        l <= 0.0031308 ? l * 12.92 : 1.055 * std::pow(l, 1.0 / 2.4) - 0.055;
+      values[i] = u8(c * 255.0 + 0.5);
+    }
+    return values;
+  }();
+  return table.data();
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Add weighted values to an accumulated row **/
+static void
+AccumulateScalar(f32* destination, const f32* source, f32 weight, u64 count)
+{
+  for (u64 i = 0; i < count; i++) {
+    destination[i] += source[i] * weight;
+  }
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Returns the weight of a tap of the triangle or Kaiser filter, at a distance
+ * from the center of the destination pixel, in destination pixels **/
+static f64
+GetFilterWeight(Image::MipFilter filter, f64 u)
+{
+  if (filter == Image::MipFilter::kTriangle) {
+    return 1.0 - std::abs(u);
+  }
+  const f64 x = Constants::kPi64 * u;
+  const f64 sinc = u == 0.0 ? 1.0 : std::sin(x) / x;
+  const f64 r = u / kKaiserWidth;
+  const f64 window =
+    BesselI0(kKaiserAlpha * std::sqrt(1.0 - r * r)) / BesselI0(kKaiserAlpha);
+  return sinc * window;
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Filter a row horizontally, for any number of channels. Destination pixel
+ * 'x' reads 'tapCount' source pixels from 'first[x]', weighted by the weights
+ * at 'weights + x * weightStride' **/
+static void
+FilterRowScalar(const f32* source,
+                u32 sourceWidth,
+                f32* destination,
+                u32 destinationWidth,
+                u32 channelCount,
+                const s32* first,
+                const f32* weights,
+                u32 weightStride,
+                u32 tapCount)
+{
+  const s32 last = s32(sourceWidth) - 1;
+  for (u32 x = 0; x < destinationWidth; x++, weights += weightStride) {
+    f32 sums[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+    for (u32 k = 0; k < tapCount; k++) {
+      const s32 i = Clamp(first[x] + s32(k), 0, last);
+      const f32* pixel = source + u64(i) * channelCount;
+      for (u32 c = 0; c < channelCount; c++) {
+        sums[c] += pixel[c] * weights[k];
+      }
+    }
+    for (u32 c = 0; c < channelCount; c++) {
+      destination[u64(x) * channelCount + c] = sums[c];
+    }
+  }
+}
+
+}
+
+// ========================================================================== //
+// SSE2 Functions
+// ========================================================================== //
+
+namespace olivine {
+
+/** Add weighted values to an accumulated row, four at a time **/
+static void
+AccumulateSSE2(f32* destination, const f32* source, f32 weight, u64 count)
+{
+  const __m128 w = _mm_set1_ps(weight);
+  u64 i = 0;
+  for (; i + 4 <= count; i += 4) {
+    const __m128 sum = _mm_add_ps(_mm_loadu_ps(destination + i),
+                                  _mm_mul_ps(_mm_loadu_ps(source + i), w));
+    _mm_storeu_ps(destination + i, sum);
+  }
+  AccumulateScalar(destination + i, source + i, weight, count - i);
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Filter a row of 4-channel pixels horizontally, one pixel per vector. See
+ * 'FilterRowScalar' for the taps **/
+static void
+FilterRow4SSE2(const f32* source,
+               u32 sourceWidth,
+               f32* destination,
+               u32 destinationWidth,
+               const s32* firsts,
+               const f32* weights,
+               u32 weightStride,
+               u32 tapCount)
+{
+  const s32 last = s32(sourceWidth) - 1;
+  for (u32 x = 0; x < destinationWidth; x++, weights += weightStride) {
+    __m128 sum = _mm_setzero_ps();
+    const s32 first = firsts[x];
+    if (first >= 0 && first + s32(tapCount) - 1 <= last) {
+      const f32* pixel = source + u64(first) * 4;
+      for (u32 k = 0; k < tapCount; k++, pixel += 4) {
+        sum = _mm_add_ps(
+          sum, _mm_mul_ps(_mm_loadu_ps(pixel), _mm_set1_ps(weights[k])));
+      }
+    } else {
+      for (u32 k = 0; k < tapCount; k++) {
+        const s32 i = Clamp(first + s32(k), 0, last);
+        sum = _mm_add_ps(sum,
+                         _mm_mul_ps(_mm_loadu_ps(source + u64(i) * 4),
+                                    _mm_set1_ps(weights[k])));
+      }
+    }
+    _mm_storeu_ps(destination + u64(x) * 4, sum);
+  }
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Decode a row of 4-channel pixels with alpha in the last channel, one pixel
+ * per vector **/
+static void
+Decode4SSE2(const u8* source,
+            f32* destination,
+            u32 width,
+            const f32* const (&tables)[4],
+            bool weighted)
+{
+  const __m128 colorMask = _mm_castsi128_ps(_mm_setr_epi32(-1, -1, -1, 0));
+  const __m128 alphaOne = _mm_setr_ps(0.0f, 0.0f, 0.0f, 1.0f);
+  for (u32 x = 0; x < width; x++, source += 4, destination += 4) {
+    __m128 values = _mm_setr_ps(tables[0][source[0]],
+                                tables[1][source[1]],
+                                tables[2][source[2]],
+                                tables[3][source[3]]);
+    if (weighted) {
+      const __m128 alpha = _mm_shuffle_ps(values, values, 0xFF);
+      values = _mm_mul_ps(
+        values, _mm_or_ps(_mm_and_ps(alpha, colorMask), alphaOne));
+    }
+    _mm_storeu_ps(destination, values);
+  }
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Encode a row of 4-channel values with alpha in the last channel, one pixel
+ * per vector. The values are scaled to integer indices, which are looked up
+ * in the sRGB table for the channels that are sRGB encoded **/
+static void
+Encode4SSE2(const f32* source,
+            u8* destination,
+            u32 width,
+            const bool (&srgb)[4],
+            const u8* table,
+            bool weighted)
+{
+  const __m128 zero = _mm_setzero_ps();
+  const __m128 one = _mm_set1_ps(1.0f);
+  const __m128 half = _mm_set1_ps(0.5f);
+  const __m128 scales = _mm_setr_ps(srgb[0] ? kEncodeTableSize - 1 : 255.0f,
+                                    srgb[1] ? kEncodeTableSize - 1 : 255.0f,
+                                    srgb[2] ? kEncodeTableSize - 1 : 255.0f,
+                                    srgb[3] ? kEncodeTableSize - 1 : 255.0f);
+  alignas(16) s32 indices[4];
+  for (u32 x = 0; x < width; x++, source += 4, destination += 4) {
+    __m128 values = _mm_loadu_ps(source);
+    if (weighted) {
+      const f32 alpha = Clamp(source[3], 0.0f, 1.0f);
+      const f32 scale = alpha > 0.0f ? 1.0f / alpha : 0.0f;
+      values = _mm_mul_ps(values, _mm_setr_ps(scale, scale, scale, 1.0f));
+    }
+    values = _mm_min_ps(_mm_max_ps(values, zero), one);
+    _mm_store_si128(
+      reinterpret_cast<__m128i*>(indices),
+      _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(values, scales), half)));
+    for (u32 c = 0; c < 4; c++) {
+      destination[c] = srgb[c] ? table[indices[c]] : u8(indices[c]);
+    }
+  }
+}
+
+}
+
+// ========================================================================== //
+// AVX2 Functions
+// ========================================================================== //
+
+namespace olivine {
+
+/** Add weighted values to an accumulated row, eight at a time **/
+OL_TARGET_AVX2 static void
+AccumulateAVX2(f32* destination, const f32* source, f32 weight, u64 count)
+{
+  const __m256 w = _mm256_set1_ps(weight);
+  u64 i = 0;
+  for (; i + 8 <= count; i += 8) {
+    const __m256 sum =
+      _mm256_add_ps(_mm256_loadu_ps(destination + i),
+                    _mm256_mul_ps(_mm256_loadu_ps(source + i), w));
+    _mm256_storeu_ps(destination + i, sum);
+  }
+  AccumulateScalar(destination + i, source + i, weight, count - i);
+}
+
+}
+
+// ========================================================================== //
+// MipGenerator Implementation
+// ========================================================================== //
+
+namespace olivine {
+
+/** Taps of the filter along one axis of a level. Destination pixel 'x' reads
+ * 'count' source pixels from 'first[x]', weighted by the weights at
+ * 'weights.data() + x * weightStride'. All pixels share the same weights when
+ * the stride is zero **/
+struct MipGenerator::Taps
+{
+  /** Number of taps of each destination pixel **/
+  u32 count = 0;
+  /** Number of weights between consecutive destination pixels **/
+  u32 weightStride = 0;
+  /** First source pixel of each destination pixel **/
+  std::vector<s32> first;
+  /** Weights of the taps. The weights of each pixel sum up to one **/
+  std::vector<f32> weights;
+};
+
+// -------------------------------------------------------------------------- //
+
+MipGenerator::MipGenerator(Image::Format format,
+                           Image::MipFilter filter,
+                           Image::ColorSpace colorSpace)
+  : mFormat(format)
+  , mChannelCount(Image::GetFormatChannelCount(format))
+  , mFilter(filter)
+{
+  Assert(format != Image::Format::kUnknown,
+         "Cannot generate mipmaps for images of unknown format");
+
+  // Determine channels
+  if (format == Image::Format::kRGBA || format == Image::Format::kBGRA) {
+    mAlphaChannel = 3;
+  } else if (format == Image::Format::kAlpha) {
+    mAlphaChannel = 0;
+  }
+  for (u32 c = 0; c < mChannelCount; c++) {
+    mSRGB[c] =
+      colorSpace == Image::ColorSpace::kSRGB && s32(c) != mAlphaChannel;
+  }
+}
+
+// -------------------------------------------------------------------------- //
+
+void
+MipGenerator::Generate(u8* data, u32 width, u32 height, u32 levelCount) const
+{
+  // Each level is generated from the previous one. The filtered values of a
+  // level are only kept if there is a level after it
+  std::vector<f32> sourceValues;
+  std::vector<f32> destinationValues;
+  const u8* source = data;
+  u32 sourceWidth = width;
+  u32 sourceHeight = height;
+  for (u32 level = 1; level < levelCount; level++) {
+    const u32 destinationWidth = Max(1u, sourceWidth / 2);
+    const u32 destinationHeight = Max(1u, sourceHeight / 2);
+    u8* destination = const_cast<u8*>(source) +
+                      u64(sourceWidth) * sourceHeight * mChannelCount;
+    const bool isLast = level + 1 == levelCount;
+    destinationValues.resize(
+      isLast ? 0 : u64(destinationWidth) * destinationHeight * mChannelCount);
+    GenerateLevel(source,
+                  level == 1 ? nullptr : sourceValues.data(),
+                  sourceWidth,
+                  sourceHeight,
+                  destination,
+                  isLast ? nullptr : destinationValues.data());
+
+    // Continue from this level
+    std::swap(sourceValues, destinationValues);
+    source = destination;
+    sourceWidth = destinationWidth;
+    sourceHeight = destinationHeight;
+  }
+}
+
+// -------------------------------------------------------------------------- //
+
+void
+MipGenerator::Downsample(const u8* source,
+                         u32 width,
+                         u32 height,
+                         u8* destination) const
+{
+  GenerateLevel(source, nullptr, width, height, destination, nullptr);
+}
+
+// -------------------------------------------------------------------------- //
+
+void
+MipGenerator::SetupTaps(Taps& taps, u32 sourceSize, u32 destinationSize) const
+{
+  // An axis of a single pixel is not filtered
+  taps.first.resize(destinationSize);
+  if (sourceSize == 1) {
+    taps.count = 1;
+    taps.weightStride = 0;
+    taps.first[0] = 0;
+    taps.weights.assign(1, 1.0f);
+    return;
+  }
+
+  // Positions are counted in units of 1 / (2 * destinationSize) source pixels,
+  // which keeps them exact for any ratio of the sizes. Destination pixel 'x'
+  // covers [x, x + 1) * sourceSize * 2 and is centered in that range. When the
+  // axis is halved exactly all pixels have the same taps relative to their
+  // first one, so only the first pixel is computed
+  const bool shared = sourceSize == destinationSize * 2;
+  const s64 unit = s64(destinationSize) * 2;
+  const s64 span = s64(sourceSize) * 2;
+  s64 radius = s64(kKaiserWidth) * span;
+  if (mFilter == Image::MipFilter::kBox) {
+    radius = span / 2;
+  } else if (mFilter == Image::MipFilter::kTriangle) {
+    radius = span;
+  }
+  std::vector<f64> weights;
+  std::vector<std::vector<f64>> pixelWeights(shared ? 1 : destinationSize);
+  taps.count = 0;
+  for (u32 x = 0; x < pixelWeights.size(); x++) {
+    // Source pixel 'i' covers [i, i + 1) * unit. The box filter weights it by
+    // how much of the destination pixel it covers, the other filters by its
+    // distance from the center, in destination pixels
+    const s64 center = s64(x) * span + span / 2;
+    const s64 begin = center - radius;
+    const s64 end = center + radius;
+    s64 first = begin >= 0 ? begin / unit : -((unit - 1 - begin) / unit);
+    weights.clear();
+    for (s64 i = first; i * unit < end; i++) {
+      const s64 low = i * unit;
+      const s64 high = low + unit;
+      if (mFilter == Image::MipFilter::kBox) {
+        weights.push_back(f64(Min(high, end) - Max(low, begin)));
+        continue;
+      }
+      const s64 distance = low + unit / 2 - center;
+      if (distance <= -radius) {
+        first++;
+        continue;
+      }
+      if (distance >= radius) {
+        break;
+      }
+      weights.push_back(GetFilterWeight(mFilter, f64(distance) / f64(span)));
+    }
+    f64 sum = 0.0;
+    for (f64 weight : weights) {
+      sum += weight;
+    }
+    for (f64& weight : weights) {
+      weight /= sum;
+    }
+    taps.first[x] = s32(first);
+    taps.count = Max(taps.count, u32(weights.size()));
+    pixelWeights[x] = weights;
+  }
+  if (shared) {
+    for (u32 x = 1; x < destinationSize; x++) {
+      taps.first[x] = taps.first[0] + s32(2 * x);
+    }
+  }
+
+  // Pixels with fewer taps are padded with zero weights
+  taps.weightStride = shared ? 0 : taps.count;
+  taps.weights.assign(u64(taps.count) * pixelWeights.size(), 0.0f);
+  for (u64 x = 0; x < pixelWeights.size(); x++) {
+    for (u64 k = 0; k < pixelWeights[x].size(); k++) {
+      taps.weights[x * taps.count + k] = f32(pixelWeights[x][k]);
+    }
+  }
+}
+
+// -------------------------------------------------------------------------- //
+
+void
+MipGenerator::GenerateLevel(const u8* source,
+                            const f32* sourceValues,
+                            u32 sourceWidth,
+                            u32 sourceHeight,
+                            u8* destination,
+                            f32* destinationValues) const
+{
+  const u32 destinationWidth = Max(1u, sourceWidth / 2);
+  const u32 destinationHeight = Max(1u, sourceHeight / 2);
+  Taps rowTaps;
+  Taps columnTaps;
+  SetupTaps(rowTaps, sourceHeight, destinationHeight);
+  SetupTaps(columnTaps, sourceWidth, destinationWidth);
+
+  // Split large levels into bands of rows
+  const u64 pixelCount = u64(destinationWidth) * destinationHeight;
+  if (pixelCount < kParallelThreshold) {
+    GenerateRows(source,
+                 sourceValues,
+                 sourceWidth,
+                 sourceHeight,
+                 destination,
+                 destinationValues,
+                 destinationWidth,
+                 rowTaps,
+                 columnTaps,
+                 0,
+                 destinationHeight);
+    return;
+  }
+  ThreadPool& pool = ThreadPool::GetGlobal();
+  const u64 bandCount =
+    Min(u64(destinationHeight), u64(pool.GetThreadCount()) * 4);
+  pool.ParallelFor(bandCount, [&](u64 band) {
+    GenerateRows(source,
+                 sourceValues,
+                 sourceWidth,
+                 sourceHeight,
+                 destination,
+                 destinationValues,
+                 destinationWidth,
+                 rowTaps,
+                 columnTaps,
+                 u32(destinationHeight * band / bandCount),
+                 u32(destinationHeight * (band + 1) / bandCount));
+  });
+}
+
+// -------------------------------------------------------------------------- //
+
+void
+MipGenerator::GenerateRows(const u8* source,
+                           const f32* sourceValues,
+                           u32 sourceWidth,
+                           u32 sourceHeight,
+                           u8* destination,
+                           f32* destinationValues,
+                           u32 destinationWidth,
+                           const Taps& rowTaps,
+                           const Taps& columnTaps,
+                           u32 begin,
+                           u32 end) const
+{
+  const auto Accumulate = Cpu::HasAVX2() ? AccumulateAVX2 : AccumulateSSE2;
+
+  // Scratch rows. Decoded source rows are kept in a ring that is indexed by
+  // the row modulo the tap count, as consecutive destination rows share most
+  // of their source rows
+  const u64 sourceStride = u64(sourceWidth) * mChannelCount;
+  const u64 destinationStride = u64(destinationWidth) * mChannelCount;
+  std::vector<f32> filtered(sourceStride);
+  const u32 slotCount = rowTaps.count;
+  std::vector<f32> decoded(sourceValues ? 0 : sourceStride * slotCount);
+  std::vector<s32> decodedRows(slotCount, -1);
+  std::vector<f32> values(destinationValues ? 0 : destinationStride);
+
+  const s32 last = s32(sourceHeight) - 1;
+  for (u32 y = begin; y < end; y++) {
+    // Filter the source rows vertically
+    std::fill(filtered.begin(), filtered.end(), 0.0f);
+    const f32* rowWeights =
+      rowTaps.weights.data() + u64(y) * rowTaps.weightStride;
+    for (u32 k = 0; k < rowTaps.count; k++) {
+      if (rowWeights[k] == 0.0f) {
+        continue;
+      }
+      const s32 r = Clamp(rowTaps.first[y] + s32(k), 0, last);
+      const f32* row = sourceValues + u64(r) * sourceStride;
+      if (!sourceValues) {
+        const u32 slot = u32(r) % slotCount;
+        f32* slotRow = decoded.data() + slot * sourceStride;
+        if (decodedRows[slot] != r) {
+          Decode(source + u64(r) * sourceStride, slotRow, sourceWidth);
+          decodedRows[slot] = r;
+        }
+        row = slotRow;
+      }
+      Accumulate(filtered.data(), row, rowWeights[k], sourceStride);
+    }
+
+    // Filter the result horizontally
+    f32* output = destinationValues
+                    ? destinationValues + u64(y) * destinationStride
+                    : values.data();
+    if (mChannelCount == 4) {
+      FilterRow4SSE2(filtered.data(),
+                     sourceWidth,
+                     output,
+                     destinationWidth,
+                     columnTaps.first.data(),
+                     columnTaps.weights.data(),
+                     columnTaps.weightStride,
+                     columnTaps.count);
+    } else {
+      FilterRowScalar(filtered.data(),
+                      sourceWidth,
+                      output,
+                      destinationWidth,
+                      mChannelCount,
+                      columnTaps.first.data(),
+                      columnTaps.weights.data(),
+                      columnTaps.weightStride,
+                      columnTaps.count);
+    }
+    Encode(output, destination + u64(y) * destinationStride, destinationWidth);
+  }
+}
+
+// -------------------------------------------------------------------------- //
+
+void
+MipGenerator::Decode(const u8* source, f32* destination, u32 width) const
+{
+  const f32* const tables[4] = { GetDecodeTable(mSRGB[0]),
+                                 GetDecodeTable(mSRGB[1]),
+                                 GetDecodeTable(mSRGB[2]),
+                                 GetDecodeTable(mSRGB[3]) };
+  const bool weighted = mAlphaChannel >= 0 && mChannelCount > 1;
+  if (mChannelCount == 4) {
+    Decode4SSE2(source, destination, width, tables, weighted);
+    return;
+  }
+
+  for (u32 x = 0; x < width; x++) {
+    const u8* pixel = source + u64(x) * mChannelCount;
+    f32* values = destination + u64(x) * mChannelCount;
+    for (u32 c = 0; c < mChannelCount; c++) {
+      values[c] = tables[c][pixel[c]];
+    }
+    if (weighted) {
+      const f32 alpha = values[mAlphaChannel];
+      for (u32 c = 0; c < mChannelCount; c++) {
+        if (s32(c) != mAlphaChannel) {
+          values[c] *= alpha;
+        }
+      }
+    }
+  }
+}
+
+// -------------------------------------------------------------------------- //
+
+void
+MipGenerator::Encode(const f32* source, u8* destination, u32 width) const
+{
+  const u8* table = GetEncodeTable();
+  const bool weighted = mAlphaChannel >= 0 && mChannelCount > 1;
+  if (mChannelCount == 4) {
+    Encode4SSE2(source, destination, width, mSRGB, table, weighted);
+    return;
+  }
+
+  for (u32 x = 0; x < width; x++) {
+    const f32* values = source + u64(x) * mChannelCount;
+    u8* pixel = destination + u64(x) * mChannelCount;
+
+    // Colors are divided by the alpha that they were weighted with. The
+    // filters can overshoot, so the values are clamped
+    f32 scale = 1.0f;
+    if (weighted) {
+      const f32 alpha = Clamp(values[mAlphaChannel], 0.0f, 1.0f);
+      scale = alpha > 0.0f ? 1.0f / alpha : 0.0f;
+    }
+    for (u32 c = 0; c < mChannelCount; c++) {
+      const f32 value =
+        Clamp(s32(c) == mAlphaChannel ? values[c] : values[c] * scale,
+              0.0f,
+              1.0f);
+      pixel[c] = mSRGB[c] ? table[u32(value * (kEncodeTableSize - 1) + 0.5f)]
+                          : u8(value * 255.0f + 0.5f);
+    }
+  }
+}
+
+}
@@ -0,0 +1,163 @@
+// MIT License
+//
+// Copyright (c) 2019 Filip Björklund
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+// ========================================================================== //
+// Headers
+// ========================================================================== //
+
+// Project headers
+#include "olivine/core/types.hpp"
+#include "olivine/core/macros.hpp"
+#include "olivine/core/image.hpp"
+
+// ========================================================================== //
+// MipGenerator Declaration
+// ========================================================================== //
+
+namespace olivine {
+
+/** \class MipGenerator
+ * \author Filip Björklund
+ * \date 18 october 2026 - 23:55
+ * \brief Generator of mipmap chains.
+ * \details
+ * Generates the levels of a mipmap chain from the first level. Each level is
+ * half the size of the previous level, rounded down, and at least one pixel.
+ * The levels are stored after each other in one buffer, with tightly packed
+ * rows, which is the layout of 'Image' data.
+ *
+ * The filtering is done in linear space on floating-point values. sRGB
+ * encoded channels are linearized when they are read and encoded again when
+ * the levels are written. Colors are weighted by alpha, so that transparent
+ * pixels do not bleed into the visible ones. Each level is filtered from the
+ * floating-point result of the previous level, which avoids accumulating
+ * rounding errors along the chain.
+ *
+ * The filters are separable. Rows of a level are filtered vertically with SSE
+ * or AVX2 and then horizontally, and large levels are split into bands of
+ * rows that are run on the global thread pool.
+ *
+ * An axis of odd size is not reduced by exactly two, so its taps are placed
+ * at the source pixels that the destination pixel covers when scaled by the
+ * ratio of the sizes. The box filter then weights the three pixels that each
+ * destination pixel overlaps by the area they cover, so that the last column
+ * or row of the source contributes as much as the others.
+ */
+class MipGenerator
+{
+public:
+  /** Number of pixels in a level above which it's split across threads **/
+  static constexpr u64 kParallelThreshold = 64 * 1024;
+
+private:
+  /** Format of the pixels **/
+  Image::Format mFormat;
+  /** Number of channels **/
+  u32 mChannelCount;
+  /** Index of the alpha channel, or -1 if the format has no alpha **/
+  s32 mAlphaChannel = -1;
+  /** Whether each channel is sRGB encoded **/
+  bool mSRGB[4] = { false, false, false, false };
+  /** Filter to downsample with **/
+  Image::MipFilter mFilter;
+
+  /** Taps of the filter along one axis of a level **/
+  struct Taps;
+
+public:
+  /** Create a generator for images of a format. The format may not be
+   * 'Image::Format::kUnknown'.
+   * \brief Create generator.
+   * \param format Format of the pixels.
+   * \param filter Filter to downsample with.
+   * \param colorSpace Color space of the color channels. Alpha is always
+   * linear.
+   */
+  MipGenerator(Image::Format format,
+               Image::MipFilter filter,
+               Image::ColorSpace colorSpace);
+
+  /** Generate the levels of a mipmap chain. The first level must already be
+   * filled in, and the data must be large enough for all levels.
+   * \brief Generate mipmap chain.
+   * \param data Data of the chain.
+   * \param width Width of the first level.
+   * \param height Height of the first level.
+   * \param levelCount Number of levels, including the first one.
+   */
+  void Generate(u8* data, u32 width, u32 height, u32 levelCount) const;
+
+  /** Downsample an image to half its size, rounded down and at least one
+   * pixel, into separate memory. This is the same as generating the second
+   * level of a mipmap chain.
+   * \brief Downsample image.
+   * \param source Pixels of the image.
+   * \param width Width of the image.
+   * \param height Height of the image.
+   * \param destination Pixels of the downsampled image.
+   */
+  void Downsample(const u8* source,
+                  u32 width,
+                  u32 height,
+                  u8* destination) const;
+
+private:
+  /** Setup the taps of the filter along an axis that is downsampled from
+   * 'sourceSize' to 'destinationSize' pixels **/
+  void SetupTaps(Taps& taps, u32 sourceSize, u32 destinationSize) const;
+
+  /** Generate a level from the previous level, split into bands of rows if
+   * it's large. See 'MipGenerator::GenerateRows' for the parameters **/
+  void GenerateLevel(const u8* source,
+                     const f32* sourceValues,
+                     u32 sourceWidth,
+                     u32 sourceHeight,
+                     u8* destination,
+                     f32* destinationValues) const;
+
+  /** Generate the rows [begin, end) of a level from the previous level. The
+   * previous level is read from 'sourceValues' if it's not null, otherwise
+   * from the encoded 'source' pixels. The filtered values are written to
+   * 'destinationValues' if it's not null, and encoded to 'destination'. The
+   * rows are filtered with 'rowTaps' and the columns with 'columnTaps' **/
+  void GenerateRows(const u8* source,
+                    const f32* sourceValues,
+                    u32 sourceWidth,
+                    u32 sourceHeight,
+                    u8* destination,
+                    f32* destinationValues,
+                    u32 destinationWidth,
+                    const Taps& rowTaps,
+                    const Taps& columnTaps,
+                    u32 begin,
+                    u32 end) const;
+
+  /** Decode a row of pixels into alpha-weighted linear values **/
+  void Decode(const u8* source, f32* destination, u32 width) const;
+
+  /** Encode a row of alpha-weighted linear values into pixels **/
+  void Encode(const f32* source, u8* destination, u32 width) const;
+};
+
+}
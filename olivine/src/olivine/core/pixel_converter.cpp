@@ -0,0 +1,423 @@
+// MIT License
+//
+// Copyright (c) 2019 Filip Björklund
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "olivine/core/pixel_converter.hpp"
+
+// ========================================================================== //
+// Headers
+// ========================================================================== //
+
+// Standard headers
+#include <cstring>
+#include <immintrin.h>
+
+// Project headers
+#include "olivine/core/assert.hpp"
+#include "olivine/core/cpu.hpp"
+#include "olivine/core/memory.hpp"
+
+// ========================================================================== //
+// Scalar Functions
+// ========================================================================== //
+
+namespace olivine {
+
+/** Channel that is always 0 **/
+static constexpr s8 kChannelZero = -1;
+/** Channel that is always 255 **/
+static constexpr s8 kChannelOne = -2;
+/** Shuffle index that produces a zero byte **/
+static constexpr u8 kShuffleZero = 0x80;
+
+// -------------------------------------------------------------------------- //
+
+/** Returns the byte of a pixel in a format that holds a channel (0 = red,
+ * 1 = green, 2 = blue, 3 = alpha), or the constant value of the channel if the
+ * format does not have it **/
+static s8
+GetChannelByte(Image::Format format, u32 channel)
+{
+  switch (format) {
+    case Image::Format::kRGBA: {
+      return s8(channel);
+    }
+    case Image::Format::kBGRA: {
+      constexpr s8 kBytes[4] = { 2, 1, 0, 3 };
+      return kBytes[channel];
+    }
+    case Image::Format::kRGB: {
+      return channel == 3 ? kChannelOne : s8(channel);
+    }
+    case Image::Format::kBGR: {
+      constexpr s8 kBytes[4] = { 2, 1, 0, kChannelOne };
+      return kBytes[channel];
+    }
+    case Image::Format::kRed: {
+      return channel == 0 ? 0 : kChannelZero;
+    }
+    case Image::Format::kAlpha: {
+      return channel == 3 ? 0 : kChannelZero;
+    }
+    default: {
+      Panic("Invalid image format");
+    }
+  }
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Returns the channel (0 = red, 1 = green, 2 = blue, 3 = alpha) that is
+ * stored in a byte of a pixel in a format **/
+static u32
+GetByteChannel(Image::Format format, u32 byte)
+{
+  switch (format) {
+    case Image::Format::kRGBA:
+    case Image::Format::kRGB: {
+      return byte;
+    }
+    case Image::Format::kBGRA:
+    case Image::Format::kBGR: {
+      return byte == 3 ? 3 : 2 - byte;
+    }
+    case Image::Format::kRed: {
+      return 0;
+    }
+    case Image::Format::kAlpha: {
+      return 3;
+    }
+    default: {
+      Panic("Invalid image format");
+    }
+  }
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Convert pixels one at a time **/
+static void
+ConvertScalar(const s8 (&channels)[4],
+              u32 sourceSize,
+              u32 destinationSize,
+              const u8* source,
+              u8* destination,
+              u64 count)
+{
+  for (u64 i = 0; i < count; i++) {
+    for (u32 j = 0; j < destinationSize; j++) {
+      const s8 channel = channels[j];
+      destination[j] = channel >= 0 ? source[channel]
+                                    : channel == kChannelOne ? 255 : 0;
+    }
+    source += sourceSize;
+    destination += destinationSize;
+  }
+}
+
+}
+
+// ========================================================================== //
+// SSSE3 Functions
+// ========================================================================== //
+
+namespace olivine {
+
+/** Convert between formats where one source load gives one destination store.
+ * Each block is as many pixels as fits in 16 bytes of the larger format **/
+template<u32 S, u32 D>
+OL_TARGET_SSSE3 static u64
+ShuffleSSSE3(const u8 (&shuffles)[4][16],
+             const u8 (&constants)[4][16],
+             const u8* source,
+             u8* destination,
+             u64 count)
+{
+  constexpr u64 kBlock = 16 / (S > D ? S : D);
+  const __m128i shuffle =
+    _mm_load_si128(reinterpret_cast<const __m128i*>(shuffles[0]));
+  const __m128i constant =
+    _mm_load_si128(reinterpret_cast<const __m128i*>(constants[0]));
+
+  // Loads and stores are 16 bytes even when the block is smaller, so stop
+  // while they still fit in the row. The bytes that are stored past the block
+  // are overwritten by the next block or by the scalar tail
+  u64 i = 0;
+  for (; (i * S + 16 <= count * S) && (i * D + 16 <= count * D); i += kBlock) {
+    const __m128i pixels =
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i * S));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i * D),
+                     _mm_or_si128(_mm_shuffle_epi8(pixels, shuffle), constant));
+  }
+  return i;
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Convert from a 1-byte format to a larger format. Each block is 16 pixels,
+ * which are expanded into D stores **/
+template<u32 D>
+OL_TARGET_SSSE3 static u64
+ExpandSSSE3(const u8 (&shuffles)[4][16],
+            const u8 (&constants)[4][16],
+            const u8* source,
+            u8* destination,
+            u64 count)
+{
+  __m128i shuffle[D];
+  __m128i constant[D];
+  for (u32 k = 0; k < D; k++) {
+    shuffle[k] = _mm_load_si128(reinterpret_cast<const __m128i*>(shuffles[k]));
+    constant[k] =
+      _mm_load_si128(reinterpret_cast<const __m128i*>(constants[k]));
+  }
+
+  u64 i = 0;
+  for (; i + 16 <= count; i += 16) {
+    const __m128i pixels =
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i));
+    for (u32 k = 0; k < D; k++) {
+      _mm_storeu_si128(
+        reinterpret_cast<__m128i*>(destination + i * D + k * 16),
+        _mm_or_si128(_mm_shuffle_epi8(pixels, shuffle[k]), constant[k]));
+    }
+  }
+  return i;
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Convert from a larger format to a 1-byte format. Each block is 16 pixels,
+ * which are gathered from S loads **/
+template<u32 S>
+OL_TARGET_SSSE3 static u64
+ReduceSSSE3(const u8 (&shuffles)[4][16],
+            const u8 (&constants)[4][16],
+            const u8* source,
+            u8* destination,
+            u64 count)
+{
+  __m128i shuffle[S];
+  for (u32 k = 0; k < S; k++) {
+    shuffle[k] = _mm_load_si128(reinterpret_cast<const __m128i*>(shuffles[k]));
+  }
+  const __m128i constant =
+    _mm_load_si128(reinterpret_cast<const __m128i*>(constants[0]));
+
+  u64 i = 0;
+  for (; i + 16 <= count; i += 16) {
+    __m128i gathered = constant;
+    for (u32 k = 0; k < S; k++) {
+      const __m128i pixels = _mm_loadu_si128(
+        reinterpret_cast<const __m128i*>(source + i * S + k * 16));
+      gathered =
+        _mm_or_si128(gathered, _mm_shuffle_epi8(pixels, shuffle[k]));
+    }
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i), gathered);
+  }
+  return i;
+}
+
+}
+
+// ========================================================================== //
+// AVX2 Functions
+// ========================================================================== //
+
+namespace olivine {
+
+/** Convert between formats where one source load gives one destination store,
+ * with one block in each 128-bit lane. This is the same as 'ShuffleSSSE3' but
+ * converts two blocks per shuffle **/
+template<u32 S, u32 D>
+OL_TARGET_AVX2 static u64
+ShuffleAVX2(const u8 (&shuffles)[4][16],
+            const u8 (&constants)[4][16],
+            const u8* source,
+            u8* destination,
+            u64 count)
+{
+  constexpr u64 kBlock = 16 / (S > D ? S : D);
+  const __m256i shuffle = _mm256_broadcastsi128_si256(
+    _mm_load_si128(reinterpret_cast<const __m128i*>(shuffles[0])));
+  const __m256i constant = _mm256_broadcastsi128_si256(
+    _mm_load_si128(reinterpret_cast<const __m128i*>(constants[0])));
+
+  u64 i = 0;
+  for (; ((i + kBlock) * S + 16 <= count * S) &&
+         ((i + kBlock) * D + 16 <= count * D);
+       i += 2 * kBlock) {
+    const u8* pixels = source + i * S;
+    const __m256i loaded = _mm256_inserti128_si256(
+      _mm256_castsi128_si256(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(pixels))),
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(pixels + kBlock * S)),
+      1);
+    const __m256i converted =
+      _mm256_or_si256(_mm256_shuffle_epi8(loaded, shuffle), constant);
+
+    // Blocks that fill their lane can be stored together
+    u8* out = destination + i * D;
+    if (kBlock * D == 16) {
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), converted);
+    } else {
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(out),
+                       _mm256_castsi256_si128(converted));
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(out + kBlock * D),
+                       _mm256_extracti128_si256(converted, 1));
+    }
+  }
+
+  // Finish with the narrower kernel, which can get closer to the end
+  return i + ShuffleSSSE3<S, D>(shuffles,
+                                constants,
+                                source + i * S,
+                                destination + i * D,
+                                count - i);
+}
+
+}
+
+// ========================================================================== //
+// PixelConverter Implementation
+// ========================================================================== //
+
+namespace olivine {
+
+PixelConverter::PixelConverter(Image::Format from, Image::Format to)
+  : mSourceFormat(from)
+  , mDestinationFormat(to)
+  , mSourceSize(Image::GetFormatChannelCount(from))
+  , mDestinationSize(Image::GetFormatChannelCount(to))
+{
+  Assert(mSourceSize != 0 && mDestinationSize != 0,
+         "Cannot convert pixels of an unknown image format");
+
+  // Determine the source byte of each destination byte
+  for (u32 j = 0; j < 4; j++) {
+    mChannels[j] = j < mDestinationSize
+                     ? GetChannelByte(from, GetByteChannel(to, j))
+                     : kChannelZero;
+  }
+
+  // Build the masks. For each output byte the shuffle index selects the source
+  // byte and the constant is set for channels that are always 255
+  const u32 S = mSourceSize;
+  const u32 D = mDestinationSize;
+  memset(mShuffles, kShuffleZero, sizeof(mShuffles));
+  memset(mConstants, 0, sizeof(mConstants));
+  auto SetByte = [&](u32 vector, u32 byte, u32 pixel, u32 channel) {
+    const s8 source = mChannels[channel];
+    if (source >= 0) {
+      mShuffles[vector][byte] = u8(pixel * S + u32(source));
+    } else if (source == kChannelOne) {
+      mConstants[vector][byte] = 255;
+    }
+  };
+  if (S != 1 && D == 1) {
+    // Reduce: load k holds the source bytes [16k, 16k + 16)
+    for (u32 pixel = 0; pixel < 16; pixel++) {
+      const s8 source = mChannels[0];
+      if (source >= 0) {
+        const u32 byte = pixel * S + u32(source);
+        mShuffles[byte / 16][pixel] = u8(byte % 16);
+      } else if (source == kChannelOne) {
+        mConstants[0][pixel] = 255;
+      }
+    }
+  } else if (S == 1 && D != 1) {
+    // Expand: store k holds the destination bytes [16k, 16k + 16)
+    for (u32 byte = 0; byte < 16 * D; byte++) {
+      SetByte(byte / 16, byte % 16, byte / D, byte % D);
+    }
+  } else {
+    // Shuffle: one block of pixels per vector
+    const u32 block = 16 / (S > D ? S : D);
+    for (u32 byte = 0; byte < block * D; byte++) {
+      SetByte(0, byte, byte / D, byte % D);
+    }
+  }
+
+  // Select kernel
+  const bool avx2 = Cpu::HasAVX2();
+  if (!Cpu::HasSSSE3()) {
+    mKernel = nullptr;
+  } else if (S == 4 && D == 4) {
+    mKernel = avx2 ? ShuffleAVX2<4, 4> : ShuffleSSSE3<4, 4>;
+  } else if (S == 3 && D == 4) {
+    mKernel = avx2 ? ShuffleAVX2<3, 4> : ShuffleSSSE3<3, 4>;
+  } else if (S == 4 && D == 3) {
+    mKernel = avx2 ? ShuffleAVX2<4, 3> : ShuffleSSSE3<4, 3>;
+  } else if (S == 3 && D == 3) {
+    mKernel = avx2 ? ShuffleAVX2<3, 3> : ShuffleSSSE3<3, 3>;
+  } else if (S == 1 && D == 1) {
+    mKernel = ShuffleSSSE3<1, 1>;
+  } else if (S == 1 && D == 4) {
+    mKernel = ExpandSSSE3<4>;
+  } else if (S == 1 && D == 3) {
+    mKernel = ExpandSSSE3<3>;
+  } else if (S == 4 && D == 1) {
+    mKernel = ReduceSSSE3<4>;
+  } else if (S == 3 && D == 1) {
+    mKernel = ReduceSSSE3<3>;
+  }
+}
+
+// -------------------------------------------------------------------------- //
+
+void
+PixelConverter::Convert(const u8* source, u8* destination, u64 count) const
+{
+  if (mSourceFormat == mDestinationFormat) {
+    Memory::Copy(destination, source, count * mSourceSize);
+    return;
+  }
+
+  // Convert with the kernel, and the remaining pixels one at a time
+  u64 converted = 0;
+  if (mKernel) {
+    converted = mKernel(mShuffles, mConstants, source, destination, count);
+  }
+  ConvertScalar(mChannels,
+                mSourceSize,
+                mDestinationSize,
+                source + converted * mSourceSize,
+                destination + converted * mDestinationSize,
+                count - converted);
+}
+
+// -------------------------------------------------------------------------- //
+
+void
+PixelConverter::Convert(const u8* source,
+                        u64 sourceStride,
+                        u8* destination,
+                        u64 destinationStride,
+                        u32 width,
+                        u32 height) const
+{
+  for (u32 y = 0; y < height; y++) {
+    Convert(
+      source + y * sourceStride, destination + y * destinationStride, width);
+  }
+}
+
+}
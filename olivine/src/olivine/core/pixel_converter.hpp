@@ -0,0 +1,139 @@
+// MIT License
+//
+// Copyright (c) 2019 Filip Björklund
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+// ========================================================================== //
+// Headers
+// ========================================================================== //
+
+// Project headers
+#include "olivine/core/types.hpp"
+#include "olivine/core/macros.hpp"
+#include "olivine/core/image.hpp"
+
+// ========================================================================== //
+// PixelConverter Declaration
+// ========================================================================== //
+
+namespace olivine {
+
+/** \class PixelConverter
+ * \author Filip Björklund
+ * \date 18 october 2026 - 23:40
+ * \brief Converter of pixels between image formats.
+ * \details
+ * Converts rows of pixels from one 'Image::Format' to another. The conversion
+ * gives the same result as reading each pixel with 'Image::GetPixel' and
+ * writing it with 'Image::SetPixel'. Channels that the source format does not
+ * have are 0, except for the alpha of 3-channel formats which is 255.
+ *
+ * Each destination byte is either a byte of the source pixel or a constant,
+ * which means that every conversion is a byte shuffle. The shuffle masks are
+ * computed when the converter is created, and the rows are converted with
+ * SSSE3 or AVX2 shuffles when the CPU supports them. A converter can be reused
+ * for any number of rows and from multiple threads.
+ *
+ * \code
+ * const PixelConverter converter(Image::Format::kRGB, Image::Format::kRGBA);
+ * converter.Convert(rgb, width * 3, rgba, width * 4, width, height);
+ * \endcode
+ */
+class PixelConverter
+{
+private:
+  /** Function that converts as many pixels as it can of a row, and returns
+   * the number of pixels that was converted **/
+  using Kernel = u64 (*)(const u8 (&shuffles)[4][16],
+                         const u8 (&constants)[4][16],
+                         const u8* source,
+                         u8* destination,
+                         u64 count);
+
+  /** Shuffle masks of the kernel **/
+  alignas(16) u8 mShuffles[4][16];
+  /** Constants that are OR:ed into the shuffled bytes **/
+  alignas(16) u8 mConstants[4][16];
+  /** For each destination channel, the byte of the source pixel that it's
+   * taken from, or one of the constant channel values **/
+  s8 mChannels[4];
+  /** Source format **/
+  Image::Format mSourceFormat;
+  /** Destination format **/
+  Image::Format mDestinationFormat;
+  /** Size of a source pixel in bytes **/
+  u32 mSourceSize;
+  /** Size of a destination pixel in bytes **/
+  u32 mDestinationSize;
+  /** Vectorized kernel, or nullptr if only the scalar conversion is used **/
+  Kernel mKernel = nullptr;
+
+public:
+  /** Create a converter between two formats. Neither of the formats may be
+   * 'Image::Format::kUnknown'.
+   * \brief Create converter.
+   * \param from Format to convert from.
+   * \param to Format to convert to.
+   */
+  PixelConverter(Image::Format from, Image::Format to);
+
+  /** Convert a row of pixels. The source and destination must not overlap.
+   * \brief Convert row.
+   * \param source Pixels to convert.
+   * \param destination Destination of the converted pixels.
+   * \param count Number of pixels.
+   */
+  void Convert(const u8* source, u8* destination, u64 count) const;
+
+  /** Convert a rectangle of pixels, row by row.
+   * \brief Convert rectangle.
+   * \param source First pixel of the first row to convert.
+   * \param sourceStride Distance between the source rows in bytes.
+   * \param destination Destination of the first row.
+   * \param destinationStride Distance between the destination rows in bytes.
+   * \param width Number of pixels per row.
+   * \param height Number of rows.
+   */
+  void Convert(const u8* source,
+               u64 sourceStride,
+               u8* destination,
+               u64 destinationStride,
+               u32 width,
+               u32 height) const;
+
+  /** Returns the format that is converted from.
+   * \brief Returns source format.
+   * \return Source format.
+   */
+  OL_NODISCARD Image::Format GetSourceFormat() const { return mSourceFormat; }
+
+  /** Returns the format that is converted to.
+   * \brief Returns destination format.
+   * \return Destination format.
+   */
+  OL_NODISCARD Image::Format GetDestinationFormat() const
+  {
+    return mDestinationFormat;
+  }
+};
+
+}
@@ -22,10 +22,31 @@
 
 #pragma once
 
+// Project headers
+#include "olivine/core/macros.hpp"
+
+#if defined(OL_PLATFORM_WINDOWS)
+
 // ========================================================================== //
 // Windows Headers
 // ========================================================================== //
 
 #define NOMINMAX
 #define WIN32_LEAN_AND_MEAN
-#include <windows.h>
\ No newline at end of file
+#include <windows.h>
+
+#elif defined(OL_PLATFORM_POSIX)
+
+// ========================================================================== //
+// POSIX Headers
+// ========================================================================== //
+
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <time.h>
+#include <unistd.h>
+
+#endif
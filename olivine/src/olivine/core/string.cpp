@@ -28,6 +28,7 @@
 
 // Project headers
 #include "olivine/core/assert.hpp"
+#include "olivine/core/unicode.hpp"
 
 // Thirdparty headers
 #include "thirdparty/alflib/alf_unicode.h"
@@ -76,25 +77,22 @@ typename String::Codepoint String::Iterator::operator*()
 
 String::String(const char8* string)
   : mBuffer(string)
-  , mLength(static_cast<LengthType>(alfUTF8StringLength(string)))
+  , mLength(LengthType(Unicode::CountUTF8(mBuffer.data(), mBuffer.size())))
 {}
 
 // -------------------------------------------------------------------------- //
 
 String::String(const char16* string)
 {
-  u32 numBytes;
-  AlfBool success = alfUTF16ToUTF8(
-    reinterpret_cast<const AlfChar16*>(string), &numBytes, nullptr);
-  OL_ASSERT(success, "Failed to convert UTF-16 to UTF-8");
-  char* buffer = new char[numBytes + 1ull];
-  buffer[numBytes] = 0;
-  success = alfUTF16ToUTF8(
-    reinterpret_cast<const AlfChar16*>(string), &numBytes, buffer);
+  // Transcode directly into the buffer
+  const u64 size = std::char_traits<char16>::length(string);
+  mBuffer.resize(Unicode::UTF8SizeOfUTF16(string, size));
+  u64 written;
+  const bool success =
+    Unicode::UTF16ToUTF8(string, size, mBuffer.data(), mBuffer.size(), written);
   OL_ASSERT(success, "Failed to convert UTF-16 to UTF-8");
-  mBuffer = BufferType(buffer);
-  mLength = static_cast<u32>(alfUTF8StringLength(buffer));
-  delete[] buffer;
+  mBuffer.resize(written);
+  mLength = LengthType(Unicode::CountUTF8(mBuffer.data(), mBuffer.size()));
 }
 
 // -------------------------------------------------------------------------- //
@@ -112,6 +110,41 @@ String::String(String::Codepoint codepoint)
 
 // -------------------------------------------------------------------------- //
 
+String::String(BufferType&& buffer, LengthType length)
+  : mBuffer(std::move(buffer))
+  , mLength(length)
+{}
+
+// -------------------------------------------------------------------------- //
+
+String::String(StringView view)
+  : mBuffer(view.GetData(), view.GetSize())
+  , mLength(view.GetLength())
+{}
+
+// -------------------------------------------------------------------------- //
+
+String::String(const String& other)
+  : mBuffer(other.mBuffer)
+  , mLength(other.mLength)
+  , mBreadcrumbs(std::atomic_load(&other.mBreadcrumbs))
+{}
+
+// -------------------------------------------------------------------------- //
+
+String&
+String::operator=(const String& other)
+{
+  if (this != &other) {
+    mBuffer = other.mBuffer;
+    mLength = other.mLength;
+    mBreadcrumbs = std::atomic_load(&other.mBreadcrumbs);
+  }
+  return *this;
+}
+
+// -------------------------------------------------------------------------- //
+
 String::Codepoint
 String::AtByteOffset(u32 offset, u32& width) const
 {
@@ -131,13 +164,9 @@ String::AtByteOffset(u32 offset, u32& width) const
 // -------------------------------------------------------------------------- //
 
 s64
-String::Find(const String& substring) const
+String::Find(StringView substring) const
 {
-  const std::string::size_type pos = mBuffer.find(substring.mBuffer);
-  if (pos == std::string::npos) {
-    return -1;
-  }
-  return pos;
+  return GetView().Find(substring);
 }
 
 // -------------------------------------------------------------------------- //
@@ -159,12 +188,9 @@ String::LastIndexOf(String::Codepoint codepoint) const
 // -------------------------------------------------------------------------- //
 
 bool
-String::StartsWith(const String& string) const
+String::StartsWith(StringView string) const
 {
-  if (GetSize() < string.GetSize()) {
-    return false;
-  }
-  return 0 == memcmp(GetUTF8(), string.GetUTF8(), string.GetSize());
+  return GetView().StartsWith(string);
 }
 
 // -------------------------------------------------------------------------- //
@@ -178,14 +204,9 @@ String::StartsWith(String::Codepoint codepoint) const
 // -------------------------------------------------------------------------- //
 
 bool
-String::EndsWith(const String& string) const
+String::EndsWith(StringView string) const
 {
-  if (GetSize() < string.GetSize()) {
-    return false;
-  }
-  return 0 == memcmp(GetUTF8() + GetSize() - string.GetSize(),
-                     string.GetUTF8(),
-                     string.GetSize());
+  return GetView().EndsWith(string);
 }
 
 // -------------------------------------------------------------------------- //
@@ -211,16 +232,49 @@ String::EndsWith(String::Codepoint codepoint) const
 // -------------------------------------------------------------------------- //
 
 u32
-String::Replace(const String& from, const String& to)
+String::Replace(StringView from, StringView to)
 {
-  s64 index;
+  if (from.IsEmpty()) {
+    return 0;
+  }
+
+  // Count occurrences to compute the size of the result up-front
+  const char8* needle = from.GetData();
+  const BufferType::size_type fromSize = from.GetSize();
+  const BufferType::size_type toSize = to.GetSize();
+  BufferType::size_type index = mBuffer.find(needle, 0, fromSize);
+  if (index == BufferType::npos) {
+    return 0;
+  }
   u32 count = 0;
-  while ((index = Find(from)) >= 0) {
-    String str0 = mBuffer.substr(0, index).c_str();
-    String str1 = mBuffer.substr(index + from.GetSize()).c_str();
-    operator=(str0 + to + str1);
+  for (BufferType::size_type i = index; i != BufferType::npos;
+       i = mBuffer.find(needle, i + fromSize, fromSize)) {
     count++;
   }
+
+  if (fromSize == toSize) {
+    // Overwrite each occurrence in-place
+    for (; index != BufferType::npos;
+         index = mBuffer.find(needle, index + fromSize, fromSize)) {
+      mBuffer.replace(index, fromSize, to.GetData(), toSize);
+    }
+  } else {
+    // Copy the spans between the occurrences into a new buffer
+    BufferType buffer;
+    buffer.reserve(mBuffer.size() - count * fromSize + count * toSize);
+    BufferType::size_type offset = 0;
+    for (; index != BufferType::npos;
+         index = mBuffer.find(needle, offset, fromSize)) {
+      buffer.append(mBuffer, offset, index - offset);
+      buffer.append(to.GetData(), toSize);
+      offset = index + fromSize;
+    }
+    buffer.append(mBuffer, offset, BufferType::npos);
+    mBuffer = std::move(buffer);
+  }
+
+  mLength = mLength - count * from.GetLength() + count * to.GetLength();
+  mBreadcrumbs.reset();
   return count;
 }
 
@@ -247,13 +301,14 @@ String::Remove(u32 codepoint)
 String
 String::Substring(u64 from, s64 count) const
 {
-  // Retrieve substring
-  char8* substring = alfUTF8Substring(GetUTF8(), from, count);
-  String output;
-  output.mBuffer = BufferType{ substring, mBuffer.get_allocator() };
-  output.mLength = LengthType(alfUTF8StringLength(output.mBuffer.c_str()));
-  free(substring);
-  return output;
+  if (from >= mLength || count == 0) {
+    return String();
+  }
+  const u64 end =
+    count < 0 || from + u64(count) > mLength ? mLength : from + u64(count);
+  const SizeType begin = GetByteOffset(LengthType(from));
+  return String(mBuffer.substr(begin, GetByteOffset(LengthType(end)) - begin),
+                LengthType(end - from));
 }
 
 // -------------------------------------------------------------------------- //
@@ -262,7 +317,8 @@ void
 String::operator+=(const String& string)
 {
   mBuffer += string.mBuffer;
-  mLength = LengthType(alfUTF8StringLength(mBuffer.c_str()));
+  mLength += string.mLength;
+  mBreadcrumbs.reset();
 }
 
 // -------------------------------------------------------------------------- //
@@ -270,8 +326,10 @@ String::operator+=(const String& string)
 void
 String::operator+=(const char8* string)
 {
-  mBuffer += string;
-  mLength = LengthType(alfUTF8StringLength(mBuffer.c_str()));
+  const u64 size = strlen(string);
+  mBuffer.append(string, size);
+  mLength += LengthType(Unicode::CountUTF8(string, size));
+  mBreadcrumbs.reset();
 }
 
 // -------------------------------------------------------------------------- //
@@ -279,7 +337,14 @@ String::operator+=(const char8* string)
 u32
 String::At(u32 index) const
 {
-  return alfUTF8AtIndex(GetUTF8(), static_cast<u64>(index));
+  if (index >= mLength) {
+    return 0;
+  }
+  if (IsASCII()) {
+    return u8(mBuffer[index]);
+  }
+  u32 width;
+  return AtByteOffset(GetByteOffset(index), width);
 }
 
 // -------------------------------------------------------------------------- //
@@ -303,21 +368,61 @@ String::As()
 char16*
 String::GetUTF16() const
 {
-  const char8* _string = GetUTF8();
-  u32 numCodeUnits;
-  AlfBool success = alfUTF8ToUTF16(_string, &numCodeUnits, nullptr);
-  OL_ASSERT(success, "Failed to convert UTF-16 to UTF-8");
-
-  char16* buffer = new char16[numCodeUnits + 1ull];
-  buffer[numCodeUnits] = 0;
-  success = alfUTF8ToUTF16(
-    _string, &numCodeUnits, reinterpret_cast<AlfChar16*>(buffer));
-  OL_ASSERT(success, "Failed to convert UTF-16 to UTF-8");
+  const u64 size = Unicode::UTF16SizeOfUTF8(mBuffer.data(), mBuffer.size());
+  char16* buffer = new char16[size + 1ull];
+  u64 written;
+  const bool success =
+    Unicode::UTF8ToUTF16(mBuffer.data(), mBuffer.size(), buffer, size, written);
+  OL_ASSERT(success, "Failed to convert UTF-8 to UTF-16");
+  buffer[written] = 0;
   return buffer;
 }
 
 // -------------------------------------------------------------------------- //
 
+String::SizeType
+String::GetByteOffset(LengthType index) const
+{
+  if (index >= mLength) {
+    return GetSize();
+  }
+  if (IsASCII()) {
+    return index;
+  }
+
+  // Build the index cache by walking the lead bytes once. Threads that race
+  // to build it build identical caches, and one of them is kept
+  std::shared_ptr<const std::vector<SizeType>> breadcrumbs =
+    std::atomic_load(&mBreadcrumbs);
+  if (!breadcrumbs) {
+    auto built = std::make_shared<std::vector<SizeType>>();
+    built->reserve(mLength / kBreadcrumbInterval + 1);
+    LengthType count = 0;
+    for (SizeType offset = 0; offset < GetSize(); offset++) {
+      if ((u8(mBuffer[offset]) & 0xC0) != 0x80) {
+        if (count % kBreadcrumbInterval == 0) {
+          built->push_back(offset);
+        }
+        count++;
+      }
+    }
+    breadcrumbs = std::move(built);
+    std::atomic_store(&mBreadcrumbs, breadcrumbs);
+  }
+
+  // Step forward from the closest preceding breadcrumb. The null-terminator
+  // stops the scan at the end of the buffer
+  SizeType offset = (*breadcrumbs)[index / kBreadcrumbInterval];
+  for (LengthType n = index % kBreadcrumbInterval; n > 0; n--) {
+    do {
+      offset++;
+    } while ((u8(mBuffer[offset]) & 0xC0) == 0x80);
+  }
+  return offset;
+}
+
+// -------------------------------------------------------------------------- //
+
 String::LengthType
 String::CodepointWidth(Codepoint codepoint)
 {
@@ -27,15 +27,100 @@
 // ========================================================================== //
 
 // Standard headers
+#include <memory>
 #include <string>
+#include <vector>
 
 // Project headers
 #include "olivine/core/types.hpp"
 #include "olivine/core/macros.hpp"
+#include "olivine/core/string_view.hpp"
+#include "olivine/core/unicode.hpp"
 
 // Thirdparty headers
 #include "fmt/ostream.h"
 
+// ========================================================================== //
+// Macros
+// ========================================================================== //
+
+/** Macro for a format string that is checked against the format arguments at
+ * compile-time. Can be passed to all functions that take a format string **/
+#define OL_FMT(string) FMT_STRING(string)
+
+// ========================================================================== //
+// FormatBuffer Declaration
+// ========================================================================== //
+
+namespace olivine {
+
+/** \class FormatBuffer
+ * \author Filip Björklund
+ * \date 18 october 2026 - 15:30
+ * \brief Buffer to format text into.
+ * \details
+ * Buffer that stores up to 'SIZE' bytes inline, which means that a buffer that
+ * is declared on the stack can be formatted into without any allocations. If
+ * the formatted text does not fit then the buffer grows on the heap.
+ *
+ * \code
+ * FormatBuffer<> buffer;
+ * StringView name = String::FormatTo(buffer, OL_FMT("Buffer{}"), index);
+ * \endcode
+ *
+ * \tparam SIZE Inline size in bytes.
+ */
+template<u32 SIZE = 256>
+class FormatBuffer
+{
+  OL_NO_COPY(FormatBuffer);
+
+  friend class String;
+
+private:
+  /** Underlying buffer **/
+  fmt::basic_memory_buffer<char8, SIZE> mBuffer;
+
+public:
+  /** Construct an empty buffer **/
+  FormatBuffer() = default;
+
+  /** Append a string to the end of the buffer.
+   * \brief Append string.
+   * \param string String to append.
+   */
+  void Append(StringView string)
+  {
+    mBuffer.append(string.GetData(), string.GetData() + string.GetSize());
+  }
+
+  /** Clear the contents of the buffer.
+   * \brief Clear buffer.
+   */
+  void Clear() { mBuffer.clear(); }
+
+  /** Returns a view of the contents of the buffer. The view is invalidated by
+   * any modification of the buffer.
+   * \brief Returns view of contents.
+   * \return View of contents.
+   */
+  OL_NODISCARD StringView GetView() const
+  {
+    return StringView{ mBuffer.data(), GetSize() };
+  }
+
+  /** Returns the size of the contents in bytes.
+   * \brief Returns size.
+   * \return Size in bytes.
+   */
+  OL_NODISCARD StringView::SizeType GetSize() const
+  {
+    return StringView::SizeType(mBuffer.size());
+  }
+};
+
+}
+
 // ========================================================================== //
 // String Declaration
 // ========================================================================== //
@@ -84,11 +169,31 @@ public:
   /** Value of an invalid codepoint **/
   static constexpr Codepoint InvalidCodepoint = Codepoint(-1);
 
+  /** Number of codepoints between each breadcrumb in the index cache **/
+  static constexpr LengthType kBreadcrumbInterval = 32;
+
 private:
   /** Underlying string buffer **/
   BufferType mBuffer;
   /** Length in codepoints  **/
   LengthType mLength = 0;
+  /** Index cache with the byte offset of every 'kBreadcrumbInterval'th
+   * codepoint. Built on the first indexed access of a non-ASCII string,
+   * shared between copies and reset when the string is modified. The cache
+   * can be built by const accessors on multiple threads at the same time, so
+   * it's only loaded and stored with the atomic 'std::shared_ptr' functions **/
+  mutable std::shared_ptr<const std::vector<SizeType>> mBreadcrumbs;
+
+  friend class StringBuilder;
+
+private:
+  /** Construct a string by taking ownership of a buffer with a known length
+   * in codepoints **/
+  String(BufferType&& buffer, LengthType length);
+
+  /** Returns the byte offset of the codepoint at the specified index. An index
+   * equal to the length returns the size **/
+  SizeType GetByteOffset(LengthType index) const;
 
 public:
   /** Construct a string from a UTF-8 encoded c-string.
@@ -110,17 +215,23 @@ public:
    */
   String(Codepoint codepoint);
 
+  /** Construct a string from the UTF-8 data of a string view.
+   * \brief Construct from view.
+   * \param view View to construct from.
+   */
+  explicit String(StringView view);
+
   /** Default constructor **/
   String() = default;
 
-  /** Default copy-constructor **/
-  String(const String&) = default;
+  /** Copy-constructor **/
+  String(const String& other);
 
   /** Default move-constructor **/
   String(String&&) = default;
 
-  /** Default copy-assignment **/
-  String& operator=(const String&) = default;
+  /** Copy-assignment **/
+  String& operator=(const String& other);
 
   /** Default move-assignment **/
   String& operator=(String&&) noexcept = default;
@@ -142,7 +253,7 @@ public:
    * \return Index of first occurance or -1 if the substring never occurs in the
    * string.
    */
-  s64 Find(const String& substring) const;
+  s64 Find(StringView substring) const;
 
   /** Returns the index of the first occurance of the specified codepoint.
    * \brief Returns index of first occurance.
@@ -165,7 +276,7 @@ public:
    * \param string String to check if this string begins with.
    * \return True if this string begins with the other string.
    */
-  bool StartsWith(const String& string) const;
+  bool StartsWith(StringView string) const;
 
   /** Returns whether or not the string begins with the specified codepoint.
    * \brief Returns whether string begins with codepoint.
@@ -180,7 +291,7 @@ public:
    * \param string String to check if this string ends with.
    * \return True if this string ends with the other string.
    */
-  bool EndsWith(const String& string) const;
+  bool EndsWith(StringView string) const;
 
   /** Returns whether or not the string ends with the specified codepoint.
    * \brief Returns whether string ends with codepoint.
@@ -190,15 +301,16 @@ public:
    */
   bool EndsWith(Codepoint codepoint) const;
 
-  /** Replace all occurrences of the
-   * \todo Currently the implementation is naïve and not very efficient. A
-   * better substring searching algorithm should be used.
+  /** Replace all occurrences of the string 'from' with the string 'to'. The
+   * string is scanned once from left to right and replaced occurrences are
+   * not searched again. Replacements of equal size are done in-place,
+   * otherwise the result is built in a single new allocation.
    * \brief Replace all occurrences of the string 'from' with the string 'to'.
    * \param from String to replace all occurrences of.
    * \param to String to replace the occurrences with.
    * \return Number of replaced occurrences.
    */
-  u32 Replace(const String& from, const String& to);
+  u32 Replace(StringView from, StringView to);
 
   /** Remove all occurrences of the specified codepoint from the string.
    * \brief Remove all occurrences of codepoint.
@@ -229,24 +341,32 @@ public:
    */
   void operator+=(const char8* string);
 
-  /** Returns the codepoint at the specified index in the string.
-   * \note This function will traverse the entire string due to the
-   * variable-length encoding nature of UTF-8.
+  /** Returns the codepoint at the specified index in the string. ASCII
+   * strings are indexed directly, other strings use the index cache to start
+   * decoding at most 'kBreadcrumbInterval' codepoints before the index.
    * \brief Returns codepoint at index.
    * \param index Index to get codepoint at.
-   * \return Codepoint at index.
+   * \return Codepoint at index or 0 if the index is out of bounds.
    */
   OL_NODISCARD u32 At(u32 index) const;
 
-  /** Returns the codepoint at the specified index in the string.
-   * \note This function will traverse the entire string due to the
-   * variable-length encoding nature of UTF-8.
+  /** Returns the codepoint at the specified index in the string. ASCII
+   * strings are indexed directly, other strings use the index cache to start
+   * decoding at most 'kBreadcrumbInterval' codepoints before the index.
    * \brief Returns codepoint at index.
    * \param index Index to get codepoint at.
-   * \return Codepoint at index.
+   * \return Codepoint at index or 0 if the index is out of bounds.
    */
   OL_NODISCARD u32 operator[](u32 index) const;
 
+  /** Returns whether or not the string only contains ASCII characters. This
+   * is the case exactly when the length equals the size, as every other
+   * codepoint takes more than one byte.
+   * \brief Returns whether string is ASCII.
+   * \return True if the string is ASCII otherwise false.
+   */
+  OL_NODISCARD bool IsASCII() const { return mLength == mBuffer.size(); }
+
   template<typename T>
   T As();
 
@@ -274,6 +394,19 @@ public:
    */
   OL_NODISCARD const char8* GetUTF8() const { return mBuffer.c_str(); }
 
+  /** Returns a view of the entire string. The view is only valid as long as
+   * the string is not modified or destroyed.
+   * \brief Returns view.
+   * \return View of string.
+   */
+  OL_NODISCARD StringView GetView() const
+  {
+    return StringView{ mBuffer.data(), GetSize(), mLength };
+  }
+
+  /** Implicit conversion to a view of the entire string **/
+  operator StringView() const { return GetView(); }
+
   /** Returns a UTF-16 encoded string converted from this string.
    * \brief Returns UTF-16 string.
    * \return UTF-16 string.
@@ -350,13 +483,13 @@ public:
   /** Equality **/
   friend bool operator==(const String& str0, const char8* str1)
   {
-    return str0 == String(str1);
+    return strcmp(str0.GetUTF8(), str1) == 0;
   }
 
   /** Equality **/
   friend bool operator==(const char8* str0, const String& str1)
   {
-    return String(str0) == str1;
+    return strcmp(str0, str1.GetUTF8()) == 0;
   }
 
   /** Inequality **/
@@ -368,29 +501,79 @@ public:
   /** Inequality **/
   friend bool operator!=(const String& str0, const char8* str1)
   {
-    return str0 != String(str1);
+    return !(str0 == str1);
   }
 
   /** Inequality **/
   friend bool operator!=(const char8* str0, const String& str1)
   {
-    return String(str0) != str1;
+    return !(str0 == str1);
   }
 
   /** Format a string according to the rules of the fmt library. The format
-   * string is formatted with the arguments.
+   * string is formatted with the arguments. The result is formatted directly
+   * into the buffer of the returned string.
    * \brief Format a string.
+   * \tparam S Format string type.
    * \tparam ARGS Argument types.
-   * \param format String that describes format.
+   * \param format String that describes format. Use 'OL_FMT' to have the
+   * format checked at compile-time.
    * \param arguments Arguments to format string with.
    * \return Formatted string.
    *
    * \example
    * // "Sum: 2 + 2 = 4"
-   * String str = String::Format("Sum: {} + {} = {}", 2, "2", 4);
+   * String str = String::Format(OL_FMT("Sum: {} + {} = {}"), 2, "2", 4);
+   */
+  template<typename S, typename... ARGS>
+  OL_NODISCARD static String Format(const S& format, ARGS&&... arguments);
+
+  /** Format text according to the rules of the fmt library and append it to
+   * the end of an existing string.
+   * \brief Format and append to string.
+   * \tparam S Format string type.
+   * \tparam ARGS Argument types.
+   * \param output String to append to.
+   * \param format String that describes format.
+   * \param arguments Arguments to format string with.
+   */
+  template<typename S, typename... ARGS>
+  static void FormatTo(String& output, const S& format, ARGS&&... arguments);
+
+  /** Format text according to the rules of the fmt library and append it to
+   * the end of a format buffer.
+   * \brief Format and append to buffer.
+   * \tparam SIZE Inline size of the buffer.
+   * \tparam S Format string type.
+   * \tparam ARGS Argument types.
+   * \param buffer Buffer to append to.
+   * \param format String that describes format.
+   * \param arguments Arguments to format string with.
+   * \return View of the entire contents of the buffer.
+   */
+  template<u32 SIZE, typename S, typename... ARGS>
+  static StringView FormatTo(FormatBuffer<SIZE>& buffer,
+                             const S& format,
+                             ARGS&&... arguments);
+
+  /** Format text according to the rules of the fmt library into a fixed-size
+   * buffer. Text that does not fit is truncated and the output is always
+   * null-terminated.
+   * \brief Format into fixed-size buffer.
+   * \tparam S Format string type.
+   * \tparam ARGS Argument types.
+   * \param buffer Buffer to format into.
+   * \param size Size of the buffer in bytes, including the null-terminator.
+   * \param format String that describes format.
+   * \param arguments Arguments to format string with.
+   * \return Size of the formatted text before truncation, excluding the
+   * null-terminator.
    */
-  template<typename... ARGS>
-  OL_NODISCARD static String Format(const String& format, ARGS&&... arguments);
+  template<typename S, typename... ARGS>
+  static u64 FormatTo(char8* buffer,
+                      u64 size,
+                      const S& format,
+                      ARGS&&... arguments);
 
   /** Convert the given value to string form.
    * \brief Convert value to string.
@@ -441,12 +624,55 @@ String::ToString(T value)
 
 // -------------------------------------------------------------------------- //
 
-template<typename... ARGS>
+template<typename S, typename... ARGS>
 String
-String::Format(const String& format, ARGS&&... arguments)
+String::Format(const S& format, ARGS&&... arguments)
 {
-  return String(
-    fmt::format(format.mBuffer, std::forward<ARGS>(arguments)...).c_str());
+  String output;
+  FormatTo(output, format, std::forward<ARGS>(arguments)...);
+  return output;
+}
+
+// -------------------------------------------------------------------------- //
+
+template<typename S, typename... ARGS>
+void
+String::FormatTo(String& output, const S& format, ARGS&&... arguments)
+{
+  const BufferType::size_type offset = output.mBuffer.size();
+  fmt::format_to(std::back_inserter(output.mBuffer),
+                 format,
+                 std::forward<ARGS>(arguments)...);
+  output.mLength += LengthType(Unicode::CountUTF8(
+    output.mBuffer.data() + offset, output.mBuffer.size() - offset));
+  output.mBreadcrumbs.reset();
+}
+
+// -------------------------------------------------------------------------- //
+
+template<u32 SIZE, typename S, typename... ARGS>
+StringView
+String::FormatTo(FormatBuffer<SIZE>& buffer,
+                 const S& format,
+                 ARGS&&... arguments)
+{
+  fmt::format_to(buffer.mBuffer, format, std::forward<ARGS>(arguments)...);
+  return buffer.GetView();
+}
+
+// -------------------------------------------------------------------------- //
+
+template<typename S, typename... ARGS>
+u64
+String::FormatTo(char8* buffer, u64 size, const S& format, ARGS&&... arguments)
+{
+  if (size == 0) {
+    return 0;
+  }
+  const auto result = fmt::format_to_n(
+    buffer, size - 1, format, std::forward<ARGS>(arguments)...);
+  *result.out = 0;
+  return u64(result.size);
 }
 
 }
@@ -455,6 +681,30 @@ String::Format(const String& format, ARGS&&... arguments)
 // Functions
 // ========================================================================== //
 
+namespace olivine {
+
+/** Makes strings usable as format strings and lets the fmt library format
+ * them without going through 'operator<<'. Found by argument-dependent
+ * lookup **/
+inline fmt::string_view
+to_string_view(const String& string)
+{
+  return fmt::string_view{ string.GetUTF8(), string.GetSize() };
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Makes string views usable as format strings and format arguments **/
+inline fmt::string_view
+to_string_view(StringView string)
+{
+  return fmt::string_view{ string.GetData(), string.GetSize() };
+}
+
+}
+
+// -------------------------------------------------------------------------- //
+
 namespace std {
 template<>
 struct hash<olivine::String>
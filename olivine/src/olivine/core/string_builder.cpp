@@ -0,0 +1,94 @@
+// MIT License
+//
+// Copyright (c) 2019 Filip Björklund
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "olivine/core/string_builder.hpp"
+
+// ========================================================================== //
+// Headers
+// ========================================================================== //
+
+// Project headers
+#include "olivine/core/assert.hpp"
+#include "olivine/core/unicode.hpp"
+
+// Thirdparty headers
+#include "thirdparty/alflib/alf_unicode.h"
+
+// ========================================================================== //
+// StringBuilder Implementation
+// ========================================================================== //
+
+namespace olivine {
+
+StringBuilder::StringBuilder(SizeType capacity)
+{
+  mBuffer.reserve(capacity);
+}
+
+// -------------------------------------------------------------------------- //
+
+void
+StringBuilder::Reserve(SizeType capacity)
+{
+  mBuffer.reserve(capacity);
+}
+
+// -------------------------------------------------------------------------- //
+
+StringBuilder&
+StringBuilder::Append(StringView string)
+{
+  mBuffer.append(string.GetData(), string.GetSize());
+  return *this;
+}
+
+// -------------------------------------------------------------------------- //
+
+StringBuilder&
+StringBuilder::Append(String::Codepoint codepoint)
+{
+  if (codepoint < 0x80) {
+    mBuffer.push_back(char8(codepoint));
+    return *this;
+  }
+
+  char8 encoded[4];
+  u32 numBytes;
+  const AlfBool success = alfUTF8Encode(encoded, 0, codepoint, &numBytes);
+  OL_ASSERT(success, "Failed to encode codepoint");
+  mBuffer.append(encoded, numBytes);
+  return *this;
+}
+
+// -------------------------------------------------------------------------- //
+
+String
+StringBuilder::Build()
+{
+  const String::LengthType length =
+    String::LengthType(Unicode::CountUTF8(mBuffer.data(), mBuffer.size()));
+  String string(std::move(mBuffer), length);
+  mBuffer.clear();
+  return string;
+}
+
+}
@@ -0,0 +1,159 @@
+// MIT License
+//
+// Copyright (c) 2019 Filip Björklund
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+// ========================================================================== //
+// Headers
+// ========================================================================== //
+
+// Standard headers
+#include <iterator>
+
+// Project headers
+#include "olivine/core/string.hpp"
+
+// ========================================================================== //
+// StringBuilder Declaration
+// ========================================================================== //
+
+namespace olivine {
+
+/** \class StringBuilder
+ * \author Filip Björklund
+ * \date 18 october 2026 - 14:50
+ * \brief Builder for strings.
+ * \details
+ * Builds a UTF-8 string by appending pieces to a growable buffer. When the
+ * string is complete the buffer is moved into a 'String' with 'Build', which
+ * does not copy the data. If the final size is known, or can be estimated,
+ * then 'Reserve' can be used to make the buffer a single allocation.
+ *
+ * \code
+ * StringBuilder builder;
+ * builder.Append("#define ").AppendFormat("{} {}", name, value).Append('\n');
+ * String source = builder.Build();
+ * \endcode
+ */
+class StringBuilder
+{
+  OL_NO_COPY(StringBuilder);
+  OL_DEFAULT_MOVE(StringBuilder);
+
+public:
+  /** Size type **/
+  using SizeType = String::SizeType;
+
+private:
+  /** Buffer that is being built **/
+  String::BufferType mBuffer;
+
+public:
+  /** Construct an empty builder **/
+  StringBuilder() = default;
+
+  /** Construct a builder with an initial capacity.
+   * \brief Construct with capacity.
+   * \param capacity Capacity in bytes.
+   */
+  explicit StringBuilder(SizeType capacity);
+
+  /** Reserve capacity in the buffer of the builder.
+   * \brief Reserve capacity.
+   * \param capacity Capacity in bytes.
+   */
+  void Reserve(SizeType capacity);
+
+  /** Append a string to the end of the builder.
+   * \brief Append string.
+   * \param string String to append.
+   * \return Reference to the builder.
+   */
+  StringBuilder& Append(StringView string);
+
+  /** Append a single codepoint to the end of the builder.
+   * \brief Append codepoint.
+   * \param codepoint Codepoint to append.
+   * \return Reference to the builder.
+   */
+  StringBuilder& Append(String::Codepoint codepoint);
+
+  /** Append a string formatted according to the rules of the fmt library to
+   * the end of the builder. The result is formatted directly into the buffer
+   * of the builder.
+   * \brief Append formatted string.
+   * \tparam ARGS Types of the format arguments.
+   * \param format Format string.
+   * \param arguments Format arguments.
+   * \return Reference to the builder.
+   */
+  template<typename... ARGS>
+  StringBuilder& AppendFormat(StringView format, ARGS&&... arguments);
+
+  /** Clear the contents of the builder. The capacity is kept.
+   * \brief Clear builder.
+   */
+  void Clear() { mBuffer.clear(); }
+
+  /** Move the contents of the builder into a string. The builder is empty
+   * after the call.
+   * \brief Build string.
+   * \return Built string.
+   */
+  OL_NODISCARD String Build();
+
+  /** Returns a view of the current contents of the builder. The view is
+   * invalidated by any modification of the builder.
+   * \brief Returns view of contents.
+   * \return View of contents.
+   */
+  OL_NODISCARD StringView GetView() const
+  {
+    return StringView{ mBuffer.data(), GetSize() };
+  }
+
+  /** Returns the size of the current contents in bytes.
+   * \brief Returns size.
+   * \return Size in bytes.
+   */
+  OL_NODISCARD SizeType GetSize() const { return SizeType(mBuffer.size()); }
+
+  /** Returns whether or not the builder is empty.
+   * \brief Returns whether empty.
+   * \return True if the builder is empty otherwise false.
+   */
+  OL_NODISCARD bool IsEmpty() const { return mBuffer.empty(); }
+};
+
+// -------------------------------------------------------------------------- //
+
+template<typename... ARGS>
+StringBuilder&
+StringBuilder::AppendFormat(StringView format, ARGS&&... arguments)
+{
+  fmt::format_to(std::back_inserter(mBuffer),
+                 fmt::string_view{ format.GetData(), format.GetSize() },
+                 std::forward<ARGS>(arguments)...);
+  return *this;
+}
+
+}
@@ -0,0 +1,83 @@
+// MIT License
+//
+// Copyright (c) 2019 Filip Björklund
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "olivine/core/string_view.hpp"
+
+// ========================================================================== //
+// Headers
+// ========================================================================== //
+
+// Project headers
+#include "olivine/core/unicode.hpp"
+
+// ========================================================================== //
+// StringView Implementation
+// ========================================================================== //
+
+namespace olivine {
+
+s64
+StringView::Find(StringView substring, SizeType offset) const
+{
+  const std::string_view::size_type pos =
+    GetStd().find(substring.GetStd(), offset);
+  if (pos == std::string_view::npos) {
+    return -1;
+  }
+  return s64(pos);
+}
+
+// -------------------------------------------------------------------------- //
+
+s64
+StringView::FindLast(char8 byte) const
+{
+  for (SizeType i = mSize; i > 0; i--) {
+    if (mData[i - 1] == byte) {
+      return s64(i - 1);
+    }
+  }
+  return -1;
+}
+
+// -------------------------------------------------------------------------- //
+
+StringView
+StringView::Subview(SizeType offset, SizeType size) const
+{
+  offset = offset > mSize ? mSize : offset;
+  size = size > mSize - offset ? mSize - offset : size;
+  return StringView{ mData + offset, size };
+}
+
+// -------------------------------------------------------------------------- //
+
+StringView::LengthType
+StringView::GetLength() const
+{
+  if (mLength == kUnknownLength) {
+    mLength = LengthType(Unicode::CountUTF8(mData, mSize));
+  }
+  return mLength;
+}
+
+}
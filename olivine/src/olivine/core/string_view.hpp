@@ -0,0 +1,225 @@
+// MIT License
+//
+// Copyright (c) 2019 Filip Björklund
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+// ========================================================================== //
+// Headers
+// ========================================================================== //
+
+// Standard headers
+#include <cstring>
+#include <string>
+#include <string_view>
+
+// Project headers
+#include "olivine/core/types.hpp"
+#include "olivine/core/macros.hpp"
+
+// Thirdparty headers
+#include "fmt/ostream.h"
+
+// ========================================================================== //
+// StringView Declaration
+// ========================================================================== //
+
+namespace olivine {
+
+/** \class StringView
+ * \author Filip Björklund
+ * \date 18 october 2026 - 10:12
+ * \brief Non-owning view of a UTF-8 string.
+ * \details
+ * Represents a view of a range of UTF-8 encoded bytes that is owned by someone
+ * else, for example a 'String' or a string literal. Views are cheap to create
+ * and copy and can be used for lookups and comparisons without having to
+ * allocate a 'String'.
+ *
+ * The length (in codepoints) of the view is only calculated when first
+ * requested and is then cached in the view.
+ *
+ * \note The viewed data is not required to be null-terminated.
+ */
+class StringView
+{
+public:
+  /** Length type **/
+  using LengthType = u32;
+  /** Size type **/
+  using SizeType = u32;
+
+  /** Value of the length when it has not yet been calculated **/
+  static constexpr LengthType kUnknownLength = LengthType(-1);
+
+private:
+  /** Pointer to the viewed data **/
+  const char8* mData = "";
+  /** Size of the view in bytes **/
+  SizeType mSize = 0;
+  /** Cached length in codepoints **/
+  mutable LengthType mLength = 0;
+
+public:
+  /** Construct an empty view **/
+  constexpr StringView() = default;
+
+  /** Construct a view of a null-terminated UTF-8 string.
+   * \brief Construct from UTF-8 string.
+   * \param string String to view.
+   */
+  constexpr StringView(const char8* string)
+    : mData(string)
+    , mSize(SizeType(std::char_traits<char8>::length(string)))
+    , mLength(kUnknownLength)
+  {}
+
+  /** Construct a view of 'size' bytes starting at 'data'. The length can be
+   * specified if it's already known by the caller.
+   * \brief Construct from data and size.
+   * \param data Data to view.
+   * \param size Size of data in bytes.
+   * \param length Length of data in codepoints, if known.
+   */
+  constexpr StringView(const char8* data,
+                       SizeType size,
+                       LengthType length = kUnknownLength)
+    : mData(data)
+    , mSize(size)
+    , mLength(length)
+  {}
+
+  /** Returns the byte offset of the first occurrence of a substring in the
+   * view.
+   * \brief Find substring.
+   * \param substring Substring to find.
+   * \param offset Byte offset to start searching from.
+   * \return Byte offset of the first occurrence or -1 if the substring does
+   * not occur in the view.
+   */
+  OL_NODISCARD s64 Find(StringView substring, SizeType offset = 0) const;
+
+  /** Returns the byte offset of the last occurrence of a byte in the view.
+   * \brief Find last byte.
+   * \param byte Byte to find.
+   * \return Byte offset of the last occurrence or -1 if the byte does not
+   * occur in the view.
+   */
+  OL_NODISCARD s64 FindLast(char8 byte) const;
+
+  /** Returns whether or not the view begins with another view.
+   * \brief Returns whether view begins with other view.
+   * \param view View to check if this view begins with.
+   * \return True if this view begins with the other view.
+   */
+  OL_NODISCARD bool StartsWith(StringView view) const
+  {
+    return mSize >= view.mSize && memcmp(mData, view.mData, view.mSize) == 0;
+  }
+
+  /** Returns whether or not the view ends with another view.
+   * \brief Returns whether view ends with other view.
+   * \param view View to check if this view ends with.
+   * \return True if this view ends with the other view.
+   */
+  OL_NODISCARD bool EndsWith(StringView view) const
+  {
+    return mSize >= view.mSize &&
+           memcmp(mData + mSize - view.mSize, view.mData, view.mSize) == 0;
+  }
+
+  /** Returns a view of a byte range of this view. The range is clamped to the
+   * size of the view.
+   * \brief Returns sub-view.
+   * \param offset Byte offset of the sub-view.
+   * \param size Size of the sub-view in bytes. -1 means the rest of the view.
+   * \return Sub-view.
+   */
+  OL_NODISCARD StringView Subview(SizeType offset,
+                                  SizeType size = SizeType(-1)) const;
+
+  /** Returns the viewed data. This is not guaranteed to be null-terminated.
+   * \brief Returns data.
+   * \return Data.
+   */
+  OL_NODISCARD const char8* GetData() const { return mData; }
+
+  /** Returns the size of the view in bytes.
+   * \brief Returns size.
+   * \return Size in bytes.
+   */
+  OL_NODISCARD SizeType GetSize() const { return mSize; }
+
+  /** Returns the length of the view in codepoints. This is calculated on the
+   * first call and cached for subsequent calls.
+   * \brief Returns length.
+   * \return Length in codepoints.
+   */
+  OL_NODISCARD LengthType GetLength() const;
+
+  /** Returns whether or not the view is empty.
+   * \brief Returns whether view is empty.
+   * \return True if the view is empty otherwise false.
+   */
+  OL_NODISCARD bool IsEmpty() const { return mSize == 0; }
+
+  /** Returns the view as a 'std::string_view' **/
+  OL_NODISCARD std::string_view GetStd() const { return { mData, mSize }; }
+
+public:
+  /** Output stream function **/
+  friend std::ostream& operator<<(std::ostream& stream, StringView view)
+  {
+    return stream.write(view.mData, view.mSize);
+  }
+
+  /** Equality **/
+  friend bool operator==(StringView view0, StringView view1)
+  {
+    return view0.mSize == view1.mSize &&
+           memcmp(view0.mData, view1.mData, view0.mSize) == 0;
+  }
+
+  /** Inequality **/
+  friend bool operator!=(StringView view0, StringView view1)
+  {
+    return !(view0 == view1);
+  }
+};
+
+}
+
+// ========================================================================== //
+// Functions
+// ========================================================================== //
+
+namespace std {
+template<>
+struct hash<olivine::StringView>
+{
+  std::size_t operator()(const olivine::StringView& view) const
+  {
+    // Matches std::hash<olivine::String>, which hashes the std::string buffer
+    return std::hash<std::string_view>{}(view.GetStd());
+  }
+};
+
+}
@@ -0,0 +1,210 @@
+// MIT License
+//
+// Copyright (c) 2019 Filip Björklund
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "olivine/core/thread_pool.hpp"
+
+// ========================================================================== //
+// Headers
+// ========================================================================== //
+
+// Standard headers
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
+// ========================================================================== //
+// ThreadPool Implementation
+// ========================================================================== //
+
+namespace olivine {
+
+ThreadPool::ThreadPool(u32 threadCount)
+{
+  if (threadCount == 0) {
+    threadCount = std::max(1u, std::thread::hardware_concurrency());
+  }
+  mThreads.reserve(threadCount);
+  for (u32 i = 0; i < threadCount; i++) {
+    mThreads.emplace_back([this] { Work(); });
+  }
+}
+
+// -------------------------------------------------------------------------- //
+
+ThreadPool::~ThreadPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mStop = true;
+  }
+  mTaskCondition.notify_all();
+  for (std::thread& thread : mThreads) {
+    thread.join();
+  }
+}
+
+// -------------------------------------------------------------------------- //
+
+void
+ThreadPool::Submit(Task task, Priority priority)
+{
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mQueues[u32(priority)].push_back(std::move(task));
+    mPendingCount++;
+  }
+  mTaskCondition.notify_one();
+}
+
+// -------------------------------------------------------------------------- //
+
+void
+ThreadPool::Submit(std::vector<Task>&& tasks, Priority priority)
+{
+  if (tasks.empty()) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    std::deque<Task>& queue = mQueues[u32(priority)];
+    for (Task& task : tasks) {
+      queue.push_back(std::move(task));
+    }
+    mPendingCount += tasks.size();
+  }
+  tasks.clear();
+  mTaskCondition.notify_all();
+}
+
+// -------------------------------------------------------------------------- //
+
+void
+ThreadPool::Wait()
+{
+  std::unique_lock<std::mutex> lock(mMutex);
+  mIdleCondition.wait(lock, [this] { return mPendingCount == 0; });
+}
+
+// -------------------------------------------------------------------------- //
+
+void
+ThreadPool::ParallelFor(u64 count, const IndexTask& function, Priority priority)
+{
+  // State that is shared with the helper tasks. Helpers that start after all
+  // indices have been taken return without touching the function, so the
+  // state is the only thing that has to outlive this call
+  struct State
+  {
+    const IndexTask* function;
+    u64 count;
+    std::atomic<u64> next{ 0 };
+    std::atomic<u64> done{ 0 };
+    std::mutex mutex;
+    std::condition_variable condition;
+
+    void Run()
+    {
+      u64 index;
+      while ((index = next.fetch_add(1, std::memory_order_relaxed)) < count) {
+        (*function)(index);
+        if (done.fetch_add(1, std::memory_order_acq_rel) + 1 == count) {
+          std::lock_guard<std::mutex> lock(mutex);
+          condition.notify_all();
+        }
+      }
+    }
+  };
+
+  if (count == 0) {
+    return;
+  }
+  if (count == 1) {
+    function(0);
+    return;
+  }
+  std::shared_ptr<State> state = std::make_shared<State>();
+  state->function = &function;
+  state->count = count;
+
+  // Submit one helper per worker that can be used, then help out
+  const u64 helperCount = std::min(count - 1, u64(mThreads.size()));
+  std::vector<Task> helpers;
+  helpers.reserve(helperCount);
+  for (u64 i = 0; i < helperCount; i++) {
+    helpers.emplace_back([state] { state->Run(); });
+  }
+  Submit(std::move(helpers), priority);
+  state->Run();
+
+  // Wait for indices that are still running on the workers
+  std::unique_lock<std::mutex> lock(state->mutex);
+  state->condition.wait(lock, [&] {
+    return state->done.load(std::memory_order_acquire) == count;
+  });
+}
+
+// -------------------------------------------------------------------------- //
+
+ThreadPool&
+ThreadPool::GetGlobal()
+{
+  static ThreadPool pool;
+  return pool;
+}
+
+// -------------------------------------------------------------------------- //
+
+void
+ThreadPool::Work()
+{
+  std::unique_lock<std::mutex> lock(mMutex);
+  while (true) {
+    // Take the first task of the highest priority
+    Task task;
+    for (u32 i = kPriorityCount; i-- > 0;) {
+      if (!mQueues[i].empty()) {
+        task = std::move(mQueues[i].front());
+        mQueues[i].pop_front();
+        break;
+      }
+    }
+
+    // Wait for more tasks if there are none, or stop if requested
+    if (!task) {
+      if (mStop) {
+        return;
+      }
+      mTaskCondition.wait(lock);
+      continue;
+    }
+
+    // Run task without holding the lock
+    lock.unlock();
+    task();
+    lock.lock();
+    if (--mPendingCount == 0) {
+      mIdleCondition.notify_all();
+    }
+  }
+}
+
+}
@@ -0,0 +1,168 @@
+// MIT License
+//
+// Copyright (c) 2019 Filip Björklund
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+// ========================================================================== //
+// Headers
+// ========================================================================== //
+
+// Standard headers
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Project headers
+#include "olivine/core/common.hpp"
+#include "olivine/core/macros.hpp"
+
+// ========================================================================== //
+// ThreadPool Declaration
+// ========================================================================== //
+
+namespace olivine {
+
+/** \class ThreadPool
+ * \author Filip Björklund
+ * \date 18 october 2026 - 16:40
+ * \brief Pool of worker threads.
+ * \details
+ * Runs tasks on a fixed set of worker threads. Tasks are taken in order of
+ * priority, and in submission order for tasks of the same priority.
+ *
+ * A global pool that is shared by the engine systems can be retrieved with
+ * 'ThreadPool::GetGlobal'. Systems that perform blocking work, like file IO,
+ * should create their own pool so that they don't starve the computational
+ * tasks of the global pool.
+ */
+class ThreadPool
+{
+  OL_NO_COPY(ThreadPool);
+
+public:
+  /** Task function **/
+  using Task = std::function<void()>;
+
+  /** Function that is run for each index by 'ThreadPool::ParallelFor' **/
+  using IndexTask = std::function<void(u64)>;
+
+  /** Task priorities **/
+  enum class Priority : u8
+  {
+    /** Low priority, for background work **/
+    kLow,
+    /** Normal priority **/
+    kNormal,
+    /** High priority, for work that something is waiting on **/
+    kHigh
+  };
+
+  /** Number of priorities **/
+  static constexpr u32 kPriorityCount = 3;
+
+private:
+  /** Worker threads **/
+  std::vector<std::thread> mThreads;
+  /** Queues of tasks, one per priority **/
+  std::deque<Task> mQueues[kPriorityCount];
+  /** Mutex for the queues and counters **/
+  std::mutex mMutex;
+  /** Condition that is signaled when tasks are submitted **/
+  std::condition_variable mTaskCondition;
+  /** Condition that is signaled when the pool becomes idle **/
+  std::condition_variable mIdleCondition;
+  /** Number of tasks that are queued or running **/
+  u64 mPendingCount = 0;
+  /** Whether the workers should stop **/
+  bool mStop = false;
+
+public:
+  /** Create a thread pool with the specified number of worker threads.
+   * \brief Create thread pool.
+   * \param threadCount Number of threads. If 0 then one thread per hardware
+   * thread is created.
+   */
+  explicit ThreadPool(u32 threadCount = 0);
+
+  /** Destruct the thread pool. All tasks that have been submitted are run
+   * before the workers are stopped.
+   * \brief Destruct thread pool.
+   */
+  ~ThreadPool();
+
+  /** Submit a task to be run on one of the worker threads.
+   * \brief Submit task.
+   * \param task Task to submit.
+   * \param priority Priority of the task.
+   */
+  void Submit(Task task, Priority priority = Priority::kNormal);
+
+  /** Submit multiple tasks at once. This only takes the lock of the pool once
+   * and wakes all workers, which is cheaper than submitting the tasks one by
+   * one.
+   * \brief Submit batch of tasks.
+   * \param tasks Tasks to submit.
+   * \param priority Priority of the tasks.
+   */
+  void Submit(std::vector<Task>&& tasks, Priority priority = Priority::kNormal);
+
+  /** Wait until all submitted tasks have finished running.
+   * \note This must not be called from a task that is running in the same pool.
+   * \brief Wait for tasks.
+   */
+  void Wait();
+
+  /** Run a function once for each index in [0, count) and wait until all of
+   * them have finished. The calling thread runs indices too, and it does not
+   * wait for tasks that has not started, which means that this can be called
+   * from tasks that are running in the same pool.
+   * \brief Run function in parallel.
+   * \param count Number of indices.
+   * \param function Function to run for each index.
+   * \param priority Priority of the tasks.
+   */
+  void ParallelFor(u64 count,
+                   const IndexTask& function,
+                   Priority priority = Priority::kHigh);
+
+  /** Returns the number of worker threads in the pool.
+   * \brief Returns thread count.
+   * \return Thread count.
+   */
+  OL_NODISCARD u32 GetThreadCount() const { return u32(mThreads.size()); }
+
+  /** Returns the global thread pool. It's created on first use with one thread
+   * per hardware thread.
+   * \brief Returns global pool.
+   * \return Global pool.
+   */
+  static ThreadPool& GetGlobal();
+
+private:
+  /** Run loop of the worker threads **/
+  void Work();
+};
+
+}
@@ -131,6 +131,7 @@ operator!=(const Time& lhs, const Time& rhs)
 Time
 Time::Now()
 {
+#if defined(OL_PLATFORM_WINDOWS)
   // Frequency
   static u64 frequency = 0;
   if (frequency == 0) {
@@ -156,6 +157,18 @@ Time::Now()
   const u64 counter = c.QuadPart - start_counter;
 
   return Time{ counter * 1000000 / frequency };
+#else
+  // Startup time, for the same reason as on Windows
+  static const u64 start = [] {
+    timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return u64(t.tv_sec) * 1000000 + u64(t.tv_nsec) / 1000;
+  }();
+
+  timespec t;
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  return Time{ u64(t.tv_sec) * 1000000 + u64(t.tv_nsec) / 1000 - start };
+#endif
 }
 
 // -------------------------------------------------------------------------- //
@@ -0,0 +1,1016 @@
+// MIT License
+//
+// Copyright (c) 2019 Filip Björklund
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "olivine/core/unicode.hpp"
+
+// ========================================================================== //
+// Headers
+// ========================================================================== //
+
+// Standard headers
+#include <immintrin.h>
+
+// Project headers
+#include "olivine/core/cpu.hpp"
+#include "olivine/math/math.hpp"
+
+// ========================================================================== //
+// Scalar Functions
+// ========================================================================== //
+
+namespace olivine {
+
+/** Codepoint that replaces unpaired surrogates in UTF-16 data **/
+static constexpr u32 kReplacementCharacter = 0xFFFD;
+
+/** Decode a single codepoint from UTF-8 data. Returns the number of bytes in
+ * the sequence or 0 if the sequence is invalid **/
+static u32
+DecodeUTF8(const u8* data, u64 remaining, u32& codepoint)
+{
+  const u8 b0 = data[0];
+  if (b0 < 0x80) {
+    codepoint = b0;
+    return 1;
+  }
+
+  // Continuation bytes, overlong 2-byte leads and leads above U+10FFFF
+  if (b0 < 0xC2 || b0 > 0xF4) {
+    return 0;
+  }
+
+  if (b0 < 0xE0) {
+    if (remaining < 2 || (data[1] & 0xC0) != 0x80) {
+      return 0;
+    }
+    codepoint = (u32(b0 & 0x1F) << 6) | (data[1] & 0x3F);
+    return 2;
+  }
+
+  if (b0 < 0xF0) {
+    if (remaining < 3 || (data[1] & 0xC0) != 0x80 ||
+        (data[2] & 0xC0) != 0x80) {
+      return 0;
+    }
+    codepoint = (u32(b0 & 0x0F) << 12) | (u32(data[1] & 0x3F) << 6) |
+                (data[2] & 0x3F);
+    if (codepoint < 0x800 || (codepoint >= 0xD800 && codepoint <= 0xDFFF)) {
+      return 0;
+    }
+    return 3;
+  }
+
+  if (remaining < 4 || (data[1] & 0xC0) != 0x80 || (data[2] & 0xC0) != 0x80 ||
+      (data[3] & 0xC0) != 0x80) {
+    return 0;
+  }
+  codepoint = (u32(b0 & 0x07) << 18) | (u32(data[1] & 0x3F) << 12) |
+              (u32(data[2] & 0x3F) << 6) | (data[3] & 0x3F);
+  if (codepoint < 0x10000 || codepoint > 0x10FFFF) {
+    return 0;
+  }
+  return 4;
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Encode a codepoint as UTF-8. Returns the number of bytes written **/
+static u32
+EncodeUTF8(u32 codepoint, u8* out)
+{
+  if (codepoint < 0x80) {
+    out[0] = u8(codepoint);
+    return 1;
+  }
+  if (codepoint < 0x800) {
+    out[0] = u8(0xC0 | (codepoint >> 6));
+    out[1] = u8(0x80 | (codepoint & 0x3F));
+    return 2;
+  }
+  if (codepoint < 0x10000) {
+    out[0] = u8(0xE0 | (codepoint >> 12));
+    out[1] = u8(0x80 | ((codepoint >> 6) & 0x3F));
+    out[2] = u8(0x80 | (codepoint & 0x3F));
+    return 3;
+  }
+  out[0] = u8(0xF0 | (codepoint >> 18));
+  out[1] = u8(0x80 | ((codepoint >> 12) & 0x3F));
+  out[2] = u8(0x80 | ((codepoint >> 6) & 0x3F));
+  out[3] = u8(0x80 | (codepoint & 0x3F));
+  return 4;
+}
+
+// -------------------------------------------------------------------------- //
+
+static bool
+ValidateUTF8Scalar(const u8* data, u64 size)
+{
+  u64 i = 0;
+  while (i < size) {
+    u32 codepoint;
+    const u32 width = DecodeUTF8(data + i, size - i, codepoint);
+    if (width == 0) {
+      return false;
+    }
+    i += width;
+  }
+  return true;
+}
+
+// -------------------------------------------------------------------------- //
+
+static bool
+IsASCIIScalar(const u8* data, u64 size)
+{
+  u8 bits = 0;
+  for (u64 i = 0; i < size; i++) {
+    bits |= data[i];
+  }
+  return (bits & 0x80) == 0;
+}
+
+// -------------------------------------------------------------------------- //
+
+static u64
+CountUTF8Scalar(const u8* data, u64 size)
+{
+  u64 count = 0;
+  for (u64 i = 0; i < size; i++) {
+    count += (data[i] & 0xC0) != 0x80;
+  }
+  return count;
+}
+
+// -------------------------------------------------------------------------- //
+
+static u64
+UTF16SizeOfUTF8Scalar(const u8* data, u64 size)
+{
+  u64 count = 0;
+  for (u64 i = 0; i < size; i++) {
+    count += ((data[i] & 0xC0) != 0x80) + (data[i] >= 0xF0);
+  }
+  return count;
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Transcode UTF-8 to UTF-16 one codepoint at a time. 'in' and 'out' are
+ * advanced past the transcoded data **/
+static bool
+UTF8ToUTF16Scalar(const u8* source,
+                  u64 sourceSize,
+                  u64& in,
+                  char16* destination,
+                  u64 destinationSize,
+                  u64& out,
+                  u64 count = ~0ull)
+{
+  for (u64 n = 0; n < count && in < sourceSize; n++) {
+    u32 codepoint;
+    const u32 width = DecodeUTF8(source + in, sourceSize - in, codepoint);
+    if (width == 0) {
+      return false;
+    }
+    // Surrogate pairs are only needed when 'char16' is 16 bits wide
+    if (codepoint < 0x10000 || sizeof(char16) > 2) {
+      if (out >= destinationSize) {
+        return false;
+      }
+      destination[out++] = char16(codepoint);
+    } else {
+      if (out + 2 > destinationSize) {
+        return false;
+      }
+      codepoint -= 0x10000;
+      destination[out++] = char16(0xD800 | (codepoint >> 10));
+      destination[out++] = char16(0xDC00 | (codepoint & 0x3FF));
+    }
+    in += width;
+  }
+  return true;
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Transcode UTF-16 to UTF-8 one codepoint at a time. Unpaired surrogates and
+ * units above U+10FFFF are replaced with U+FFFD. 'in' and 'out' are advanced
+ * past the transcoded data **/
+static bool
+UTF16ToUTF8Scalar(const char16* source,
+                  u64 sourceSize,
+                  u64& in,
+                  u8* destination,
+                  u64 destinationSize,
+                  u64& out,
+                  u64 count = ~0ull)
+{
+  for (u64 n = 0; n < count && in < sourceSize; n++) {
+    u32 codepoint = u32(source[in]);
+    u32 width = 1;
+    if (codepoint >= 0xD800 && codepoint <= 0xDFFF) {
+      const u32 low = in + 1 < sourceSize ? u32(source[in + 1]) : 0;
+      if (codepoint <= 0xDBFF && low >= 0xDC00 && low <= 0xDFFF) {
+        codepoint = 0x10000 + ((codepoint - 0xD800) << 10) + (low - 0xDC00);
+        width = 2;
+      } else {
+        codepoint = kReplacementCharacter;
+      }
+    } else if (codepoint > 0x10FFFF) {
+      codepoint = kReplacementCharacter;
+    }
+
+    u8 encoded[4];
+    const u32 size = EncodeUTF8(codepoint, encoded);
+    if (out + size > destinationSize) {
+      return false;
+    }
+    for (u32 i = 0; i < size; i++) {
+      destination[out++] = encoded[i];
+    }
+    in += width;
+  }
+  return true;
+}
+
+}
+
+// ========================================================================== //
+// Validation Tables
+// ========================================================================== //
+
+namespace olivine {
+
+/* Lookup tables for the validation algorithm described by Keiser and Lemire in
+ * "Validating UTF-8 In Less Than One Instruction Per Byte". Each error class
+ * is represented by a bit, and a pair of bytes is invalid if the three tables,
+ * indexed by the high and low nibble of the first byte and the high nibble of
+ * the second byte, have a bit in common. */
+
+static constexpr u8 kTooShort = 1 << 0;
+static constexpr u8 kTooLong = 1 << 1;
+static constexpr u8 kOverlong3 = 1 << 2;
+static constexpr u8 kTooLarge = 1 << 3;
+static constexpr u8 kSurrogate = 1 << 4;
+static constexpr u8 kOverlong2 = 1 << 5;
+static constexpr u8 kTooLarge1000 = 1 << 6;
+static constexpr u8 kOverlong4 = 1 << 6;
+static constexpr u8 kTwoConts = 1 << 7;
+static constexpr u8 kCarry = kTooShort | kTooLong | kTwoConts;
+
+/** Table indexed by the high nibble of the first byte **/
+alignas(16) static constexpr u8 kByte1High[16] = {
+  kTooLong,
+  kTooLong,
+  kTooLong,
+  kTooLong,
+  kTooLong,
+  kTooLong,
+  kTooLong,
+  kTooLong,
+  kTwoConts,
+  kTwoConts,
+  kTwoConts,
+  kTwoConts,
+  kTooShort | kOverlong2,
+  kTooShort,
+  kTooShort | kOverlong3 | kSurrogate,
+  kTooShort | kTooLarge | kTooLarge1000 | kOverlong4
+};
+
+/** Table indexed by the low nibble of the first byte **/
+alignas(16) static constexpr u8 kByte1Low[16] = {
+  kCarry | kOverlong3 | kOverlong2 | kOverlong4,
+  kCarry | kOverlong2,
+  kCarry,
+  kCarry,
+  kCarry | kTooLarge,
+  kCarry | kTooLarge | kTooLarge1000,
+  kCarry | kTooLarge | kTooLarge1000,
+  kCarry | kTooLarge | kTooLarge1000,
+  kCarry | kTooLarge | kTooLarge1000,
+  kCarry | kTooLarge | kTooLarge1000,
+  kCarry | kTooLarge | kTooLarge1000,
+  kCarry | kTooLarge | kTooLarge1000,
+  kCarry | kTooLarge | kTooLarge1000,
+  kCarry | kTooLarge | kTooLarge1000 | kSurrogate,
+  kCarry | kTooLarge | kTooLarge1000,
+  kCarry | kTooLarge | kTooLarge1000
+};
+
+/** Table indexed by the high nibble of the second byte **/
+alignas(16) static constexpr u8 kByte2High[16] = {
+  kTooShort,
+  kTooShort,
+  kTooShort,
+  kTooShort,
+  kTooShort,
+  kTooShort,
+  kTooShort,
+  kTooShort,
+  kTooLong | kOverlong2 | kTwoConts | kOverlong3 | kTooLarge1000 | kOverlong4,
+  kTooLong | kOverlong2 | kTwoConts | kOverlong3 | kTooLarge,
+  kTooLong | kOverlong2 | kTwoConts | kSurrogate | kTooLarge,
+  kTooLong | kOverlong2 | kTwoConts | kSurrogate | kTooLarge,
+  kTooShort,
+  kTooShort,
+  kTooShort,
+  kTooShort
+};
+
+/** Maximum values of the last three bytes in a block for it to not end in an
+ * incomplete sequence **/
+alignas(32) static constexpr u8 kMaxValue[32] = {
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xEF, 0xDF, 0xBF
+};
+
+}
+
+// ========================================================================== //
+// SSE4.1 Functions
+// ========================================================================== //
+
+namespace olivine {
+
+/** State of the SSE4.1 validation **/
+struct ValidateStateSSE41
+{
+  __m128i error;
+  __m128i prevInput;
+  __m128i prevIncomplete;
+};
+
+// -------------------------------------------------------------------------- //
+
+OL_TARGET_SSE41 static inline void
+ValidateBlockSSE41(ValidateStateSSE41& state, __m128i input)
+{
+  if (_mm_movemask_epi8(input) == 0) {
+    // An ASCII block is only an error if the previous block was incomplete
+    state.error = _mm_or_si128(state.error, state.prevIncomplete);
+    state.prevIncomplete = _mm_setzero_si128();
+  } else {
+    const __m128i nibble = _mm_set1_epi8(0x0F);
+    const __m128i prev1 = _mm_alignr_epi8(input, state.prevInput, 15);
+    const __m128i byte1High = _mm_shuffle_epi8(
+      _mm_load_si128(reinterpret_cast<const __m128i*>(kByte1High)),
+      _mm_and_si128(_mm_srli_epi16(prev1, 4), nibble));
+    const __m128i byte1Low = _mm_shuffle_epi8(
+      _mm_load_si128(reinterpret_cast<const __m128i*>(kByte1Low)),
+      _mm_and_si128(prev1, nibble));
+    const __m128i byte2High = _mm_shuffle_epi8(
+      _mm_load_si128(reinterpret_cast<const __m128i*>(kByte2High)),
+      _mm_and_si128(_mm_srli_epi16(input, 4), nibble));
+    const __m128i special =
+      _mm_and_si128(_mm_and_si128(byte1High, byte1Low), byte2High);
+
+    // Bytes that follow a 3- or 4-byte lead at distance 2 or 3 must be
+    // continuation bytes, which is exactly when 'special' reports two
+    // continuations
+    const __m128i prev2 = _mm_alignr_epi8(input, state.prevInput, 14);
+    const __m128i prev3 = _mm_alignr_epi8(input, state.prevInput, 13);
+    const __m128i isThird = _mm_subs_epu8(prev2, _mm_set1_epi8(0xE0 - 0x80));
+    const __m128i isFourth =
+      _mm_subs_epu8(prev3, _mm_set1_epi8(char(0xF0 - 0x80)));
+    const __m128i must23 = _mm_and_si128(
+      _mm_cmpgt_epi8(_mm_setzero_si128(), _mm_or_si128(isThird, isFourth)),
+      _mm_set1_epi8(char(0x80)));
+    state.error =
+      _mm_or_si128(state.error, _mm_xor_si128(must23, special));
+
+    state.prevIncomplete = _mm_subs_epu8(
+      input, _mm_load_si128(reinterpret_cast<const __m128i*>(kMaxValue + 16)));
+  }
+  state.prevInput = input;
+}
+
+// -------------------------------------------------------------------------- //
+
+OL_TARGET_SSE41 static bool
+ValidateUTF8SSE41(const u8* data, u64 size)
+{
+  ValidateStateSSE41 state;
+  state.error = _mm_setzero_si128();
+  state.prevInput = _mm_setzero_si128();
+  state.prevIncomplete = _mm_setzero_si128();
+
+  u64 i = 0;
+  for (; i + 16 <= size; i += 16) {
+    ValidateBlockSSE41(
+      state, _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i)));
+  }
+
+  // Pad the tail with zeros, any truncated sequence is then too short
+  if (i < size) {
+    alignas(16) u8 tail[16] = {};
+    for (u64 j = 0; i + j < size; j++) {
+      tail[j] = data[i + j];
+    }
+    ValidateBlockSSE41(state,
+                       _mm_load_si128(reinterpret_cast<const __m128i*>(tail)));
+  }
+
+  state.error = _mm_or_si128(state.error, state.prevIncomplete);
+  return _mm_testz_si128(state.error, state.error) != 0;
+}
+
+// -------------------------------------------------------------------------- //
+
+OL_TARGET_SSE41 static bool
+IsASCIISSE41(const u8* data, u64 size)
+{
+  __m128i bits = _mm_setzero_si128();
+  u64 i = 0;
+  for (; i + 16 <= size; i += 16) {
+    bits = _mm_or_si128(
+      bits, _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i)));
+  }
+  return _mm_movemask_epi8(bits) == 0 && IsASCIIScalar(data + i, size - i);
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Returns the sum of all bytes in a vector **/
+OL_TARGET_SSE41 static inline u64
+SumBytesSSE41(__m128i bytes)
+{
+  const __m128i sum = _mm_sad_epu8(bytes, _mm_setzero_si128());
+  return u64(_mm_cvtsi128_si64(sum)) + u64(_mm_extract_epi64(sum, 1));
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Count codepoints, plus the number of 4-byte leads if 'surrogates' is true.
+ * Per-byte counters are accumulated in 8-bit lanes and flushed before they can
+ * overflow **/
+OL_TARGET_SSE41 static u64
+CountUTF8SSE41(const u8* data, u64 size, bool surrogates)
+{
+  const __m128i continuation = _mm_set1_epi8(-0x41);
+  const __m128i fourByteLead = _mm_set1_epi8(char(0xF0));
+  u64 count = 0;
+  u64 i = 0;
+  while (i + 16 <= size) {
+    __m128i leads = _mm_setzero_si128();
+    __m128i fours = _mm_setzero_si128();
+    const u64 end = Min(size, i + 255 * 16);
+    for (; i + 16 <= end; i += 16) {
+      const __m128i input =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+      leads = _mm_sub_epi8(leads, _mm_cmpgt_epi8(input, continuation));
+      fours = _mm_sub_epi8(
+        fours, _mm_cmpeq_epi8(_mm_max_epu8(input, fourByteLead), input));
+    }
+    count += SumBytesSSE41(leads);
+    if (surrogates) {
+      count += SumBytesSSE41(fours);
+    }
+  }
+  return count + (surrogates ? UTF16SizeOfUTF8Scalar(data + i, size - i)
+                             : CountUTF8Scalar(data + i, size - i));
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Try to transcode four 3-byte sequences from the first 12 bytes of a block.
+ * Returns false without writing anything if the block does not start with four
+ * valid 3-byte sequences **/
+OL_TARGET_SSE41 static inline bool
+UTF8ToUTF16Block3SSE41(__m128i input, char16* out)
+{
+  const __m128i mask = _mm_setr_epi8(char(0xF0), char(0xC0), char(0xC0),
+                                     char(0xF0), char(0xC0), char(0xC0),
+                                     char(0xF0), char(0xC0), char(0xC0),
+                                     char(0xF0), char(0xC0), char(0xC0),
+                                     0, 0, 0, 0);
+  const __m128i expected = _mm_setr_epi8(char(0xE0), char(0x80), char(0x80),
+                                         char(0xE0), char(0x80), char(0x80),
+                                         char(0xE0), char(0x80), char(0x80),
+                                         char(0xE0), char(0x80), char(0x80),
+                                         0, 0, 0, 0);
+  if (_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(input, mask),
+                                       expected)) != 0xFFFF) {
+    return false;
+  }
+
+  // Gather each sequence into a 32-bit lane as (b0 << 16 | b1 << 8 | b2)
+  const __m128i gathered = _mm_shuffle_epi8(
+    input, _mm_setr_epi8(2, 1, 0, -1, 5, 4, 3, -1, 8, 7, 6, -1, 11, 10, 9, -1));
+  const __m128i codepoints = _mm_or_si128(
+    _mm_or_si128(
+      _mm_srli_epi32(_mm_and_si128(gathered, _mm_set1_epi32(0x0F0000)), 4),
+      _mm_srli_epi32(_mm_and_si128(gathered, _mm_set1_epi32(0x3F00)), 2)),
+    _mm_and_si128(gathered, _mm_set1_epi32(0x3F)));
+
+  // Reject overlong encodings and surrogates
+  const __m128i overlong = _mm_cmplt_epi32(codepoints, _mm_set1_epi32(0x800));
+  const __m128i surrogate =
+    _mm_cmpeq_epi32(_mm_and_si128(codepoints, _mm_set1_epi32(0xF800)),
+                    _mm_set1_epi32(0xD800));
+  const __m128i invalid = _mm_or_si128(overlong, surrogate);
+  if (!_mm_testz_si128(invalid, invalid)) {
+    return false;
+  }
+
+  _mm_storel_epi64(reinterpret_cast<__m128i*>(out),
+                   _mm_packus_epi32(codepoints, codepoints));
+  return true;
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Transcode from a block of 16 bytes, advancing 'in' and 'out'. Requires at
+ * least 16 bytes of input and space for 16 code units of output **/
+OL_TARGET_SSE41 static inline bool
+UTF8ToUTF16StepSSE41(const u8* source,
+                     u64 sourceSize,
+                     u64& in,
+                     char16* destination,
+                     u64 destinationSize,
+                     u64& out)
+{
+  const __m128i input =
+    _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + in));
+  const u32 nonASCII = u32(_mm_movemask_epi8(input));
+
+  // Widen all 16 bytes, then only advance past the ASCII prefix
+  if ((nonASCII & 0x1) == 0) {
+    __m128i* dst = reinterpret_cast<__m128i*>(destination + out);
+    _mm_storeu_si128(dst, _mm_cvtepu8_epi16(input));
+    _mm_storeu_si128(dst + 1, _mm_cvtepu8_epi16(_mm_srli_si128(input, 8)));
+    u32 prefix = 1;
+    while (prefix < 16 && (nonASCII & (1u << prefix)) == 0) {
+      prefix++;
+    }
+    in += prefix;
+    out += prefix;
+    return true;
+  }
+
+  // Common case for CJK text, otherwise decode a single codepoint
+  if (UTF8ToUTF16Block3SSE41(input, destination + out)) {
+    in += 12;
+    out += 4;
+    return true;
+  }
+  return UTF8ToUTF16Scalar(
+    source, sourceSize, in, destination, destinationSize, out, 1);
+}
+
+// -------------------------------------------------------------------------- //
+
+OL_TARGET_SSE41 static bool
+UTF8ToUTF16SSE41(const u8* source,
+                 u64 sourceSize,
+                 char16* destination,
+                 u64 destinationSize,
+                 u64& written)
+{
+  u64 in = 0, out = 0;
+  while (in + 16 <= sourceSize && out + 16 <= destinationSize) {
+    if (!UTF8ToUTF16StepSSE41(
+          source, sourceSize, in, destination, destinationSize, out)) {
+      written = out;
+      return false;
+    }
+  }
+
+  const bool success = UTF8ToUTF16Scalar(
+    source, sourceSize, in, destination, destinationSize, out);
+  written = out;
+  return success;
+}
+
+// -------------------------------------------------------------------------- //
+
+OL_TARGET_SSE41 static bool
+UTF16ToUTF8SSE41(const char16* source,
+                 u64 sourceSize,
+                 u8* destination,
+                 u64 destinationSize,
+                 u64& written)
+{
+  u64 in = 0, out = 0;
+  const __m128i nonASCIIMask = _mm_set1_epi16(char16(0xFF80));
+  while (in + 8 <= sourceSize && out + 8 <= destinationSize) {
+    const __m128i input =
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + in));
+    if (_mm_testz_si128(input, nonASCIIMask)) {
+      _mm_storel_epi64(reinterpret_cast<__m128i*>(destination + out),
+                       _mm_packus_epi16(input, input));
+      in += 8;
+      out += 8;
+      continue;
+    }
+    if (!UTF16ToUTF8Scalar(
+          source, sourceSize, in, destination, destinationSize, out, 8)) {
+      written = out;
+      return false;
+    }
+  }
+
+  const bool success = UTF16ToUTF8Scalar(
+    source, sourceSize, in, destination, destinationSize, out);
+  written = out;
+  return success;
+}
+
+}
+
+// ========================================================================== //
+// AVX2 Functions
+// ========================================================================== //
+
+namespace olivine {
+
+/** State of the AVX2 validation **/
+struct ValidateStateAVX2
+{
+  __m256i error;
+  __m256i prevInput;
+  __m256i prevIncomplete;
+};
+
+// -------------------------------------------------------------------------- //
+
+/** Returns the input shifted right by N bytes across the whole 256-bit
+ * register, with the bytes shifted in taken from the end of 'prev' **/
+template<int N>
+OL_TARGET_AVX2 static inline __m256i
+PrevAVX2(__m256i input, __m256i prev)
+{
+  return _mm256_alignr_epi8(
+    input, _mm256_permute2x128_si256(prev, input, 0x21), 16 - N);
+}
+
+// -------------------------------------------------------------------------- //
+
+OL_TARGET_AVX2 static inline __m256i
+LoadTableAVX2(const u8* table)
+{
+  return _mm256_broadcastsi128_si256(
+    _mm_load_si128(reinterpret_cast<const __m128i*>(table)));
+}
+
+// -------------------------------------------------------------------------- //
+
+OL_TARGET_AVX2 static inline void
+ValidateBlockAVX2(ValidateStateAVX2& state, __m256i input)
+{
+  if (_mm256_movemask_epi8(input) == 0) {
+    state.error = _mm256_or_si256(state.error, state.prevIncomplete);
+    state.prevIncomplete = _mm256_setzero_si256();
+  } else {
+    const __m256i nibble = _mm256_set1_epi8(0x0F);
+    const __m256i prev1 = PrevAVX2<1>(input, state.prevInput);
+    const __m256i byte1High = _mm256_shuffle_epi8(
+      LoadTableAVX2(kByte1High),
+      _mm256_and_si256(_mm256_srli_epi16(prev1, 4), nibble));
+    const __m256i byte1Low = _mm256_shuffle_epi8(
+      LoadTableAVX2(kByte1Low), _mm256_and_si256(prev1, nibble));
+    const __m256i byte2High = _mm256_shuffle_epi8(
+      LoadTableAVX2(kByte2High),
+      _mm256_and_si256(_mm256_srli_epi16(input, 4), nibble));
+    const __m256i special =
+      _mm256_and_si256(_mm256_and_si256(byte1High, byte1Low), byte2High);
+
+    const __m256i prev2 = PrevAVX2<2>(input, state.prevInput);
+    const __m256i prev3 = PrevAVX2<3>(input, state.prevInput);
+    const __m256i isThird =
+      _mm256_subs_epu8(prev2, _mm256_set1_epi8(0xE0 - 0x80));
+    const __m256i isFourth =
+      _mm256_subs_epu8(prev3, _mm256_set1_epi8(char(0xF0 - 0x80)));
+    const __m256i must23 = _mm256_and_si256(
+      _mm256_cmpgt_epi8(_mm256_setzero_si256(),
+                        _mm256_or_si256(isThird, isFourth)),
+      _mm256_set1_epi8(char(0x80)));
+    state.error =
+      _mm256_or_si256(state.error, _mm256_xor_si256(must23, special));
+
+    state.prevIncomplete = _mm256_subs_epu8(
+      input, _mm256_load_si256(reinterpret_cast<const __m256i*>(kMaxValue)));
+  }
+  state.prevInput = input;
+}
+
+// -------------------------------------------------------------------------- //
+
+OL_TARGET_AVX2 static bool
+ValidateUTF8AVX2(const u8* data, u64 size)
+{
+  ValidateStateAVX2 state;
+  state.error = _mm256_setzero_si256();
+  state.prevInput = _mm256_setzero_si256();
+  state.prevIncomplete = _mm256_setzero_si256();
+
+  u64 i = 0;
+  for (; i + 32 <= size; i += 32) {
+    ValidateBlockAVX2(
+      state, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i)));
+  }
+
+  if (i < size) {
+    alignas(32) u8 tail[32] = {};
+    for (u64 j = 0; i + j < size; j++) {
+      tail[j] = data[i + j];
+    }
+    ValidateBlockAVX2(
+      state, _mm256_load_si256(reinterpret_cast<const __m256i*>(tail)));
+  }
+
+  state.error = _mm256_or_si256(state.error, state.prevIncomplete);
+  return _mm256_testz_si256(state.error, state.error) != 0;
+}
+
+// -------------------------------------------------------------------------- //
+
+OL_TARGET_AVX2 static bool
+IsASCIIAVX2(const u8* data, u64 size)
+{
+  __m256i bits = _mm256_setzero_si256();
+  u64 i = 0;
+  for (; i + 32 <= size; i += 32) {
+    bits = _mm256_or_si256(
+      bits, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i)));
+  }
+  return _mm256_movemask_epi8(bits) == 0 && IsASCIIScalar(data + i, size - i);
+}
+
+// -------------------------------------------------------------------------- //
+
+OL_TARGET_AVX2 static inline u64
+SumBytesAVX2(__m256i bytes)
+{
+  const __m256i sum = _mm256_sad_epu8(bytes, _mm256_setzero_si256());
+  const __m128i half = _mm_add_epi64(_mm256_castsi256_si128(sum),
+                                     _mm256_extracti128_si256(sum, 1));
+  return u64(_mm_cvtsi128_si64(half)) +
+         u64(_mm_cvtsi128_si64(_mm_unpackhi_epi64(half, half)));
+}
+
+// -------------------------------------------------------------------------- //
+
+OL_TARGET_AVX2 static u64
+CountUTF8AVX2(const u8* data, u64 size, bool surrogates)
+{
+  const __m256i continuation = _mm256_set1_epi8(-0x41);
+  const __m256i fourByteLead = _mm256_set1_epi8(char(0xF0));
+  u64 count = 0;
+  u64 i = 0;
+  while (i + 32 <= size) {
+    __m256i leads = _mm256_setzero_si256();
+    __m256i fours = _mm256_setzero_si256();
+    const u64 end = Min(size, i + 255 * 32);
+    for (; i + 32 <= end; i += 32) {
+      const __m256i input =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+      leads = _mm256_sub_epi8(leads, _mm256_cmpgt_epi8(input, continuation));
+      fours = _mm256_sub_epi8(
+        fours,
+        _mm256_cmpeq_epi8(_mm256_max_epu8(input, fourByteLead), input));
+    }
+    count += SumBytesAVX2(leads);
+    if (surrogates) {
+      count += SumBytesAVX2(fours);
+    }
+  }
+  return count + (surrogates ? UTF16SizeOfUTF8Scalar(data + i, size - i)
+                             : CountUTF8Scalar(data + i, size - i));
+}
+
+// -------------------------------------------------------------------------- //
+
+OL_TARGET_AVX2 static bool
+UTF8ToUTF16AVX2(const u8* source,
+                u64 sourceSize,
+                char16* destination,
+                u64 destinationSize,
+                u64& written)
+{
+  // ASCII blocks are widened 32 bytes at a time, everything else takes the
+  // SSE4.1 path
+  u64 in = 0, out = 0;
+  while (in + 32 <= sourceSize && out + 32 <= destinationSize) {
+    const __m256i input =
+      _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + in));
+    if (_mm256_movemask_epi8(input) != 0) {
+      if (!UTF8ToUTF16StepSSE41(
+            source, sourceSize, in, destination, destinationSize, out)) {
+        written = out;
+        return false;
+      }
+      continue;
+    }
+    __m256i* dst = reinterpret_cast<__m256i*>(destination + out);
+    _mm256_storeu_si256(dst,
+                        _mm256_cvtepu8_epi16(_mm256_castsi256_si128(input)));
+    _mm256_storeu_si256(
+      dst + 1, _mm256_cvtepu8_epi16(_mm256_extracti128_si256(input, 1)));
+    in += 32;
+    out += 32;
+  }
+
+  u64 count = 0;
+  const bool success = UTF8ToUTF16SSE41(source + in,
+                                        sourceSize - in,
+                                        destination + out,
+                                        destinationSize - out,
+                                        count);
+  written = out + count;
+  return success;
+}
+
+}
+
+// ========================================================================== //
+// Unicode Implementation
+// ========================================================================== //
+
+namespace olivine {
+
+bool
+Unicode::ValidateUTF8(const char8* data, u64 size)
+{
+  const u8* bytes = reinterpret_cast<const u8*>(data);
+  if (Cpu::HasAVX2()) {
+    return ValidateUTF8AVX2(bytes, size);
+  }
+  if (Cpu::HasSSE41()) {
+    return ValidateUTF8SSE41(bytes, size);
+  }
+  return ValidateUTF8Scalar(bytes, size);
+}
+
+// -------------------------------------------------------------------------- //
+
+bool
+Unicode::IsASCII(const char8* data, u64 size)
+{
+  const u8* bytes = reinterpret_cast<const u8*>(data);
+  if (Cpu::HasAVX2()) {
+    return IsASCIIAVX2(bytes, size);
+  }
+  if (Cpu::HasSSE41()) {
+    return IsASCIISSE41(bytes, size);
+  }
+  return IsASCIIScalar(bytes, size);
+}
+
+// -------------------------------------------------------------------------- //
+
+u64
+Unicode::CountUTF8(const char8* data, u64 size)
+{
+  const u8* bytes = reinterpret_cast<const u8*>(data);
+  if (Cpu::HasAVX2()) {
+    return CountUTF8AVX2(bytes, size, false);
+  }
+  if (Cpu::HasSSE41()) {
+    return CountUTF8SSE41(bytes, size, false);
+  }
+  return CountUTF8Scalar(bytes, size);
+}
+
+// -------------------------------------------------------------------------- //
+
+u64
+Unicode::UTF16SizeOfUTF8(const char8* data, u64 size)
+{
+  const u8* bytes = reinterpret_cast<const u8*>(data);
+  if (sizeof(char16) != 2) {
+    return CountUTF8(data, size);
+  }
+  if (Cpu::HasAVX2()) {
+    return CountUTF8AVX2(bytes, size, true);
+  }
+  if (Cpu::HasSSE41()) {
+    return CountUTF8SSE41(bytes, size, true);
+  }
+  return UTF16SizeOfUTF8Scalar(bytes, size);
+}
+
+// -------------------------------------------------------------------------- //
+
+u64
+Unicode::UTF8SizeOfUTF16(const char16* data, u64 size)
+{
+  u64 count = 0;
+  for (u64 i = 0; i < size; i++) {
+    const u32 unit = u32(data[i]);
+    if (unit < 0x80) {
+      count += 1;
+    } else if (unit < 0x800) {
+      count += 2;
+    } else if (unit >= 0xD800 && unit <= 0xDBFF && i + 1 < size &&
+               u32(data[i + 1]) >= 0xDC00 && u32(data[i + 1]) <= 0xDFFF) {
+      count += 4;
+      i++;
+    } else {
+      // Unpaired surrogates and units above U+10FFFF are transcoded as U+FFFD
+      count += unit < 0x10000 || unit > 0x10FFFF ? 3 : 4;
+    }
+  }
+  return count;
+}
+
+// -------------------------------------------------------------------------- //
+
+bool
+Unicode::UTF8ToUTF16(const char8* source,
+                     u64 sourceSize,
+                     char16* destination,
+                     u64 destinationSize,
+                     u64& written)
+{
+  const u8* bytes = reinterpret_cast<const u8*>(source);
+
+  // The vectorized paths store 16-bit code units
+  if (sizeof(char16) == 2) {
+    if (Cpu::HasAVX2()) {
+      return UTF8ToUTF16AVX2(
+        bytes, sourceSize, destination, destinationSize, written);
+    }
+    if (Cpu::HasSSE41()) {
+      return UTF8ToUTF16SSE41(
+        bytes, sourceSize, destination, destinationSize, written);
+    }
+  }
+
+  u64 in = 0;
+  written = 0;
+  return UTF8ToUTF16Scalar(
+    bytes, sourceSize, in, destination, destinationSize, written);
+}
+
+// -------------------------------------------------------------------------- //
+
+bool
+Unicode::UTF16ToUTF8(const char16* source,
+                     u64 sourceSize,
+                     char8* destination,
+                     u64 destinationSize,
+                     u64& written)
+{
+  u8* bytes = reinterpret_cast<u8*>(destination);
+  if (sizeof(char16) == 2 && Cpu::HasSSE41()) {
+    return UTF16ToUTF8SSE41(
+      source, sourceSize, bytes, destinationSize, written);
+  }
+
+  u64 in = 0;
+  written = 0;
+  return UTF16ToUTF8Scalar(
+    source, sourceSize, in, bytes, destinationSize, written);
+}
+
+}
+
+// ========================================================================== //
+// UTF16Buffer Implementation
+// ========================================================================== //
+
+namespace olivine {
+
+UTF16Buffer::UTF16Buffer(const char8* data, u64 size)
+{
+  const u64 capacity = Unicode::UTF16SizeOfUTF8(data, size) + 1;
+  if (capacity > kInlineSize) {
+    mData = new char16[capacity];
+  }
+  if (!Unicode::UTF8ToUTF16(data, size, mData, capacity - 1, mSize)) {
+    mSize = 0;
+  }
+  mData[mSize] = 0;
+}
+
+// -------------------------------------------------------------------------- //
+
+UTF16Buffer::~UTF16Buffer()
+{
+  if (mData != mInline) {
+    delete[] mData;
+  }
+}
+
+}
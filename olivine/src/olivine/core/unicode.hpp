@@ -0,0 +1,193 @@
+// MIT License
+//
+// Copyright (c) 2019 Filip Björklund
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+// ========================================================================== //
+// Headers
+// ========================================================================== //
+
+// Project headers
+#include "olivine/core/types.hpp"
+#include "olivine/core/macros.hpp"
+
+// ========================================================================== //
+// Unicode Declaration
+// ========================================================================== //
+
+namespace olivine {
+
+/** \class Unicode
+ * \author Filip Björklund
+ * \date 18 october 2026 - 13:55
+ * \brief Unicode utilities.
+ * \details
+ * Namespace class with functions for validating, measuring and transcoding
+ * UTF-8 and UTF-16 text. The functions use SSE4.1 or AVX2 when the CPU
+ * supports it and fall back to scalar code otherwise. Sizes are always
+ * specified in code units (bytes for UTF-8, 'char16' for UTF-16).
+ */
+class Unicode
+{
+  OL_NAMESPACE_CLASS(Unicode);
+
+public:
+  /** Returns whether or not a range of bytes is valid UTF-8. Overlong
+   * encodings, surrogate codepoints, codepoints above U+10FFFF and truncated
+   * sequences are all considered invalid.
+   * \brief Validate UTF-8.
+   * \param data Data to validate.
+   * \param size Size of the data in bytes.
+   * \return True if the data is valid UTF-8 otherwise false.
+   */
+  static bool ValidateUTF8(const char8* data, u64 size);
+
+  /** Returns whether or not a range of bytes only contains ASCII characters.
+   * \brief Returns whether data is ASCII.
+   * \param data Data to check.
+   * \param size Size of the data in bytes.
+   * \return True if all bytes are ASCII otherwise false.
+   */
+  static bool IsASCII(const char8* data, u64 size);
+
+  /** Returns the number of codepoints in a range of UTF-8 data. The data is
+   * assumed to be valid.
+   * \brief Count UTF-8 codepoints.
+   * \param data UTF-8 data.
+   * \param size Size of the data in bytes.
+   * \return Number of codepoints.
+   */
+  static u64 CountUTF8(const char8* data, u64 size);
+
+  /** Returns the number of UTF-16 code units that are required to represent
+   * a range of UTF-8 data. The data is assumed to be valid.
+   * \brief Returns UTF-16 size of UTF-8 data.
+   * \param data UTF-8 data.
+   * \param size Size of the data in bytes.
+   * \return Number of UTF-16 code units.
+   */
+  static u64 UTF16SizeOfUTF8(const char8* data, u64 size);
+
+  /** Returns the number of UTF-8 bytes that are required to represent a range
+   * of UTF-16 data. Unpaired surrogates are counted as the three bytes of the
+   * replacement character U+FFFD, which 'Unicode::UTF16ToUTF8' writes in their
+   * place.
+   * \brief Returns UTF-8 size of UTF-16 data.
+   * \param data UTF-16 data.
+   * \param size Size of the data in code units.
+   * \return Number of UTF-8 bytes.
+   */
+  static u64 UTF8SizeOfUTF16(const char16* data, u64 size);
+
+  /** Transcode UTF-8 data to UTF-16. The output is not null-terminated.
+   * \brief Transcode UTF-8 to UTF-16.
+   * \param source UTF-8 data to transcode.
+   * \param sourceSize Size of the source data in bytes.
+   * \param destination Destination buffer.
+   * \param destinationSize Size of the destination buffer in code units.
+   * \param written Set to the number of code units written.
+   * \return True on success. False if the source is not valid UTF-8 or the
+   * destination is too small.
+   */
+  static bool UTF8ToUTF16(const char8* source,
+                          u64 sourceSize,
+                          char16* destination,
+                          u64 destinationSize,
+                          u64& written);
+
+  /** Transcode UTF-16 data to UTF-8. The output is not null-terminated.
+   * Unpaired surrogates, which are allowed in for example Windows file names,
+   * are replaced with the replacement character U+FFFD.
+   * \brief Transcode UTF-16 to UTF-8.
+   * \param source UTF-16 data to transcode.
+   * \param sourceSize Size of the source data in code units.
+   * \param destination Destination buffer.
+   * \param destinationSize Size of the destination buffer in bytes.
+   * \param written Set to the number of bytes written.
+   * \return True on success. False if the destination is too small.
+   */
+  static bool UTF16ToUTF8(const char16* source,
+                          u64 sourceSize,
+                          char8* destination,
+                          u64 destinationSize,
+                          u64& written);
+};
+
+}
+
+// ========================================================================== //
+// UTF16Buffer Declaration
+// ========================================================================== //
+
+namespace olivine {
+
+/** \class UTF16Buffer
+ * \author Filip Björklund
+ * \date 18 october 2026 - 15:45
+ * \brief Temporary UTF-16 copy of UTF-8 text.
+ * \details
+ * Null-terminated UTF-16 copy of UTF-8 text for passing to platform functions
+ * that take wide strings. Text that fits in 'kInlineSize' code units is stored
+ * inline, so a buffer on the stack does not allocate for short text.
+ */
+class UTF16Buffer
+{
+  OL_NO_COPY(UTF16Buffer);
+
+public:
+  /** Number of code units, including the null-terminator, stored inline **/
+  static constexpr u64 kInlineSize = 256;
+
+private:
+  /** Inline storage **/
+  char16 mInline[kInlineSize];
+  /** Data, either the inline storage or a heap allocation **/
+  char16* mData = mInline;
+  /** Size in code units, excluding the null-terminator **/
+  u64 mSize = 0;
+
+public:
+  /** Construct a UTF-16 copy of UTF-8 text. Invalid text results in an empty
+   * buffer.
+   * \brief Construct from UTF-8.
+   * \param data UTF-8 data.
+   * \param size Size of the data in bytes.
+   */
+  UTF16Buffer(const char8* data, u64 size);
+
+  /** Destruct **/
+  ~UTF16Buffer();
+
+  /** Returns the null-terminated UTF-16 data.
+   * \brief Returns data.
+   * \return Data.
+   */
+  OL_NODISCARD const char16* GetData() const { return mData; }
+
+  /** Returns the size in code units, excluding the null-terminator.
+   * \brief Returns size.
+   * \return Size in code units.
+   */
+  OL_NODISCARD u64 GetSize() const { return mSize; }
+};
+
+}
@@ -145,16 +145,17 @@ Buffer::Write(const u8* data, u64 size, u64 offset)
 // -------------------------------------------------------------------------- //
 
 void
-Buffer::SetName(const String& name)
+Buffer::SetName(StringView name)
 {
   // Name resource
   D3D12Util::SetName(mResource, name);
 
   // Name allocation
   if (mAllocation) {
-    char16* _name = (name + "Mem").GetUTF16();
-    mAllocation->SetName(_name);
-    delete _name;
+    FormatBuffer<> buffer;
+    const StringView memName = String::FormatTo(buffer, OL_FMT("{}Mem"), name);
+    const UTF16Buffer _name(memName.GetData(), memName.GetSize());
+    mAllocation->SetName(_name.GetData());
   }
 }
 
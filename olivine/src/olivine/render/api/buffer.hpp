@@ -156,7 +156,17 @@ public:
    * \brief Set name.
    * \param name Name to set.
    */
-  void SetName(const String& name);
+  void SetName(StringView name);
+
+  /** Set the name of the buffer from a format string. The name is formatted
+   * into a stack buffer.
+   * \brief Set name from format.
+   * \param format Format string for name.
+   * \param argument First argument to format string.
+   * \param arguments Remaining arguments to format string.
+   */
+  template<typename S, typename ARG, typename... ARGS>
+  void SetName(const S& format, ARG&& argument, ARGS&&... arguments);
 
   /** Returns the handle to the resource backing the buffer.
    * \brief Returns buffer backing resource.
@@ -165,4 +175,21 @@ public:
   ID3D12Resource* GetResource() const { return mResource; }
 };
 
-}
\ No newline at end of file
+}
+
+// -------------------------------------------------------------------------- //
+
+namespace olivine {
+
+template<typename S, typename ARG, typename... ARGS>
+void
+Buffer::SetName(const S& format, ARG&& argument, ARGS&&... arguments)
+{
+  FormatBuffer<> buffer;
+  SetName(String::FormatTo(buffer,
+                           format,
+                           std::forward<ARG>(argument),
+                           std::forward<ARGS>(arguments)...));
+}
+
+}
@@ -165,24 +165,29 @@ CommandList::Copy(Texture* dst, Buffer* src, u64 srcOffset)
   ID3D12Resource* resource = dst->GetResource();
   D3D12_RESOURCE_DESC resourceDesc = resource->GetDesc();
 
-  // Get the copyable footprint
-  D3D12_PLACED_SUBRESOURCE_FOOTPRINT footprint;
-  UINT64 rowSizeInBytes;
-  UINT numRows;
-  UINT64 totalBytes;
-  device->GetHandle()->GetCopyableFootprints(
-    &resourceDesc, 0, 1, 0, &footprint, &numRows, &rowSizeInBytes, &totalBytes);
+  // Get the copyable footprints of all mip levels
+  const u32 mipLevels = dst->GetMipLevels();
+  D3D12_PLACED_SUBRESOURCE_FOOTPRINT footprints[D3D12_REQ_MIP_LEVELS];
+  device->GetHandle()->GetCopyableFootprints(&resourceDesc,
+                                             0,
+                                             mipLevels,
+                                             srcOffset,
+                                             footprints,
+                                             nullptr,
+                                             nullptr,
+                                             nullptr);
 
   // Copy texture regions
-  D3D12_TEXTURE_COPY_LOCATION _dst, _src;
-  _dst.pResource = dst->GetResource();
-  _dst.Type = D3D12_TEXTURE_COPY_TYPE_SUBRESOURCE_INDEX;
-  _dst.SubresourceIndex = 0;
-  _src.pResource = src->GetResource();
-  _src.Type = D3D12_TEXTURE_COPY_TYPE_PLACED_FOOTPRINT;
-  _src.PlacedFootprint.Offset = srcOffset;
-  _src.PlacedFootprint = footprint;
-  mHandle->CopyTextureRegion(&_dst, 0, 0, 0, &_src, nullptr);
+  for (u32 i = 0; i < mipLevels; i++) {
+    D3D12_TEXTURE_COPY_LOCATION _dst, _src;
+    _dst.pResource = dst->GetResource();
+    _dst.Type = D3D12_TEXTURE_COPY_TYPE_SUBRESOURCE_INDEX;
+    _dst.SubresourceIndex = i;
+    _src.pResource = src->GetResource();
+    _src.Type = D3D12_TEXTURE_COPY_TYPE_PLACED_FOOTPRINT;
+    _src.PlacedFootprint = footprints[i];
+    mHandle->CopyTextureRegion(&_dst, 0, 0, 0, &_src, nullptr);
+  }
 }
 
 // -------------------------------------------------------------------------- //
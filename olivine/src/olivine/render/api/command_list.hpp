@@ -147,7 +147,8 @@ public:
 
   /** Copy data from the 'src' buffer into the 'dst' texture. The buffer has
    * certain requirements for the layout of data that must be respected. These
-   * requirement can be retrieved from the texture.
+   * requirement can be retrieved from the texture. All mip levels of the
+   * texture are copied.
    * \brief Copy buffer to texture.
    * \param dst Destination texture.
    * \param src Source buffer.
@@ -73,6 +73,21 @@ D3D12Util::ToDXGIFormat(Format format)
     case Format::kB8G8R8A8Unorm: {
       return DXGI_FORMAT_B8G8R8A8_UNORM;
     }
+    case Format::kBC1Unorm: {
+      return DXGI_FORMAT_BC1_UNORM;
+    }
+    case Format::kBC3Unorm: {
+      return DXGI_FORMAT_BC3_UNORM;
+    }
+    case Format::kBC4Unorm: {
+      return DXGI_FORMAT_BC4_UNORM;
+    }
+    case Format::kBC5Unorm: {
+      return DXGI_FORMAT_BC5_UNORM;
+    }
+    case Format::kBC7Unorm: {
+      return DXGI_FORMAT_BC7_UNORM;
+    }
     case Format::kD32Float: {
       return DXGI_FORMAT_D32_FLOAT;
     }
@@ -212,25 +227,24 @@ D3D12Util::ToCullMode(CullMode cullMode)
 // -------------------------------------------------------------------------- //
 
 void
-D3D12Util::SetName(IDXGIObject* object, const String& name)
+D3D12Util::SetName(IDXGIObject* object, StringView name)
 {
   if (object) {
-    char16* _name = name.GetUTF16();
-    object->SetPrivateData(
-      WKPDID_D3DDebugObjectNameW, UINT(wcslen(_name) * sizeof(char16)), _name);
-    delete _name;
+    const UTF16Buffer _name(name.GetData(), name.GetSize());
+    object->SetPrivateData(WKPDID_D3DDebugObjectNameW,
+                           UINT(_name.GetSize() * sizeof(char16)),
+                           _name.GetData());
   }
 }
 
 // -------------------------------------------------------------------------- //
 
 void
-D3D12Util::SetName(ID3D12Object* object, const String& name)
+D3D12Util::SetName(ID3D12Object* object, StringView name)
 {
   if (object) {
-    char16* _name = name.GetUTF16();
-    object->SetName(_name);
-    delete _name;
+    const UTF16Buffer _name(name.GetData(), name.GetSize());
+    object->SetName(_name.GetData());
   }
 }
 
@@ -133,17 +133,19 @@ public:
    * \param object Object to set name of.
    * \param name Name to set for object.
    */
-  static void SetName(IDXGIObject* object, const String& name);
+  static void SetName(IDXGIObject* object, StringView name);
 
   /** Set the name of a IDXGIObject.
    * \brief Set IDXGIObject name.
    * \param object Object to set name of.
    * \param nameFormat Format string for name to set for object.
-   * \param arguments Arguments to format string.
+   * \param argument First argument to format string.
+   * \param arguments Remaining arguments to format string.
    */
-  template<typename... ARGS>
+  template<typename S, typename ARG, typename... ARGS>
   static void SetName(IDXGIObject* object,
-                      const String& nameFormat,
+                      const S& nameFormat,
+                      ARG&& argument,
                       ARGS&&... arguments);
 
   /** Set the name of a ID3D12Object.
@@ -151,17 +153,19 @@ public:
    * \param object Object to set name of.
    * \param name Name to set for object.
    */
-  static void SetName(ID3D12Object* object, const String& name);
+  static void SetName(ID3D12Object* object, StringView name);
 
   /** Set the name of a ID3D12Object.
    * \brief Set ID3D12Object name.
    * \param object Object to set name of.
    * \param nameFormat Format string for name to set for object.
-   * \param arguments Arguments to format string.
+   * \param argument First argument to format string.
+   * \param arguments Remaining arguments to format string.
    */
-  template<typename... ARGS>
+  template<typename S, typename ARG, typename... ARGS>
   static void SetName(ID3D12Object* object,
-                      const String& nameFormat,
+                      const S& nameFormat,
+                      ARG&& argument,
                       ARGS&&... arguments);
 };
 
@@ -181,24 +185,36 @@ D3D12Util::Assert(HRESULT hresult, const String& format, ARGS&&... arguments)
 
 // -------------------------------------------------------------------------- //
 
-template<typename... ARGS>
+template<typename S, typename ARG, typename... ARGS>
 void
 D3D12Util::SetName(IDXGIObject* object,
-                   const String& nameFormat,
+                   const S& nameFormat,
+                   ARG&& argument,
                    ARGS&&... arguments)
 {
-  SetName(object, String::Format(nameFormat, std::forward<ARGS>(arguments)...));
+  FormatBuffer<> buffer;
+  SetName(object,
+          String::FormatTo(buffer,
+                           nameFormat,
+                           std::forward<ARG>(argument),
+                           std::forward<ARGS>(arguments)...));
 }
 
 // -------------------------------------------------------------------------- //
 
-template<typename... ARGS>
+template<typename S, typename ARG, typename... ARGS>
 void
 D3D12Util::SetName(ID3D12Object* object,
-                   const String& nameFormat,
+                   const S& nameFormat,
+                   ARG&& argument,
                    ARGS&&... arguments)
 {
-  SetName(object, String::Format(nameFormat, std::forward<ARGS>(arguments)...));
+  FormatBuffer<> buffer;
+  SetName(object,
+          String::FormatTo(buffer,
+                           nameFormat,
+                           std::forward<ARG>(argument),
+                           std::forward<ARGS>(arguments)...));
 }
 
 }
@@ -208,10 +208,6 @@ PipelineState::LoadShader(const Path& path)
 {
   ShaderBinary binary;
 
-  // Resize code buffer
-  const u64 fileSize = FileSystem::GetSize(path);
-  binary.bytes.resize(fileSize);
-
   // Open file
   FileIO io(path);
   FileResult result = io.Open(FileIO::Flag::kRead);
@@ -219,6 +215,15 @@ PipelineState::LoadShader(const Path& path)
     return ShaderBinary{ {} };
   }
 
+  // Resize code buffer. The size is taken from the open handle, so that the
+  // path is only looked up once
+  u64 fileSize;
+  result = io.GetSize(fileSize);
+  if (result != FileResult::kSuccess) {
+    return ShaderBinary{ {} };
+  }
+  binary.bytes.resize(fileSize);
+
   // Read file
   u64 read;
   result = io.Read(binary.bytes.data(), fileSize, read);
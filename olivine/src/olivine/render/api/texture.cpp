@@ -40,6 +40,7 @@ Texture::Texture(const CreateInfo& createInfo)
   : mWidth(createInfo.width)
   , mHeight(createInfo.height)
   , mDepth(createInfo.depth)
+  , mMipLevels(createInfo.mipLevels)
   , mDimension(createInfo.dimension)
   , mFormat(createInfo.format)
   , mUsages(createInfo.usages)
@@ -107,6 +108,7 @@ Texture::Texture(ID3D12Resource* resource,
   , mWidth(width)
   , mHeight(height)
   , mDepth(depth)
+  , mMipLevels(resource->GetDesc().MipLevels)
   , mDimension(dimension)
   , mFormat(format)
   , mUsages(usages)
@@ -136,10 +138,12 @@ Texture::GetBufferRequirements() const
   Device* device = App::Instance()->GetDevice();
 
   D3D12_RESOURCE_DESC desc = mResource->GetDesc();
-  UINT64 size, rowsize;
+  UINT64 size;
   D3D12_PLACED_SUBRESOURCE_FOOTPRINT footprint;
   device->GetHandle()->GetCopyableFootprints(
-    &desc, 0, 1, 0, &footprint, nullptr, &rowsize, &size);
+    &desc, 0, 1, 0, &footprint, nullptr, nullptr, nullptr);
+  device->GetHandle()->GetCopyableFootprints(
+    &desc, 0, mMipLevels, 0, nullptr, nullptr, nullptr, &size);
 
   BufferRequirements reqs;
   reqs.size = u64(size);
@@ -150,6 +154,32 @@ Texture::GetBufferRequirements() const
 
 // -------------------------------------------------------------------------- //
 
+Texture::Footprint
+Texture::GetFootprint(u32 mipLevel) const
+{
+  Assert(mipLevel < mMipLevels,
+         "Mip level out of bounds: {} not in [0, {})",
+         mipLevel,
+         mMipLevels);
+  Device* device = App::Instance()->GetDevice();
+
+  // The offset of a level is only known when the footprints of all levels
+  // before it are queried together
+  D3D12_RESOURCE_DESC desc = mResource->GetDesc();
+  D3D12_PLACED_SUBRESOURCE_FOOTPRINT footprints[D3D12_REQ_MIP_LEVELS];
+  UINT rowCounts[D3D12_REQ_MIP_LEVELS];
+  device->GetHandle()->GetCopyableFootprints(
+    &desc, 0, mipLevel + 1, 0, footprints, rowCounts, nullptr, nullptr);
+
+  Footprint footprint;
+  footprint.offset = footprints[mipLevel].Offset;
+  footprint.rowStride = footprints[mipLevel].Footprint.RowPitch;
+  footprint.rowCount = rowCounts[mipLevel];
+  return footprint;
+}
+
+// -------------------------------------------------------------------------- //
+
 void
 Texture::SetName(const String& name)
 {
@@ -75,12 +75,23 @@ public:
   /* Requirements for storing texture data in a buffer */
   struct BufferRequirements
   {
-    /* Minimum size of the buffer */
+    /* Minimum size of the buffer, for all mip levels */
     u64 size;
     /* Minimum alignment of the buffer */
     u64 alignment;
+    /* Stride for data of each row of the first mip level */
+    u64 rowStride;
+  };
+
+  /* Layout of the data of a mip level in a buffer */
+  struct Footprint
+  {
+    /* Offset of the data in the buffer */
+    u64 offset;
     /* Stride for data of each row */
     u64 rowStride;
+    /* Number of rows */
+    u32 rowCount;
   };
 
   /* Creation information */
@@ -116,6 +127,8 @@ private:
   u32 mHeight;
   /* Depth */
   u32 mDepth;
+  /* Number of mip levels */
+  u32 mMipLevels;
   /* Dimension of texture */
   Dim mDimension;
   /* Format of texture  */
@@ -168,6 +181,12 @@ public:
    */
   u32 GetHeight() const { return mHeight; }
 
+  /** Returns the number of mip levels of the texture.
+   * \brief Returns mip level count.
+   * \return Number of mip levels.
+   */
+  u32 GetMipLevels() const { return mMipLevels; }
+
   /** Returns the format of the texture.
    * \brief Returns format.
    * \return Format.
@@ -181,6 +200,15 @@ public:
    */
   BufferRequirements GetBufferRequirements() const;
 
+  /** Returns the layout of the data of a mip level in a buffer that satisfies
+   * the buffer requirements of the texture. The levels are stored after each
+   * other in the buffer.
+   * \brief Returns mip level footprint.
+   * \param mipLevel Mip level.
+   * \return Footprint of the level.
+   */
+  Footprint GetFootprint(u32 mipLevel) const;
+
   /** Returns the resource for the texture.
    * \brief Returns resource.
    * \return Resource handle.
@@ -30,8 +30,80 @@
 #include "olivine/core/assert.hpp"
 #include "olivine/core/image.hpp"
 #include "olivine/core/memory.hpp"
+#include "olivine/core/pixel_converter.hpp"
+#include "olivine/core/thread_pool.hpp"
 #include "olivine/math/math.hpp"
 #include "olivine/render/api/texture.hpp"
+#include "olivine/render/block_compressor.hpp"
+
+// ========================================================================== //
+// Functions
+// ========================================================================== //
+
+namespace olivine {
+
+/** Returns the image format that has the same layout as a texture format, or
+ * 'Image::Format::kUnknown' if there is none **/
+static Image::Format
+ToImageFormat(Format format)
+{
+  switch (format) {
+    case Format::kR8Unorm: {
+      return Image::Format::kRed;
+    }
+    case Format::kR8G8B8A8Unorm: {
+      return Image::Format::kRGBA;
+    }
+    case Format::kB8G8R8A8Unorm: {
+      return Image::Format::kBGRA;
+    }
+    default: {
+      return Image::Format::kUnknown;
+    }
+  }
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Write all mip levels of an image to memory in the layout that is copied to
+ * a texture. Images with a different layout than the texture are converted
+ * while they are written, and images for block-compressed textures are
+ * encoded directly into the memory **/
+static void
+WriteTexture(const Texture* texture, const Image& image, u8* mapped)
+{
+  Assert(image.GetMipLevels() >= texture->GetMipLevels(),
+         "Image has fewer mip levels than the texture");
+  const Image::Format format = ToImageFormat(texture->GetFormat());
+  for (u32 level = 0; level < texture->GetMipLevels(); level++) {
+    const Texture::Footprint footprint = texture->GetFootprint(level);
+    const u32 width = image.GetMipWidth(level);
+    const u32 height = image.GetMipHeight(level);
+    const u64 stride = Image::GetFormatRowStride(image.GetFormat(), width);
+    if (BlockCompressor::IsCompressed(texture->GetFormat())) {
+      const BlockCompressor compressor(texture->GetFormat());
+      compressor.Compress(
+        image, level, mapped + footprint.offset, footprint.rowStride);
+    } else if (format == Image::Format::kUnknown ||
+               format == image.GetFormat()) {
+      for (u32 i = 0; i < height; i++) {
+        Memory::Copy(mapped + footprint.offset + (footprint.rowStride * i),
+                     image.GetMipData(level) + (stride * i),
+                     stride);
+      }
+    } else {
+      const PixelConverter converter(image.GetFormat(), format);
+      converter.Convert(image.GetMipData(level),
+                        stride,
+                        mapped + footprint.offset,
+                        footprint.rowStride,
+                        width,
+                        height);
+    }
+  }
+}
+
+}
 
 // ========================================================================== //
 // UploadManager Implementation
@@ -131,29 +203,95 @@ UploadManager::Upload(CommandQueue* queue,
                       Texture* dst,
                       Image* src)
 {
-  // Retrieve buffer requirements for texture
-  const Texture::BufferRequirements bufferRequirements =
-    dst->GetBufferRequirements();
+  Upload(queue, list, { TextureUpload{ dst, src } });
+}
 
-  // Create upload buffer
-  auto buffer = new Buffer(bufferRequirements.size,
+// -------------------------------------------------------------------------- //
+
+bool
+UploadManager::Upload(CommandQueue* queue,
+                      CommandList* list,
+                      Texture* dst,
+                      const u8* data,
+                      u64 size)
+{
+  Assert(dst->GetMipLevels() == 1,
+         "Image files can only be uploaded to textures with one mip level");
+
+  // Check that the image matches the texture before anything is allocated
+  Image::Info info;
+  if (Image::GetInfo(data, size, info) != Image::Result::kSuccess) {
+    return false;
+  }
+  info.format = ToImageFormat(dst->GetFormat());
+  if (info.format == Image::Format::kUnknown ||
+      info.width != dst->GetWidth() || info.height != dst->GetHeight()) {
+    return false;
+  }
+
+  // Decode the image into the upload buffer
+  auto buffer = new Buffer(dst->GetBufferRequirements().size,
                            Buffer::Usage::kNone,
-                           HeapKind::kUpload,
-                           bufferRequirements.alignment);
-  buffer->SetName(String::Format("TmpUploadBuffer{}", sNextTempBuffer++));
+                           HeapKind::kUpload);
+  buffer->SetName(OL_FMT("TmpUploadBuffer{}"), sNextTempBuffer++);
+  const Texture::Footprint footprint = dst->GetFootprint(0);
+  const Image::Result result = Image::Decode(
+    data, size, info, buffer->Map() + footprint.offset, footprint.rowStride);
+  buffer->Unmap();
+  if (result != Image::Result::kSuccess) {
+    delete buffer;
+    return false;
+  }
 
-  // Put data into digestible format
-  u8* mapped = buffer->Map();
-  for (u32 i = 0; i < src->GetHeight(); i++) {
-    Memory::Copy(mapped + (bufferRequirements.rowStride * i),
-                 src->GetData() + (src->GetStride() * i),
-                 src->GetStride());
+  // Upload data
+  list->Reset();
+  list->Copy(dst, buffer, 0);
+  list->Close();
+  queue->Submit(list);
+  queue->Flush();
+
+  // Delete buffer
+  delete buffer;
+  return true;
+}
+
+// -------------------------------------------------------------------------- //
+
+void
+UploadManager::Upload(CommandQueue* queue,
+                      CommandList* list,
+                      const std::vector<TextureUpload>& uploads)
+{
+  if (uploads.empty()) {
+    return;
+  }
+
+  // Place the data of the textures after each other in a single upload buffer
+  std::vector<u64> offsets(uploads.size());
+  u64 size = 0;
+  for (u64 i = 0; i < uploads.size(); i++) {
+    size = AlignUp(size, u64(D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT));
+    offsets[i] = size;
+    size += uploads[i].texture->GetBufferRequirements().size;
   }
+
+  // Create upload buffer
+  auto buffer = new Buffer(size, Buffer::Usage::kNone, HeapKind::kUpload);
+  buffer->SetName(OL_FMT("TmpUploadBuffer{}"), sNextTempBuffer++);
+
+  // Write the textures to the upload buffer in parallel, as they may have to
+  // be converted or block-compressed
+  u8* mapped = buffer->Map();
+  ThreadPool::GetGlobal().ParallelFor(uploads.size(), [&](u64 i) {
+    WriteTexture(uploads[i].texture, *uploads[i].image, mapped + offsets[i]);
+  });
   buffer->Unmap();
 
   // Upload data
   list->Reset();
-  list->Copy(dst, buffer);
+  for (u64 i = 0; i < uploads.size(); i++) {
+    list->Copy(uploads[i].texture, buffer, offsets[i]);
+  }
   list->Close();
   queue->Submit(list);
   queue->Flush();
@@ -174,7 +312,7 @@ UploadManager::Upload(CommandQueue* queue,
 {
   // Create upload buffer
   auto buffer = new Buffer(size, Buffer::Usage::kNone, HeapKind::kUpload);
-  buffer->SetName(String::Format("TmpUploadBuffer{}", sNextTempBuffer++));
+  buffer->SetName(OL_FMT("TmpUploadBuffer{}"), sNextTempBuffer++);
   buffer->Write(src, size);
 
   // Upload data
@@ -26,6 +26,9 @@
 // Headers
 // ========================================================================== //
 
+// Standard headers
+#include <vector>
+
 // Project headers
 #include "olivine/core/macros.hpp"
 #include "olivine/math/literals.hpp"
@@ -57,6 +60,16 @@ public:
   /* Monotonically increasing temporary buffer id */
   static u64 sNextTempBuffer;
 
+  /* Upload of an image to a texture in a batch */
+  struct TextureUpload
+  {
+    /* Destination texture */
+    Texture* texture;
+    /* Source image. This must have at least as many mip levels as the
+     * texture */
+    const Image* image;
+  };
+
 private:
   /* Command list for uploading */
   CommandList mList;
@@ -135,6 +148,8 @@ public:
    * does not work well with command lists that are used for other things.
    * \note This function flushes the command queue to ensure that uploading is
    * complete.
+   * \note All mip levels of the texture are uploaded, so the image must have
+   * at least as many levels as the texture.
    * \brief Upload image to texture.
    * \param queue Command queue to perform upload with.
    * \param list Command list to perform upload with.
@@ -146,6 +161,42 @@ public:
                      Texture* dst,
                      Image* src);
 
+  /** Utility function for uploading the contents of an image file to a
+   * texture with a single mip level. The image is decoded straight into the
+   * mapped upload buffer, without an intermediate 'Image'. The texture must
+   * have the size of the image and one of the uncompressed 8-bit formats.
+   * \note This function flushes the command queue to ensure that uploading is
+   * complete.
+   * \brief Upload image file to texture.
+   * \param queue Command queue to perform upload with.
+   * \param list Command list to perform upload with.
+   * \param dst Destination texture.
+   * \param data Contents of the image file.
+   * \param size Size of the contents in bytes.
+   * \return True if the image was decoded and uploaded, false if it could not
+   * be decoded or does not match the texture.
+   */
+  static bool Upload(CommandQueue* queue,
+                     CommandList* list,
+                     Texture* dst,
+                     const u8* data,
+                     u64 size);
+
+  /** Utility function for uploading images to multiple textures at once. The
+   * images are written to a single upload buffer in parallel on the global
+   * thread pool, and the copies are then recorded in the command list and
+   * submitted together.
+   * \note This function flushes the command queue to ensure that uploading is
+   * complete.
+   * \brief Upload images to textures.
+   * \param queue Command queue to perform upload with.
+   * \param list Command list to perform upload with.
+   * \param uploads Textures and the images to upload to them.
+   */
+  static void Upload(CommandQueue* queue,
+                     CommandList* list,
+                     const std::vector<TextureUpload>& uploads);
+
   /** Utility function for quickly uploading data from a memory to a buffer.
    * \note This function is not very performant as it will block until the
    * upload has been completed and creates a lot of temporary resources. It also
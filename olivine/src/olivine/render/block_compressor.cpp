@@ -0,0 +1,825 @@
+// MIT License
+//
+// Copyright (c) 2019 Filip Björklund
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "olivine/render/block_compressor.hpp"
+
+// ========================================================================== //
+// Headers
+// ========================================================================== //
+
+// Standard headers
+#include <cfloat>
+#include <cmath>
+#include <emmintrin.h>
+#include <utility>
+
+// Project headers
+#include "olivine/core/assert.hpp"
+#include "olivine/core/image.hpp"
+#include "olivine/core/image_view.hpp"
+#include "olivine/core/memory.hpp"
+#include "olivine/core/thread_pool.hpp"
+#include "olivine/math/math.hpp"
+
+// ========================================================================== //
+// Scalar Functions
+// ========================================================================== //
+
+namespace olivine {
+
+/** Number of pixels in a block **/
+static constexpr u32 kBlockPixels = 16;
+
+/** Interpolation weights of the BC1 palette entries **/
+static constexpr f32 kWeightsBC1[4] = { 0.0f, 1.0f, 1.0f / 3.0f, 2.0f / 3.0f };
+
+/** Interpolation weights of the BC4 palette entries **/
+static constexpr f32 kWeightsBC4[8] = { 0.0f,        1.0f,        1.0f / 7.0f,
+                                        2.0f / 7.0f, 3.0f / 7.0f, 4.0f / 7.0f,
+                                        5.0f / 7.0f, 6.0f / 7.0f };
+
+/** Interpolation weights of the BC7 palette entries with 4-bit indices, in
+ * 64ths **/
+static constexpr u32 kWeightsBC7[16] = { 0,  4,  9,  13, 17, 21, 26, 30,
+                                         34, 38, 43, 47, 51, 55, 60, 64 };
+
+// -------------------------------------------------------------------------- //
+
+/** Values of the pixels of a block, with the values of each channel stored
+ * together. Values are in the range [0, 255] **/
+struct alignas(16) Block
+{
+  f32 channels[4][kBlockPixels];
+};
+
+// -------------------------------------------------------------------------- //
+
+/** Palette of a block. Entries that are not used must not be read **/
+struct Palette
+{
+  f32 entries[16][4];
+  u32 count;
+};
+
+// -------------------------------------------------------------------------- //
+
+/** Returns the number of endpoint refinements of a quality preset **/
+static u32
+GetRefineCount(BlockCompressor::Quality quality)
+{
+  switch (quality) {
+    case BlockCompressor::Quality::kFast: {
+      return 0;
+    }
+    case BlockCompressor::Quality::kNormal: {
+      return 1;
+    }
+    case BlockCompressor::Quality::kHigh:
+    default: {
+      return 4;
+    }
+  }
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Find endpoints from the bounding box of the values of a block. The box is
+ * inset slightly, as the extreme values are rarely worth representing
+ * exactly **/
+static void
+FitBox(const Block& block, u32 channelCount, f32 (&e0)[4], f32 (&e1)[4])
+{
+  for (u32 c = 0; c < channelCount; c++) {
+    f32 min = block.channels[c][0];
+    f32 max = block.channels[c][0];
+    for (u32 i = 1; i < kBlockPixels; i++) {
+      min = Min(min, block.channels[c][i]);
+      max = Max(max, block.channels[c][i]);
+    }
+    const f32 inset = (max - min) / 16.0f;
+    e0[c] = max - inset;
+    e1[c] = min + inset;
+  }
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Find endpoints along the principal axis of the values of a block. The axis
+ * is found by power iteration on the covariance matrix **/
+static void
+FitPrincipalAxis(const Block& block,
+                 u32 channelCount,
+                 f32 (&e0)[4],
+                 f32 (&e1)[4])
+{
+  // Mean and covariance
+  f32 mean[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+  for (u32 c = 0; c < channelCount; c++) {
+    for (u32 i = 0; i < kBlockPixels; i++) {
+      mean[c] += block.channels[c][i];
+    }
+    mean[c] /= kBlockPixels;
+  }
+  f32 covariance[4][4] = {};
+  for (u32 i = 0; i < kBlockPixels; i++) {
+    for (u32 a = 0; a < channelCount; a++) {
+      for (u32 b = a; b < channelCount; b++) {
+        covariance[a][b] += (block.channels[a][i] - mean[a]) *
+                            (block.channels[b][i] - mean[b]);
+      }
+    }
+  }
+  for (u32 a = 0; a < channelCount; a++) {
+    for (u32 b = 0; b < a; b++) {
+      covariance[a][b] = covariance[b][a];
+    }
+  }
+
+  // Power iteration, starting from the diagonal of the bounding box
+  f32 axis[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+  FitBox(block, channelCount, axis, e1);
+  for (u32 c = 0; c < channelCount; c++) {
+    axis[c] -= e1[c];
+  }
+  for (u32 iteration = 0; iteration < 8; iteration++) {
+    f32 next[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+    f32 scale = 0.0f;
+    for (u32 a = 0; a < channelCount; a++) {
+      for (u32 b = 0; b < channelCount; b++) {
+        next[a] += covariance[a][b] * axis[b];
+      }
+      scale = Max(scale, std::fabs(next[a]));
+    }
+    if (scale == 0.0f) {
+      break;
+    }
+    for (u32 c = 0; c < channelCount; c++) {
+      axis[c] = next[c] / scale;
+    }
+  }
+  f32 length = 0.0f;
+  for (u32 c = 0; c < channelCount; c++) {
+    length += axis[c] * axis[c];
+  }
+  if (length == 0.0f) {
+    for (u32 c = 0; c < channelCount; c++) {
+      e0[c] = mean[c];
+      e1[c] = mean[c];
+    }
+    return;
+  }
+  length = std::sqrt(length);
+  for (u32 c = 0; c < channelCount; c++) {
+    axis[c] /= length;
+  }
+
+  // Project the values onto the axis and use the extremes as endpoints
+  f32 min = FLT_MAX;
+  f32 max = -FLT_MAX;
+  for (u32 i = 0; i < kBlockPixels; i++) {
+    f32 t = 0.0f;
+    for (u32 c = 0; c < channelCount; c++) {
+      t += (block.channels[c][i] - mean[c]) * axis[c];
+    }
+    min = Min(min, t);
+    max = Max(max, t);
+  }
+  for (u32 c = 0; c < channelCount; c++) {
+    e0[c] = Clamp(mean[c] + axis[c] * max, 0.0f, 255.0f);
+    e1[c] = Clamp(mean[c] + axis[c] * min, 0.0f, 255.0f);
+  }
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Find the endpoints that minimize the squared error of a block for the
+ * chosen indices, by least squares. 'weights' holds the interpolation weight
+ * of each index. Returns false if the indices do not determine the
+ * endpoints **/
+static bool
+RefineEndpoints(const Block& block,
+                u32 channelCount,
+                const u8 (&indices)[kBlockPixels],
+                const f32* weights,
+                f32 (&e0)[4],
+                f32 (&e1)[4])
+{
+  f32 aa = 0.0f;
+  f32 bb = 0.0f;
+  f32 ab = 0.0f;
+  f32 ax[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+  f32 bx[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+  for (u32 i = 0; i < kBlockPixels; i++) {
+    const f32 t = weights[indices[i]];
+    const f32 s = 1.0f - t;
+    aa += s * s;
+    bb += t * t;
+    ab += s * t;
+    for (u32 c = 0; c < channelCount; c++) {
+      ax[c] += s * block.channels[c][i];
+      bx[c] += t * block.channels[c][i];
+    }
+  }
+  const f32 determinant = aa * bb - ab * ab;
+  if (std::fabs(determinant) < 1e-6f) {
+    return false;
+  }
+  for (u32 c = 0; c < channelCount; c++) {
+    e0[c] = Clamp((ax[c] * bb - bx[c] * ab) / determinant, 0.0f, 255.0f);
+    e1[c] = Clamp((bx[c] * aa - ax[c] * ab) / determinant, 0.0f, 255.0f);
+  }
+  return true;
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Write bits to a block, starting at the lowest bit of the first byte **/
+static void
+WriteBits(u8* destination, u32& offset, u32 value, u32 count)
+{
+  for (u32 i = 0; i < count; i++, offset++) {
+    if ((value >> i) & 1u) {
+      destination[offset / 8] |= u8(1u << (offset % 8));
+    }
+  }
+}
+
+}
+
+// ========================================================================== //
+// SSE2 Functions
+// ========================================================================== //
+
+namespace olivine {
+
+/** Find the closest palette entry of each pixel of a block, four pixels at a
+ * time. Returns the total squared error **/
+static f32
+FindIndicesSSE2(const Block& block,
+                u32 channelCount,
+                const Palette& palette,
+                u8 (&indices)[kBlockPixels])
+{
+  alignas(16) s32 best[4];
+  alignas(16) f32 errors[4];
+  f32 total = 0.0f;
+  for (u32 p = 0; p < kBlockPixels; p += 4) {
+    __m128 bestError = _mm_set1_ps(FLT_MAX);
+    __m128i bestIndex = _mm_setzero_si128();
+    for (u32 e = 0; e < palette.count; e++) {
+      __m128 error = _mm_setzero_ps();
+      for (u32 c = 0; c < channelCount; c++) {
+        const __m128 d = _mm_sub_ps(_mm_load_ps(block.channels[c] + p),
+                                    _mm_set1_ps(palette.entries[e][c]));
+        error = _mm_add_ps(error, _mm_mul_ps(d, d));
+      }
+      const __m128i closer = _mm_castps_si128(_mm_cmplt_ps(error, bestError));
+      bestError = _mm_min_ps(error, bestError);
+      bestIndex = _mm_or_si128(_mm_and_si128(closer, _mm_set1_epi32(s32(e))),
+                               _mm_andnot_si128(closer, bestIndex));
+    }
+    _mm_store_si128(reinterpret_cast<__m128i*>(best), bestIndex);
+    _mm_store_ps(errors, bestError);
+    for (u32 i = 0; i < 4; i++) {
+      indices[p + i] = u8(best[i]);
+      total += errors[i];
+    }
+  }
+  return total;
+}
+
+}
+
+// ========================================================================== //
+// Encoder Functions
+// ========================================================================== //
+
+namespace olivine {
+
+/** Quantized BC1 endpoints and indices of a block **/
+struct StateBC1
+{
+  u16 colors[2];
+  u8 indices[kBlockPixels];
+  f32 error;
+};
+
+// -------------------------------------------------------------------------- //
+
+/** Quantize BC1 endpoints and find the indices for them **/
+static void
+EvaluateBC1(const Block& block,
+            const f32 (&e0)[4],
+            const f32 (&e1)[4],
+            StateBC1& state)
+{
+  // Quantize to RGB565, with the larger color first to select the 4-color
+  // mode. In BC3 the color block is always decoded in 4-color mode
+  auto Quantize = [](const f32(&e)[4]) -> u16 {
+    const u32 r = u32(e[0] * (31.0f / 255.0f) + 0.5f);
+    const u32 g = u32(e[1] * (63.0f / 255.0f) + 0.5f);
+    const u32 b = u32(e[2] * (31.0f / 255.0f) + 0.5f);
+    return u16((r << 11) | (g << 5) | b);
+  };
+  state.colors[0] = Quantize(e0);
+  state.colors[1] = Quantize(e1);
+  if (state.colors[0] < state.colors[1]) {
+    std::swap(state.colors[0], state.colors[1]);
+  }
+
+  // Build palette from the colors as the decoder expands them
+  Palette palette;
+  for (u32 i = 0; i < 2; i++) {
+    const u32 r = (state.colors[i] >> 11) & 31u;
+    const u32 g = (state.colors[i] >> 5) & 63u;
+    const u32 b = state.colors[i] & 31u;
+    palette.entries[i][0] = f32((r << 3) | (r >> 2));
+    palette.entries[i][1] = f32((g << 2) | (g >> 4));
+    palette.entries[i][2] = f32((b << 3) | (b >> 2));
+  }
+  for (u32 c = 0; c < 3; c++) {
+    const f32 a = palette.entries[0][c];
+    const f32 b = palette.entries[1][c];
+    palette.entries[2][c] = (2.0f * a + b) / 3.0f;
+    palette.entries[3][c] = (a + 2.0f * b) / 3.0f;
+  }
+  palette.count = state.colors[0] == state.colors[1] ? 1 : 4;
+  state.error = FindIndicesSSE2(block, 3, palette, state.indices);
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Encode the RGB channels of a block as a BC1 block **/
+static void
+EncodeBC1(const Block& block, BlockCompressor::Quality quality, u8* destination)
+{
+  f32 e0[4];
+  f32 e1[4];
+  if (quality == BlockCompressor::Quality::kFast) {
+    FitBox(block, 3, e0, e1);
+  } else {
+    FitPrincipalAxis(block, 3, e0, e1);
+  }
+  StateBC1 best;
+  EvaluateBC1(block, e0, e1, best);
+  for (u32 i = 0; i < GetRefineCount(quality) && best.error > 0.0f; i++) {
+    if (!RefineEndpoints(block, 3, best.indices, kWeightsBC1, e0, e1)) {
+      break;
+    }
+    StateBC1 state;
+    EvaluateBC1(block, e0, e1, state);
+    if (state.error >= best.error) {
+      break;
+    }
+    best = state;
+  }
+
+  // Write block
+  u32 bits = 0;
+  for (u32 i = 0; i < kBlockPixels; i++) {
+    bits |= u32(best.indices[i]) << (2 * i);
+  }
+  destination[0] = u8(best.colors[0]);
+  destination[1] = u8(best.colors[0] >> 8);
+  destination[2] = u8(best.colors[1]);
+  destination[3] = u8(best.colors[1] >> 8);
+  for (u32 i = 0; i < 4; i++) {
+    destination[4 + i] = u8(bits >> (8 * i));
+  }
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Quantized BC4 endpoints and indices of a block **/
+struct StateBC4
+{
+  u8 values[2];
+  u8 indices[kBlockPixels];
+  f32 error;
+};
+
+// -------------------------------------------------------------------------- //
+
+/** Quantize BC4 endpoints and find the indices for them **/
+static void
+EvaluateBC4(const Block& block,
+            const f32 (&e0)[4],
+            const f32 (&e1)[4],
+            StateBC4& state)
+{
+  // The larger value is first to select the 8-value mode
+  state.values[0] = u8(e0[0] + 0.5f);
+  state.values[1] = u8(e1[0] + 0.5f);
+  if (state.values[0] < state.values[1]) {
+    std::swap(state.values[0], state.values[1]);
+  }
+
+  Palette palette;
+  const f32 a = state.values[0];
+  const f32 b = state.values[1];
+  for (u32 i = 0; i < 8; i++) {
+    palette.entries[i][0] = a + (b - a) * kWeightsBC4[i];
+  }
+  palette.count = state.values[0] == state.values[1] ? 1 : 8;
+  state.error = FindIndicesSSE2(block, 1, palette, state.indices);
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Encode a single channel of values as a BC4 block **/
+static void
+EncodeBC4(const f32 (&values)[kBlockPixels],
+          BlockCompressor::Quality quality,
+          u8* destination)
+{
+  Block block;
+  Memory::Copy(block.channels[0], values, sizeof(values));
+
+  // The bounding box is exact for a single channel, so it is only inset for
+  // the higher qualities, where the refinement can correct it
+  f32 e0[4];
+  f32 e1[4];
+  FitBox(block, 1, e0, e1);
+  if (quality == BlockCompressor::Quality::kFast) {
+    const f32 inset = (e0[0] - e1[0]) / 14.0f;
+    e0[0] += inset;
+    e1[0] -= inset;
+  }
+  StateBC4 best;
+  EvaluateBC4(block, e0, e1, best);
+  for (u32 i = 0; i < GetRefineCount(quality) && best.error > 0.0f; i++) {
+    if (!RefineEndpoints(block, 1, best.indices, kWeightsBC4, e0, e1)) {
+      break;
+    }
+    StateBC4 state;
+    EvaluateBC4(block, e0, e1, state);
+    if (state.error >= best.error) {
+      break;
+    }
+    best = state;
+  }
+
+  // Write block
+  u64 bits = 0;
+  for (u32 i = 0; i < kBlockPixels; i++) {
+    bits |= u64(best.indices[i]) << (3 * i);
+  }
+  destination[0] = best.values[0];
+  destination[1] = best.values[1];
+  for (u32 i = 0; i < 6; i++) {
+    destination[2 + i] = u8(bits >> (8 * i));
+  }
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Quantized BC7 mode 6 endpoints and indices of a block **/
+struct StateBC7
+{
+  u8 endpoints[2][4];
+  u8 pbits[2];
+  u8 indices[kBlockPixels];
+  f32 error;
+};
+
+// -------------------------------------------------------------------------- //
+
+/** Quantize a BC7 mode 6 endpoint to 7 bits per channel and a shared lowest
+ * bit. Returns the quantized endpoint and the squared error **/
+static f32
+QuantizeBC7(const f32 (&e)[4], u32 pbit, u8 (&endpoint)[4])
+{
+  f32 error = 0.0f;
+  for (u32 c = 0; c < 4; c++) {
+    const s32 q = Clamp(s32((e[c] - f32(pbit)) * 0.5f + 0.5f), 0, 127);
+    endpoint[c] = u8(q);
+    const f32 d = f32((q << 1) | s32(pbit)) - e[c];
+    error += d * d;
+  }
+  return error;
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Quantize BC7 mode 6 endpoints with the specified lowest bits, or with the
+ * best bits of each endpoint if 'pbit0' is negative, and find the indices **/
+static void
+EvaluateBC7(const Block& block,
+            const f32 (&e0)[4],
+            const f32 (&e1)[4],
+            s32 pbit0,
+            s32 pbit1,
+            StateBC7& state)
+{
+  const f32* endpoints[2] = { e0, e1 };
+  const s32 pbits[2] = { pbit0, pbit1 };
+  for (u32 i = 0; i < 2; i++) {
+    const f32(&e)[4] = *reinterpret_cast<const f32(*)[4]>(endpoints[i]);
+    if (pbits[i] >= 0) {
+      state.pbits[i] = u8(pbits[i]);
+      QuantizeBC7(e, state.pbits[i], state.endpoints[i]);
+      continue;
+    }
+    u8 other[4];
+    const f32 error0 = QuantizeBC7(e, 0, state.endpoints[i]);
+    const f32 error1 = QuantizeBC7(e, 1, other);
+    state.pbits[i] = error1 < error0 ? 1 : 0;
+    if (state.pbits[i]) {
+      Memory::Copy(state.endpoints[i], other, sizeof(other));
+    }
+  }
+
+  // Build palette as the decoder interpolates it
+  Palette palette;
+  for (u32 c = 0; c < 4; c++) {
+    const u32 a = (u32(state.endpoints[0][c]) << 1) | state.pbits[0];
+    const u32 b = (u32(state.endpoints[1][c]) << 1) | state.pbits[1];
+    for (u32 i = 0; i < 16; i++) {
+      const u32 w = kWeightsBC7[i];
+      palette.entries[i][c] = f32(((64 - w) * a + w * b + 32) >> 6);
+    }
+  }
+  palette.count = 16;
+  state.error = FindIndicesSSE2(block, 4, palette, state.indices);
+}
+
+// -------------------------------------------------------------------------- //
+
+/** Encode the RGBA channels of a block as a BC7 mode 6 block **/
+static void
+EncodeBC7(const Block& block, BlockCompressor::Quality quality, u8* destination)
+{
+  static f32 sWeights[16];
+  static const bool sWeightsInitialized = [] {
+    for (u32 i = 0; i < 16; i++) {
+      sWeights[i] = kWeightsBC7[i] / 64.0f;
+    }
+    return true;
+  }();
+  (void)sWeightsInitialized;
+
+  f32 e0[4];
+  f32 e1[4];
+  if (quality == BlockCompressor::Quality::kFast) {
+    FitBox(block, 4, e0, e1);
+  } else {
+    FitPrincipalAxis(block, 4, e0, e1);
+  }
+
+  // Evaluate the endpoints. The high quality preset tries all combinations
+  // of the lowest bits instead of choosing them per endpoint
+  auto Evaluate = [&](StateBC7& state) {
+    EvaluateBC7(block, e0, e1, -1, -1, state);
+    if (quality != BlockCompressor::Quality::kHigh) {
+      return;
+    }
+    for (s32 combination = 0; combination < 4; combination++) {
+      StateBC7 other;
+      EvaluateBC7(block, e0, e1, combination & 1, combination >> 1, other);
+      if (other.error < state.error) {
+        state = other;
+      }
+    }
+  };
+  StateBC7 best;
+  Evaluate(best);
+  for (u32 i = 0; i < GetRefineCount(quality) && best.error > 0.0f; i++) {
+    if (!RefineEndpoints(block, 4, best.indices, sWeights, e0, e1)) {
+      break;
+    }
+    StateBC7 state;
+    Evaluate(state);
+    if (state.error >= best.error) {
+      break;
+    }
+    best = state;
+  }
+
+  // The highest bit of the index of the first pixel is implicitly zero. If it
+  // would be one then the endpoints are swapped, which inverts the indices
+  if (best.indices[0] >= 8) {
+    for (u32 c = 0; c < 4; c++) {
+      std::swap(best.endpoints[0][c], best.endpoints[1][c]);
+    }
+    std::swap(best.pbits[0], best.pbits[1]);
+    for (u8& index : best.indices) {
+      index = u8(15 - index);
+    }
+  }
+
+  // Write block
+  Memory::Clear(destination, 16);
+  u32 offset = 0;
+  WriteBits(destination, offset, 1u << 6, 7);
+  for (u32 c = 0; c < 4; c++) {
+    WriteBits(destination, offset, best.endpoints[0][c], 7);
+    WriteBits(destination, offset, best.endpoints[1][c], 7);
+  }
+  WriteBits(destination, offset, best.pbits[0], 1);
+  WriteBits(destination, offset, best.pbits[1], 1);
+  WriteBits(destination, offset, best.indices[0], 3);
+  for (u32 i = 1; i < kBlockPixels; i++) {
+    WriteBits(destination, offset, best.indices[i], 4);
+  }
+}
+
+}
+
+// ========================================================================== //
+// BlockCompressor Implementation
+// ========================================================================== //
+
+namespace olivine {
+
+BlockCompressor::BlockCompressor(Format format, Quality quality)
+  : mFormat(format)
+  , mQuality(quality)
+{
+  Assert(IsCompressed(format),
+         "Block compressor can only encode block-compressed formats");
+}
+
+// -------------------------------------------------------------------------- //
+
+void
+BlockCompressor::Compress(const Image& image,
+                          u32 mipLevel,
+                          u8* destination,
+                          u64 rowStride) const
+{
+  const u32 width = image.GetMipWidth(mipLevel);
+  const u32 height = image.GetMipHeight(mipLevel);
+  const u32 blocksX = (width + kBlockDim - 1) / kBlockDim;
+  const u32 blocksY = (height + kBlockDim - 1) / kBlockDim;
+  const u32 blockSize = GetBlockSize(mFormat);
+
+  // Compress rows of blocks. The pixels of each block are fetched as RGBA
+  // through a view that is specialized for the format of the image. Blocks
+  // that extend past the edges repeat the last column and row
+  auto CompressRows = [&](u32 begin, u32 end) {
+    VisitImageView(image, mipLevel, [&](auto view) {
+      using View = decltype(view);
+      const u8* rows[kBlockDim];
+      u8 block[kBlockDim * kBlockDim * 4];
+      for (u32 by = begin; by < end; by++) {
+        for (u32 r = 0; r < kBlockDim; r++) {
+          rows[r] = view.GetRow(Min(by * kBlockDim + r, height - 1)).GetData();
+        }
+        for (u32 bx = 0; bx < blocksX; bx++) {
+          u8* pixel = block;
+          for (u32 r = 0; r < kBlockDim; r++) {
+            for (u32 c = 0; c < kBlockDim; c++, pixel += 4) {
+              const u64 x = Min(bx * kBlockDim + c, width - 1);
+              View::LoadRGBA(rows[r] + x * View::Layout::kSize, pixel);
+            }
+          }
+          EncodeBlock(block,
+                      destination + rowStride * by + u64(bx) * blockSize);
+        }
+      }
+    });
+  };
+
+  // Split large levels into bands of block rows
+  const u64 blockCount = u64(blocksX) * blocksY;
+  if (blockCount < kParallelThreshold) {
+    CompressRows(0, blocksY);
+    return;
+  }
+  ThreadPool& pool = ThreadPool::GetGlobal();
+  const u64 bandCount = Min(u64(blocksY), u64(pool.GetThreadCount()) * 4);
+  pool.ParallelFor(bandCount, [&](u64 band) {
+    CompressRows(u32(blocksY * band / bandCount),
+                 u32(blocksY * (band + 1) / bandCount));
+  });
+}
+
+// -------------------------------------------------------------------------- //
+
+void
+BlockCompressor::Compress(const Image& image, u8* destination) const
+{
+  for (u32 level = 0; level < image.GetMipLevels(); level++) {
+    const u32 width = image.GetMipWidth(level);
+    const u32 height = image.GetMipHeight(level);
+    const u64 rowStride =
+      u64((width + kBlockDim - 1) / kBlockDim) * GetBlockSize(mFormat);
+    Compress(image, level, destination, rowStride);
+    destination += GetCompressedSize(mFormat, width, height);
+  }
+}
+
+// -------------------------------------------------------------------------- //
+
+bool
+BlockCompressor::IsCompressed(Format format)
+{
+  return GetBlockSize(format) != 0;
+}
+
+// -------------------------------------------------------------------------- //
+
+u32
+BlockCompressor::GetBlockSize(Format format)
+{
+  switch (format) {
+    case Format::kBC1Unorm:
+    case Format::kBC4Unorm: {
+      return 8;
+    }
+    case Format::kBC3Unorm:
+    case Format::kBC5Unorm:
+    case Format::kBC7Unorm: {
+      return 16;
+    }
+    default: {
+      return 0;
+    }
+  }
+}
+
+// -------------------------------------------------------------------------- //
+
+u64
+BlockCompressor::GetCompressedSize(Format format, u32 width, u32 height)
+{
+  const u64 blocksX = (width + kBlockDim - 1) / kBlockDim;
+  const u64 blocksY = (height + kBlockDim - 1) / kBlockDim;
+  return blocksX * blocksY * GetBlockSize(format);
+}
+
+// -------------------------------------------------------------------------- //
+
+u64
+BlockCompressor::GetCompressedSize(Format format, const Image& image)
+{
+  u64 size = 0;
+  for (u32 level = 0; level < image.GetMipLevels(); level++) {
+    size += GetCompressedSize(
+      format, image.GetMipWidth(level), image.GetMipHeight(level));
+  }
+  return size;
+}
+
+// -------------------------------------------------------------------------- //
+
+void
+BlockCompressor::EncodeBlock(const u8* pixels, u8* destination) const
+{
+  // Separate the channels of the block
+  Block block;
+  for (u32 i = 0; i < kBlockPixels; i++) {
+    for (u32 c = 0; c < 4; c++) {
+      block.channels[c][i] = pixels[i * 4 + c];
+    }
+  }
+
+  switch (mFormat) {
+    case Format::kBC1Unorm: {
+      EncodeBC1(block, mQuality, destination);
+      break;
+    }
+    case Format::kBC3Unorm: {
+      EncodeBC4(block.channels[3], mQuality, destination);
+      EncodeBC1(block, mQuality, destination + 8);
+      break;
+    }
+    case Format::kBC4Unorm: {
+      EncodeBC4(block.channels[0], mQuality, destination);
+      break;
+    }
+    case Format::kBC5Unorm: {
+      EncodeBC4(block.channels[0], mQuality, destination);
+      EncodeBC4(block.channels[1], mQuality, destination + 8);
+      break;
+    }
+    case Format::kBC7Unorm: {
+      EncodeBC7(block, mQuality, destination);
+      break;
+    }
+    default: {
+      Panic("Invalid block-compressed format");
+    }
+  }
+}
+
+}
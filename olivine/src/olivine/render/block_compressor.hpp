@@ -0,0 +1,165 @@
+// MIT License
+//
+// Copyright (c) 2019 Filip Björklund
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+// ========================================================================== //
+// Headers
+// ========================================================================== //
+
+// Project headers
+#include "olivine/core/types.hpp"
+#include "olivine/core/macros.hpp"
+#include "olivine/render/format.hpp"
+
+// ========================================================================== //
+// BlockCompressor Declaration
+// ========================================================================== //
+
+namespace olivine {
+
+class Image;
+
+/** \class BlockCompressor
+ * \author Filip Björklund
+ * \date 19 october 2026 - 00:40
+ * \brief Encoder of block-compressed texture data.
+ * \details
+ * Encodes the pixels of an 'Image' into one of the block-compressed formats
+ * BC1, BC3, BC4, BC5 or BC7. The pixels are first converted to RGBA. BC1
+ * encodes RGB, BC3 and BC7 encode RGBA, BC4 encodes red and BC5 encodes red
+ * and green. BC7 is encoded with mode 6, which has a single pair of RGBA
+ * endpoints and 16 levels between them.
+ *
+ * The quality determines how the endpoints of each block are chosen. The fast
+ * preset uses the bounding box of the block. The other presets use the
+ * principal axis of the block, and then refine the endpoints by least squares
+ * fitting to the chosen indices as long as the error decreases. The closest
+ * palette entries of the pixels are found with SSE2, four pixels at a time.
+ * Large levels are split into bands of block rows that are run on the global
+ * thread pool.
+ *
+ * Blocks at the right and bottom edges of levels whose size is not a multiple
+ * of four are padded by repeating the last column and row.
+ */
+class BlockCompressor
+{
+public:
+  /** Quality presets **/
+  enum class Quality
+  {
+    /** Bounding box endpoints **/
+    kFast,
+    /** Principal axis endpoints with one refinement **/
+    kNormal,
+    /** Principal axis endpoints with multiple refinements, and an exhaustive
+     * search of the BC7 endpoint bits **/
+    kHigh
+  };
+
+  /** Width and height of a block in pixels **/
+  static constexpr u32 kBlockDim = 4;
+
+  /** Number of blocks in a level above which it's split across threads **/
+  static constexpr u64 kParallelThreshold = 1024;
+
+private:
+  /** Format to encode to **/
+  Format mFormat;
+  /** Quality preset **/
+  Quality mQuality;
+
+public:
+  /** Create a compressor for a block-compressed format.
+   * \brief Create compressor.
+   * \param format Format to encode to. This must be a format for which
+   * 'BlockCompressor::IsCompressed' returns true.
+   * \param quality Quality preset.
+   */
+  explicit BlockCompressor(Format format, Quality quality = Quality::kNormal);
+
+  /** Compress a mip level of an image. The rows of blocks are written with the
+   * specified stride, which can be the row stride of a texture footprint.
+   * \brief Compress mip level.
+   * \param image Image to compress.
+   * \param mipLevel Mip level of the image to compress.
+   * \param destination Destination of the first row of blocks.
+   * \param rowStride Distance between the rows of blocks in bytes.
+   */
+  void Compress(const Image& image,
+                u32 mipLevel,
+                u8* destination,
+                u64 rowStride) const;
+
+  /** Compress all mip levels of an image. The levels are written after each
+   * other with tightly packed rows of blocks. The destination must be at least
+   * 'BlockCompressor::GetCompressedSize' bytes large.
+   * \brief Compress mip chain.
+   * \param image Image to compress.
+   * \param destination Destination of the compressed data.
+   */
+  void Compress(const Image& image, u8* destination) const;
+
+  /** Returns the format that is encoded to.
+   * \brief Returns format.
+   * \return Format.
+   */
+  OL_NODISCARD Format GetFormat() const { return mFormat; }
+
+  /** Returns whether a format is block-compressed.
+   * \brief Returns whether format is compressed.
+   * \param format Format to check.
+   * \return True if the format is block-compressed otherwise false.
+   */
+  static bool IsCompressed(Format format);
+
+  /** Returns the size in bytes of a block of a block-compressed format.
+   * \brief Returns block size.
+   * \param format Block-compressed format.
+   * \return Size of a block in bytes.
+   */
+  static u32 GetBlockSize(Format format);
+
+  /** Returns the size of the compressed data of a single level, with tightly
+   * packed rows of blocks.
+   * \brief Returns compressed level size.
+   * \param format Block-compressed format.
+   * \param width Width of the level in pixels.
+   * \param height Height of the level in pixels.
+   * \return Size in bytes.
+   */
+  static u64 GetCompressedSize(Format format, u32 width, u32 height);
+
+  /** Returns the size of the compressed data of all mip levels of an image.
+   * \brief Returns compressed chain size.
+   * \param format Block-compressed format.
+   * \param image Image to compress.
+   * \return Size in bytes.
+   */
+  static u64 GetCompressedSize(Format format, const Image& image);
+
+private:
+  /** Encode a block of 4x4 RGBA pixels **/
+  void EncodeBlock(const u8* pixels, u8* destination) const;
+};
+
+}
@@ -54,6 +54,18 @@ enum class Format : u32
   kR8G8B8A8Unorm,
   /** 8-bit BGRA, unsigned and normalized **/
   kB8G8R8A8Unorm,
+  /** Block-compressed RGB with 565 endpoints, unsigned and normalized **/
+  kBC1Unorm,
+  /** Block-compressed RGBA with BC1 color and BC4 alpha, unsigned and
+   * normalized **/
+  kBC3Unorm,
+  /** Block-compressed R, unsigned and normalized **/
+  kBC4Unorm,
+  /** Block-compressed RG with two BC4 channels, unsigned and normalized **/
+  kBC5Unorm,
+  /** Block-compressed RGBA with high precision endpoints, unsigned and
+   * normalized **/
+  kBC7Unorm,
 
   /** 32-bit depth float **/
   kD32Float,
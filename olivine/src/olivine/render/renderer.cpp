@@ -187,7 +187,10 @@ Renderer::SetupPSO()
   RootSignature::StaticSampler staticSampler0;
   staticSampler0.reg = 0;
   staticSampler0.accessibleStages = ShaderStage::kPixel;
+  staticSampler0.minFilter = Sampler::Filter::kLinear;
   staticSampler0.magFilter = Sampler::Filter::kLinear;
+  staticSampler0.mipFilter = Sampler::Filter::kLinear;
+  staticSampler0.maxLOD = D3D12_FLOAT32_MAX;
   rootSignatureInfo.staticSamplers.push_back(staticSampler0);
   mRootSignature = new RootSignature(rootSignatureInfo);
 
@@ -27,9 +27,31 @@
 // ========================================================================== //
 
 // Project headers
+#include "olivine/core/thread_pool.hpp"
+#include "olivine/core/file/metadata_cache.hpp"
+#include "olivine/render/api/upload.hpp"
 #include "olivine/render/scene/model.hpp"
 #include "olivine/render/scene/material.hpp"
 
+// ========================================================================== //
+// Functions
+// ========================================================================== //
+
+namespace olivine {
+
+/** Returns the directory that is watched for changes to a file **/
+static Path
+GetWatchedDirectory(const Path& file)
+{
+  const Path directory = file.GetDirectory();
+  if (directory.GetPathString().IsEmpty()) {
+    return Path{ "." };
+  }
+  return directory;
+}
+
+}
+
 // ========================================================================== //
 // Loader Implementation
 // ========================================================================== //
@@ -40,22 +62,28 @@ Loader::Loader()
 {
   mSrvHeap = new DescriptorHeap(
     Descriptor::Kind::kCbvSrvUav, SRV_PER_MAT * MAX_MAT, false);
+
+  // The watcher invalidates the cached metadata of the resource files when
+  // they change, so the metadata can be cached while the loader is alive
+  MetadataCache::SetEnabled(true);
 }
 
 // -------------------------------------------------------------------------- //
 
 Loader::~Loader()
 {
-  for (std::pair<String, MatRef> elem : mMaterials) {
+  for (auto& elem : mMaterials) {
     MatRef& ref = elem.second;
     delete ref.material;
   }
-  for (std::pair<String, ModelRef> elem : mModels) {
+  for (auto& elem : mModels) {
     ModelRef& ref = elem.second;
     delete ref.model;
   }
 
   delete mSrvHeap;
+
+  MetadataCache::SetEnabled(false);
 }
 
 // -------------------------------------------------------------------------- //
@@ -63,33 +91,178 @@ Loader::~Loader()
 void
 Loader::Load(CommandQueue* queue, CommandList* list)
 {
-  // Upload materials
-  for (std::pair<String, MatRef> elem : mMaterials) {
-    elem.second.material->Upload(queue, list);
+  // Reload models from file. This can add materials, which are then loaded
+  // below
+  for (auto& elem : mModels) {
+    ModelRef& ref = elem.second;
+    if (ref.reload) {
+      ref.reload = false;
+      if (ref.model->Reload(this) == Model::Error::kSuccess) {
+        Watch(ref.model->GetSources());
+        ref.upload = true;
+      }
+    }
   }
+
+  // Collect the images of the materials to upload. Materials often use the
+  // same texture files, so each file is only read and decoded by the first
+  // material that uses it. The decoded image is then shared by the others
+  struct ImageJob
+  {
+    Material* material;
+    Material::Slot slot;
+    Image image;
+    Image::Result result;
+  };
+  struct ImageUse
+  {
+    Material* material;
+    Material::Slot slot;
+    u64 job;
+  };
+  std::vector<MatRef*> matRefs;
+  std::vector<ImageJob> jobs;
+  std::vector<ImageUse> uses;
+  // Jobs are looked up by path, separately for each color space. The mipmaps
+  // depend on the color space, so a file that is used both as albedo and in
+  // another slot is decoded twice
+  std::unordered_map<StringView, u64> jobIndices[2];
+  for (auto& elem : mMaterials) {
+    MatRef& ref = elem.second;
+    if (!ref.upload) {
+      continue;
+    }
+    ref.upload = false;
+    matRefs.push_back(&ref);
+    for (u32 index = 0; index < Material::kSlotCount; index++) {
+      const Material::Slot slot = Material::Slot(index);
+      const String& path = ref.material->GetSource(slot).GetPathString();
+      if (path.IsEmpty()) {
+        continue;
+      }
+      auto& indices = jobIndices[u32(Material::GetColorSpace(slot))];
+      const auto job = indices.find(path.GetView());
+      if (job != indices.end()) {
+        uses.push_back(ImageUse{ ref.material, slot, job->second });
+        continue;
+      }
+      indices.emplace(path.GetView(), jobs.size());
+      uses.push_back(ImageUse{ ref.material, slot, jobs.size() });
+      jobs.push_back(
+        ImageJob{ ref.material, slot, Image{}, Image::Result::kUnknownError });
+    }
+  }
+
+  // Read the texture files in a single batch, so that the reads are in flight
+  // together instead of one file at a time
+  std::vector<AsyncIO::Request> requests;
+  for (ImageJob& job : jobs) {
+    job.material->AddReadRequest(job.slot, requests);
+  }
+  mAsyncIO.Submit(std::move(requests));
+  mAsyncIO.Wait();
+
+  // Decode the images in parallel, hand them to the materials that use them
+  // and then upload them to the GPU in a single batch
+  ThreadPool::GetGlobal().ParallelFor(jobs.size(), [&](u64 index) {
+    ImageJob& job = jobs[index];
+    job.result = job.material->DecodeImage(job.slot, job.image);
+  });
+  for (const ImageUse& use : uses) {
+    const ImageJob& job = jobs[use.job];
+    use.material->SetImage(use.slot, job.image, job.result);
+  }
+  jobs.clear();
+  std::vector<UploadManager::TextureUpload> uploads;
+  for (MatRef* matRef : matRefs) {
+    matRef->material->CreateTextures(uploads);
+  }
+  UploadManager::Upload(queue, list, uploads);
+
+  // Release the images and write the descriptors of the materials
+  for (MatRef* matRef : matRefs) {
+    matRef->material->ReleaseImages();
+    mSrvHeap->WriteDescriptorSRV(matRef->idxStart,
+                                 matRef->material->GetAlbedoTexture());
+    if (matRef->material->GetRoughnessTexture()) {
+      mSrvHeap->WriteDescriptorSRV(matRef->idxStart + 1,
+                                   matRef->material->GetRoughnessTexture());
+    }
+    if (matRef->material->GetMetallicTexture()) {
+      mSrvHeap->WriteDescriptorSRV(matRef->idxStart + 2,
+                                   matRef->material->GetMetallicTexture());
+    }
+    if (matRef->material->GetNormalTexture()) {
+      mSrvHeap->WriteDescriptorSRV(matRef->idxStart + 3,
+                                   matRef->material->GetNormalTexture());
+    }
+  }
+
   // Upload models
-  for (std::pair<String, ModelRef> elem : mModels) {
-    elem.second.model->Upload(queue, list);
-  }
-
-  // Write material descriptors
-  for (std::pair<String, MatRef> elem : mMaterials) {
-    MatRef& matRef = elem.second;
-    mSrvHeap->WriteDescriptorSRV(matRef.idxStart,
-                                 matRef.material->GetAlbedoTexture());
-    if (matRef.material->GetRoughnessTexture()) {
-      mSrvHeap->WriteDescriptorSRV(matRef.idxStart + 1,
-                                   matRef.material->GetRoughnessTexture());
+  for (auto& elem : mModels) {
+    ModelRef& ref = elem.second;
+    if (ref.upload) {
+      ref.upload = false;
+      ref.model->Upload(queue, list);
     }
-    if (matRef.material->GetMetallicTexture()) {
-      mSrvHeap->WriteDescriptorSRV(matRef.idxStart + 2,
-                                   matRef.material->GetAlbedoTexture());
+  }
+}
+
+// -------------------------------------------------------------------------- //
+
+u32
+Loader::PollChanges()
+{
+  // A directory that could not be read anymore is no longer watched. Try to
+  // watch it again, which succeeds if it has been recreated
+  std::vector<FileWatcher::Event> events;
+  if (mWatcher.Poll(events) != FileResult::kSuccess) {
+    for (auto& elem : mModels) {
+      Watch(elem.second.model->GetSources());
     }
-    if (matRef.material->GetNormalTexture()) {
-      mSrvHeap->WriteDescriptorSRV(matRef.idxStart + 3,
-                                   matRef.material->GetNormalTexture());
+    for (auto& elem : mMaterials) {
+      Watch(elem.second.material->GetSources());
+    }
+  }
+  if (events.empty()) {
+    return 0;
+  }
+
+  // Returns whether any of the files has been created or modified. When the
+  // notifications of a directory was lost, all files in it might have been
+  const auto changed = [&events](const std::vector<Path>& files) {
+    for (const FileWatcher::Event& event : events) {
+      if (event.action == FileWatcher::Action::kDeleted) {
+        continue;
+      }
+      for (const Path& file : files) {
+        if (event.action == FileWatcher::Action::kRescan
+              ? GetWatchedDirectory(file) == event.path
+              : file == event.path) {
+          return true;
+        }
+      }
+    }
+    return false;
+  };
+
+  // Mark resources that depends on the changed files
+  u32 count = 0;
+  for (auto& elem : mModels) {
+    ModelRef& ref = elem.second;
+    if (!ref.reload && changed(ref.model->GetSources())) {
+      ref.reload = true;
+      count++;
+    }
+  }
+  for (auto& elem : mMaterials) {
+    MatRef& ref = elem.second;
+    if (!ref.upload && changed(ref.material->GetSources())) {
+      ref.upload = true;
+      count++;
     }
   }
+  return count;
 }
 
 // -------------------------------------------------------------------------- //
@@ -104,9 +277,22 @@ Loader::AddModel(const String& name, const Path& path)
     delete model;
     return Result::kUnknownError;
   }
+  Watch(model->GetSources());
+
+  // Replace model if one with the same name already exists
+  const auto obj = mModels.find(name);
+  if (obj != mModels.end()) {
+    delete obj->second.model;
+    obj->second.model = model;
+    obj->second.upload = true;
+    obj->second.reload = false;
+    return Result::kSuccess;
+  }
 
   // Add model
-  mModels[name] = ModelRef{ model };
+  std::unique_ptr<String> key = std::make_unique<String>(name);
+  const StringView view = key->GetView();
+  mModels.emplace(view, ModelRef{ model, std::move(key), true, false });
   return Result::kSuccess;
 }
 
@@ -119,9 +305,29 @@ Loader::AddMaterial(const String& name,
                     const Path& pathMetallic,
                     const Path& pathNormal)
 {
+  // Keep the existing material if it uses the same files. Models add all their
+  // materials again when they are reloaded, and changes to the texture files
+  // themselves are picked up by 'Loader::PollChanges'
+  const auto obj = mMaterials.find(name);
+  if (obj != mMaterials.end() &&
+      obj->second.material->HasSources(
+        pathAlbedo, pathRoughness, pathMetallic, pathNormal)) {
+    return Result::kSuccess;
+  }
+
   // Create material
   Material* material =
     new Material(name, pathAlbedo, pathRoughness, pathMetallic, pathNormal);
+  Watch(material->GetSources());
+
+  // Replace material if one with the same name already exists. The
+  // descriptors of the previous material are reused
+  if (obj != mMaterials.end()) {
+    delete obj->second.material;
+    obj->second.material = material;
+    obj->second.upload = true;
+    return Result::kSuccess;
+  }
 
   // Allocate descriptors
   const u32 idxAlbedo = mSrvHeap->Allocate();
@@ -136,14 +342,16 @@ Loader::AddMaterial(const String& name,
          "Normal SRV must be directly after metallic SRV");
 
   // Add material
-  mMaterials[name] = MatRef{ material, idxAlbedo };
+  std::unique_ptr<String> key = std::make_unique<String>(name);
+  const StringView view = key->GetView();
+  mMaterials.emplace(view, MatRef{ material, idxAlbedo, std::move(key), true });
   return Result::kSuccess;
 }
 
 // -------------------------------------------------------------------------- //
 
 Model*
-Loader::GetModel(const String& name)
+Loader::GetModel(StringView name)
 {
   const auto obj = mModels.find(name);
   if (obj == mModels.end()) {
@@ -155,7 +363,7 @@ Loader::GetModel(const String& name)
 // -------------------------------------------------------------------------- //
 
 const Model*
-Loader::GetModel(const String& name) const
+Loader::GetModel(StringView name) const
 {
   const auto obj = mModels.find(name);
   if (obj == mModels.end()) {
@@ -167,7 +375,7 @@ Loader::GetModel(const String& name) const
 // -------------------------------------------------------------------------- //
 
 Material*
-Loader::GetMaterial(const String& name)
+Loader::GetMaterial(StringView name)
 {
   const auto obj = mMaterials.find(name);
   if (obj == mMaterials.end()) {
@@ -179,7 +387,7 @@ Loader::GetMaterial(const String& name)
 // -------------------------------------------------------------------------- //
 
 const Material*
-Loader::GetMaterial(const String& name) const
+Loader::GetMaterial(StringView name) const
 {
   const auto obj = mMaterials.find(name);
   if (obj == mMaterials.end()) {
@@ -193,7 +401,7 @@ Loader::GetMaterial(const String& name) const
 u32
 Loader::GetMaterialSrvHeapOffset(const Material* material) const
 {
-  for (std::pair<String, MatRef> elem : mMaterials) {
+  for (const auto& elem : mMaterials) {
     if (elem.second.material == material) {
       return elem.second.idxStart;
     }
@@ -204,7 +412,7 @@ Loader::GetMaterialSrvHeapOffset(const Material* material) const
 // -------------------------------------------------------------------------- //
 
 u32
-Loader::GetMaterialSrvHeapOffset(const String& name) const
+Loader::GetMaterialSrvHeapOffset(StringView name) const
 {
   const auto obj = mMaterials.find(name);
   if (obj == mMaterials.end()) {
@@ -213,4 +421,16 @@ Loader::GetMaterialSrvHeapOffset(const String& name) const
   return obj->second.idxStart;
 }
 
+// -------------------------------------------------------------------------- //
+
+void
+Loader::Watch(const std::vector<Path>& files)
+{
+  // Watching is best-effort, resources in directories that cannot be watched
+  // are simply not reloaded
+  for (const Path& file : files) {
+    mWatcher.Watch(GetWatchedDirectory(file));
+  }
+}
+
 }
@@ -27,12 +27,16 @@
 // ========================================================================== //
 
 // Standard headers
+#include <memory>
 #include <unordered_map>
+#include <vector>
 
 // Project headers
 #include "olivine/core/types.hpp"
 #include "olivine/core/macros.hpp"
 #include "olivine/core/string.hpp"
+#include "olivine/core/file/async_io.hpp"
+#include "olivine/core/file/file_watcher.hpp"
 #include "olivine/render/api/descriptor.hpp"
 
 // ========================================================================== //
@@ -53,6 +57,12 @@ OL_FORWARD_DECLARE(CommandQueue);
  * \date 06 december 2019 - 12:51
  * \brief
  * \details
+ * The directories of the files that the models and materials are loaded from
+ * are watched for changes. Call 'Loader::PollChanges' to mark the resources
+ * whose files has changed, and then 'Loader::Load' to reload them.
+ *
+ * The 'MetadataCache' is enabled while a loader exists, since the watcher
+ * invalidates the cached metadata of the resource files when they change.
  */
 class Loader
 {
@@ -74,6 +84,14 @@ public:
   struct ModelRef
   {
     Model* model;
+    /* Name of the model. The key of the model map is a view of this. The
+     * string is on the heap so that moving the ref does not move the
+     * characters that the key views */
+    std::unique_ptr<String> name;
+    /* Whether the model must be uploaded on the next load */
+    bool upload;
+    /* Whether the model must be reloaded from file on the next load */
+    bool reload;
   };
 
   /* Material reference */
@@ -81,16 +99,26 @@ public:
   {
     Material* material;
     u32 idxStart;
+    /* Name of the material. The key of the material map is a view of this */
+    std::unique_ptr<String> name;
+    /* Whether the material must be uploaded on the next load */
+    bool upload;
   };
 
 private:
   /** Srv heap **/
   DescriptorHeap* mSrvHeap = nullptr;
-
-  /* Map of registered models */
-  std::unordered_map<String, ModelRef> mModels;
-  /* Map of registered materials */
-  std::unordered_map<String, MatRef> mMaterials;
+  /** Asynchronous IO engine for reading resource files **/
+  AsyncIO mAsyncIO;
+  /** Watcher of the directories of the resource files **/
+  FileWatcher mWatcher;
+
+  /* Map of registered models. Keys are views of the names owned by the refs,
+   * which lets lookups be done without allocating a 'String' */
+  std::unordered_map<StringView, ModelRef> mModels;
+  /* Map of registered materials. Keys are views of the names owned by the
+   * refs */
+  std::unordered_map<StringView, MatRef> mMaterials;
 
 public:
   Loader();
@@ -100,10 +128,22 @@ public:
   /** This functions triggers the loading of all the models and material from
    * disc. It also manages the uploading of data to the GPU for the resources
    * that requires it.
+   *
+   * Only resources that has been added or marked as changed since the last
+   * call are loaded. Resources that are reloaded replace their GPU resources,
+   * which means that the GPU must not be using them during the call.
    * \param
    */
   void Load(CommandQueue* queue, CommandList* list);
 
+  /** Poll the watcher for changes to the resource files, and mark the models
+   * and materials that depends on the changed files to be reloaded by the next
+   * call to 'Loader::Load'.
+   * \brief Poll for changed resources.
+   * \return Number of resources that was marked.
+   */
+  u32 PollChanges();
+
   /**
    *
    */
@@ -118,19 +158,23 @@ public:
                      const Path& pathMetallic,
                      const Path& pathNormal);
 
-  Model* GetModel(const String& name);
+  Model* GetModel(StringView name);
 
-  const Model* GetModel(const String& name) const;
+  const Model* GetModel(StringView name) const;
 
-  Material* GetMaterial(const String& name);
+  Material* GetMaterial(StringView name);
 
-  const Material* GetMaterial(const String& name) const;
+  const Material* GetMaterial(StringView name) const;
 
   const DescriptorHeap* GetSrvHeap() const { return mSrvHeap; }
 
   u32 GetMaterialSrvHeapOffset(const Material* material) const;
 
-  u32 GetMaterialSrvHeapOffset(const String& name) const;
+  u32 GetMaterialSrvHeapOffset(StringView name) const;
+
+private:
+  /* Watch the directories of the specified files */
+  void Watch(const std::vector<Path>& files);
 };
 
 using LoaderRes = Loader::Result;
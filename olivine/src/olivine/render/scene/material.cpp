@@ -27,9 +27,46 @@
 // ========================================================================== //
 
 // Project headers
+#include "olivine/core/console.hpp"
 #include "olivine/core/image.hpp"
+#include "olivine/core/thread_pool.hpp"
 #include "olivine/render/api/texture.hpp"
 #include "olivine/render/api/upload.hpp"
+#include "olivine/render/block_compressor.hpp"
+
+// ========================================================================== //
+// Functions
+// ========================================================================== //
+
+namespace olivine {
+
+/** Returns the texture format to upload an image as. Images whose size is a
+ * multiple of the block size are block-compressed, with BC4 for single-channel
+ * images and BC7 otherwise. Other single-channel images keep their layout,
+ * while other formats are converted to RGBA when they are uploaded **/
+static Format
+ToTextureFormat(const Image& image)
+{
+  const Image::Format format = image.GetFormat();
+  if (image.GetWidth() % BlockCompressor::kBlockDim == 0 &&
+      image.GetHeight() % BlockCompressor::kBlockDim == 0) {
+    return format == Image::Format::kRed ? Format::kBC4Unorm
+                                         : Format::kBC7Unorm;
+  }
+  switch (format) {
+    case Image::Format::kRed: {
+      return Format::kR8Unorm;
+    }
+    case Image::Format::kBGRA: {
+      return Format::kB8G8R8A8Unorm;
+    }
+    default: {
+      return Format::kR8G8B8A8Unorm;
+    }
+  }
+}
+
+}
 
 // ========================================================================== //
 // Material Implementation
@@ -53,6 +90,11 @@ Material::Material(const String& name,
 
 Material::~Material()
 {
+  for (FileData& file : mFileData) {
+    Memory::Free(file.data);
+  }
+  ReleaseImages();
+
   delete mTexAlbedo;
   delete mTexRoughness;
   delete mTexMetallic;
@@ -62,101 +104,205 @@ Material::~Material()
 // -------------------------------------------------------------------------- //
 
 void
-Material::Upload(CommandQueue* queue, CommandList* list)
+Material::AddReadRequest(Slot slot, std::vector<AsyncIO::Request>& requests)
 {
-  // Create albedo texture
-  {
-    Assert(!mPathAlbedo.GetPathString().IsEmpty(),
-           "Albedo path cannot be empty");
-    Image image;
-    const Image::Result result = image.Load(mPathAlbedo);
-    Assert(result == Image::Result::kSuccess,
-           "Failed to load albedo image ({})",
-           mPathAlbedo);
+  const Path& path = GetSource(slot);
+  const u32 index = u32(slot);
+  if (path.GetPathString().IsEmpty() || mFileData[index].data) {
+    return;
+  }
+  AsyncIO::Request request;
+  request.path = path;
+  request.callback = [this, index](AsyncIO::Completion& completion) {
+    if (completion.result == FileResult::kSuccess) {
+      mFileData[index] = FileData{ completion.data, completion.size };
+    } else {
+      Memory::Free(completion.data);
+    }
+  };
+  requests.push_back(std::move(request));
+}
 
-    Texture::CreateInfo texInfo;
-    texInfo.width = image.GetWidth();
-    texInfo.height = image.GetHeight();
-    texInfo.dimension = Texture::Dim::k2D;
-    texInfo.format = image.GetFormat() == Image::Format::kRGB
-                       ? Format::kInvalid
-                       : Format::kR8G8B8A8Unorm;
-    texInfo.heapKind = HeapKind::kDefault;
-    texInfo.usages = Texture::Usage::kShaderResource;
-    mTexAlbedo = new Texture(texInfo);
-    mTexAlbedo->SetName("mat_" + mName + "_albedo");
+// -------------------------------------------------------------------------- //
 
-    UploadManager::Upload(queue, list, mTexAlbedo, &image);
+Image::Result
+Material::DecodeImage(Slot slot, Image& image)
+{
+  const Image::Result result = LoadImage(slot, GetSource(slot), image);
+  if (result == Image::Result::kSuccess) {
+    image.GenerateMips(Image::MipFilter::kKaiser, GetColorSpace(slot));
   }
+  return result;
+}
+
+// -------------------------------------------------------------------------- //
+
+void
+Material::SetImage(Slot slot, const Image& image, Image::Result result)
+{
+  mImages[u32(slot)] = image;
+  mResults[u32(slot)] = result;
+}
+
+// -------------------------------------------------------------------------- //
 
-  // Create roughness texture
-  if (!mPathRoughness.GetPathString().IsEmpty()) {
-    Image image;
-    const Image::Result result = image.Load(mPathRoughness);
-    Assert(result == Image::Result::kSuccess,
-           "Failed to load roughness image ({})",
-           mPathRoughness);
+void
+Material::Decode()
+{
+  ThreadPool::GetGlobal().ParallelFor(kSlotCount, [&](u64 index) {
+    const Slot slot = Slot(index);
+    if (GetSource(slot).GetPathString().IsEmpty()) {
+      return;
+    }
+    mResults[index] = DecodeImage(slot, mImages[index]);
+  });
+}
 
+// -------------------------------------------------------------------------- //
+
+void
+Material::CreateTextures(std::vector<UploadManager::TextureUpload>& uploads)
+{
+  Assert(!mPathAlbedo.GetPathString().IsEmpty(),
+         "Albedo path cannot be empty");
+
+  const Path* paths[kSlotCount] = {
+    &mPathAlbedo, &mPathRoughness, &mPathMetallic, &mPathNormal
+  };
+  Texture** textures[kSlotCount] = {
+    &mTexAlbedo, &mTexRoughness, &mTexMetallic, &mTexNormal
+  };
+  const char8* suffixes[kSlotCount] = {
+    "albedo", "roughness", "metallic", "normal"
+  };
+  for (u32 slot = 0; slot < kSlotCount; slot++) {
+    if (paths[slot]->GetPathString().IsEmpty()) {
+      continue;
+    }
+
+    // Keep the previous texture if the image could not be loaded on a reload,
+    // the file might be in the middle of being written
+    Texture*& texture = *textures[slot];
+    if (mResults[slot] != Image::Result::kSuccess && texture) {
+      Console::WriteLine("Failed to reload {} image ({}), keeping old texture",
+                         suffixes[slot],
+                         paths[slot]->GetPathStringUTF8());
+      continue;
+    }
+    Assert(mResults[slot] == Image::Result::kSuccess,
+           "Failed to load {} image ({})",
+           suffixes[slot],
+           *paths[slot]);
+
+    const Image& image = mImages[slot];
     Texture::CreateInfo texInfo;
     texInfo.width = image.GetWidth();
     texInfo.height = image.GetHeight();
+    texInfo.mipLevels = image.GetMipLevels();
     texInfo.dimension = Texture::Dim::k2D;
-    texInfo.format = image.GetFormat() == Image::Format::kRGB
-                       ? Format::kInvalid
-                       : Format::kR8G8B8A8Unorm;
+    texInfo.format = ToTextureFormat(image);
     texInfo.heapKind = HeapKind::kDefault;
     texInfo.usages = Texture::Usage::kShaderResource;
-    mTexRoughness = new Texture(texInfo);
-    mTexRoughness->SetName("mat_" + mName + "_roughness");
+    delete texture;
+    texture = new Texture(texInfo);
+    texture->SetName("mat_" + mName + "_" + suffixes[slot]);
+    uploads.push_back(UploadManager::TextureUpload{ texture, &image });
+  }
+}
+
+// -------------------------------------------------------------------------- //
 
-    UploadManager::Upload(queue, list, mTexRoughness, &image);
+void
+Material::ReleaseImages()
+{
+  for (u32 slot = 0; slot < kSlotCount; slot++) {
+    mImages[slot] = Image{};
+    mResults[slot] = Image::Result::kUnknownError;
   }
+}
 
-  // Create metallic texture
-  if (!mPathMetallic.GetPathString().IsEmpty()) {
-    Image image;
-    const Image::Result result = image.Load(mPathMetallic);
-    Assert(result == Image::Result::kSuccess,
-           "Failed to load metallic image ({})",
-           mPathMetallic);
+// -------------------------------------------------------------------------- //
 
-    Texture::CreateInfo texInfo;
-    texInfo.width = image.GetWidth();
-    texInfo.height = image.GetHeight();
-    texInfo.dimension = Texture::Dim::k2D;
-    texInfo.format = image.GetFormat() == Image::Format::kRGB
-                       ? Format::kInvalid
-                       : Format::kR8G8B8A8Unorm;
-    texInfo.heapKind = HeapKind::kDefault;
-    texInfo.usages = Texture::Usage::kShaderResource;
-    mTexMetallic = new Texture(texInfo);
-    mTexMetallic->SetName("mat_" + mName + "_metallic");
+void
+Material::Upload(CommandQueue* queue, CommandList* list)
+{
+  Decode();
+  std::vector<UploadManager::TextureUpload> uploads;
+  CreateTextures(uploads);
+  UploadManager::Upload(queue, list, uploads);
+  ReleaseImages();
+}
+
+// -------------------------------------------------------------------------- //
+
+std::vector<Path>
+Material::GetSources() const
+{
+  std::vector<Path> sources;
+  for (const Path* path :
+       { &mPathAlbedo, &mPathRoughness, &mPathMetallic, &mPathNormal }) {
+    if (!path->GetPathString().IsEmpty()) {
+      sources.push_back(*path);
+    }
+  }
+  return sources;
+}
+
+// -------------------------------------------------------------------------- //
 
-    UploadManager::Upload(queue, list, mTexMetallic, &image);
+const Path&
+Material::GetSource(Slot slot) const
+{
+  switch (slot) {
+    case Slot::kAlbedo: {
+      return mPathAlbedo;
+    }
+    case Slot::kRoughness: {
+      return mPathRoughness;
+    }
+    case Slot::kMetallic: {
+      return mPathMetallic;
+    }
+    default: {
+      return mPathNormal;
+    }
   }
+}
 
-  // Create normal texture
-  if (!mPathNormal.GetPathString().IsEmpty()) {
-    Image image;
-    const Image::Result result = image.Load(mPathNormal);
-    Assert(result == Image::Result::kSuccess,
-           "Failed to load normal image ({})",
-           mPathNormal);
+// -------------------------------------------------------------------------- //
 
-    Texture::CreateInfo texInfo;
-    texInfo.width = image.GetWidth();
-    texInfo.height = image.GetHeight();
-    texInfo.dimension = Texture::Dim::k2D;
-    texInfo.format = image.GetFormat() == Image::Format::kRGB
-                       ? Format::kInvalid
-                       : Format::kR8G8B8A8Unorm;
-    texInfo.heapKind = HeapKind::kDefault;
-    texInfo.usages = Texture::Usage::kShaderResource;
-    mTexNormal = new Texture(texInfo);
-    mTexNormal->SetName("mat_" + mName + "_normal");
+Image::ColorSpace
+Material::GetColorSpace(Slot slot)
+{
+  return slot == Slot::kAlbedo ? Image::ColorSpace::kSRGB
+                               : Image::ColorSpace::kLinear;
+}
 
-    UploadManager::Upload(queue, list, mTexNormal, &image);
+// -------------------------------------------------------------------------- //
+
+bool
+Material::HasSources(const Path& pathAlbedo,
+                     const Path& pathRoughness,
+                     const Path& pathMetallic,
+                     const Path& pathNormal) const
+{
+  return mPathAlbedo == pathAlbedo && mPathRoughness == pathRoughness &&
+         mPathMetallic == pathMetallic && mPathNormal == pathNormal;
+}
+
+// -------------------------------------------------------------------------- //
+
+Image::Result
+Material::LoadImage(Slot slot, const Path& path, Image& image)
+{
+  FileData& file = mFileData[u32(slot)];
+  if (!file.data) {
+    return image.Load(path);
   }
+  const Image::Result result = image.Load(file.data, file.size);
+  Memory::Free(file.data);
+  file = FileData{};
+  return result;
 }
 
 }
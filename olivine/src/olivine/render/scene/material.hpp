@@ -26,10 +26,16 @@
 // Headers
 // ========================================================================== //
 
+// Standard headers
+#include <vector>
+
 // Project headers
 #include "olivine/core/macros.hpp"
 #include "olivine/core/string.hpp"
+#include "olivine/core/image.hpp"
+#include "olivine/core/file/async_io.hpp"
 #include "olivine/core/file/path.hpp"
+#include "olivine/render/api/upload.hpp"
 
 // ========================================================================== //
 // Material Declaration
@@ -49,7 +55,28 @@ OL_FORWARD_DECLARE(CommandQueue);
  */
 class Material
 {
+public:
+  /* Texture slots */
+  enum class Slot : u32
+  {
+    kAlbedo,
+    kRoughness,
+    kMetallic,
+    kNormal
+  };
+
+  /* Number of texture slots */
+  static constexpr u32 kSlotCount = 4;
+
 private:
+  /* Contents of a texture file that has been read ahead of the upload */
+  struct FileData
+  {
+    u8* data = nullptr;
+    u64 size = 0;
+  };
+
+
   /* Name of the material */
   String mName;
 
@@ -71,6 +98,14 @@ private:
   /* Normal texture */
   Texture* mTexNormal = nullptr;
 
+  /* Texture file contents, indexed by slot */
+  FileData mFileData[kSlotCount];
+  /* Images to upload, indexed by slot. These share their data with the images
+   * of other materials that use the same files */
+  Image mImages[kSlotCount];
+  /* Results of decoding the images, indexed by slot */
+  Image::Result mResults[kSlotCount] = {};
+
 public:
   Material(const String& name,
            const Path& pathAlbedo,
@@ -80,11 +115,103 @@ public:
 
   ~Material();
 
-  /**
-   *
+  /** Add a request for reading the texture file of a slot to a batch of
+   * requests. When the request has completed the material holds on to the file
+   * contents, so that 'Material::DecodeImage' does not have to read the file.
+   * \brief Add read request.
+   * \param slot Slot to read the file of.
+   * \param requests Batch to add the request to.
+   */
+  void AddReadRequest(Slot slot, std::vector<AsyncIO::Request>& requests);
+
+  /** Decode the image of a slot, from the file contents that was read ahead if
+   * available, and generate its mipmaps. Different slots can be decoded at the
+   * same time.
+   * \brief Decode image.
+   * \param slot Slot to decode the image of.
+   * \param image Image to decode into.
+   * \return Result of decoding the image.
+   */
+  Image::Result DecodeImage(Slot slot, Image& image);
+
+  /** Set the image of a slot to upload, instead of decoding it with
+   * 'Material::Decode'. This lets materials that use the same file share a
+   * single decoded image.
+   * \brief Set image.
+   * \param slot Slot to set the image of.
+   * \param image Image to set. The data is shared, not copied.
+   * \param result Result of decoding the image.
+   */
+  void SetImage(Slot slot, const Image& image, Image::Result result);
+
+  /** Decode the images of all slots of the material with
+   * 'Material::DecodeImage'. The images are decoded in parallel on the global
+   * thread pool. This does not touch the GPU, which
+   * means that multiple materials can be decoded at the same time.
+   * \brief Decode images.
+   */
+  void Decode();
+
+  /** Create the textures of the material for the images that was decoded by
+   * 'Material::Decode' or set by 'Material::SetImage', and add the uploads of
+   * the images to a batch. Textures that already exist are replaced, which
+   * means that the GPU must not be using them. If an image failed to load when
+   * its texture already exists then the previous texture is kept. The images
+   * must be kept until the batch has been uploaded.
+   * \brief Create textures.
+   * \param uploads Batch to add the uploads to.
+   */
+  void CreateTextures(std::vector<UploadManager::TextureUpload>& uploads);
+
+  /** Release the images of the material. Call this when
+   * the uploads from 'Material::CreateTextures' has completed.
+   * \brief Release images.
+   */
+  void ReleaseImages();
+
+  /** Decode the images of the material, create the textures and upload the
+   * images to them. See 'Material::Decode' and 'Material::CreateTextures'.
+   * \brief Upload textures.
+   * \param queue Queue to upload on.
+   * \param list List to record the upload in.
    */
   void Upload(CommandQueue* queue, CommandList* list);
 
+  /** Returns the paths of the texture files of the material.
+   * \brief Returns source files.
+   * \return Source files.
+   */
+  std::vector<Path> GetSources() const;
+
+  /** Returns the path of the texture file of a slot. The path is empty if the
+   * slot is not used.
+   * \brief Returns source file.
+   * \param slot Slot to return the path of.
+   * \return Source file.
+   */
+  const Path& GetSource(Slot slot) const;
+
+  /** Returns the color space of the image of a slot. Only the albedo holds
+   * sRGB encoded colors.
+   * \brief Returns color space.
+   * \param slot Slot to return the color space of.
+   * \return Color space.
+   */
+  static Image::ColorSpace GetColorSpace(Slot slot);
+
+  /** Returns whether the material uses the specified texture files.
+   * \brief Returns whether sources match.
+   * \param pathAlbedo Path to the albedo texture.
+   * \param pathRoughness Path to the roughness texture.
+   * \param pathMetallic Path to the metallic texture.
+   * \param pathNormal Path to the normal texture.
+   * \return True if the material uses the files otherwise false.
+   */
+  bool HasSources(const Path& pathAlbedo,
+                  const Path& pathRoughness,
+                  const Path& pathMetallic,
+                  const Path& pathNormal) const;
+
   Texture* GetAlbedoTexture() const { return mTexAlbedo; }
 
   Texture* GetRoughnessTexture() const { return mTexRoughness; }
@@ -92,6 +219,11 @@ public:
   Texture* GetMetallicTexture() const { return mTexMetallic; }
 
   Texture* GetNormalTexture() const { return mTexNormal; }
+
+private:
+  /* Load the image of a texture slot. This uses the contents that was read
+   * ahead if available, otherwise the file is read */
+  Image::Result LoadImage(Slot slot, const Path& path, Image& image);
 };
 
 }
\ No newline at end of file
@@ -26,9 +26,17 @@
 // Headers
 // ========================================================================== //
 
+// Standard headers
+#include <istream>
+#include <streambuf>
+#include <utility>
+#include <vector>
+
 // Project headers
 #include "olivine/core/assert.hpp"
+#include "olivine/core/file/mapped_file.hpp"
 #include "olivine/core/file/path.hpp"
+#include "olivine/core/file/vfs.hpp"
 #include "olivine/core/console.hpp"
 #include "olivine/core/image.hpp"
 #include "olivine/render/api/vertex_buffer.hpp"
@@ -45,6 +53,51 @@
 #define JSON_NOEXCEPTION
 #include "thirdparty/tinygltf/tiny_gltf.h"
 
+// ========================================================================== //
+// ResourceStreamBuf
+// ========================================================================== //
+
+namespace olivine {
+
+/** Read-only stream buffer over the data of a resource file. The data is taken
+ * from a mounted pack if the file is in one, otherwise the file is mapped. This
+ * lets the stream-based parsers read the data directly, instead of copying the
+ * file through the buffer of a file stream. Files that are compressed in a pack
+ * are decompressed into a buffer first **/
+class ResourceStreamBuf : public std::streambuf
+{
+private:
+  /** Mapped file, if the file is not in a pack **/
+  MappedFile mFile;
+  /** Decompressed data, if the file is compressed in a pack **/
+  std::vector<u8> mBuffer;
+
+public:
+  explicit ResourceStreamBuf(const Path& path)
+    : mFile(path)
+  {
+    VFS::File packed;
+    if (!VFS::Find(path.GetView(), packed)) {
+      mFile.Open();
+      mFile.Advise(MappedFile::Hint::kSequential | MappedFile::Hint::kWillNeed);
+      packed.data = mFile.GetData();
+      packed.size = mFile.GetSize();
+    } else if (!packed.data) {
+      mBuffer.resize(packed.size);
+      if (VFS::Read(packed, 0, packed.size, mBuffer.data()) !=
+          FileResult::kSuccess) {
+        mBuffer.clear();
+      }
+      packed.data = mBuffer.data();
+      packed.size = mBuffer.size();
+    }
+    char* begin = const_cast<char*>(reinterpret_cast<const char*>(packed.data));
+    setg(begin, begin, begin + packed.size);
+  }
+};
+
+}
+
 // ==========================================================================
 // // Model Implementation
 // ==========================================================================
@@ -55,7 +108,7 @@ namespace olivine {
 Model::~Model()
 {
   // Delete vertex and index data
-  delete mVertices;
+  delete[] mVertices;
   mVertices = nullptr;
 
   // Delete vertex buffer
@@ -82,6 +135,33 @@ Model::Load(Loader* loader, const Path& path)
 
 // -------------------------------------------------------------------------- //
 
+Model::Error
+Model::Reload(Loader* loader)
+{
+  if (mSources.empty()) {
+    return Error::kFileNotFound;
+  }
+
+  // Load into a separate model so that a file that fails to load, for example
+  // one that is being written, does not leave this model without data
+  Model model;
+  const Error error = model.Load(loader, mSources[0]);
+  if (error != Error::kSuccess) {
+    return error;
+  }
+
+  // Take the new data. The old data is deleted with the temporary model. The
+  // material is kept, as it might have been set with 'Model::SetMaterial'
+  std::swap(mName, model.mName);
+  std::swap(mVertices, model.mVertices);
+  std::swap(mVertexCount, model.mVertexCount);
+  std::swap(mVertexBuffer, model.mVertexBuffer);
+  std::swap(mSources, model.mSources);
+  return Error::kSuccess;
+}
+
+// -------------------------------------------------------------------------- //
+
 void
 Model::Upload(CommandQueue* queue, CommandList* list)
 {
@@ -104,10 +184,12 @@ Model::LoadObj(Loader* loader, const Path& path)
   {
   private:
     Path mDirectory;
+    std::vector<Path>* mSources;
 
   public:
-    explicit MatReader(const Path& directory)
+    MatReader(const Path& directory, std::vector<Path>* sources)
       : mDirectory(directory)
+      , mSources(sources)
     {}
 
     /* Called to load material */
@@ -117,23 +199,26 @@ Model::LoadObj(Loader* loader, const Path& path)
                     std::string* warn,
                     std::string* err) override
     {
-      const Path path = mDirectory + matId.c_str();
-      std::ifstream handle(path.GetPathStringUTF8(), std::ios::in);
+      mSources->push_back(mDirectory + matId.c_str());
+      ResourceStreamBuf buffer(mSources->back());
+      std::istream handle(&buffer);
       std::string warning, error;
       tinyobj::LoadMtl(matMap, materials, &handle, &warning, &error);
       return true;
     }
   };
 
-  // Open stream
-  std::ifstream handle(path.GetPathStringUTF8(), std::ios::in);
+  // Open stream over the file data
+  mSources.push_back(path);
+  ResourceStreamBuf buffer(path);
+  std::istream handle(&buffer);
 
   // Read file
   tinyobj::attrib_t attrib;
   std::vector<tinyobj::shape_t> shapes;
   std::vector<tinyobj::material_t> materials;
   std::string warning, error;
-  MatReader materialReader(path.GetDirectory());
+  MatReader materialReader(path.GetDirectory(), &mSources);
 
   bool ret = tinyobj::LoadObj(&attrib,
                               &shapes,
@@ -154,12 +239,11 @@ Model::LoadObj(Loader* loader, const Path& path)
     Console::WriteLine(
       "Error while loading model ({}): {}", path.GetPathStringUTF8(), warning);
   }
-  if (!ret) {
+  if (!ret || shapes.empty()) {
     Console::WriteLine("Failed to load model {}", path.GetPathStringUTF8());
+    return Error::kInvalidFileType;
   }
 
-  Assert(shapes.size() > 0, "Model does not contains any meshes");
-
   // Set name
   mName = String::Format("Model({})", shapes[0].name);
 
@@ -187,26 +271,27 @@ Model::LoadObj(Loader* loader, const Path& path)
     new VertexBuffer(sizeof(Vertex) * mVertexCount, sizeof(Vertex));
   mVertexBuffer->SetName(mName + "VB");
 
-  // Load material
-  for (auto material : materials) {
+  // Load material. Texture paths are relative to the directory of the model
+  const Path directory = path.GetDirectory();
+  for (const tinyobj::material_t& material : materials) {
     Path p0 = { "" };
     if (!material.diffuse_texname.empty()) {
-      p0 = path.GetDirectory() + material.diffuse_texname.c_str();
+      p0 = directory + material.diffuse_texname.c_str();
     }
 
     Path p1 = { "" };
     if (!material.roughness_texname.empty()) {
-      p1 = path.GetDirectory() + material.roughness_texname.c_str();
+      p1 = directory + material.roughness_texname.c_str();
     }
 
     Path p2 = { "" };
     if (!material.metallic_texname.empty()) {
-      p2 = path.GetDirectory() + material.metallic_texname.c_str();
+      p2 = directory + material.metallic_texname.c_str();
     }
 
     Path p3 = { "" };
     if (!material.normal_texname.empty()) {
-      p3 = path.GetDirectory() + material.normal_texname.c_str();
+      p3 = directory + material.normal_texname.c_str();
     }
 
     loader->AddMaterial(material.name.c_str(), p0, p1, p2, p3);
@@ -26,7 +26,11 @@
 // Headers
 // ========================================================================== //
 
+// Standard headers
+#include <vector>
+
 // Project heeaders
+#include "olivine/core/file/path.hpp"
 #include "olivine/core/macros.hpp"
 #include "olivine/core/string.hpp"
 #include "olivine/math/vector2f.hpp"
@@ -41,7 +45,6 @@ namespace olivine {
 OL_FORWARD_DECLARE(VertexBuffer);
 OL_FORWARD_DECLARE(IndexBuffer);
 OL_FORWARD_DECLARE(Texture);
-OL_FORWARD_DECLARE(Path);
 OL_FORWARD_DECLARE(CommandList);
 OL_FORWARD_DECLARE(CommandQueue);
 
@@ -88,11 +91,15 @@ private:
   /* Vertex data */
   Vertex* mVertices = nullptr;
   /* Number of vertices */
-  u32 mVertexCount;
+  u32 mVertexCount = 0;
 
   /* Vertex buffer */
   VertexBuffer* mVertexBuffer = nullptr;
 
+  /* Files that the model was loaded from. The model file is first, followed
+   * by the material libraries that it references */
+  std::vector<Path> mSources;
+
 public:
   /**
    *
@@ -106,6 +113,16 @@ public:
 
   Error Load(Loader* loader, const Path& path);
 
+  /** Load the model again from the file that it was loaded from. The model is
+   * only changed if the file could be loaded, otherwise the previous data is
+   * kept. The vertex buffer is replaced, which means that the model must be
+   * uploaded again and that the GPU must not be using the old buffer.
+   * \brief Reload model.
+   * \param loader Loader to add the materials of the model to.
+   * \return Error.
+   */
+  Error Reload(Loader* loader);
+
   /**
    *
    */
@@ -131,6 +148,12 @@ public:
    */
   void SetMaterial(const String& name) { mMaterialName = name; }
 
+  /** Returns the files that the model was loaded from.
+   * \brief Returns source files.
+   * \return Source files.
+   */
+  const std::vector<Path>& GetSources() const { return mSources; }
+
 private:
   Error LoadObj(Loader* loader, const Path& path);
 
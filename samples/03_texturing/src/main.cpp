@@ -22,6 +22,7 @@
 
 #include <olivine/app/app.hpp>
 #include <olivine/core/console.hpp>
+#include <olivine/core/file/mapped_file.hpp>
 #include <olivine/core/file/path.hpp>
 #include <olivine/core/image.hpp>
 #include <olivine/math/vector2f.hpp>
@@ -184,20 +185,29 @@ public:
     mIndexBuffer->Write(indices, 6);
     mIndexBuffer->SetName("MainIndexBuffer");
 
-    // Create and upload texture
-    Image image;
-    Image::Result imageResult = image.Load({ "res/texture.png" });
+    // Create texture and decode the image straight into the upload buffer
+    MappedFile imageFile(Path{ "res/texture.png" });
+    const FileResult fileResult = imageFile.Open();
+    Assert(fileResult == FileResult::kSuccess, "Failed to read image");
+    Image::Info imageInfo;
+    Image::Result imageResult = Image::GetInfo(
+      imageFile.GetData(), imageFile.GetSize(), imageInfo);
     Assert(imageResult == Image::Result::kSuccess, "Failed to load image");
     Texture::CreateInfo textureInfo;
-    textureInfo.width = image.GetWidth();
-    textureInfo.height = image.GetHeight();
+    textureInfo.width = imageInfo.width;
+    textureInfo.height = imageInfo.height;
     textureInfo.dimension = Texture::Dim::k2D;
     textureInfo.format = Format::kR8G8B8A8Unorm;
     textureInfo.usages = Texture::Usage::kShaderResource;
     textureInfo.heapKind = HeapKind::kDefault;
     mTexture = new Texture(textureInfo);
     mTexture->SetName("MainTexture");
-    UploadManager::Upload(GetCopyQueue(), mUploadList, mTexture, &image);
+    const bool uploaded = UploadManager::Upload(GetCopyQueue(),
+                                                mUploadList,
+                                                mTexture,
+                                                imageFile.GetData(),
+                                                imageFile.GetSize());
+    Assert(uploaded, "Failed to upload image");
 
     // Create SRV heap
     mHeapSRV = new DescriptorHeap(Descriptor::Kind::kCbvSrvUav, 1, true);
@@ -22,6 +22,7 @@
 
 #include <olivine/app/app.hpp>
 #include <olivine/core/console.hpp>
+#include <olivine/core/file/access_trace.hpp>
 #include <olivine/core/file/path.hpp>
 #include <olivine/core/image.hpp>
 #include <olivine/core/time.hpp>
@@ -197,6 +198,17 @@ public:
     GetSwapChain()->Present();
   }
 
+  /* Update */
+  void Update(f64 delta) override
+  {
+    // Reload resources whose files has changed. The queues are flushed first
+    // as the reloaded resources replace the ones that are in use
+    if (mScene->GetLoader()->PollChanges() > 0) {
+      FlushQueues();
+      mScene->Load(GetCopyQueue(), mUploadList);
+    }
+  }
+
   /* Update (Fixed) */
   void FixedUpdate() override
   {
@@ -224,7 +236,16 @@ main()
   appInfo.window.height = 720;
   appInfo.flags = App::Flag::kExitOnEscape;
   appInfo.toggleFullscreenKey = Key::kF;
+
+  // Prefetch the files that was read while loading during the last run, and
+  // record the reads of this run for the next one
+  const Path trace{ "res/startup.trace" };
+  Prefetcher prefetcher;
+  prefetcher.Start(trace);
+  AccessTrace::StartRecording();
   Sample app(appInfo);
+  AccessTrace::StopRecording(trace);
+  prefetcher.Stop();
 
   // Run app
   app.Run();
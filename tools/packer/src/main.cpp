@@ -0,0 +1,126 @@
+// MIT License
+//
+// Copyright (c) 2019 Filip Björklund
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include <olivine/core/console.hpp>
+#include <olivine/core/file/file_system.hpp>
+#include <olivine/core/file/pack.hpp>
+
+// ========================================================================== //
+// Packer
+// ========================================================================== //
+
+using namespace olivine;
+
+/** File to pack **/
+struct Input
+{
+  /** Name in the pack, relative to the input directory **/
+  String name;
+  /** Path of the file **/
+  Path path;
+};
+
+/** Collect the files in a directory and its subdirectories **/
+static void
+Collect(const Path& directory, const String& prefix, std::vector<Input>& inputs)
+{
+  const ArrayList<Path> entries = FileSystem::Enumerate(directory);
+  for (u32 i = 0; i < entries.GetSize(); i++) {
+    const Path path = directory.Joined(entries[i]);
+    const String name = prefix + entries[i].GetPathString();
+    switch (FileSystem::GetType(path)) {
+      case FileSystem::ObjectType::kFile: {
+        inputs.push_back(Input{ name, path });
+        break;
+      }
+      case FileSystem::ObjectType::kDirectory: {
+        Collect(path, name + "/", inputs);
+        break;
+      }
+      default: {
+        break;
+      }
+    }
+  }
+}
+
+/** Pack all files in a directory into a single pack file **/
+int
+main(int argc, char** argv)
+{
+  // Files are compressed with '--compress' as the first argument
+  const bool compress = argc > 1 && std::strcmp(argv[1], "--compress") == 0;
+  if (compress) {
+    argc--;
+    argv++;
+  }
+  if (argc < 3 || argc > 4) {
+    Console::WriteLine("usage: packer [--compress] <input directory> "
+                       "<output pack> [alignment]");
+    return 1;
+  }
+  const Path input(argv[1]);
+  const Path output(argv[2]);
+  u32 alignment = Pack::kDefaultAlignment;
+  if (argc == 4) {
+    alignment = u32(std::strtoul(argv[3], nullptr, 10));
+  }
+  if (alignment == 0 || (alignment & (alignment - 1)) != 0) {
+    Console::WriteLine("alignment must be a power of two");
+    return 1;
+  }
+  if (FileSystem::GetType(input) != FileSystem::ObjectType::kDirectory) {
+    Console::WriteLine("'{}' is not a directory", input.GetPathString());
+    return 1;
+  }
+
+  // Sort files by name so that the pack is the same between runs
+  std::vector<Input> inputs;
+  Collect(input, "", inputs);
+  std::sort(inputs.begin(), inputs.end(), [](const Input& a, const Input& b) {
+    return std::strcmp(a.name.GetUTF8(), b.name.GetUTF8()) < 0;
+  });
+
+  // Write pack
+  PackBuilder builder(alignment);
+  const Pack::Flag flags =
+    compress ? Pack::Flag::kCompressed : Pack::Flag::kNone;
+  for (Input& file : inputs) {
+    builder.Add(std::move(file.name), std::move(file.path), flags);
+  }
+  const FileResult result = builder.Write(output);
+  if (result != FileResult::kSuccess) {
+    Console::WriteLine("failed to write '{}' ({})",
+                       output.GetPathString(),
+                       u32(result));
+    return 1;
+  }
+  Console::WriteLine("packed {} files into '{}'",
+                     builder.GetFileCount(),
+                     output.GetPathString());
+  return 0;
+}